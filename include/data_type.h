@@ -6,8 +6,7 @@
 #define DATA_TYPE_H
 
 #include <stdint.h>
-
-typedef enum lcd_state_t lcd_state;
+#include <stdbool.h>
 
 typedef enum {
   NORMAL_MODE,
@@ -35,6 +34,7 @@ typedef enum {
   CMD_CAL_CANCEL,
   CMD_SLEEP,
   CMD_WAKE_UP,
+  CMD_SET_RATE, // value = interval sample Device A (ms)
   CMD_UNKNOWN_OR_INVALID
 } cmd_main_t;
 
@@ -46,15 +46,6 @@ typedef struct {
   bool          is_ready;
 } weight_data_t;
 
-typedef struct {
-  lcd_state lcd_state;
-  const char* line_1;
-  const char* line_2;
-  uint8_t cursor_row;
-  uint8_t cursor_col;
-  bool is_clear;
-} led_data_t;
-
 typedef enum {
   LCD_IDLE = 0,
   LCD_INIT,
@@ -64,8 +55,39 @@ typedef enum {
   LCD_CALIBRATION_WAITING,
   LCD_CALIBRATION_INPUT,
   LCD_CONFIRMATION,
+  LCD_DIAGNOSTIC, // kualitas link peer yang sedang ditampilkan
 } lcd_state_t;
 
+typedef lcd_state_t lcd_state;
+
+// jejak latency tombol -> udara / LCD (lihat utils/input_trace.h); origin_us 0 = tanpa jejak
+typedef struct {
+  int64_t origin_us;
+  int64_t stamp_us;
+} input_trace_t;
+
+#define LED_DATA_LINE_SIZE 17 // 16 kolom LCD + '\0'
+
+typedef enum {
+  LED_STYLE_TEXT = 0,   // line_1 / line_2 apa adanya
+  LED_STYLE_BIG_DIGITS, // line_1 digambar dua baris (angka besar), line_2 diabaikan
+  LED_STYLE_BAR,        // line_1 di baris atas, baris bawah bar graph bar_permille
+} led_style_t;
+
+// disalin utuh (main_task -> lcd_mailbox -> lcd_task), jadi baris disimpan di dalam struct
+typedef struct {
+  lcd_state_t lcd_state;
+  char line_1[LED_DATA_LINE_SIZE];
+  char line_2[LED_DATA_LINE_SIZE];
+  uint8_t cursor_row;
+  uint8_t cursor_col;
+  bool is_clear;
+  uint16_t overlay_ms; // >0: tampil sementara (tare, satuan, ...) lalu kembali ke layar sebelumnya
+  uint8_t style;       // led_style_t
+  uint16_t bar_permille;
+  input_trace_t trace; // frame akibat tombol
+} led_data_t;
+
 typedef enum {
   RECEIVED,
   FAILED
@@ -83,6 +105,9 @@ typedef struct {
 typedef struct {
   cmd_main_t  command;
   float       value;
+  uint8_t     peer;       // index peer tujuan di tabel peer comm_task
+  int64_t     enqueue_us; // esp_timer_get_time() saat masuk queue ke comm_task (tidak dikirim ke A)
+  input_trace_t trace;    // command akibat tombol (tidak dikirim ke A)
 } comm_send_data_t;
 
 #endif //DATA_TYPE_H
@@ -0,0 +1,155 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "hd44780_emu.h"
+
+#ifndef ESP_PLATFORM
+
+#include <string.h>
+#include "hd44780_pcf8574.h"
+
+// bit per transaksi di luar byte: start + stop; setiap byte 8 bit + ACK
+#define HD44780_EMU_FRAME_BITS 2
+#define HD44780_EMU_BYTE_BITS  9
+
+static const uint8_t row_offsets[2] = { 0x00, 0x40 };
+
+// forward declaration
+static void latch_nibble(hd44780_emu_t* emu, uint8_t port);
+static void execute(hd44780_emu_t* emu, uint8_t value, bool rs);
+static void instruction(hd44780_emu_t* emu, uint8_t value);
+static void advance(hd44780_emu_t* emu);
+
+void hd44780_emu_init(hd44780_emu_t* emu, uint8_t address) {
+  memset(emu, 0, sizeof(*emu));
+  emu->address = address;
+  emu->increment = true;
+  memset(emu->ddram, ' ', sizeof(emu->ddram));
+}
+
+bool hd44780_emu_i2c_write(hd44780_emu_t* emu, uint8_t address, const uint8_t* data, size_t len) {
+  emu->stats.transactions++;
+  if (address != emu->address) {
+    emu->stats.nacks++;
+    return false;
+  }
+  emu->stats.bytes += len;
+  for (size_t i = 0; i < len; i++) {
+    // HD44780 me-latch di falling edge EN, data yang dipakai = saat EN masih high
+    if ((emu->port & HD44780_PCF_EN) && !(data[i] & HD44780_PCF_EN)) latch_nibble(emu, emu->port);
+    emu->port = data[i];
+  }
+  return true;
+}
+
+bool hd44780_emu_backlight(const hd44780_emu_t* emu) {
+  return (emu->port & HD44780_PCF_BACKLIGHT) != 0;
+}
+
+void hd44780_emu_line(const hd44780_emu_t* emu, uint8_t row, uint8_t cols, char* out) {
+  uint8_t base = row_offsets[row & 1];
+  for (uint8_t i = 0; i < cols; i++) out[i] = (char) emu->ddram[(base + i) & (HD44780_EMU_DDRAM - 1)];
+  out[cols] = '\0';
+}
+
+uint64_t hd44780_emu_bus_us(const hd44780_emu_stats_t* stats, uint32_t clock_hz) {
+  // byte alamat ikut dihitung per transaksi
+  uint64_t bits = (uint64_t) stats->transactions * (HD44780_EMU_FRAME_BITS + HD44780_EMU_BYTE_BITS)
+                  + stats->bytes * HD44780_EMU_BYTE_BITS;
+  return bits * 1000000ULL / clock_hz;
+}
+
+void hd44780_emu_reset_stats(hd44780_emu_t* emu) {
+  memset(&emu->stats, 0, sizeof(emu->stats));
+}
+
+// --- static function ---
+static void latch_nibble(hd44780_emu_t* emu, uint8_t port) {
+  if (port & HD44780_PCF_RW) {
+    emu->stats.protocol_errors++;
+    return;
+  }
+  uint8_t nibble = port >> 4;
+  bool rs = (port & HD44780_PCF_RS) != 0;
+  if (!emu->four_bit) {
+    // mode 8 bit: D0..D3 tidak tersambung di backpack, terbaca 0
+    execute(emu, (uint8_t) (nibble << 4), rs);
+    return;
+  }
+  if (!emu->nibble_pending) {
+    emu->nibble_high = nibble;
+    emu->nibble_pending = true;
+    return;
+  }
+  emu->nibble_pending = false;
+  execute(emu, (uint8_t) (emu->nibble_high << 4 | nibble), rs);
+}
+
+static void execute(hd44780_emu_t* emu, uint8_t value, bool rs) {
+  if (!rs) {
+    emu->stats.instructions++;
+    instruction(emu, value);
+    return;
+  }
+  emu->stats.data_writes++;
+  if (emu->cgram_mode) {
+    emu->cgram[emu->ac & (HD44780_EMU_CGRAM - 1)] = value;
+  } else {
+    emu->ddram[emu->ac & (HD44780_EMU_DDRAM - 1)] = value;
+  }
+  advance(emu);
+}
+
+static void instruction(hd44780_emu_t* emu, uint8_t value) {
+  if (value & HD44780_SET_DDRAM) {
+    emu->ac = value & 0x7F;
+    emu->cgram_mode = false;
+  } else if (value & HD44780_SET_CGRAM) {
+    emu->ac = value & 0x3F;
+    emu->cgram_mode = true;
+  } else if (value & HD44780_FUNCTION_SET) {
+    emu->four_bit = !(value & HD44780_FUNCTION_8BIT);
+    emu->two_line = (value & HD44780_FUNCTION_2LINE) != 0;
+    emu->nibble_pending = false;
+  } else if (value & 0x10) {
+    // cursor / display shift: hanya geser cursor yang didukung
+    if (!(value & 0x08)) {
+      bool saved = emu->increment;
+      emu->increment = (value & 0x04) != 0;
+      advance(emu);
+      emu->increment = saved;
+    }
+  } else if (value & HD44780_DISPLAY_CTRL) {
+    emu->display_on = (value & HD44780_DISPLAY_ON) != 0;
+  } else if (value & HD44780_ENTRY_MODE) {
+    emu->increment = (value & HD44780_ENTRY_INC) != 0;
+  } else if (value & HD44780_HOME) {
+    emu->ac = 0;
+    emu->cgram_mode = false;
+  } else if (value & HD44780_CLEAR) {
+    memset(emu->ddram, ' ', sizeof(emu->ddram));
+    emu->ac = 0;
+    emu->cgram_mode = false;
+    emu->increment = true;
+  }
+}
+
+static void advance(hd44780_emu_t* emu) {
+  if (emu->cgram_mode) {
+    emu->ac = (uint8_t) ((emu->ac + (emu->increment ? 1 : -1)) & (HD44780_EMU_CGRAM - 1));
+    return;
+  }
+  // mode 2 baris: 0x00..0x27 dan 0x40..0x67, berlanjut dari akhir satu baris ke awal baris lain
+  if (emu->increment) {
+    if (emu->ac == 0x27) emu->ac = 0x40;
+    else if (emu->ac == 0x67) emu->ac = 0x00;
+    else emu->ac++;
+  } else {
+    if (emu->ac == 0x00) emu->ac = 0x67;
+    else if (emu->ac == 0x40) emu->ac = 0x27;
+    else emu->ac--;
+  }
+}
+
+#endif
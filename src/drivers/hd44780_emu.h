@@ -0,0 +1,72 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef HD44780_EMU_H
+#define HD44780_EMU_H
+
+// Emulator host (Linux) PCF8574 + HD44780: menerima transaksi I2C mentah seperti bus sungguhan,
+// me-latch nibble di falling edge EN, dan menjalankan instruksi (mode 8/4 bit, DDRAM 2 baris,
+// CGRAM, entry mode). Dipakai untuk memeriksa isi layar dan menghitung transaksi / byte per update.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ESP_PLATFORM
+
+#define HD44780_EMU_DDRAM 0x80
+#define HD44780_EMU_CGRAM 64
+
+typedef struct {
+  uint32_t transactions;
+  uint64_t bytes;           // byte data (tanpa byte alamat)
+  uint32_t instructions;
+  uint32_t data_writes;
+  uint32_t nacks;           // alamat salah
+  uint32_t protocol_errors; // strobe EN dengan RW = 1
+} hd44780_emu_stats_t;
+
+typedef struct {
+  uint8_t address;
+  uint8_t port;             // output PCF8574 terakhir
+  bool    four_bit;
+  bool    nibble_pending;
+  uint8_t nibble_high;
+  bool    two_line;
+  bool    display_on;
+  bool    increment;
+  bool    cgram_mode;
+  uint8_t ac;               // address counter
+  uint8_t ddram[HD44780_EMU_DDRAM];
+  uint8_t cgram[HD44780_EMU_CGRAM];
+  hd44780_emu_stats_t stats;
+} hd44780_emu_t;
+
+// state power-on: mode 8 bit, display mati, DDRAM berisi spasi
+void hd44780_emu_init(hd44780_emu_t* emu, uint8_t address);
+
+// satu transaksi I2C (start, alamat, data, stop); false = NACK
+bool hd44780_emu_i2c_write(hd44780_emu_t* emu, uint8_t address, const uint8_t* data, size_t len);
+
+bool hd44780_emu_backlight(const hd44780_emu_t* emu);
+
+// isi terlihat baris `row` sepanjang `cols`, '\0'-terminated (`out` minimal cols + 1)
+void hd44780_emu_line(const hd44780_emu_t* emu, uint8_t row, uint8_t cols, char* out);
+
+// perkiraan waktu bus (us) untuk stats pada clock I2C `clock_hz`
+uint64_t hd44780_emu_bus_us(const hd44780_emu_stats_t* stats, uint32_t clock_hz);
+
+void hd44780_emu_reset_stats(hd44780_emu_t* emu);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //HD44780_EMU_H
@@ -0,0 +1,65 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "hd44780_pcf8574.h"
+
+// alamat DDRAM awal tiap baris (16x2, 20x4)
+static const uint8_t row_offsets[HD44780_MAX_ROWS] = { 0x00, 0x40, 0x14, 0x54 };
+
+// forward declaration
+static size_t encode_byte(uint8_t* out, uint8_t value, uint8_t flags);
+
+size_t hd44780_encode_nibble(uint8_t* out, size_t cap, uint8_t nibble, bool backlight) {
+  if (cap < HD44780_BYTES_PER_NIBBLE) return 0;
+  uint8_t port = (uint8_t) ((nibble & 0x0F) << 4) | (backlight ? HD44780_PCF_BACKLIGHT : 0);
+  out[0] = port | HD44780_PCF_EN;
+  out[1] = port;
+  return HD44780_BYTES_PER_NIBBLE;
+}
+
+size_t hd44780_encode_command(uint8_t* out, size_t cap, uint8_t command, bool backlight) {
+  if (cap < HD44780_BYTES_PER_CHAR) return 0;
+  return encode_byte(out, command, backlight ? HD44780_PCF_BACKLIGHT : 0);
+}
+
+size_t hd44780_encode_data(uint8_t* out, size_t cap, const uint8_t* data, size_t len, bool backlight) {
+  if (cap < len * HD44780_BYTES_PER_CHAR) return 0;
+  uint8_t flags = HD44780_PCF_RS | (backlight ? HD44780_PCF_BACKLIGHT : 0);
+  size_t n = 0;
+  for (size_t i = 0; i < len; i++) n += encode_byte(out + n, data[i], flags);
+  return n;
+}
+
+size_t hd44780_encode_set_cursor(uint8_t* out, size_t cap, uint8_t col, uint8_t row, bool backlight) {
+  return hd44780_encode_command(out, cap, HD44780_SET_DDRAM | hd44780_ddram_address(col, row), backlight);
+}
+
+size_t hd44780_encode_cgram(uint8_t* out, size_t cap, uint8_t slot, const uint8_t* rows, bool backlight) {
+  if (cap < HD44780_BYTES_PER_CHAR * (1 + HD44780_GLYPH_ROWS)) return 0;
+  size_t n = hd44780_encode_command(out, cap, HD44780_SET_CGRAM | (uint8_t) ((slot & 0x07) << 3), backlight);
+  return n + hd44780_encode_data(out + n, cap - n, rows, HD44780_GLYPH_ROWS, backlight);
+}
+
+uint8_t hd44780_ddram_address(uint8_t col, uint8_t row) {
+  if (row >= HD44780_MAX_ROWS) row = HD44780_MAX_ROWS - 1;
+  return (uint8_t) ((row_offsets[row] + col) & 0x7F);
+}
+
+size_t hd44780_encode_backlight(uint8_t* out, size_t cap, bool backlight) {
+  if (cap < 1) return 0;
+  out[0] = backlight ? HD44780_PCF_BACKLIGHT : 0;
+  return 1;
+}
+
+// --- static function ---
+static size_t encode_byte(uint8_t* out, uint8_t value, uint8_t flags) {
+  // nibble atas dulu
+  uint8_t high = (value & 0xF0) | flags;
+  uint8_t low = (uint8_t) (value << 4) | flags;
+  out[0] = high | HD44780_PCF_EN;
+  out[1] = high;
+  out[2] = low | HD44780_PCF_EN;
+  out[3] = low;
+  return HD44780_BYTES_PER_CHAR;
+}
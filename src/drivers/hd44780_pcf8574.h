@@ -0,0 +1,88 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef HD44780_PCF8574_H
+#define HD44780_PCF8574_H
+
+// Encoder byte I2C untuk LCD HD44780 di belakang expander PCF8574 (backpack "LCD1602 I2C").
+// Pin PCF8574: P0 = RS, P1 = RW, P2 = EN, P3 = backlight, P4..P7 = D4..D7 (mode 4 bit).
+//
+// Setiap nibble = 2 byte expander: data dengan EN high, lalu data dengan EN low (HD44780
+// me-latch di falling edge). Satu byte LCD = 4 byte I2C; string utuh + set cursor di-encode
+// ke satu buffer dan dikirim sebagai satu transaksi I2C. Di 100 kHz satu byte I2C ~90 us,
+// jadi jeda 37 us antar instruksi HD44780 selalu terpenuhi tanpa delay tambahan; hanya
+// clear / home (1.52 ms) dan urutan init yang butuh delay dari pemanggil.
+//
+// Tanpa header ESP-IDF: dipakai lcd_driver.c di target dan emulator hd44780_emu di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HD44780_PCF_RS        0x01
+#define HD44780_PCF_RW        0x02
+#define HD44780_PCF_EN        0x04
+#define HD44780_PCF_BACKLIGHT 0x08
+
+// byte expander per byte LCD / per nibble
+#define HD44780_BYTES_PER_NIBBLE 2
+#define HD44780_BYTES_PER_CHAR   (2 * HD44780_BYTES_PER_NIBBLE)
+
+// instruksi HD44780
+#define HD44780_CLEAR          0x01
+#define HD44780_HOME           0x02
+#define HD44780_ENTRY_MODE     0x04
+#define HD44780_ENTRY_INC      0x02
+#define HD44780_DISPLAY_CTRL   0x08
+#define HD44780_DISPLAY_ON     0x04
+#define HD44780_CURSOR_ON      0x02
+#define HD44780_BLINK_ON       0x01
+#define HD44780_FUNCTION_SET   0x20
+#define HD44780_FUNCTION_8BIT  0x10
+#define HD44780_FUNCTION_2LINE 0x08
+#define HD44780_SET_CGRAM      0x40
+#define HD44780_SET_DDRAM      0x80
+
+// waktu eksekusi (us) instruksi yang jauh lebih lama dari transfer I2C
+#define HD44780_CLEAR_US       2000
+#define HD44780_POWER_ON_MS    50
+#define HD44780_INIT_8BIT_US   4500
+
+#define HD44780_MAX_ROWS 4
+
+// CGRAM: 8 pola 5x8, tampil lewat kode karakter 0..7 (juga 8..15, alias yang sama)
+#define HD44780_CGRAM_SLOTS 8
+#define HD44780_GLYPH_ROWS  8
+
+// hasil encode: jumlah byte yang ditulis ke `out`, 0 jika `cap` tidak cukup (tidak ada yang ditulis)
+size_t hd44780_encode_nibble(uint8_t* out, size_t cap, uint8_t nibble, bool backlight);
+size_t hd44780_encode_command(uint8_t* out, size_t cap, uint8_t command, bool backlight);
+size_t hd44780_encode_data(uint8_t* out, size_t cap, const uint8_t* data, size_t len, bool backlight);
+size_t hd44780_encode_set_cursor(uint8_t* out, size_t cap, uint8_t col, uint8_t row, bool backlight);
+
+// pola 5x8 ke CGRAM `slot` (0..7): set alamat CGRAM + 8 byte data; address counter tertinggal
+// di CGRAM, jadi penulisan karakter berikutnya harus didahului set cursor
+size_t hd44780_encode_cgram(uint8_t* out, size_t cap, uint8_t slot, const uint8_t* rows, bool backlight);
+
+// alamat DDRAM untuk (col, row)
+uint8_t hd44780_ddram_address(uint8_t col, uint8_t row);
+
+// satu byte expander tanpa strobe EN (ubah backlight saja)
+size_t hd44780_encode_backlight(uint8_t* out, size_t cap, bool backlight);
+
+// ukuran buffer untuk set cursor + `chars` karakter
+#define HD44780_RUN_BYTES(chars) (HD44780_BYTES_PER_CHAR * (1 + (chars)))
+
+// ukuran buffer untuk upload satu pola CGRAM + set cursor kembali ke DDRAM
+#define HD44780_CGRAM_BYTES (HD44780_BYTES_PER_CHAR * (2 + HD44780_GLYPH_ROWS))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //HD44780_PCF8574_H
@@ -0,0 +1,279 @@
+//
+// Created by Human Race on 28/05/2025.
+//
+
+#include "lcd_driver.h"
+
+#include "hd44780_pcf8574.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "LCD_DRIVER";
+
+typedef struct {
+  uint16_t len;
+  uint16_t delay_us;        // tunggu setelah transaksi (clear, langkah init)
+  SemaphoreHandle_t done;   // != NULL: penanda lcd_wait_idle tanpa data
+  uint8_t data[HD44780_RUN_BYTES(LCD_DRIVER_XFER_CHARS)];
+} lcd_xfer_t;
+
+typedef struct {
+  uint8_t address;
+  uint8_t cols;
+  uint8_t rows;
+  bool backlight;
+  bool async;
+  // set cursor ditahan dan dikirim dalam transaksi yang sama dengan lcd_write berikutnya
+  uint8_t cursor_len;
+  uint8_t cursor[HD44780_BYTES_PER_CHAR];
+  // alamat DDRAM tempat karakter berikutnya ditulis; dipulihkan setelah upload CGRAM
+  uint8_t ddram;
+  QueueHandle_t queue;
+  TaskHandle_t worker;
+  lcd_driver_stats_t stats;
+} lcd_driver_t;
+
+// forward declaration
+static void transmit(lcd_driver_t* lcd, const uint8_t* data, size_t len, uint16_t delay_us);
+static void flush_cursor(lcd_driver_t* lcd);
+static void transfer(lcd_driver_t* lcd, const uint8_t* data, size_t len, uint16_t delay_us);
+static void command(lcd_driver_t* lcd, uint8_t value, uint16_t delay_us);
+static void async_worker(void* pvParameters);
+
+lcd_handle_t liquidcrystal_i2c_create(uint8_t lcd_addr, uint8_t cols, uint8_t rows) {
+  lcd_driver_t* lcd = calloc(1, sizeof(lcd_driver_t));
+  if (lcd == NULL) return NULL;
+  lcd->address = lcd_addr;
+  lcd->cols = cols;
+  lcd->rows = rows;
+  lcd->backlight = true;
+  return (lcd_handle_t) lcd;
+}
+
+void liquidcrystal_i2c_init(lcd_handle_t lcd_handle) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+
+  i2c_config_t config = {
+    .mode = I2C_MODE_MASTER,
+    .sda_io_num = LCD_DRIVER_I2C_SDA,
+    .scl_io_num = LCD_DRIVER_I2C_SCL,
+    .sda_pullup_en = GPIO_PULLUP_ENABLE,
+    .scl_pullup_en = GPIO_PULLUP_ENABLE,
+    .master.clk_speed = LCD_DRIVER_I2C_HZ,
+  };
+  esp_err_t err = i2c_param_config(LCD_DRIVER_I2C_PORT, &config);
+  if (err == ESP_OK) err = i2c_driver_install(LCD_DRIVER_I2C_PORT, I2C_MODE_MASTER, 0, 0, 0);
+  // ESP_ERR_INVALID_STATE = driver sudah terpasang (perangkat I2C lain)
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "I2C init failed: %s", esp_err_to_name(err));
+    return;
+  }
+
+  vTaskDelay(pdMS_TO_TICKS(HD44780_POWER_ON_MS));
+  // dari state apa pun (8 bit, atau 4 bit di tengah byte) kembali ke 8 bit, lalu pindah ke 4 bit
+  uint8_t buf[HD44780_BYTES_PER_NIBBLE];
+  for (uint8_t i = 0; i < 3; i++) {
+    size_t n = hd44780_encode_nibble(buf, sizeof(buf), 0x3, lcd->backlight);
+    transmit(lcd, buf, n, HD44780_INIT_8BIT_US);
+  }
+  size_t n = hd44780_encode_nibble(buf, sizeof(buf), 0x2, lcd->backlight);
+  transmit(lcd, buf, n, 0);
+
+  command(lcd, HD44780_FUNCTION_SET | (lcd->rows > 1 ? HD44780_FUNCTION_2LINE : 0), 0);
+  command(lcd, HD44780_DISPLAY_CTRL | HD44780_DISPLAY_ON, 0);
+  command(lcd, HD44780_CLEAR, HD44780_CLEAR_US);
+  command(lcd, HD44780_ENTRY_MODE | HD44780_ENTRY_INC, 0);
+}
+
+void lcd_backlight(lcd_handle_t lcd_handle) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+  flush_cursor(lcd);
+  lcd->backlight = true;
+  uint8_t port;
+  transmit(lcd, &port, hd44780_encode_backlight(&port, 1, true), 0);
+}
+
+void lcd_no_backlight(lcd_handle_t lcd_handle) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+  flush_cursor(lcd);
+  lcd->backlight = false;
+  uint8_t port;
+  transmit(lcd, &port, hd44780_encode_backlight(&port, 1, false), 0);
+}
+
+void lcd_set_cursor(lcd_handle_t lcd_handle, uint8_t col, uint8_t row) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+  if (row >= lcd->rows) row = lcd->rows - 1;
+  // set cursor berturut-turut: hanya yang terakhir berarti
+  lcd->cursor_len = (uint8_t) hd44780_encode_set_cursor(lcd->cursor, sizeof(lcd->cursor), col, row, lcd->backlight);
+  lcd->ddram = hd44780_ddram_address(col, row);
+}
+
+void lcd_clear(lcd_handle_t lcd_handle) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+  command(lcd, HD44780_CLEAR, HD44780_CLEAR_US);
+  lcd->ddram = 0;
+}
+
+void lcd_create_char(lcd_handle_t lcd_handle, uint8_t slot, const uint8_t* rows) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL || rows == NULL) return;
+  uint8_t buf[HD44780_CGRAM_BYTES];
+  size_t n = hd44780_encode_cgram(buf, sizeof(buf), slot, rows, lcd->backlight);
+  // kembali ke DDRAM di transaksi yang sama: set cursor yang ditahan, atau posisi terakhir
+  if (lcd->cursor_len > 0) {
+    memcpy(buf + n, lcd->cursor, lcd->cursor_len);
+    n += lcd->cursor_len;
+    lcd->cursor_len = 0;
+  } else {
+    n += hd44780_encode_command(buf + n, sizeof(buf) - n, HD44780_SET_DDRAM | lcd->ddram, lcd->backlight);
+  }
+  transmit(lcd, buf, n, 0);
+}
+
+void lcd_print(lcd_handle_t lcd_handle, char* str) {
+  if (str == NULL) return;
+  size_t len = strlen(str);
+  // potongan per baris DDRAM; string LCD tidak pernah lebih panjang dari itu
+  while (len > 0) {
+    uint8_t chunk = len > LCD_DRIVER_XFER_CHARS ? LCD_DRIVER_XFER_CHARS : (uint8_t) len;
+    lcd_write(lcd_handle, str, chunk);
+    str += chunk;
+    len -= chunk;
+  }
+}
+
+void lcd_write(lcd_handle_t lcd_handle, const char* data, uint8_t len) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL || data == NULL) return;
+  uint8_t buf[HD44780_RUN_BYTES(LCD_DRIVER_XFER_CHARS)];
+  while (len > 0) {
+    uint8_t chunk = len > LCD_DRIVER_XFER_CHARS ? LCD_DRIVER_XFER_CHARS : len;
+    size_t n = lcd->cursor_len;
+    memcpy(buf, lcd->cursor, n);
+    lcd->cursor_len = 0;
+    n += hd44780_encode_data(buf + n, sizeof(buf) - n, (const uint8_t*) data, chunk, lcd->backlight);
+    transmit(lcd, buf, n, 0);
+    lcd->ddram = (uint8_t) ((lcd->ddram + chunk) & 0x7F);
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+bool lcd_set_async(lcd_handle_t lcd_handle, bool async) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return false;
+  if (async && lcd->worker == NULL) {
+    lcd->queue = xQueueCreate(LCD_DRIVER_ASYNC_DEPTH, sizeof(lcd_xfer_t));
+    if (lcd->queue == NULL) return false;
+    if (xTaskCreate(async_worker, "lcd_i2c", 3072, lcd, 6, &lcd->worker) != pdPASS) {
+      vQueueDelete(lcd->queue);
+      lcd->queue = NULL;
+      return false;
+    }
+  }
+  // sync lagi: transaksi yang masih antri diselesaikan dulu supaya urutan tetap
+  if (!async) lcd_wait_idle(lcd_handle, portMAX_DELAY);
+  lcd->async = async;
+  return true;
+}
+
+bool lcd_wait_idle(lcd_handle_t lcd_handle, uint32_t timeout_ms) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return true;
+  flush_cursor(lcd);
+  if (!lcd->async) return true;
+  // penanda di antrian: FIFO, jadi saat diproses semua transaksi sebelumnya sudah selesai
+  lcd_xfer_t marker;
+  SemaphoreHandle_t done = xSemaphoreCreateBinary();
+  if (done == NULL) return false;
+  marker.len = 0;
+  marker.delay_us = 0;
+  marker.done = done;
+  TickType_t ticks = timeout_ms == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+  bool idle = xQueueSend(lcd->queue, &marker, ticks) == pdPASS && xSemaphoreTake(done, ticks) == pdPASS;
+  // timeout: penanda masih di antrian, semaphore-nya tidak boleh dihapus
+  if (idle) vSemaphoreDelete(done);
+  return idle;
+}
+
+void lcd_get_stats(lcd_handle_t lcd_handle, lcd_driver_stats_t* stats) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL || stats == NULL) return;
+  *stats = lcd->stats;
+}
+
+void lcd_deinit(lcd_handle_t lcd_handle) {
+  lcd_driver_t* lcd = lcd_handle;
+  if (lcd == NULL) return;
+  if (lcd->worker != NULL) {
+    lcd_wait_idle(lcd_handle, portMAX_DELAY);
+    vTaskDelete(lcd->worker);
+    vQueueDelete(lcd->queue);
+  }
+  free(lcd);
+}
+
+// --- static function ---
+static void flush_cursor(lcd_driver_t* lcd) {
+  if (lcd->cursor_len == 0) return;
+  uint8_t len = lcd->cursor_len;
+  lcd->cursor_len = 0;
+  transmit(lcd, lcd->cursor, len, 0);
+}
+
+static void transmit(lcd_driver_t* lcd, const uint8_t* data, size_t len, uint16_t delay_us) {
+  if (len == 0) return;
+  if (!lcd->async) {
+    transfer(lcd, data, len, delay_us);
+    return;
+  }
+  // disalin ke antrian: buffer pemanggil boleh langsung dipakai ulang
+  lcd_xfer_t xfer;
+  xfer.len = (uint16_t) len;
+  xfer.delay_us = delay_us;
+  xfer.done = NULL;
+  memcpy(xfer.data, data, len);
+  xQueueSend(lcd->queue, &xfer, portMAX_DELAY);
+  lcd->stats.queued++;
+}
+
+static void transfer(lcd_driver_t* lcd, const uint8_t* data, size_t len, uint16_t delay_us) {
+  // satu transaksi: start, alamat, semua byte expander, stop
+  int64_t start_us = esp_timer_get_time();
+  esp_err_t err = i2c_master_write_to_device(LCD_DRIVER_I2C_PORT, lcd->address, data, len,
+                                             pdMS_TO_TICKS(LCD_DRIVER_TIMEOUT_MS));
+  lcd->stats.busy_us += (uint64_t) (esp_timer_get_time() - start_us);
+  lcd->stats.transactions++;
+  lcd->stats.bytes += len;
+  if (err != ESP_OK) {
+    lcd->stats.errors++;
+    ESP_LOGD(TAG, "I2C write failed: %s", esp_err_to_name(err));
+  }
+  // clear / init: HD44780 sibuk jauh lebih lama dari transfer I2C (dibulatkan ke atas 1 tick)
+  if (delay_us > 0) vTaskDelay(pdMS_TO_TICKS((delay_us + 999) / 1000) + 1);
+}
+
+static void command(lcd_driver_t* lcd, uint8_t value, uint16_t delay_us) {
+  flush_cursor(lcd);
+  uint8_t buf[HD44780_BYTES_PER_CHAR];
+  transmit(lcd, buf, hd44780_encode_command(buf, sizeof(buf), value, lcd->backlight), delay_us);
+}
+
+static void async_worker(void* pvParameters) {
+  lcd_driver_t* lcd = pvParameters;
+  lcd_xfer_t xfer;
+  while (1) {
+    if (xQueueReceive(lcd->queue, &xfer, portMAX_DELAY) != pdPASS) continue;
+    if (xfer.done != NULL) {
+      xSemaphoreGive(xfer.done);
+      continue;
+    }
+    transfer(lcd, xfer.data, xfer.len, xfer.delay_us);
+  }
+}
@@ -8,8 +8,38 @@
 #include <mine_header.h>
 #include "driver/i2c.h"
 
+// LCD HD44780 lewat backpack PCF8574 langsung dengan driver/i2c ESP-IDF (lihat hd44780_pcf8574.h).
+// Setiap panggilan (set cursor, string utuh) = satu transaksi I2C tanpa busy-wait per nibble.
+// Mode async: transaksi diantrikan ke worker task, pemanggil langsung kembali.
+
+#ifndef LCD_DRIVER_I2C_PORT
+#define LCD_DRIVER_I2C_PORT I2C_NUM_0
+#endif
+#ifndef LCD_DRIVER_I2C_SDA
+#define LCD_DRIVER_I2C_SDA  21
+#endif
+#ifndef LCD_DRIVER_I2C_SCL
+#define LCD_DRIVER_I2C_SCL  22
+#endif
+// PCF8574 hanya dispesifikasikan sampai 100 kHz
+#ifndef LCD_DRIVER_I2C_HZ
+#define LCD_DRIVER_I2C_HZ   100000
+#endif
+
+#define LCD_DRIVER_XFER_CHARS   40 // satu baris DDRAM
+#define LCD_DRIVER_ASYNC_DEPTH  4
+#define LCD_DRIVER_TIMEOUT_MS   50
+
 typedef void* lcd_handle_t;
 
+typedef struct {
+  uint32_t transactions;
+  uint64_t bytes;
+  uint32_t errors;
+  uint32_t queued;       // transaksi lewat worker async
+  uint64_t busy_us;      // waktu di i2c_master_write_to_device
+} lcd_driver_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -22,12 +52,27 @@ void lcd_backlight(lcd_handle_t lcd_handle);
 
 void lcd_no_backlight(lcd_handle_t lcd_handle);
 
+// dikirim dalam satu transaksi dengan lcd_write / lcd_print berikutnya (atau sebelum command lain)
 void lcd_set_cursor(lcd_handle_t lcd_handle, uint8_t col, uint8_t row);
 
 void lcd_clear(lcd_handle_t lcd_handle);
 
 void lcd_print(lcd_handle_t lcd_handle, char* str);
 
+// `len` karakter mulai dari cursor, tanpa '\0'
+void lcd_write(lcd_handle_t lcd_handle, const char* data, uint8_t len);
+
+// pola 5x8 (`rows` 8 byte, bit 4..0) ke CGRAM `slot` 0..7; posisi cursor tidak berubah
+void lcd_create_char(lcd_handle_t lcd_handle, uint8_t slot, const uint8_t* rows);
+
+// async: transaksi berikutnya diantrikan; false jika worker tidak bisa dibuat
+bool lcd_set_async(lcd_handle_t lcd_handle, bool async);
+
+// tunggu semua transaksi async yang sudah diantrikan selesai (langsung true jika sync)
+bool lcd_wait_idle(lcd_handle_t lcd_handle, uint32_t timeout_ms);
+
+void lcd_get_stats(lcd_handle_t lcd_handle, lcd_driver_stats_t* stats);
+
 void lcd_deinit(lcd_handle_t lcd_handle);
 
 #ifdef __cplusplus
@@ -0,0 +1,134 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "lcd_glyph.h"
+
+#include <string.h>
+
+#define LCD_GLYPH_BAR_STEPS 5 // kolom pixel per sel
+
+static const uint8_t glyph_bitmaps[LCD_GLYPH_COUNT][HD44780_GLYPH_ROWS] = {
+  [LCD_GLYPH_BAR_1]      = { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+  [LCD_GLYPH_BAR_2]      = { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },
+  [LCD_GLYPH_BAR_3]      = { 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C },
+  [LCD_GLYPH_BAR_4]      = { 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E },
+  [LCD_GLYPH_TOP_AFB]     = { 0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11 },
+  [LCD_GLYPH_TOP_AB]      = { 0x1F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 },
+  [LCD_GLYPH_TOP_AF]      = { 0x1F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+  [LCD_GLYPH_SIDES]       = { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F },
+  [LCD_GLYPH_RIGHT]       = { 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01 },
+  [LCD_GLYPH_BOTTOM_GED]  = { 0x1F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F },
+  [LCD_GLYPH_BOTTOM_GCD]  = { 0x1F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1F },
+  [LCD_GLYPH_BOTTOM_GECD] = { 0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F },
+};
+
+// angka besar: setengah atas dan bawah per digit
+static const uint8_t big_digits[10][2] = {
+  { LCD_GLYPH_TOP_AFB, LCD_GLYPH_SIDES },
+  { LCD_GLYPH_RIGHT,   LCD_GLYPH_RIGHT },
+  { LCD_GLYPH_TOP_AB,  LCD_GLYPH_BOTTOM_GED },
+  { LCD_GLYPH_TOP_AB,  LCD_GLYPH_BOTTOM_GCD },
+  { LCD_GLYPH_SIDES,   LCD_GLYPH_RIGHT },
+  { LCD_GLYPH_TOP_AF,  LCD_GLYPH_BOTTOM_GCD },
+  { LCD_GLYPH_TOP_AF,  LCD_GLYPH_BOTTOM_GECD },
+  { LCD_GLYPH_TOP_AB,  LCD_GLYPH_RIGHT },
+  { LCD_GLYPH_TOP_AFB, LCD_GLYPH_BOTTOM_GECD },
+  { LCD_GLYPH_TOP_AFB, LCD_GLYPH_BOTTOM_GCD },
+};
+
+// forward declaration
+static int8_t find_victim(const lcd_glyph_cache_t* cache);
+
+void lcd_glyph_init(lcd_glyph_cache_t* cache, lcd_glyph_upload_fn upload, void* upload_ctx) {
+  memset(cache, 0, sizeof(*cache));
+  cache->upload = upload;
+  cache->upload_ctx = upload_ctx;
+  memset(cache->slot_glyph, -1, sizeof(cache->slot_glyph));
+}
+
+void lcd_glyph_begin_frame(lcd_glyph_cache_t* cache) {
+  // frame 0 = slot belum pernah dipakai
+  cache->frame++;
+  cache->stats.frames++;
+}
+
+char lcd_glyph_code(lcd_glyph_cache_t* cache, lcd_glyph_id_t id, char fallback) {
+  if (id >= LCD_GLYPH_COUNT) return fallback;
+  for (uint8_t slot = 0; slot < HD44780_CGRAM_SLOTS; slot++) {
+    if (cache->slot_glyph[slot] == (int8_t) id) {
+      cache->slot_used[slot] = cache->frame;
+      cache->stats.hits++;
+      return (char) (LCD_GLYPH_CODE_BASE + slot);
+    }
+  }
+
+  int8_t slot = find_victim(cache);
+  if (slot < 0) {
+    cache->stats.fallbacks++;
+    return fallback;
+  }
+  if (cache->slot_glyph[slot] >= 0) cache->stats.evictions++;
+  cache->slot_glyph[slot] = (int8_t) id;
+  cache->slot_used[slot] = cache->frame;
+  cache->stats.uploads++;
+  if (cache->upload != NULL) cache->upload(cache->upload_ctx, (uint8_t) slot, glyph_bitmaps[id]);
+  return (char) (LCD_GLYPH_CODE_BASE + slot);
+}
+
+void lcd_glyph_bar(lcd_glyph_cache_t* cache, char* out, uint8_t width, uint16_t permille) {
+  if (permille > 1000) permille = 1000;
+  uint32_t steps = (uint32_t) permille * width * LCD_GLYPH_BAR_STEPS / 1000;
+  uint8_t full = (uint8_t) (steps / LCD_GLYPH_BAR_STEPS);
+  uint8_t partial = (uint8_t) (steps % LCD_GLYPH_BAR_STEPS);
+
+  memset(out, LCD_GLYPH_FULL, full);
+  memset(out + full, ' ', width - full);
+  if (partial > 0) {
+    out[full] = lcd_glyph_code(cache, (lcd_glyph_id_t) (LCD_GLYPH_BAR_1 + partial - 1), '|');
+  }
+  out[width] = '\0';
+}
+
+void lcd_glyph_big_text(lcd_glyph_cache_t* cache, const char* text, char* top, char* bottom, uint8_t width) {
+  memset(top, ' ', width);
+  memset(bottom, ' ', width);
+  for (uint8_t col = 0; col < width && text != NULL && text[col] != '\0'; col++) {
+    char c = text[col];
+    if (c >= '0' && c <= '9') {
+      // tanpa slot untuk kedua setengah: angka biasa di baris bawah, bukan setengah digit
+      const uint8_t* halves = big_digits[c - '0'];
+      char upper = lcd_glyph_code(cache, (lcd_glyph_id_t) halves[0], '\0');
+      char lower = upper != '\0' ? lcd_glyph_code(cache, (lcd_glyph_id_t) halves[1], '\0') : '\0';
+      if (upper != '\0' && lower != '\0') {
+        top[col] = upper;
+        bottom[col] = lower;
+      } else {
+        bottom[col] = c;
+      }
+    } else if (c == '-') {
+      top[col] = c;
+    } else {
+      bottom[col] = c;
+    }
+  }
+  top[width] = '\0';
+  bottom[width] = '\0';
+}
+
+const uint8_t* lcd_glyph_bitmap(lcd_glyph_id_t id) {
+  if (id >= LCD_GLYPH_COUNT) return NULL;
+  return glyph_bitmaps[id];
+}
+
+// --- static function ---
+static int8_t find_victim(const lcd_glyph_cache_t* cache) {
+  // slot kosong dulu, lalu yang paling lama tidak dipakai; slot frame ini tidak boleh diganti
+  int8_t victim = -1;
+  for (uint8_t slot = 0; slot < HD44780_CGRAM_SLOTS; slot++) {
+    if (cache->slot_glyph[slot] < 0) return (int8_t) slot;
+    if (cache->slot_used[slot] == cache->frame) continue;
+    if (victim < 0 || cache->slot_used[slot] < cache->slot_used[victim]) victim = (int8_t) slot;
+  }
+  return victim;
+}
@@ -0,0 +1,92 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_GLYPH_H
+#define LCD_GLYPH_H
+
+// Cache 8 slot CGRAM HD44780 untuk glyph custom (bar graph, angka dua baris).
+//
+// Upload satu glyph = 1 transaksi I2C ~36 byte (~3.3 ms di 100 kHz), jadi glyph hanya di-upload
+// jika belum ada di slot mana pun; slot yang dipakai paling lama dulu (LRU) yang diganti. Glyph
+// yang sudah dipakai di frame yang sedang disusun tidak pernah diganti di frame yang sama; jika
+// frame butuh lebih dari 8 glyph, sisanya memakai karakter ASCII pengganti.
+//
+// Slot ditampilkan lewat kode 8..15 (alias CGRAM 0..7) supaya tidak ada '\0' di tengah string.
+// Sel lama yang masih memakai slot yang diganti ikut berubah bentuk sampai frame berikutnya
+// di-flush (beberapa ms).
+//
+// Tanpa header ESP-IDF: upload lewat callback (lcd_create_char di target, emulator di host).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hd44780_pcf8574.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LCD_GLYPH_CODE_BASE 8
+#define LCD_GLYPH_FULL      ((char) 0xFF) // blok penuh dari ROM karakter A00, tanpa CGRAM
+
+typedef enum {
+  // bar graph: 1..4 kolom dari 5 terisi dari kiri
+  LCD_GLYPH_BAR_1 = 0,
+  LCD_GLYPH_BAR_2,
+  LCD_GLYPH_BAR_3,
+  LCD_GLYPH_BAR_4,
+  // angka dua baris (5x16, gaya 7 segmen): setengah atas (a, f, b) dan bawah (g, e, c, d).
+  // 8 glyph untuk semua digit, jadi angka besar saja muat seluruhnya di CGRAM
+  LCD_GLYPH_TOP_AFB,
+  LCD_GLYPH_TOP_AB,
+  LCD_GLYPH_TOP_AF,
+  LCD_GLYPH_SIDES,     // kiri + kanan + garis bawah: bawah 0, atas 4 (g di bawah sel atas)
+  LCD_GLYPH_RIGHT,     // segmen kanan saja, dipakai atas dan bawah
+  LCD_GLYPH_BOTTOM_GED,
+  LCD_GLYPH_BOTTOM_GCD,
+  LCD_GLYPH_BOTTOM_GECD,
+  LCD_GLYPH_COUNT,
+} lcd_glyph_id_t;
+
+typedef struct {
+  uint32_t frames;
+  uint32_t hits;
+  uint32_t uploads;    // glyph yang di-upload (miss)
+  uint32_t evictions;  // upload yang mengganti glyph lain
+  uint32_t fallbacks;  // glyph diganti ASCII karena 8 slot sudah dipakai frame ini
+} lcd_glyph_stats_t;
+
+typedef void (*lcd_glyph_upload_fn)(void* ctx, uint8_t slot, const uint8_t* rows);
+
+typedef struct {
+  lcd_glyph_upload_fn upload;
+  void*    upload_ctx;
+  int8_t   slot_glyph[HD44780_CGRAM_SLOTS]; // -1 = kosong / tidak diketahui
+  uint32_t slot_used[HD44780_CGRAM_SLOTS];  // frame terakhir slot dipakai
+  uint32_t frame;
+  lcd_glyph_stats_t stats;
+} lcd_glyph_cache_t;
+
+// isi CGRAM dianggap tidak diketahui (setelah init LCD)
+void lcd_glyph_init(lcd_glyph_cache_t* cache, lcd_glyph_upload_fn upload, void* upload_ctx);
+
+// panggil sebelum menyusun setiap frame
+void lcd_glyph_begin_frame(lcd_glyph_cache_t* cache);
+
+// kode karakter untuk glyph (upload jika perlu), atau `fallback` jika tidak ada slot
+char lcd_glyph_code(lcd_glyph_cache_t* cache, lcd_glyph_id_t id, char fallback);
+
+// `width` sel bar untuk permille 0..1000 (resolusi 5 per sel); `out` minimal width + 1
+void lcd_glyph_bar(lcd_glyph_cache_t* cache, char* out, uint8_t width, uint16_t permille);
+
+// `text` digambar dua baris: angka jadi glyph besar, karakter lain di baris bawah (titik,
+// satuan) kecuali '-' di baris atas. `top` / `bottom` minimal width + 1, sisa kolom diisi spasi.
+void lcd_glyph_big_text(lcd_glyph_cache_t* cache, const char* text, char* top, char* bottom, uint8_t width);
+
+const uint8_t* lcd_glyph_bitmap(lcd_glyph_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_GLYPH_H
@@ -5,6 +5,10 @@
 #include "nvs_flash.h"
 #include "modules/lcd_task.h"
 #include "modules/button_task.h"
+#include "modules/settings.h"
+#include "modules/power_manager.h"
+#include "modules/boot.h"
+#include "modules/input_latency.h"
 
 static const char* TAG = "MAIN";
 
@@ -15,11 +19,12 @@ led_data_t led_data;
 comm_send_data_t comm_send;
 
 // Queue Handle
-QueueHandle_t main_to_led_queue;
 QueueHandle_t main_to_comm_queue;
-QueueHandle_t comm_to_main_queue;
 QueueHandle_t button_to_main_queue;
 
+// main_task dibangunkan lewat task notification oleh button_task dan comm_task
+TaskHandle_t main_task_handle = NULL;
+
 // declaration task func
 static void main_task(void *pvParameters);
 static void comm_task(void *pvParameters);
@@ -28,48 +33,52 @@ static void button_task(void *pvParameters);
 
 static void main_var_init(void);
 
+// stage boot (index = prioritas saat beberapa stage siap bersamaan)
+typedef enum {
+  BOOT_NVS = 0,
+  BOOT_LCD,
+  BOOT_SETTINGS,
+  BOOT_COMM,
+  BOOT_BUTTON,
+  BOOT_POWER,
+  BOOT_QUEUES,
+  BOOT_STAGE_COUNT,
+} boot_stage_id_t;
+
+static int boot_stage_nvs(void* ctx);
+static int boot_stage_lcd(void* ctx);
+static int boot_stage_settings(void* ctx);
+static int boot_stage_comm(void* ctx);
+static int boot_stage_button(void* ctx);
+static int boot_stage_power(void* ctx);
+static int boot_stage_queues(void* ctx);
+
+static const boot_stage_t boot_stages[BOOT_STAGE_COUNT] = {
+  [BOOT_NVS]      = { .name = "nvs",      .deps = 0,                                            .run = boot_stage_nvs },
+  [BOOT_LCD]      = { .name = "lcd",      .deps = 0,                                            .run = boot_stage_lcd },
+  // satu kali baca blob settings; comm_task dan main_task membaca dari cache
+  [BOOT_SETTINGS] = { .name = "settings", .deps = BOOT_DEP(BOOT_NVS),                           .run = boot_stage_settings },
+  // Wi-Fi butuh NVS, daftar peer dari settings
+  [BOOT_COMM]     = { .name = "comm",     .deps = BOOT_DEP(BOOT_NVS) | BOOT_DEP(BOOT_SETTINGS), .run = boot_stage_comm },
+  [BOOT_BUTTON]   = { .name = "button",   .deps = 0,                                            .run = boot_stage_button },
+  // GPIO tombol dikonfigurasi dulu, power manager memasang wakeup light sleep di atasnya
+  [BOOT_POWER]    = { .name = "power",    .deps = BOOT_DEP(BOOT_BUTTON),                        .run = boot_stage_power },
+  [BOOT_QUEUES]   = { .name = "queues",   .deps = 0,                                            .run = boot_stage_queues },
+};
+
 void app_main() {
   // debug type
   esp_log_level_set("BUTTON_TASK", ESP_LOG_INFO);
 
   // isi variabel dengan nilai awal
   main_var_init();
+  input_latency_init();
 
-  // init task
-
-  // comm_task
-  // Inisialisasi NVS
-  esp_err_t ret = nvs_flash_init();
-  if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-    ESP_ERROR_CHECK(nvs_flash_erase());
-    ret = nvs_flash_init();
-  }
-  ESP_ERROR_CHECK(ret);
-  ESP_ERROR_CHECK(comm_task_init());
-
-  // Main Task -> led task queue
-  main_to_led_queue = xQueueCreate(10, sizeof(led_data_t));
-  if (main_to_led_queue == NULL) {
-    ESP_LOGE(TAG, "main_to_led_queue is NULL");
-  }
-
-  main_to_comm_queue = xQueueCreate(10, sizeof(comm_send_data_t));
-  if (main_to_comm_queue == NULL) {
-    ESP_LOGE(TAG, "main_to_comm_queue is NULL");
-  }
-
-  comm_to_main_queue = xQueueCreate(10, sizeof(weight_data_t));
-  if (comm_to_main_queue == NULL) {
-    ESP_LOGE(TAG, "comm_to_main_queue is NULL");
-  }
-
-  button_to_main_queue = xQueueCreate(5, sizeof(button_event_type_t));
-  if (button_to_main_queue == NULL) {
-    ESP_LOGE(TAG, "button_to_main_queue is NULL");
-  }
+  // stage independen jalan paralel: LCD + splash tidak menunggu Wi-Fi / ESP-NOW
+  ESP_ERROR_CHECK(boot_run(boot_stages, BOOT_STAGE_COUNT));
 
   // create task
-  xTaskCreate(main_task, "main_task", 8192, NULL, 5, NULL);
+  xTaskCreate(main_task, "main_task", 8192, NULL, 5, &main_task_handle);
   xTaskCreate(comm_task, "comm_task", 4096, NULL, 5, NULL);
   xTaskCreate(led_task, "led_task", 4096, NULL, 5, NULL);
   xTaskCreate(button_task, "button_task", 4096, NULL, 5, NULL);
@@ -80,7 +89,7 @@ static void main_task(void *pvParameters) {
   // main task init
   main_task_init();
 
-  if (!main_task_rcv_comm(comm_to_main_queue)) {
+  if (!main_task_rcv_comm()) {
     ESP_LOGE(TAG, "main_task_rcv_comm failed");
   }
 
@@ -88,10 +97,6 @@ static void main_task(void *pvParameters) {
     ESP_LOGE(TAG, "main_task_send_comm failed");
   }
 
-  if (!main_task_send_oled(main_to_led_queue)) {
-    ESP_LOGE(TAG, "main_task_send_oled failed");
-  }
-
   if (!main_task_rcv_button(button_to_main_queue)) {
     ESP_LOGE(TAG, "main_task_rcv_button failed");
   }
@@ -100,11 +105,6 @@ static void main_task(void *pvParameters) {
 }
 
 static void comm_task(void *pvParameters) {
-  // menerima pesan dari ESP32_A
-  if (!comm_task_send_to_main_queue(comm_to_main_queue)) {
-    ESP_LOGW(TAG, "comm_task_send_to_main_queue failed");
-  }
-
   if (!comm_task_rcv_from_main_queue(main_to_comm_queue)) {
     ESP_LOGW(TAG, "comm_task_rcv_from_main_queue rcv failed");
   }
@@ -113,25 +113,69 @@ static void comm_task(void *pvParameters) {
 }
 
 static void led_task(void *pvParameters) {
+  // LCD sudah diinisialisasi di stage boot (splash tampil selama radio naik)
+  lcd_task_update();
+}
 
-  // lcd init
-  lcd_task_init();
+static void button_task(void *pvParameters) {
+  if (!button_task_send_to_main_queue(button_to_main_queue)) {
+    ESP_LOGW(TAG, "button_task_send_to_main_queue failed");
+  }
 
-  if (!lcd_queue_handler_from_main(main_to_led_queue)) {
-    ESP_LOGW(TAG, "lcd_queue_handler_from_main failed");
+  if (!button_task_set_notify(main_task_handle, MAIN_TASK_NOTIFY_BUTTON)) {
+    ESP_LOGW(TAG, "button_task_set_notify failed");
   }
 
-  lcd_task_update();
+  button_task_update();
 }
 
-static void button_task(void *pvParameters) {
-  button_task_init();
+static int boot_stage_nvs(void* ctx) {
+  esp_err_t ret = nvs_flash_init();
+  if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+    ret = nvs_flash_erase();
+    if (ret == ESP_OK) ret = nvs_flash_init();
+  }
+  return ret;
+}
 
-  if (button_task_send_to_main_queue(button_to_main_queue)) {
-    ESP_LOGW(TAG, "button_task_send_to_main_queue failed");
+static int boot_stage_lcd(void* ctx) {
+  lcd_task_init();
+  lcd_task_splash("WEIGHT SCALE", "STARTING...");
+  return ESP_OK;
+}
+
+static int boot_stage_settings(void* ctx) {
+  return settings_init();
+}
+
+static int boot_stage_comm(void* ctx) {
+  return comm_task_init();
+}
+
+static int boot_stage_button(void* ctx) {
+  return button_task_init();
+}
+
+static int boot_stage_power(void* ctx) {
+  return power_manager_init();
+}
+
+static int boot_stage_queues(void* ctx) {
+  // Main Task -> led task lewat lcd_mailbox (lcd_task_post), bukan queue
+  main_to_comm_queue = xQueueCreate(10, sizeof(comm_send_data_t));
+  if (main_to_comm_queue == NULL) {
+    ESP_LOGE(TAG, "main_to_comm_queue is NULL");
   }
 
-  button_task_update();
+  button_to_main_queue = xQueueCreate(5, sizeof(button_msg_t));
+  if (button_to_main_queue == NULL) {
+    ESP_LOGE(TAG, "button_to_main_queue is NULL");
+  }
+
+  if (main_to_comm_queue == NULL || button_to_main_queue == NULL) {
+    return ESP_ERR_NO_MEM;
+  }
+  return ESP_OK;
 }
 
 static void main_var_init(void) {
@@ -143,9 +187,11 @@ static void main_var_init(void) {
   weight_data.raw_weight = 0;
   weight_data.is_ready = false;
 
-  led_data.line_1 = "";
-  led_data.line_2 = "";
+  led_data.line_1[0] = '\0';
+  led_data.line_2[0] = '\0';
 
   comm_send.command = CMD_NORMAL;
   comm_send.value = 0.0f;
+  comm_send.peer = 0;
+  comm_send.enqueue_us = 0;
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "boot.h"
+
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+
+static const char* TAG = "BOOT";
+
+static boot_seq_t seq;
+static portMUX_TYPE seq_lock = portMUX_INITIALIZER_UNLOCKED;
+// diberikan setiap ada stage selesai; worker yang menunggu mengecek ulang stage yang siap
+static SemaphoreHandle_t progress_sem = NULL;
+static SemaphoreHandle_t worker_done_sem = NULL;
+
+// forward declaration
+static void boot_worker(void);
+static void boot_worker_task(void* pvParameters);
+static void boot_report(void);
+
+esp_err_t boot_run(const boot_stage_t* stages, uint8_t count) {
+  if (!boot_seq_init(&seq, stages, count, esp_timer_get_time())) {
+    ESP_LOGE(TAG, "Invalid boot stage graph");
+    return ESP_ERR_INVALID_ARG;
+  }
+  progress_sem = xSemaphoreCreateCounting(BOOT_STAGE_MAX * BOOT_WORKERS, 0);
+  worker_done_sem = xSemaphoreCreateCounting(BOOT_WORKERS, 0);
+  if (progress_sem == NULL || worker_done_sem == NULL) return ESP_ERR_NO_MEM;
+
+  uint8_t helpers = 0;
+  for (uint8_t i = 1; i < BOOT_WORKERS; i++) {
+    if (xTaskCreatePinnedToCore(boot_worker_task, "boot_worker", BOOT_WORKER_STACK, NULL, 5, NULL,
+                                i % portNUM_PROCESSORS) == pdPASS) {
+      helpers++;
+    }
+  }
+  boot_worker();
+  for (uint8_t i = 0; i < helpers; i++) xSemaphoreTake(worker_done_sem, portMAX_DELAY);
+
+  vSemaphoreDelete(progress_sem);
+  vSemaphoreDelete(worker_done_sem);
+  progress_sem = NULL;
+  worker_done_sem = NULL;
+
+  boot_report();
+  return boot_seq_failed(&seq) ? ESP_FAIL : ESP_OK;
+}
+
+void boot_mark_first_weight(void) {
+  int64_t now_us = esp_timer_get_time();
+  portENTER_CRITICAL(&seq_lock);
+  bool first = boot_seq_mark_first_weight(&seq, now_us);
+  portEXIT_CRITICAL(&seq_lock);
+  if (!first) return;
+  ESP_LOGI(TAG, "First weight displayed %lld ms after app_main (%lld ms after power on)",
+           (long long) ((now_us - seq.boot_start_us) / 1000), (long long) (now_us / 1000));
+}
+
+// --- static function ---
+static void boot_worker(void) {
+  while (1) {
+    portENTER_CRITICAL(&seq_lock);
+    int index = boot_seq_take_ready(&seq, esp_timer_get_time());
+    bool finished = boot_seq_finished(&seq);
+    portEXIT_CRITICAL(&seq_lock);
+
+    if (index >= 0) {
+      const boot_stage_t* stage = &seq.stages[index];
+      int status = stage->run(stage->ctx);
+      portENTER_CRITICAL(&seq_lock);
+      boot_seq_complete(&seq, (uint8_t) index, status, esp_timer_get_time());
+      finished = boot_seq_finished(&seq);
+      portEXIT_CRITICAL(&seq_lock);
+      // bangunkan semua worker: bisa jadi beberapa stage sekaligus siap
+      for (uint8_t i = 0; i < BOOT_WORKERS; i++) xSemaphoreGive(progress_sem);
+      if (finished) return;
+      continue;
+    }
+    if (finished) return;
+    xSemaphoreTake(progress_sem, portMAX_DELAY);
+  }
+}
+
+static void boot_worker_task(void* pvParameters) {
+  boot_worker();
+  xSemaphoreGive(worker_done_sem);
+  vTaskDelete(NULL);
+}
+
+static void boot_report(void) {
+  for (uint8_t i = 0; i < seq.count; i++) {
+    ESP_LOGI(TAG, "  %-10s %-7s %6lld .. %6lld us (%lld us)", seq.stages[i].name,
+             boot_stage_state_name((boot_stage_state_t) seq.state[i]),
+             (long long) (seq.start_us[i] - seq.boot_start_us), (long long) (seq.end_us[i] - seq.boot_start_us),
+             (long long) (seq.end_us[i] - seq.start_us[i]));
+  }
+  ESP_LOGI(TAG, "Boot stages done in %lld us (critical path %lld us, app_main at %lld us)",
+           (long long) (seq.boot_end_us - seq.boot_start_us), (long long) boot_seq_critical_path_us(&seq),
+           (long long) seq.boot_start_us);
+}
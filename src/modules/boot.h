@@ -0,0 +1,32 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef BOOT_H
+#define BOOT_H
+
+// Menjalankan tabel stage boot (sub_boot/boot_seq.h) secara paralel di BOOT_WORKERS worker
+// (task pemanggil ikut jadi worker) dan melaporkan waktu tiap stage.
+
+#include <mine_header.h>
+#include "sub_boot/boot_seq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// satu worker per core
+#define BOOT_WORKERS      2
+#define BOOT_WORKER_STACK 4096
+
+// block sampai semua stage selesai; ESP_FAIL jika ada stage wajib yang gagal / dilewati
+esp_err_t boot_run(const boot_stage_t* stages, uint8_t count);
+
+// dari lcd_task saat berat pertama tampil; mencetak waktu boot-to-first-weight sekali
+void boot_mark_first_weight(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //BOOT_H
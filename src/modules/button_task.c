@@ -6,27 +6,83 @@
 
 #include "button_defs.h"
 #include "esp_timer.h" // Untuk esp_timer_get_time()
+#include "soc/gpio_reg.h"
+#include "input_latency.h"
 
 static const char* TAG = "BUTTON_TASK";
 
-static QueueHandle_t button_event_queue;
+// bit notifikasi button_task: bit 0..3 interrupt pin, bit 4 timer
+#define BUTTON_NOTIFY_TIMER (1UL << BUTTON_ENGINE_MAX_PINS)
+
+// gesture per tombol; double_click 0 = click langsung saat dilepas.
+// jendela double click menunda setiap click tombol itu, jadi hanya untuk tombol yang DOUBLE_CLICK-nya
+// dipetakan di main_task (button_to_fsm_event); saat ini belum ada
+#define BUTTON_GESTURE_CLICK        { .long_press_us = LONG_PRESS_TIME_MS * 1000, .double_click_us = 0 }
+#define BUTTON_GESTURE_DOUBLE_CLICK { .long_press_us = LONG_PRESS_TIME_MS * 1000, \
+                                      .double_click_us = DOUBLE_CLICK_TIME_MS * 1000 }
+
+enum { BUTTON_A = 0, BUTTON_B, BUTTON_C, BUTTON_D };
+
+typedef struct {
+  gpio_num_t gpio_num;
+  // urutan button_engine_kind_t (CLICK, DOUBLE_CLICK, LONG_START, LONG_UP) sama dengan urutan enum
+  button_event_type_t first_event;
+  button_engine_pin_config_t gesture;
+} button_pin_t;
+
+typedef struct {
+  uint8_t mask;
+  uint32_t hold_ms;
+  button_event_type_t event;
+} button_chord_t;
+
+static const button_pin_t buttons[] = {
+  [BUTTON_A] = { .gpio_num = BUTTON_A_GPIO, .first_event = BUTTON_EVENT_A_SINGLE_CLICK, .gesture = BUTTON_GESTURE_CLICK },
+  [BUTTON_B] = { .gpio_num = BUTTON_B_GPIO, .first_event = BUTTON_EVENT_B_SINGLE_CLICK, .gesture = BUTTON_GESTURE_CLICK },
+  [BUTTON_C] = { .gpio_num = BUTTON_C_GPIO, .first_event = BUTTON_EVENT_C_SINGLE_CLICK, .gesture = BUTTON_GESTURE_CLICK },
+  [BUTTON_D] = { .gpio_num = BUTTON_D_GPIO, .first_event = BUTTON_EVENT_D_SINGLE_CLICK, .gesture = BUTTON_GESTURE_CLICK },
+};
 
-static button_info_t buttons[] = {
-  { .gpio_num = BUTTON_A_GPIO, .current_state = true, .prev_state = true, .last_press_time = 0, .last_release_time = 0, .last_single_click_time = 0, .long_press_triggered = false, .is_pressed = false },
-  { .gpio_num = BUTTON_B_GPIO, .current_state = true, .prev_state = true, .last_press_time = 0, .last_release_time = 0, .last_single_click_time = 0, .long_press_triggered = false, .is_pressed = false },
-  { .gpio_num = BUTTON_C_GPIO, .current_state = true, .prev_state = true, .last_press_time = 0, .last_release_time = 0, .last_single_click_time = 0, .long_press_triggered = false, .is_pressed = false },
-  { .gpio_num = BUTTON_D_GPIO, .current_state = true, .prev_state = true, .last_press_time = 0, .last_release_time = 0, .last_single_click_time = 0, .long_press_triggered = false, .is_pressed = false },
+static const button_chord_t chords[] = {
+  { .mask = (1u << BUTTON_A) | (1u << BUTTON_B), .hold_ms = LONG_PRESS_TIME_MS, .event = BUTTON_EVENT_AB_LONG_PRESS },
 };
 
 #define NUM_BUTTONS (sizeof(buttons) / sizeof(buttons[0]))
+#define NUM_CHORDS  (sizeof(chords) / sizeof(chords[0]))
 
-static button_event_type_t button_handler_read_event(void);
-static void send_button_event(button_event_type_t event);
+_Static_assert(NUM_BUTTONS <= BUTTON_ENGINE_MAX_PINS, "button_engine pin limit");
+_Static_assert(NUM_CHORDS <= BUTTON_ENGINE_MAX_CHORDS, "button_engine chord limit");
+
+static QueueHandle_t button_event_queue;
+// task consumer yang dibangunkan setelah event masuk queue
+static TaskHandle_t notify_task = NULL;
+static uint32_t notify_bits = 0;
+
+static TaskHandle_t button_task_handle = NULL;
+static esp_timer_handle_t deadline_timer = NULL;
+static button_engine_t engine;
+// ditulis ISR saat interrupt pin aktif, dibaca task setelah notifikasi (interrupt pin sudah mati)
+static volatile int64_t irq_us[NUM_BUTTONS];
+
+// hanya ditulis button_task, salinan untuk task lain di stats_snapshot
+static button_task_stats_t stats;
+static button_task_stats_t stats_snapshot;
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// forward declaration
+static void button_isr(void* arg);
+static void deadline_timer_cb(void* arg);
+static uint32_t engine_read(void* ctx);
+static void engine_arm(void* ctx, uint8_t pin, bool pressed);
+static void schedule_deadline(int64_t now_us);
+static button_event_type_t map_event(const button_engine_event_t* event);
+static void send_button_events(const button_engine_event_t* events, uint8_t count);
+static void publish_stats(void);
 
 esp_err_t button_task_init(void) {
   esp_err_t ret;
   gpio_config_t io_conf;
-  // non-intrerrupt mode
+  // interrupt di-arm per pin oleh button_task (level kebalikan state sekarang)
   io_conf.intr_type = GPIO_INTR_DISABLE;
   // set as input mode
   io_conf.mode = GPIO_MODE_INPUT;
@@ -43,6 +99,32 @@ esp_err_t button_task_init(void) {
       return ret;
     }
   }
+
+  // sudah terpasang jika komponen lain memasang lebih dulu
+  ret = gpio_install_isr_service(0);
+  if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "gpio_install_isr_service failed: %s", esp_err_to_name(ret));
+    return ret;
+  }
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    ret = gpio_isr_handler_add(buttons[i].gpio_num, button_isr, (void*) (uintptr_t) i);
+    if (ret != ESP_OK) {
+      ESP_LOGE(TAG, "gpio_isr_handler_add %d failed: %s", buttons[i].gpio_num, esp_err_to_name(ret));
+      return ret;
+    }
+  }
+
+  const esp_timer_create_args_t timer_args = {
+    .callback = deadline_timer_cb,
+    .name = "button_deadline",
+  };
+  ret = esp_timer_create(&timer_args, &deadline_timer);
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "esp_timer_create failed: %s", esp_err_to_name(ret));
+    return ret;
+  }
+
+  latency_hist_reset(&stats.dispatch);
   ESP_LOGI(TAG, "Buttons initialized");
   return ESP_OK;
 }
@@ -53,188 +135,144 @@ bool button_task_send_to_main_queue(QueueHandle_t button_to_main_queue) {
     return true;
 }
 
+bool button_task_set_notify(TaskHandle_t task, uint32_t bits) {
+  if (task == NULL) return false;
+  notify_bits = bits;
+  notify_task = task;
+  return true;
+}
+
 void button_task_update(void) {
-  while (1) {
-    button_event_type_t button_event = button_handler_read_event();
-
-    switch (button_event) {
-            case BUTTON_EVENT_A_SINGLE_CLICK:
-                ESP_LOGI(TAG, "Button A: Single Click!");
-                break;
-            case BUTTON_EVENT_A_DOUBLE_CLICK:
-                ESP_LOGI(TAG, "Button A: Double Click!");
-                break;
-            case BUTTON_EVENT_A_LONG_PRESS_START:
-                ESP_LOGI(TAG, "Button A: Long Press Started!");
-                break;
-            case BUTTON_EVENT_A_LONG_PRESS_UP:
-                ESP_LOGI(TAG, "Button A: Long Press Released!");
-                break;
-
-            case BUTTON_EVENT_B_SINGLE_CLICK:
-                ESP_LOGI(TAG, "Button B: Single Click!");
-                break;
-            case BUTTON_EVENT_B_DOUBLE_CLICK:
-                ESP_LOGI(TAG, "Button B: Double Click!");
-                break;
-            case BUTTON_EVENT_B_LONG_PRESS_START:
-                ESP_LOGI(TAG, "Button B: Long Press Started!");
-                break;
-            case BUTTON_EVENT_B_LONG_PRESS_UP:
-                ESP_LOGI(TAG, "Button B: Long Press Released!");
-                break;
-
-            case BUTTON_EVENT_C_SINGLE_CLICK:
-                ESP_LOGI(TAG, "Button C: Single Click!");
-                break;
-            case BUTTON_EVENT_C_DOUBLE_CLICK:
-                ESP_LOGI(TAG, "Button C: Double Click!");
-                break;
-            case BUTTON_EVENT_C_LONG_PRESS_START:
-                ESP_LOGI(TAG, "Button C: Long Press Started!");
-                break;
-            case BUTTON_EVENT_C_LONG_PRESS_UP:
-                ESP_LOGI(TAG, "Button C: Long Press Released!");
-                break;
-
-            case BUTTON_EVENT_D_SINGLE_CLICK:
-                ESP_LOGI(TAG, "Button D: Single Click!");
-                break;
-            case BUTTON_EVENT_D_DOUBLE_CLICK:
-                ESP_LOGI(TAG, "Button D: Double Click!");
-                break;
-            case BUTTON_EVENT_D_LONG_PRESS_START:
-                ESP_LOGI(TAG, "Button D: Long Press Started!");
-                break;
-            case BUTTON_EVENT_D_LONG_PRESS_UP:
-                ESP_LOGI(TAG, "Button D: Long Press Released!");
-                break;
-
-            case BUTTON_EVENT_AB_LONG_PRESS:
-                ESP_LOGI(TAG, "Combination: A and B Long Press!");
-                break;
-
-            case BUTTON_NONE:
-                // Tidak ada event, lakukan sesuatu yang lain atau biarkan saja
-                break;
-            default:
-                break;
-        }
-
-    send_button_event(button_event);
-
-    vTaskDelay(pdMS_TO_TICKS(20));
+  // handle dulu: interrupt baru di-arm oleh button_engine_init di bawah
+  button_task_handle = xTaskGetCurrentTaskHandle();
+
+  button_engine_config_t config = {
+    .pin_count = NUM_BUTTONS,
+    .chord_count = NUM_CHORDS,
+    .debounce_us = DEBOUNCE_TIME_MS * 1000,
+  };
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) config.pins[i] = buttons[i].gesture;
+  for (uint8_t i = 0; i < NUM_CHORDS; i++) {
+    config.chords[i].mask = chords[i].mask;
+    config.chords[i].hold_us = chords[i].hold_ms * 1000;
   }
-}
+  const button_engine_io_t io = {
+    .read = engine_read,
+    .arm = engine_arm,
+    .ctx = NULL,
+  };
+  button_engine_init(&engine, &config, &io, esp_timer_get_time());
+
+  button_engine_event_t events[BUTTON_ENGINE_MAX_EVENTS];
+  while (1) {
+    uint32_t bits = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+    stats.wakes++;
+    if (bits & BUTTON_NOTIFY_TIMER) stats.timer_wakes++;
 
-static button_event_type_t button_handler_read_event(void) {
-  button_event_type_t event = BUTTON_NONE;
-    uint64_t current_time_us = esp_timer_get_time();
-
-    // Cek event untuk setiap tombol
-    for (int i = 0; i < NUM_BUTTONS; i++) {
-        buttons[i].current_state = gpio_get_level(buttons[i].gpio_num);
-
-        // Jika tombol sedang ditekan (active low)
-        if (buttons[i].current_state == 0) {
-            if (!buttons[i].is_pressed) { // Baru mulai ditekan
-                buttons[i].is_pressed = true;
-                buttons[i].last_press_time = current_time_us;
-                buttons[i].long_press_triggered = false;
-            } else { // Sedang ditekan
-                if (!buttons[i].long_press_triggered && (current_time_us - buttons[i].last_press_time) / 1000 >= LONG_PRESS_TIME_MS) {
-                    buttons[i].long_press_triggered = true;
-                    switch (buttons[i].gpio_num) {
-                        case BUTTON_A_GPIO: event = BUTTON_EVENT_A_LONG_PRESS_START; break;
-                        case BUTTON_B_GPIO: event = BUTTON_EVENT_B_LONG_PRESS_START; break;
-                        case BUTTON_C_GPIO: event = BUTTON_EVENT_C_LONG_PRESS_START; break;
-                        case BUTTON_D_GPIO: event = BUTTON_EVENT_D_LONG_PRESS_START; break;
-                        default: break;
-                    }
-                    if (event != BUTTON_NONE) return event; // Prioritaskan long press start
-                }
-            }
-        } else { // Jika tombol dilepas
-            if (buttons[i].is_pressed) { // Baru saja dilepas
-                buttons[i].is_pressed = false;
-                buttons[i].last_release_time = current_time_us;
-
-                if (buttons[i].long_press_triggered) {
-                    switch (buttons[i].gpio_num) {
-                        case BUTTON_A_GPIO: event = BUTTON_EVENT_A_LONG_PRESS_UP; break;
-                        case BUTTON_B_GPIO: event = BUTTON_EVENT_B_LONG_PRESS_UP; break;
-                        case BUTTON_C_GPIO: event = BUTTON_EVENT_C_LONG_PRESS_UP; break;
-                        case BUTTON_D_GPIO: event = BUTTON_EVENT_D_LONG_PRESS_UP; break;
-                        default: break;
-                    }
-                    if (event != BUTTON_NONE) return event; // Prioritaskan long press up
-                } else {
-                    // Cek double click
-                    if ((current_time_us - buttons[i].last_single_click_time) / 1000 < DOUBLE_CLICK_TIME_MS) {
-                        switch (buttons[i].gpio_num) {
-                            case BUTTON_A_GPIO: event = BUTTON_EVENT_A_DOUBLE_CLICK; break;
-                            case BUTTON_B_GPIO: event = BUTTON_EVENT_B_DOUBLE_CLICK; break;
-                            case BUTTON_C_GPIO: event = BUTTON_EVENT_C_DOUBLE_CLICK; break;
-                            case BUTTON_D_GPIO: event = BUTTON_EVENT_D_DOUBLE_CLICK; break;
-                            default: break;
-                        }
-                        buttons[i].last_single_click_time = 0; // Reset untuk mencegah triple click yang tidak diinginkan
-                        if (event != BUTTON_NONE) return event; // Prioritaskan double click
-                    } else {
-                        // Single click potensial, simpan waktu
-                        buttons[i].last_single_click_time = current_time_us;
-                    }
-                }
-            } else { // Tombol tidak ditekan dan stabil
-                // Jika ada single click potensial yang belum diproses (waktunya habis)
-                if (buttons[i].last_single_click_time != 0 && (current_time_us - buttons[i].last_single_click_time) / 1000 >= DOUBLE_CLICK_TIME_MS) {
-                    switch (buttons[i].gpio_num) {
-                        case BUTTON_A_GPIO: event = BUTTON_EVENT_A_SINGLE_CLICK; break;
-                        case BUTTON_B_GPIO: event = BUTTON_EVENT_B_SINGLE_CLICK; break;
-                        case BUTTON_C_GPIO: event = BUTTON_EVENT_C_SINGLE_CLICK; break;
-                        case BUTTON_D_GPIO: event = BUTTON_EVENT_D_SINGLE_CLICK; break;
-                        default: break;
-                    }
-                    buttons[i].last_single_click_time = 0; // Reset
-                    if (event != BUTTON_NONE) return event; // Prioritaskan single click
-                }
-            }
-        }
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+      if (bits & (1UL << i)) button_engine_irq(&engine, i, irq_us[i]);
     }
 
-    // Cek event kombinasi (BUTTON_EVENT_AB_LONG_PRESS)
-    // Asumsi kedua tombol harus ditekan secara bersamaan dan mencapai durasi long press
-    if (buttons[0].is_pressed && buttons[1].is_pressed) { // Tombol A dan B sedang ditekan
-        uint64_t press_duration_A = (current_time_us - buttons[0].last_press_time) / 1000;
-        uint64_t press_duration_B = (current_time_us - buttons[1].last_press_time) / 1000;
-
-        // Cek jika kedua tombol sudah melewati durasi long press
-        // Dan pastikan tidak ada long press individual yang terdeteksi untuk A atau B
-        if (press_duration_A >= LONG_PRESS_TIME_MS && press_duration_B >= LONG_PRESS_TIME_MS) {
-            // Untuk memastikan hanya terdeteksi sekali saat kombinasi long press dimulai
-            if (!buttons[0].long_press_triggered && !buttons[1].long_press_triggered) {
-                event = BUTTON_EVENT_AB_LONG_PRESS;
-                // Set long_press_triggered untuk kedua tombol agar tidak re-trigger
-                buttons[0].long_press_triggered = true;
-                buttons[1].long_press_triggered = true;
-                return event;
-            }
-        }
-    } else {
-        // Reset long_press_triggered jika kombinasi dilepas
-        if (buttons[0].long_press_triggered && buttons[1].long_press_triggered) {
-            buttons[0].long_press_triggered = false;
-            buttons[1].long_press_triggered = false;
-        }
+    int64_t now_us = esp_timer_get_time();
+    uint8_t count = button_engine_poll(&engine, now_us, events, BUTTON_ENGINE_MAX_EVENTS);
+    for (uint8_t i = 0; i < count; i++) {
+      if (events[i].kind == BUTTON_ENGINE_CHORD_LONG) {
+        ESP_LOGI(TAG, "Chord %u: Long Press!", events[i].pin);
+      } else {
+        ESP_LOGI(TAG, "Button %c: %s", 'A' + events[i].pin,
+                 button_engine_kind_name((button_engine_kind_t) events[i].kind));
+      }
     }
+    send_button_events(events, count);
+
+    schedule_deadline(now_us);
+    publish_stats();
+  }
+}
 
-    return event;
+void button_task_get_stats(button_task_stats_t* out) {
+  if (out == NULL) return;
+  portENTER_CRITICAL(&stats_lock);
+  *out = stats_snapshot;
+  portEXIT_CRITICAL(&stats_lock);
 }
 
-static void send_button_event(button_event_type_t event) {
-  if (xQueueSend(button_event_queue, &event, pdMS_TO_TICKS(200)) != pdPASS) {
-    ESP_LOGW(TAG, "Failed to send button event");
-  } else {
-    ESP_LOGE(TAG, "Button event: %d", event);
+// --- static function ---
+static void IRAM_ATTR button_isr(void* arg) {
+  uint32_t pin = (uint32_t) (uintptr_t) arg;
+  // level interrupt: matikan sampai button_task selesai debounce dan arm lagi
+  gpio_intr_disable(buttons[pin].gpio_num);
+  irq_us[pin] = esp_timer_get_time();
+  BaseType_t woken = pdFALSE;
+  xTaskNotifyFromISR(button_task_handle, 1UL << pin, eSetBits, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+static void deadline_timer_cb(void* arg) {
+  xTaskNotify(button_task_handle, BUTTON_NOTIFY_TIMER, eSetBits);
+}
+
+static uint32_t engine_read(void* ctx) {
+  // satu baca register untuk semua tombol (semua di GPIO 0..31), active low
+  uint32_t in = REG_READ(GPIO_IN_REG);
+  uint32_t pressed = 0;
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    if (!((in >> buttons[i].gpio_num) & 1)) pressed |= 1UL << i;
   }
-}
\ No newline at end of file
+  return pressed;
+}
+
+static void engine_arm(void* ctx, uint8_t pin, bool pressed) {
+  // level, bukan edge: transisi yang terjadi sebelum arm langsung memicu interrupt, dan
+  // wakeup light sleep GPIO di ESP32 hanya mendukung level (lepas saat ditahan juga membangunkan)
+  gpio_int_type_t level = pressed ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL;
+  gpio_num_t gpio = buttons[pin].gpio_num;
+  gpio_set_intr_type(gpio, level);
+  gpio_wakeup_enable(gpio, level);
+  gpio_intr_enable(gpio);
+}
+
+static void schedule_deadline(int64_t now_us) {
+  // tanpa tenggat tidak ada timer sama sekali: task tidur sampai interrupt berikutnya
+  esp_timer_stop(deadline_timer);
+  int64_t deadline = button_engine_next_deadline_us(&engine);
+  if (deadline == BUTTON_ENGINE_NO_DEADLINE) return;
+  esp_timer_start_once(deadline_timer, deadline > now_us ? (uint64_t) (deadline - now_us) : 0);
+}
+
+static button_event_type_t map_event(const button_engine_event_t* event) {
+  if (event->kind == BUTTON_ENGINE_CHORD_LONG) return chords[event->pin].event;
+  return (button_event_type_t) (buttons[event->pin].first_event + event->kind);
+}
+
+static void send_button_events(const button_engine_event_t* events, uint8_t count) {
+  // satu notifikasi untuk satu batch; jika queue penuh, main_task dibangunkan dulu supaya menguras
+  bool queued = false;
+  for (uint8_t i = 0; i < count; i++) {
+    button_msg_t msg = { .event = map_event(&events[i]) };
+    input_trace_start(&msg.trace, events[i].origin_us);
+    input_latency_hop(&msg.trace, INPUT_TRACE_RECOGNIZE, events[i].time_us);
+    if (xQueueSend(button_event_queue, &msg, 0) != pdPASS) {
+      if (notify_task != NULL) xTaskNotify(notify_task, notify_bits, eSetBits);
+      if (xQueueSend(button_event_queue, &msg, pdMS_TO_TICKS(200)) != pdPASS) {
+        stats.dropped++;
+        ESP_LOGW(TAG, "Failed to send button event");
+        continue;
+      }
+    }
+    queued = true;
+    int64_t sent_us = esp_timer_get_time();
+    stats.sent++;
+    latency_hist_record(&stats.dispatch, sent_us > events[i].time_us ? (uint32_t) (sent_us - events[i].time_us) : 0);
+    ESP_LOGD(TAG, "Button event: %d", msg.event);
+  }
+  if (queued && notify_task != NULL) xTaskNotify(notify_task, notify_bits, eSetBits);
+}
+
+static void publish_stats(void) {
+  stats.engine = engine.stats;
+  portENTER_CRITICAL(&stats_lock);
+  stats_snapshot = stats;
+  portEXIT_CRITICAL(&stats_lock);
+}
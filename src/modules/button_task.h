@@ -7,6 +7,9 @@
 
 #include <mine_header.h>
 #include "driver/gpio.h"
+#include "sub_button/button_engine.h"
+#include "utils/latency_hist.h"
+#include "utils/input_trace.h"
 
 // Definisi GPIO untuk setiap tombol
 #define BUTTON_A_GPIO GPIO_NUM_13 // Sebelumnya GPIO_NUM_0
@@ -14,8 +17,8 @@
 #define BUTTON_C_GPIO GPIO_NUM_14 // Sebelumnya GPIO_NUM_2
 #define BUTTON_D_GPIO GPIO_NUM_27 // Sebelumnya GPIO_NUM_3
 
-// Waktu debounce dalam milidetik
-#define DEBOUNCE_TIME_MS 100
+// Waktu debounce dalam milidetik (interrupt pin mati selama ini setelah transisi)
+#define DEBOUNCE_TIME_MS 20
 
 // Waktu double click dalam milidetik
 #define DOUBLE_CLICK_TIME_MS 300
@@ -53,22 +56,31 @@ typedef enum  {
   BUTTON_EVENT_AB_LONG_PRESS,     // Tombol A dan B ditekan lama bersamaan
 } button_event_type_t;
 
-// Struktur untuk menyimpan status setiap tombol
+// isi queue button_task -> main_task
 typedef struct {
-  gpio_num_t gpio_num;
-  bool current_state;
-  bool prev_state;
-  uint64_t last_press_time;
-  uint64_t last_release_time;
-  uint64_t last_single_click_time;
-  bool long_press_triggered;
-  bool is_pressed; // True jika tombol sedang ditekan
-} button_info_t;
+  button_event_type_t event;
+  input_trace_t trace;     // origin = tekan fisik yang memulai gesture
+} button_msg_t;
+
+typedef struct {
+  button_engine_stats_t engine;
+  uint32_t wakes;        // button_task bangun (interrupt + timer)
+  uint32_t timer_wakes;  // dari timer debounce / long press / double click
+  uint32_t sent;
+  uint32_t dropped;      // queue ke main_task penuh
+  latency_hist_t dispatch; // kondisi event terpenuhi sampai masuk queue (us)
+} button_task_stats_t;
 
 esp_err_t  button_task_init(void);
 
 bool button_task_send_to_main_queue(QueueHandle_t button_to_main_queue);
 
+// task yang dibangunkan (xTaskNotify, eSetBits) setiap event dikirim ke queue
+bool button_task_set_notify(TaskHandle_t task, uint32_t bits);
+
+// tidur sampai interrupt tombol atau tenggat timer; hanya event nyata yang dikirim
 void button_task_update(void); // button loop
 
+void button_task_get_stats(button_task_stats_t* stats);
+
 #endif //BUTTON_TASK_H
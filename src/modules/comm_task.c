@@ -3,115 +3,327 @@
 //
 
 #include "comm_task.h"
-#include "esp_now.h"
-#include "esp_wifi.h"
-#include "esp_event.h"
+#include "sub_comm/comm_codec.h"
+#include "sub_comm/comm_transport_espnow.h"
+#include "esp_timer.h"
+#include "settings.h"
+#include "input_latency.h"
+
+// ring penuh: buang sample paling lama, display selalu butuh data terbaru
+#define COMM_RX_RING_POLICY COMM_RX_OVERWRITE_OLDEST
+
+// retransmit command: 150, 300, 600, 1000, 1000 ms lalu dianggap gagal
+#define COMM_CMD_TIMEOUT_MS      150
+#define COMM_CMD_MAX_TIMEOUT_MS  1000
+#define COMM_CMD_MAX_RETRIES     4
+
+#define COMM_CTRL_QUEUE_LEN      8
+#define COMM_SEND_DONE_QUEUE_LEN 8
+// panjang main_to_comm_queue di app_main, dibutuhkan untuk ukuran queue set
+#define COMM_CMD_QUEUE_LEN       10
+// jarak antar PING saat probe aktif; peer di-ping bergiliran
+#define COMM_LINK_PROBE_INTERVAL_MS 250
+// jendela pairing maksimum, supaya node asing tidak bisa masuk kapan saja
+#define COMM_PAIRING_MAX_MS      60000
+
+_Static_assert(COMM_PEER_MAC_LEN == COMM_TRANSPORT_MAC_LEN, "MAC length mismatch");
+_Static_assert(COMM_PEER_MAC_LEN == SETTINGS_MAC_LEN && COMM_PEER_MAX == SETTINGS_PEER_MAX, "settings peer list mismatch");
+_Static_assert(COMM_LINK_RSSI_NONE == COMM_TRANSPORT_RSSI_NONE, "RSSI sentinel mismatch");
+_Static_assert(COMM_ENGINE_BACKLOG_LEN == COMM_CMD_QUEUE_LEN, "backlog must hold a full command queue");
 
 
 static const char* TAG = "COMM_TASK";
 
-uint8_t receiver_mac[ESP_NOW_ETH_ALEN] = { 0x34, 0x98, 0x7A, 0x89, 0x89, 0x08 };
+// peer default jika NVS belum berisi daftar peer
+static const uint8_t default_receiver_mac[COMM_PEER_MAC_LEN] = { 0x34, 0x98, 0x7A, 0x89, 0x89, 0x08 };
+
+// submit / ACK / send callback / receive path, tanpa FreeRTOS (sub_comm/comm_engine)
+static comm_engine_t engine;
+
+// radio; ESP-NOW di target, bisa diganti loopback di host lewat comm_task_set_transport()
+static const comm_transport_t* transport = NULL;
 
 // queuehandler
 QueueHandle_t comm_task_rcv_queue = NULL;
-QueueHandle_t comm_task_send_queue = NULL;
+
+static TaskHandle_t rx_notify_task = NULL;
+static uint32_t rx_notify_bits = 0;
+
+// ACK / PING / PONG dari callback Wi-Fi -> comm_task
+static QueueHandle_t ctrl_queue = NULL;
+// salinan statistik untuk dibaca task lain
+static comm_reliable_stats_t cmd_stats_snapshot;
+static comm_tx_stats_t tx_stats_snapshot;
+static uint32_t cmd_settled_snapshot = 0;
+static uint32_t cmd_failed_logged = 0;
+static portMUX_TYPE cmd_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// comm_task hanya bangun jika ada command, ACK, atau send callback
+static QueueSetHandle_t comm_event_set = NULL;
+// status send callback dari Wi-Fi task -> comm_task
+static QueueHandle_t send_done_queue = NULL;
+
+// statistik link ditulis callback Wi-Fi dan comm_task
+static portMUX_TYPE link_lock = portMUX_INITIALIZER_UNLOCKED;
 
 // forward declaration
-static void esp_now_send_cb(const uint8_t* mac_address, esp_now_send_status_t status);
-static void esp_now_recv_cb(const uint8_t *mac_addr, const uint8_t *data, int data_len);
+static void transport_send_cb(const uint8_t* mac_addr, bool success, void* ctx);
+static void transport_recv_cb(const uint8_t* mac_addr, int8_t rssi, const uint8_t* data, int data_len, void* ctx);
+static int64_t engine_now_us(void* ctx);
+static bool engine_post_ctrl(void* ctx, const comm_engine_ctrl_t* ctrl);
+static bool engine_post_send_done(void* ctx, const comm_engine_send_done_t* done);
+static void engine_notify_rx(void* ctx);
+static void engine_link_lock(void* ctx);
+static void engine_link_unlock(void* ctx);
+static void engine_paired(void* ctx, const uint8_t* mac, uint8_t peer);
+static void engine_traced(void* ctx, input_trace_t* trace, int64_t air_us);
+static void submit_cmd(const comm_send_data_t* cmd, int64_t now_us);
+static void handle_ctrl(const comm_engine_ctrl_t* ctrl, int64_t now_us);
+static void publish_cmd_stats(void);
+static TickType_t ticks_until(int64_t deadline_us, int64_t now_us);
+static esp_err_t load_peers(void);
+static esp_err_t save_peers(void);
+
+static const comm_engine_io_t engine_io = {
+  .now_us = engine_now_us,
+  .post_ctrl = engine_post_ctrl,
+  .post_send_done = engine_post_send_done,
+  .notify_rx = engine_notify_rx,
+  .link_lock = engine_link_lock,
+  .link_unlock = engine_link_unlock,
+  .paired = engine_paired,
+  .traced = engine_traced,
+  .ctx = NULL,
+};
 
 esp_err_t comm_task_init(void) {
-  ESP_ERROR_CHECK(esp_netif_init());
-  ESP_ERROR_CHECK(esp_event_loop_create_default());
-  wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-  ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-  ESP_ERROR_CHECK(esp_wifi_set_storage(WIFI_STORAGE_RAM));
-  ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-  ESP_ERROR_CHECK(esp_wifi_start());
-  ESP_LOGI(TAG, "ESP WIFI_MODE_STA");
-
-  // --- KRUSIAL: INISIALISASI ESP-NOW DI SINI ---
-  esp_err_t esp_now_init_ret = esp_now_init();
-  if (esp_now_init_ret != ESP_OK) {
-    ESP_LOGE(TAG, "Failed to initialize ESP-NOW: %s", esp_err_to_name(esp_now_init_ret));
-    return esp_now_init_ret; // Kembalikan error jika inisialisasi ESP-NOW gagal
+  comm_engine_config_t engine_config = {
+    .reliable = {
+      .initial_timeout_us = COMM_CMD_TIMEOUT_MS * 1000,
+      .max_timeout_us = COMM_CMD_MAX_TIMEOUT_MS * 1000,
+      .max_retries = COMM_CMD_MAX_RETRIES,
+    },
+    .rx_policy = COMM_RX_RING_POLICY,
+    .probe_interval_us = COMM_LINK_PROBE_INTERVAL_MS * 1000,
+    .pairing_max_ms = COMM_PAIRING_MAX_MS,
+  };
+
+#ifdef ESP_PLATFORM
+  if (transport == NULL) transport = comm_transport_espnow();
+#endif
+  if (transport == NULL) {
+    ESP_LOGE(TAG, "No transport");
+    return ESP_ERR_INVALID_STATE;
   }
-  ESP_LOGI(TAG, "ESP-NOW initialized.");
-
-  // tambahkan peer (penerima)
-  esp_now_peer_info_t peer_info = {};
-  memcpy(peer_info.peer_addr, receiver_mac, ESP_NOW_ETH_ALEN);
-  peer_info.channel = 0; // channel wifi saat ini
-  peer_info.encrypt = false; // Tanpa enkripsi
-  peer_info.ifidx = WIFI_IF_STA; // jika sender dalam mode STA
-
-  // daftarkan callback
-  ESP_ERROR_CHECK(esp_now_register_send_cb(esp_now_send_cb)); // untuk status pengiriman
-  ESP_ERROR_CHECK(esp_now_register_recv_cb(esp_now_recv_cb)); // untuk menerima data
-
-  ESP_LOGI(TAG, "ADDING PEER: %02x:%02x:%02x:%02x:%02x:%02x",
-    receiver_mac[0], receiver_mac[1], receiver_mac[2], receiver_mac[3],
-    receiver_mac[4], receiver_mac[5]);
-
-  // check peer
-  if (!esp_now_is_peer_exist(receiver_mac)) {
-    esp_err_t add_peer_ret = esp_now_add_peer(&peer_info);
-    if (add_peer_ret != ESP_OK) {
-      ESP_LOGE(TAG, "Failed to add peer: %s", esp_err_to_name(add_peer_ret));
-      return ESP_FAIL;
-    }
-    ESP_LOGI(TAG, "Successfully added PEER");
-  } else {
-    ESP_LOGI(TAG, "PEER already exist");
+  comm_engine_init(&engine, &engine_config, transport, &engine_io);
+  publish_cmd_stats();
+
+  ctrl_queue = xQueueCreate(COMM_CTRL_QUEUE_LEN, sizeof(comm_engine_ctrl_t));
+  send_done_queue = xQueueCreate(COMM_SEND_DONE_QUEUE_LEN, sizeof(comm_engine_send_done_t));
+  comm_event_set = xQueueCreateSet(COMM_CMD_QUEUE_LEN + COMM_CTRL_QUEUE_LEN + COMM_SEND_DONE_QUEUE_LEN);
+  if (ctrl_queue == NULL || send_done_queue == NULL || comm_event_set == NULL) {
+    ESP_LOGE(TAG, "comm_task queues are NULL");
+    return ESP_ERR_NO_MEM;
   }
+  xQueueAddToSet(ctrl_queue, comm_event_set);
+  xQueueAddToSet(send_done_queue, comm_event_set);
 
-  return ESP_OK;
+  comm_transport_set_callbacks(transport, transport_recv_cb, transport_send_cb, NULL);
+  if (!comm_transport_init(transport)) {
+    ESP_LOGE(TAG, "Failed to initialize transport %s", transport->ops->name);
+    return ESP_FAIL;
+  }
+  ESP_LOGI(TAG, "Transport %s initialized.", transport->ops->name);
+
+  // tambahkan peer (penerima) dari settings ke tabel dan transport
+  return load_peers();
+}
+
+bool comm_task_set_transport(const comm_transport_t* radio) {
+  // hanya sebelum comm_task_init, callback transport tidak bisa dipindah saat berjalan
+  if (radio == NULL || comm_event_set != NULL) return false;
+  transport = radio;
+  return true;
+}
+
+void comm_task_start_pairing(uint32_t window_ms) {
+  if (ctrl_queue == NULL) return;
+  comm_engine_ctrl_t open = { .type = COMM_ENGINE_CTRL_PAIR_OPEN, .stamp = window_ms };
+  xQueueSend(ctrl_queue, &open, 0);
+}
+
+bool comm_task_pairing_active(void) {
+  return engine.pairing_open;
+}
+
+uint8_t comm_task_peer_count(void) {
+  return engine.peers.count;
+}
+
+const uint8_t* comm_task_peer_mac(uint8_t peer) {
+  return comm_peer_table_mac(&engine.peers, peer);
+}
+
+bool comm_task_get_peer_latest(uint8_t peer, weight_data_t* weight) {
+  if (weight == NULL) return false;
+  return comm_peer_table_load_latest(&engine.peers, peer, weight);
+}
+
+bool comm_task_get_peer_stats(uint8_t peer, comm_peer_stats_t* stats) {
+  if (stats == NULL || peer >= engine.peers.count) return false;
+  comm_peer_table_get_stats(&engine.peers, peer, stats);
+  return true;
 }
 
 bool comm_task_rcv_from_main_queue(QueueHandle_t main_to_comm_queue) {
-  if (main_to_comm_queue == NULL) return false;
+  if (main_to_comm_queue == NULL || comm_event_set == NULL) return false;
+  // queue harus masih kosong saat dimasukkan ke queue set
+  if (xQueueAddToSet(main_to_comm_queue, comm_event_set) != pdPASS) return false;
   comm_task_rcv_queue = main_to_comm_queue;
   return true;
 }
 
-bool comm_task_send_to_main_queue(QueueHandle_t comm_to_main_queue) {
-  if (comm_to_main_queue == NULL) return false;
-  comm_task_send_queue = comm_to_main_queue;
+bool comm_task_set_rx_notify(TaskHandle_t task, uint32_t notify_bits) {
+  if (task == NULL) return false;
+  rx_notify_bits = notify_bits;
+  rx_notify_task = task;
   return true;
 }
 
+bool comm_task_receive(weight_data_t* weight, uint8_t* peer, int64_t* rx_us) {
+  comm_rx_item_t item;
+  if (!comm_engine_receive(&engine, &item)) return false;
+  *weight = item.weight;
+  if (peer != NULL) *peer = item.peer;
+  if (rx_us != NULL) *rx_us = item.rx_us;
+  return true;
+}
+
+void comm_task_get_rx_stats(comm_rx_stats_t* stats) {
+  if (stats == NULL) return;
+  comm_engine_get_rx_stats(&engine, stats);
+}
+
+bool comm_task_get_link_stats(uint8_t peer, comm_link_stats_t* stats) {
+  return comm_engine_get_link_stats(&engine, peer, stats);
+}
+
+void comm_task_set_link_probe(bool enable) {
+  if (enable == engine.probe_enabled) return;
+  comm_engine_set_link_probe(&engine, enable);
+  if (enable && ctrl_queue != NULL) {
+    // comm_task bisa sedang tidur tanpa deadline
+    comm_engine_ctrl_t wake = { .type = COMM_ENGINE_CTRL_WAKE };
+    xQueueSend(ctrl_queue, &wake, 0);
+  }
+}
+
+void comm_task_get_cmd_stats(comm_reliable_stats_t* stats) {
+  if (stats == NULL) return;
+  portENTER_CRITICAL(&cmd_stats_lock);
+  *stats = cmd_stats_snapshot;
+  portEXIT_CRITICAL(&cmd_stats_lock);
+}
+
+void comm_task_get_tx_stats(comm_tx_stats_t* stats) {
+  if (stats == NULL) return;
+  portENTER_CRITICAL(&cmd_stats_lock);
+  *stats = tx_stats_snapshot;
+  portEXIT_CRITICAL(&cmd_stats_lock);
+}
+
+uint32_t comm_task_cmd_settled(void) {
+  portENTER_CRITICAL(&cmd_stats_lock);
+  uint32_t settled = cmd_settled_snapshot;
+  portEXIT_CRITICAL(&cmd_stats_lock);
+  return settled;
+}
+
 void comm_task_update(void) {
+  latency_hist_reset(&engine.tx_stats.enqueue_to_air);
+
   while (1) {
-    comm_send_data_t comm_send_data;
-    // menerima dari task lain
-    if (xQueueReceive(comm_task_rcv_queue, &comm_send_data, pdMS_TO_TICKS(200)) == pdPASS) {
-      // mengirim data ke esp32_A
-      esp_err_t send_ret = esp_now_send(receiver_mac, (uint8_t *) &comm_send_data, sizeof(comm_send_data));
-      if (send_ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to send data: %s", esp_err_to_name(send_ret));
-      } else {
-        ESP_LOGI(TAG, "Successfully sent data to ESP32 B");
+    int64_t now_us = esp_timer_get_time();
+    bool pairing_before = engine.pairing_open;
+
+    // kirim ulang command yang timeout, lalu tidur sampai deadline berikutnya atau ada event
+    int64_t deadline_us = comm_engine_poll(&engine, now_us);
+    if (pairing_before && !engine.pairing_open) {
+      ESP_LOGI(TAG, "Pairing window closed, no new peer");
+    }
+    // command gagal dan backlog yang baru dikirim langsung terlihat oleh comm_task_cmd_settled(),
+    // main_task tidak perlu menunggu event berikutnya sebelum deep sleep
+    if (engine.reliable.stats.failed != cmd_failed_logged) {
+      cmd_failed_logged = engine.reliable.stats.failed;
+      ESP_LOGE(TAG, "Command not acknowledged by ESP32 A after %d retries", COMM_CMD_MAX_RETRIES);
+    }
+    publish_cmd_stats();
+
+    QueueSetMemberHandle_t ready = xQueueSelectFromSet(comm_event_set, ticks_until(deadline_us, now_us));
+    now_us = esp_timer_get_time();
+
+    if (ready == comm_task_rcv_queue) {
+      comm_send_data_t comm_send_data;
+      if (xQueueReceive(comm_task_rcv_queue, &comm_send_data, 0) == pdPASS) {
+        submit_cmd(&comm_send_data, now_us);
+      }
+    } else if (ready == ctrl_queue) {
+      comm_engine_ctrl_t ctrl;
+      if (xQueueReceive(ctrl_queue, &ctrl, 0) == pdPASS) {
+        handle_ctrl(&ctrl, now_us);
+      }
+    } else if (ready == send_done_queue) {
+      comm_engine_send_done_t done;
+      if (xQueueReceive(send_done_queue, &done, 0) == pdPASS) {
+        comm_engine_handle_send_done(&engine, &done);
       }
-    } else {
-      ESP_LOGW(TAG, "Failed to receive data from comm_task_rcv_queue");
     }
 
-    vTaskDelay(pdMS_TO_TICKS(100));
+    publish_cmd_stats();
+  }
+}
 
+static void submit_cmd(const comm_send_data_t* cmd, int64_t now_us) {
+  switch (comm_engine_submit(&engine, cmd, now_us)) {
+    case COMM_ENGINE_COALESCED:
+      ESP_LOGI(TAG, "Command %d already in flight, not sent again", cmd->command);
+      break;
+    case COMM_ENGINE_DROPPED:
+      ESP_LOGE(TAG, "Command backlog full, dropping command %d", cmd->command);
+      break;
+    default:
+      break;
   }
 }
 
-static void esp_now_send_cb(const uint8_t* mac_addr, esp_now_send_status_t status) {
-  if (mac_addr == NULL) {
-    ESP_LOGE(TAG, "Send callback: MAC address is null");
-    return;
+static void handle_ctrl(const comm_engine_ctrl_t* ctrl, int64_t now_us) {
+  comm_engine_handle_ctrl(&engine, ctrl, now_us);
+  if (ctrl->type == COMM_ENGINE_CTRL_PAIR_OPEN) {
+    ESP_LOGI(TAG, "Pairing open for %lu ms", (unsigned long) ((engine.pairing_until_us - now_us) / 1000));
   }
-  ESP_LOGI(TAG, "Sent to %02X:%02X:%02X:%02X:%02X:%02X status: %s",
-    mac_addr[0], mac_addr[1], mac_addr[2], mac_addr[3], mac_addr[4], mac_addr[5],
-    status == ESP_NOW_SEND_SUCCESS ? "Success" : "Fail");
 }
 
-static void esp_now_recv_cb(const uint8_t *mac_addr, const uint8_t *data, int data_len) {
+static TickType_t ticks_until(int64_t deadline_us, int64_t now_us) {
+  if (deadline_us == COMM_ENGINE_NO_DEADLINE) return portMAX_DELAY;
+  if (deadline_us <= now_us) return 0;
+  TickType_t ticks = pdMS_TO_TICKS((deadline_us - now_us + 999) / 1000);
+  return ticks > 0 ? ticks : 1;
+}
+
+static void publish_cmd_stats(void) {
+  portENTER_CRITICAL(&cmd_stats_lock);
+  cmd_stats_snapshot = engine.reliable.stats;
+  comm_engine_get_tx_stats(&engine, &tx_stats_snapshot);
+  cmd_settled_snapshot = comm_engine_cmd_settled(&engine);
+  portEXIT_CRITICAL(&cmd_stats_lock);
+}
+
+// --- callback transport (Wi-Fi task: jangan block dan jangan log per frame) ---
+static void transport_send_cb(const uint8_t* mac_addr, bool success, void* ctx) {
+  comm_engine_on_send(&engine, mac_addr, success);
+}
+
+static void transport_recv_cb(const uint8_t* mac_addr, int8_t rssi, const uint8_t* data, int data_len, void* ctx) {
   if (mac_addr == NULL) {
     ESP_LOGE(TAG, "mac_addr is NULL");
     return;
@@ -122,19 +334,78 @@ static void esp_now_recv_cb(const uint8_t *mac_addr, const uint8_t *data, int da
     return;
   }
 
-  if (data_len != sizeof(weight_data_t)) {
-    ESP_LOGE(TAG, "Received data length (%d) does not match expected size (%d) for weight_data_t",
-             data_len, sizeof(weight_data_t));
+  uint32_t bad_version = engine.rx_stats.bad_version;
+  comm_engine_on_recv(&engine, mac_addr, rssi, data, data_len);
+  // cukup log sekali, jangan banjiri log tiap frame
+  if (bad_version == 0 && engine.rx_stats.bad_version > 0) {
+    ESP_LOGE(TAG, "Unsupported wire version 0x%02x (expected major %d)", data[0], COMM_WIRE_VERSION_MAJOR);
+  }
+}
+
+// --- io comm_engine ---
+static int64_t engine_now_us(void* ctx) {
+  return esp_timer_get_time();
+}
+
+static bool engine_post_ctrl(void* ctx, const comm_engine_ctrl_t* ctrl) {
+  return xQueueSend(ctrl_queue, ctrl, 0) == pdPASS;
+}
+
+static bool engine_post_send_done(void* ctx, const comm_engine_send_done_t* done) {
+  return xQueueSend(send_done_queue, done, 0) == pdPASS;
+}
+
+static void engine_notify_rx(void* ctx) {
+  if (rx_notify_task != NULL) {
+    xTaskNotify(rx_notify_task, rx_notify_bits, eSetBits);
+  }
+}
+
+static void engine_link_lock(void* ctx) {
+  portENTER_CRITICAL(&link_lock);
+}
+
+static void engine_link_unlock(void* ctx) {
+  portEXIT_CRITICAL(&link_lock);
+}
+
+static void engine_paired(void* ctx, const uint8_t* mac, uint8_t peer) {
+  if (peer == COMM_PEER_NONE) {
+    ESP_LOGE(TAG, "Peer table full (%d peers)", COMM_PEER_MAX);
     return;
   }
+  save_peers();
+  ESP_LOGI(TAG, "Paired %02x:%02x:%02x:%02x:%02x:%02x as peer %u", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5],
+           peer);
+}
+
+static void engine_traced(void* ctx, input_trace_t* trace, int64_t air_us) {
+  input_latency_hop(trace, INPUT_TRACE_COMM, air_us);
+  input_latency_end(trace, INPUT_TRACE_END_AIR, air_us);
+}
 
-  weight_data_t buffer_weight;
-  memcpy(&buffer_weight, data, sizeof(weight_data_t));
+static esp_err_t load_peers(void) {
+  settings_t settings;
+  settings_get(&settings);
 
-  // kirim queue
-  if (xQueueSendFromISR(comm_task_send_queue, &buffer_weight, NULL) != pdPASS) {
-    ESP_LOGE(TAG, "Failed to send comm_task_queue");
+  if (settings.peer_count > 0) {
+    for (uint8_t i = 0; i < settings.peer_count; i++) {
+      if (!comm_engine_add_peer(&engine, settings.peers[i], NULL)) return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Loaded %d peers from settings", engine.peers.count);
   } else {
-    ESP_LOGI(TAG, "Successfully sent comm_task_queue");
+    if (!comm_engine_add_peer(&engine, default_receiver_mac, NULL)) return ESP_FAIL;
+    ESP_LOGI(TAG, "No peers in settings, using default peer");
   }
-}
\ No newline at end of file
+  return ESP_OK;
+}
+
+static esp_err_t save_peers(void) {
+  // seluruh tabel, termasuk peer default yang belum pernah disimpan
+  for (uint8_t i = 0; i < engine.peers.count; i++) {
+    settings_add_peer(comm_peer_table_mac(&engine.peers, i));
+  }
+  // peer baru jarang dan harus selamat dari reboot: tidak menunggu debounce
+  settings_request_flush();
+  return ESP_OK;
+}
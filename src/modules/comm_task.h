@@ -6,6 +6,11 @@
 #define COMM_TASK_H
 
 #include <mine_header.h>
+#include "sub_comm/comm_reliable.h"
+#include "sub_comm/comm_peer_table.h"
+#include "sub_comm/comm_link_stats.h"
+#include "sub_comm/comm_transport.h"
+#include "sub_comm/comm_engine.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,9 +18,51 @@ extern "C" {
 
 esp_err_t comm_task_init();
 
+// ganti radio (mis. loopback di host); harus sebelum comm_task_init, default ESP-NOW
+bool comm_task_set_transport(const comm_transport_t* radio);
+
 bool comm_task_rcv_from_main_queue(QueueHandle_t main_to_comm_queue);
 
-bool comm_task_send_to_main_queue(QueueHandle_t comm_to_main_queue);
+// task yang dibangunkan (xTaskNotify, eSetBits) setiap ada frame baru
+bool comm_task_set_rx_notify(TaskHandle_t task, uint32_t notify_bits);
+
+// dipanggil dari task consumer (main_task); return false jika tidak ada data.
+// `peer` diisi index peer pengirim, `rx_us` waktu sample (esp_timer); keduanya boleh NULL
+bool comm_task_receive(weight_data_t* weight, uint8_t* peer, int64_t* rx_us);
+
+// buka jendela pairing selama `window_ms`: frame valid pertama dari MAC yang belum dikenal
+// menjadi peer baru (ESP-NOW + settings), lalu jendela ditutup dan task rx dibangunkan
+void comm_task_start_pairing(uint32_t window_ms);
+
+bool comm_task_pairing_active(void);
+
+uint8_t comm_task_peer_count(void);
+
+// NULL jika index tidak valid
+const uint8_t* comm_task_peer_mac(uint8_t peer);
+
+// sample terakhir dari satu peer, tanpa mengambil dari ring
+bool comm_task_get_peer_latest(uint8_t peer, weight_data_t* weight);
+
+bool comm_task_get_peer_stats(uint8_t peer, comm_peer_stats_t* stats);
+
+void comm_task_get_rx_stats(comm_rx_stats_t* stats);
+
+// RSSI, PDR, celah frame dan RTT ping/pong untuk satu peer
+bool comm_task_get_link_stats(uint8_t peer, comm_link_stats_t* stats);
+
+// PING berkala ke semua peer (bergiliran) untuk mengukur RTT; default mati
+void comm_task_set_link_probe(bool enable);
+
+// statistik command reliable (retransmit, gagal, histogram round-trip ACK)
+void comm_task_get_cmd_stats(comm_reliable_stats_t* stats);
+
+void comm_task_get_tx_stats(comm_tx_stats_t* stats);
+
+// command dari queue main->comm yang sudah selesai: di-ACK, gagal setelah retry, digabung dengan
+// command yang sama, atau dibuang karena backlog penuh. Sama dengan jumlah yang berhasil di-queue
+// = tidak ada command yang masih di jalan
+uint32_t comm_task_cmd_settled(void);
 
 void comm_task_update(void);
 
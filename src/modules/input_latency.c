@@ -0,0 +1,43 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "input_latency.h"
+
+static input_trace_stats_t stats;
+// hop dicatat dari beberapa task; critical section hanya sepanjang satu record histogram
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void input_latency_init(void) {
+  portENTER_CRITICAL(&stats_lock);
+  input_trace_stats_reset(&stats);
+  portEXIT_CRITICAL(&stats_lock);
+}
+
+void input_latency_hop(input_trace_t* trace, input_trace_hop_t hop, int64_t now_us) {
+  if (trace == NULL || trace->origin_us == 0) return;
+  portENTER_CRITICAL(&stats_lock);
+  input_trace_hop(&stats, trace, hop, now_us);
+  portEXIT_CRITICAL(&stats_lock);
+}
+
+void input_latency_end(const input_trace_t* trace, input_trace_hop_t hop, int64_t now_us) {
+  if (trace == NULL || trace->origin_us == 0) return;
+  portENTER_CRITICAL(&stats_lock);
+  input_trace_end(&stats, trace, hop, now_us);
+  portEXIT_CRITICAL(&stats_lock);
+}
+
+void input_latency_get_stats(input_trace_stats_t* out) {
+  if (out == NULL) return;
+  portENTER_CRITICAL(&stats_lock);
+  *out = stats;
+  portEXIT_CRITICAL(&stats_lock);
+}
+
+uint32_t input_latency_percentile(input_trace_hop_t hop, uint8_t percentile) {
+  portENTER_CRITICAL(&stats_lock);
+  uint32_t value = input_trace_percentile(&stats, hop, percentile);
+  portEXIT_CRITICAL(&stats_lock);
+  return value;
+}
@@ -0,0 +1,34 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+// Histogram latency input bersama (lihat utils/input_trace.h): button_task, main_task, comm_task
+// dan lcd_task masing-masing mencatat hop-nya sendiri, task mana pun boleh membaca salinan.
+
+#include <mine_header.h>
+#include "utils/input_trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// sebelum task dibuat
+void input_latency_init(void);
+
+void input_latency_hop(input_trace_t* trace, input_trace_hop_t hop, int64_t now_us);
+
+void input_latency_end(const input_trace_t* trace, input_trace_hop_t hop, int64_t now_us);
+
+void input_latency_get_stats(input_trace_stats_t* stats);
+
+// percentile 0..100 satu hop (us), 0 jika belum ada sample
+uint32_t input_latency_percentile(input_trace_hop_t hop, uint8_t percentile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //INPUT_LATENCY_H
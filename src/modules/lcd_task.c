@@ -5,6 +5,12 @@
 #include "lcd_task.h"
 #include "driver/i2c.h"
 #include "drivers/lcd_driver.h"
+#include "drivers/lcd_glyph.h"
+#include "esp_timer.h"
+#include "boot.h"
+#include "sub_lcd/lcd_frame.h"
+#include "sub_lcd/lcd_sched.h"
+#include "input_latency.h"
 
 static const char* TAG = "LCD_TASK";
 
@@ -15,105 +21,213 @@ static const char* TAG = "LCD_TASK";
 #define LCD_I2C_ADDR                0x27
 
 lcd_handle_t lcd_handle = NULL;
-QueueHandle_t lcd_queue_from_main = NULL;
 
 lcd_state current_lcd_state = LCD_IDLE;
 
 led_data_t lcd_data;
 
-// forward declaration
-static void lcd_state_dispatcher();
+// tanpa frame baru, loop tetap bangun sesekali untuk backlight yang mungkin terlewat
+#define LCD_TASK_IDLE_MS 1000
+
+static TaskHandle_t lcd_task_handle = NULL;
+// layar dasar dan overlay terpisah: refresh berat tidak menimpa overlay yang belum diambil
+static lcd_mailbox_t lcd_mailbox;
+static lcd_mailbox_t overlay_mailbox;
+static lcd_sched_t lcd_sched;
+// origin jejak input terakhir yang sudah dicatat
+static int64_t last_trace_origin_us = 0;
+
+// hanya ditulis lcd_task, salinan untuk task lain di stats_snapshot
+static lcd_task_stats_t stats;
+static lcd_task_stats_t stats_snapshot;
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// isi LCD yang diinginkan vs yang sudah tampil; hanya sel yang berubah dikirim lewat I2C
+static lcd_frame_t lcd_frame;
+
+// slot CGRAM untuk bar graph / angka besar
+static lcd_glyph_cache_t lcd_glyphs;
+
+// backlight yang diminta vs yang sudah terpasang
+static volatile bool backlight_request = true;
+static bool backlight_on = true;
 
+// waktu boot dilaporkan sekali, saat berat pertama benar-benar tampil
+static bool first_weight_shown = false;
+
+// forward declaration
+static void lcd_apply_backlight(void);
+static void lcd_wake(void);
+static void lcd_take_posts(void);
+static void lcd_record_render(int64_t post_us, int64_t start_us, int64_t done_us);
+static void lcd_publish_stats(void);
+static void lcd_record_input_trace(int64_t done_us);
+static void lcd_sink_set_cursor_i2c(void* self, uint8_t col, uint8_t row);
+static void lcd_sink_write_i2c(void* self, const char* data, uint8_t len);
 static void lcd_render(void);
-static void lcd_render_init(void);
-static void lcd_render_normal(void);
-static void lcd_render_tare(void);
-static void lcd_render_calibration(void);
-static void lcd_render_calibration_waiting(void);
-static void lcd_render_calibration_input(void);
-static void lcd_render_confirmation(void);
+static void lcd_upload_glyph(void* ctx, uint8_t slot, const uint8_t* rows);
+
+static const lcd_sink_ops_t lcd_sink_ops = {
+  .set_cursor = lcd_sink_set_cursor_i2c,
+  .write = lcd_sink_write_i2c,
+  .name = "i2c",
+};
+static const lcd_sink_t lcd_sink = { .ops = &lcd_sink_ops, .self = NULL };
 
 void lcd_task_init(void) {
   lcd_handle = liquidcrystal_i2c_create(LCD_I2C_ADDR, 16, 2);
   liquidcrystal_i2c_init(lcd_handle);
   lcd_backlight(lcd_handle);
+  lcd_frame_init(&lcd_frame);
+  lcd_glyph_init(&lcd_glyphs, lcd_upload_glyph, NULL);
+  lcd_mailbox_init(&lcd_mailbox);
+  lcd_mailbox_init(&overlay_mailbox);
+  lcd_sched_init(&lcd_sched, NULL);
+  memset(&stats, 0, sizeof(stats));
+  latency_hist_reset(&stats.staleness);
+  latency_hist_reset(&stats.render);
+  stats_snapshot = stats;
 }
 
-bool lcd_queue_handler_from_main(QueueHandle_t main_to_lcd_queue) {
-  if (main_to_lcd_queue == NULL) return false;
-  lcd_queue_from_main = main_to_lcd_queue;
-  return true;
+void lcd_task_post(const led_data_t* data) {
+  lcd_mailbox_post(data->overlay_ms > 0 ? &overlay_mailbox : &lcd_mailbox, data, esp_timer_get_time());
+  lcd_wake();
+}
+
+void lcd_task_splash(const char* line_1, const char* line_2) {
+  lcd_frame_set_line(&lcd_frame, 0, line_1);
+  lcd_frame_set_line(&lcd_frame, 1, line_2);
+  lcd_frame_flush(&lcd_frame, &lcd_sink);
+}
+
+void lcd_task_set_backlight(bool on) {
+  backlight_request = on;
+  lcd_wake();
 }
 
 void lcd_task_update(void) {
+  lcd_task_handle = xTaskGetCurrentTaskHandle();
   while (1) {
-    if (xQueueReceive(lcd_queue_from_main, &lcd_data, pdMS_TO_TICKS(200)) != pdPASS) {
-      ESP_LOGW(TAG, "LCD DATA receive failed");
-    } else {
-      ESP_LOGI(TAG, "LCD DATA line 1 %s", lcd_data.line_1);
-      ESP_LOGI(TAG, "LCD DATA receive success");
+    lcd_apply_backlight();
+
+    lcd_take_posts();
+
+    // pergantian layar / overlay langsung, refresh biasa dibatasi frame rate
+    int64_t post_us;
+    uint32_t wait_us;
+    int64_t start_us = esp_timer_get_time();
+    if (lcd_sched_next(&lcd_sched, start_us, &lcd_data, &post_us, &wait_us)) {
+      ESP_LOGD(TAG, "LCD DATA line 1 %s", lcd_data.line_1);
       lcd_render();
+      int64_t done_us = esp_timer_get_time();
+      lcd_record_render(post_us, start_us, done_us);
+      lcd_record_input_trace(done_us);
+      if (!first_weight_shown && lcd_data.lcd_state == LCD_NORMAL) {
+        first_weight_shown = true;
+        boot_mark_first_weight();
+      }
+      // mungkin masih ada frame lain yang jatuh tempo (mis. layar dasar setelah overlay)
+      wait_us = 0;
     }
-    vTaskDelay(pdMS_TO_TICKS(100));
+    lcd_publish_stats();
+
+    // bangun karena post / backlight / tenggat scheduler; post selama menunggu dilebur jadi satu frame
+    uint32_t wait_ms = wait_us / 1000 < LCD_TASK_IDLE_MS ? (wait_us + 999) / 1000 : LCD_TASK_IDLE_MS;
+    if (wait_ms > 0) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
   }
 }
 
+void lcd_task_get_stats(lcd_task_stats_t* out) {
+  if (out == NULL) return;
+  portENTER_CRITICAL(&stats_lock);
+  *out = stats_snapshot;
+  portEXIT_CRITICAL(&stats_lock);
+}
+
 // --- static function ---
-static void lcd_state_dispatcher(void) {
-  switch (current_lcd_state) {
-    case LCD_IDLE:
-      break;
-    case LCD_INIT:
-      lcd_render_init();
-      break;
-    case LCD_NORMAL:
-      lcd_render_normal();
-      break;
-    case LCD_CALIBRATION:
-      lcd_render_calibration();
-      break;
-    case LCD_CALIBRATION_WAITING:
-      lcd_render_calibration_waiting();
-      break;
-    case LCD_CALIBRATION_INPUT:
-      lcd_render_calibration_input();
+static void lcd_apply_backlight(void) {
+  bool on = backlight_request;
+  if (on == backlight_on) return;
+  if (on) {
+    lcd_backlight(lcd_handle);
+  } else {
+    lcd_no_backlight(lcd_handle);
+  }
+  backlight_on = on;
+}
+
+static void lcd_wake(void) {
+  // sebelum lcd_task_update berjalan: frame tetap menunggu di mailbox
+  TaskHandle_t handle = lcd_task_handle;
+  if (handle != NULL) xTaskNotifyGive(handle);
+}
+
+static void lcd_take_posts(void) {
+  led_data_t data;
+  int64_t post_us;
+  if (lcd_mailbox_take(&lcd_mailbox, &data, &post_us)) lcd_sched_submit(&lcd_sched, &data, post_us);
+  if (lcd_mailbox_take(&overlay_mailbox, &data, &post_us)) lcd_sched_submit(&lcd_sched, &data, post_us);
+}
+
+static void lcd_record_render(int64_t post_us, int64_t start_us, int64_t done_us) {
+  latency_hist_record(&stats.staleness, done_us > post_us ? (uint32_t) (done_us - post_us) : 0);
+  latency_hist_record(&stats.render, done_us > start_us ? (uint32_t) (done_us - start_us) : 0);
+}
+
+static void lcd_record_input_trace(int64_t done_us) {
+  // layar dasar yang dirender ulang setelah overlay membawa jejak yang sama: hanya tampil pertama
+  if (lcd_data.trace.origin_us == 0 || lcd_data.trace.origin_us == last_trace_origin_us) return;
+  last_trace_origin_us = lcd_data.trace.origin_us;
+  input_latency_hop(&lcd_data.trace, INPUT_TRACE_LCD, done_us);
+  input_latency_end(&lcd_data.trace, INPUT_TRACE_END_LCD, done_us);
+}
+
+static void lcd_publish_stats(void) {
+  // counter mailbox ditulis dua task; cukup untuk statistik, tidak dipakai untuk logika
+  stats.mailbox = lcd_mailbox.stats;
+  stats.sched = lcd_sched.stats;
+  stats.glyphs = lcd_glyphs.stats;
+  lcd_get_stats(lcd_handle, &stats.i2c);
+  portENTER_CRITICAL(&stats_lock);
+  stats_snapshot = stats;
+  portEXIT_CRITICAL(&stats_lock);
+}
+
+static void lcd_render(void) {
+  // glyph yang belum ada di CGRAM di-upload saat frame disusun, sebelum flush memakainya
+  char top[LCD_FRAME_COLS + 1];
+  char bottom[LCD_FRAME_COLS + 1];
+  lcd_glyph_begin_frame(&lcd_glyphs);
+  switch (lcd_data.style) {
+    case LED_STYLE_BIG_DIGITS:
+      lcd_glyph_big_text(&lcd_glyphs, lcd_data.line_1, top, bottom, LCD_FRAME_COLS);
+      lcd_frame_set_line(&lcd_frame, 0, top);
+      lcd_frame_set_line(&lcd_frame, 1, bottom);
       break;
-    case LCD_CONFIRMATION:
-      lcd_render_confirmation();
+    case LED_STYLE_BAR:
+      lcd_glyph_bar(&lcd_glyphs, bottom, LCD_FRAME_COLS, lcd_data.bar_permille);
+      lcd_frame_set_line(&lcd_frame, 0, lcd_data.line_1);
+      lcd_frame_set_line(&lcd_frame, 1, bottom);
       break;
     default:
+      // baris lebih dari 16 karakter terpotong, baris pendek diisi spasi
+      lcd_frame_set_line(&lcd_frame, 0, lcd_data.line_1);
+      lcd_frame_set_line(&lcd_frame, 1, lcd_data.line_2);
       break;
   }
+  lcd_frame_flush(&lcd_frame, &lcd_sink);
+  current_lcd_state = lcd_data.lcd_state;
 }
 
-static void lcd_render(void) {
-  char buffer_line_1[16];
-  char buffer_line_2[16];
-
-  const char* prev_line2  = "";
-
-  lcd_set_cursor(lcd_handle, 0, 0);
-  if (strlen(lcd_data.line_1) <= 16) {
-    strncpy(buffer_line_1, lcd_data.line_1, 16);
-    lcd_print(lcd_handle, buffer_line_1);
-  }
+static void lcd_upload_glyph(void* ctx, uint8_t slot, const uint8_t* rows) {
+  // driver kembali ke posisi DDRAM sebelumnya, cursor lcd_frame tetap benar
+  lcd_create_char(lcd_handle, slot, rows);
+}
 
-  lcd_set_cursor(lcd_handle, 0, 1);
-  if (strlen(lcd_data.line_2) <= 16) {
-    if (prev_line2 != lcd_data.line_2) {
-      // kosongkan dulu
-      lcd_print(lcd_handle, "                ");
-      prev_line2 = lcd_data.line_2;
-    }
-    strncpy(buffer_line_2, lcd_data.line_2, 16);
-    lcd_print(lcd_handle, buffer_line_2);
-  }
+static void lcd_sink_set_cursor_i2c(void* self, uint8_t col, uint8_t row) {
+  lcd_set_cursor(lcd_handle, col, row);
 }
 
-static void lcd_render_init(void) {}
-static void lcd_render_normal(void) {}
-static void lcd_render_tare(void) {}
-static void lcd_render_calibration(void) {}
-static void lcd_render_calibration_waiting(void) {}
-static void lcd_render_calibration_input(void) {}
-static void lcd_render_confirmation(void) {}
\ No newline at end of file
+static void lcd_sink_write_i2c(void* self, const char* data, uint8_t len) {
+  lcd_write(lcd_handle, data, len);
+}
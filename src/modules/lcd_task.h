@@ -6,6 +6,11 @@
 #define LCD_TASK_H
 
 #include <mine_header.h>
+#include "sub_lcd/lcd_mailbox.h"
+#include "sub_lcd/lcd_sched.h"
+#include "drivers/lcd_glyph.h"
+#include "drivers/lcd_driver.h"
+#include "utils/latency_hist.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,10 +18,29 @@ extern "C" {
 
 void lcd_task_init(void);
 
-bool lcd_queue_handler_from_main(QueueHandle_t queue);
+typedef struct {
+  lcd_mailbox_stats_t mailbox;   // layar dasar
+  lcd_sched_stats_t   sched;
+  lcd_glyph_stats_t   glyphs;
+  lcd_driver_stats_t  i2c;
+  latency_hist_t staleness; // lcd_task_post sampai frame selesai di-flush (us)
+  latency_hist_t render;    // lama render + flush satu frame (us)
+} lcd_task_stats_t;
+
+// dari main_task: frame terbaru menggantikan frame yang belum dirender, tidak pernah blocking;
+// overlay_ms > 0 lewat slot terpisah sehingga tidak tertimpa refresh berat
+void lcd_task_post(const led_data_t* data);
+
+// tampilan langsung sebelum lcd_task_update berjalan (boot), maks 16 karakter per baris
+void lcd_task_splash(const char* line_1, const char* line_2);
 
 void lcd_task_update(void);
 
+// dari task lain (power manager); diterapkan di loop lcd_task supaya I2C hanya dipakai satu task
+void lcd_task_set_backlight(bool on);
+
+void lcd_task_get_stats(lcd_task_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
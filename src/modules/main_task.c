@@ -8,6 +8,18 @@
 
 #include "button.h"
 #include "button_task.h"
+#include "comm_task.h"
+#include "lcd_task.h"
+#include "esp_timer.h"
+#include "sub_main/rate_control.h"
+#include "sub_main/main_fsm.h"
+#include "sub_main/cal_engine.h"
+#include "sub_main/weight_filter.h"
+#include "sub_main/main_reactor.h"
+#include "utils/weight_fmt.h"
+#include "settings.h"
+#include "power_manager.h"
+#include "input_latency.h"
 
 static const char *TAG = "MAIN_TASK";
 
@@ -15,52 +27,207 @@ main_state_t current_state = NORMAL_MODE;
 calibration_state_t calibration_state = CAL_UNKNOWN;
 
 QueueHandle_t main_from_button_handler;
-QueueHandle_t main_to_oled_handler;
-QueueHandle_t main_from_comm_handler;
 QueueHandle_t main_to_com_handler;
 
 weight_data_t weight_data;
 led_data_t led_data;
 button_event_type_t button_event;
+// jejak tombol yang sedang diproses, ikut ke command / frame LCD yang dihasilkannya; kosong di luar itu
+static input_trace_t input_trace;
 comm_send_data_t comm_send_data;
 
-typedef enum {GRAM, KG, TON} gramature_t;
-
-gramature_t current_gramature = GRAM;
-
-char buffer_1[16];
-char buffer_2[16];
+weight_unit_t current_unit = WEIGHT_UNIT_GRAM;
+
+// index peer (node load cell) yang sedang ditampilkan
+uint8_t current_peer = 0;
+
+// kecepatan streaming peer yang ditampilkan; peer lain diminta IDLE
+rate_control_t stream_rate;
+uint8_t stream_rate_peer = 0;
+
+// layar diagnostik (button D bergiliran): link peer, lalu latency input;
+// ping ke peer hanya aktif selama layar link tampil
+typedef enum {
+  DIAG_OFF = 0,
+  DIAG_LINK,
+  DIAG_INPUT,
+  DIAG_PAGE_COUNT,
+} diag_page_t;
+diag_page_t diag_page = DIAG_OFF;
+
+// massa beban referensi kalibrasi (gram), diubah dengan B / C di CAL_INPUT
+#define MAIN_CAL_MASS_DEFAULT 100.0f
+#define MAIN_CAL_MASS_STEP    10.0f
+float cal_mass = MAIN_CAL_MASS_DEFAULT;
+
+// sample dianggap diam jika tetap dalam band ini (count raw); titik butuh minimal sekian sample diam
+#define MAIN_CAL_STABLE_BAND   500
+#define MAIN_CAL_MIN_SAMPLES   10
+// residual fit linear (gram) di atas ini -> model piecewise
+#define MAIN_CAL_LINEAR_TOLERANCE 0.5f
+
+// beban minimum (units) yang diambil sebagai target bar graph
+#define MAIN_FILL_TARGET_MIN 1.0f
+
+// lama overlay konfirmasi aksi (tare, ganti satuan / peer, simpan kalibrasi)
+#define MAIN_OVERLAY_MS 1200
+
+// WAKE_UP menunggu sample pertama dari Device A; setelah ini tetap kembali ke NORMAL
+#define MAIN_WAKE_UP_TIMEOUT_MS 3000
+static int64_t wake_up_since_us = 0;
+
+// sebelum deep sleep: tunggu command yang masih di jalan (CMD_SLEEP) di-ACK, paling lama sekian.
+// cukup untuk dua retransmit (150 + 300 ms); Device A yang mati tidak menahan deep sleep lebih lama
+#define MAIN_DEEP_SLEEP_ACK_TIMEOUT_MS 1000
+#define MAIN_DEEP_SLEEP_POLL_MS        10
+// command yang berhasil masuk queue main->comm, dibandingkan dengan comm_task_cmd_settled()
+static uint32_t cmd_queued = 0;
+// CMD_SLEEP sudah dikirim sejak bangun terakhir: SLEEP -> DEEPSLEEP tidak mengirim lagi
+static bool device_a_sleep_sent = false;
+
+// jendela pairing (B long): node baru cukup mengirim satu frame selama ini
+#define MAIN_PAIRING_WINDOW_MS 30000
+// jumlah peer yang sudah diketahui main_task, bertambah setelah pairing berhasil
+static uint8_t known_peer_count = 0;
+
+// model kalibrasi Device B: raw -> gram, dipakai untuk setiap sample jika ada
+static cal_engine_t cal_engine;
+static cal_sample_acc_t cal_acc;
+// tare lokal (gram) karena units dihitung ulang dari raw
+static float tare_units = 0.0f;
+
+// filter angka yang ditampilkan, preset mengikuti mode (normal / kalibrasi)
+static weight_filter_t display_filter;
+static main_state_t display_filter_mode = NORMAL_MODE;
+
+static main_fsm_t main_fsm;
+
+// tampilan mode normal (C long); target bar graph = beban di pan saat masuk tampilan bar
+static led_style_t normal_view = LED_STYLE_TEXT;
+static float fill_target_units = 0.0f;
+
+// satu baris LCD + '\0'; diisi weight_fmt_* (selalu bounded, tanpa printf float)
+char buffer_1[WEIGHT_FMT_LINE_SIZE];
+char buffer_2[WEIGHT_FMT_LINE_SIZE];
+_Static_assert(WEIGHT_FMT_LINE_SIZE == LED_DATA_LINE_SIZE, "baris LCD harus muat di led_data_t");
+
+// kebijakan drain / dispatch loop; stats hanya ditulis main_task, salinan untuk task lain
+// di loop_stats_snapshot
+static main_reactor_t reactor;
+static main_task_loop_stats_t loop_stats_snapshot;
+static portMUX_TYPE loop_stats_lock = portMUX_INITIALIZER_UNLOCKED;
 
 // forward declaration
-static void rcv_queue_from_button_handler(void);
-static void rcv_queue_from_comm_handler(void);
+static bool rcv_queue_from_button_handler(void);
+static uint32_t rcv_queue_from_comm_handler(void);
 static void send_queue_to_led_handler(void);
 static void send_queue_to_com_handler(void);
 
-// handler queue by state
+// render layar sesuai state
 static void normal_mode_handler(void);
-static void sleep_mode_handler(void);
-static void deep_sleep_handler(void);
-static void wake_up_handler(void);
-
-static void cal_init_handler(void);
-static void cal_waiting_handler(void);
-static void cal_input_handler(void);
-static void cal_confirmation_handler(void);
-
-// menerima pesan dan meneruskan ke handler (main state)
-static void main_state_queue_dispatcher(void);
-static void main_sub_state_queue_dispatcher(void);
+static void calibration_mode_handler(void);
+
+// action FSM (lihat tabel transisi di sub_main/main_fsm.c)
+static void action_tare(main_fsm_action_t action, void* ctx);
+static void action_next_unit(main_fsm_action_t action, void* ctx);
+static void action_next_peer(main_fsm_action_t action, void* ctx);
+static void action_toggle_diag(main_fsm_action_t action, void* ctx);
+static void action_next_view(main_fsm_action_t action, void* ctx);
+static void action_dump_trace(main_fsm_action_t action, void* ctx);
+static void action_pair(main_fsm_action_t action, void* ctx);
+static void action_sleep(main_fsm_action_t action, void* ctx);
+static void action_wake_up(main_fsm_action_t action, void* ctx);
+static void action_cal_command(main_fsm_action_t action, void* ctx);
+static void action_cal_adjust(main_fsm_action_t action, void* ctx);
+
+// menerima event dan meneruskan ke FSM, lalu render state baru
+static void main_state_queue_dispatcher(main_fsm_event_t event);
 
 // mengelola pesan dan mengirimkan ke queue
 static void lcd_queue_handler(void);
 static void comm_queue_handler(void);
 
 // helper static function
-static float change_gramature(float units);
+static bool receive_current_peer(weight_data_t* weight, int64_t* rx_us);
+static void show_link_diagnostic(void);
+static void show_input_diagnostic(void);
+static void dump_system_stats(void);
+static input_trace_t stamp_input_trace(void);
+static void update_stream_rate(void);
+static void update_power(void);
+static void check_new_peer(void);
+static bool wait_cmd_settled(uint32_t timeout_ms);
+static void publish_loop_stats(void);
+static uint32_t reactor_drain_samples(void* ctx);
+static bool reactor_next_button(void* ctx, main_fsm_event_t* event);
+static bool reactor_screen_dark(void* ctx);
+static void reactor_button_activity(void* ctx);
+static main_state_t reactor_state(void* ctx);
+static void reactor_dispatch(void* ctx, main_fsm_event_t event);
+static void send_rate_cmd(uint8_t peer, uint32_t interval_ms);
+static void send_cmd(cmd_main_t command, float value);
+static void send_led_lines(lcd_state_t lcd_state);
+static void post_led_data(void);
+static void show_overlay(lcd_state_t lcd_state, const char* line_1, const char* line_2);
+static void add_cal_point(float mass);
+static void select_display_filter(void);
+static void load_settings(void);
+static esp_err_t save_calibration(void);
+
+static const main_fsm_handler_t fsm_handlers[MAIN_ACT_COUNT] = {
+  [MAIN_ACT_TARE] = action_tare,
+  [MAIN_ACT_NEXT_UNIT] = action_next_unit,
+  [MAIN_ACT_NEXT_PEER] = action_next_peer,
+  [MAIN_ACT_TOGGLE_DIAG] = action_toggle_diag,
+  [MAIN_ACT_NEXT_VIEW] = action_next_view,
+  [MAIN_ACT_DUMP_TRACE] = action_dump_trace,
+  [MAIN_ACT_PAIR] = action_pair,
+  [MAIN_ACT_SLEEP] = action_sleep,
+  [MAIN_ACT_DEEP_SLEEP] = action_sleep,
+  [MAIN_ACT_WAKE_UP] = action_wake_up,
+  [MAIN_ACT_CAL_START] = action_cal_command,
+  [MAIN_ACT_CAL_WAIT] = action_cal_command,
+  [MAIN_ACT_CAL_INPUT] = action_cal_command,
+  [MAIN_ACT_CAL_REVIEW] = action_cal_command,
+  [MAIN_ACT_CAL_CONFIRM] = action_cal_command,
+  [MAIN_ACT_CAL_CANCEL] = action_cal_command,
+  [MAIN_ACT_CAL_INC] = action_cal_adjust,
+  [MAIN_ACT_CAL_DEC] = action_cal_adjust,
+};
+
+// button_task -> event FSM; event yang tidak ada di sini = MAIN_EV_NONE
+static const uint8_t button_to_fsm_event[] = {
+  [BUTTON_EVENT_A_SINGLE_CLICK] = MAIN_EV_A_CLICK,
+  [BUTTON_EVENT_B_SINGLE_CLICK] = MAIN_EV_B_CLICK,
+  [BUTTON_EVENT_C_SINGLE_CLICK] = MAIN_EV_C_CLICK,
+  [BUTTON_EVENT_D_SINGLE_CLICK] = MAIN_EV_D_CLICK,
+  [BUTTON_EVENT_A_LONG_PRESS_START] = MAIN_EV_A_LONG,
+  [BUTTON_EVENT_B_LONG_PRESS_START] = MAIN_EV_B_LONG,
+  [BUTTON_EVENT_C_LONG_PRESS_START] = MAIN_EV_C_LONG,
+  [BUTTON_EVENT_D_LONG_PRESS_START] = MAIN_EV_D_LONG,
+  [BUTTON_EVENT_AB_LONG_PRESS] = MAIN_EV_AB_LONG,
+};
+
+static const main_reactor_io_t reactor_io = {
+  .drain_samples = reactor_drain_samples,
+  .next_button = reactor_next_button,
+  .screen_dark = reactor_screen_dark,
+  .button_activity = reactor_button_activity,
+  .state = reactor_state,
+  .dispatch = reactor_dispatch,
+  .ctx = NULL,
+};
 
 void main_task_init(void) {
-  // todo: init from nvs
+  cal_engine_init(&cal_engine);
+  cal_sample_reset(&cal_acc);
+  load_settings();
+  weight_filter_init(&display_filter, weight_filter_preset(NORMAL_MODE));
+  rate_control_init(&stream_rate, NULL);
+  main_fsm_init(&main_fsm, MAIN_FSM_NORMAL, fsm_handlers, NULL);
+  known_peer_count = comm_task_peer_count();
+  main_reactor_init(&reactor, &reactor_io);
+  loop_stats_snapshot = reactor.stats;
 }
 
 bool main_task_rcv_button(QueueHandle_t rcv_btn_queue) {
@@ -69,10 +236,8 @@ bool main_task_rcv_button(QueueHandle_t rcv_btn_queue) {
   return true;
 }
 
-bool main_task_rcv_comm(QueueHandle_t rcv_comm_queue) {
-  if (rcv_comm_queue == NULL) return false;
-  main_from_comm_handler = rcv_comm_queue;
-  return true;
+bool main_task_rcv_comm(void) {
+  return comm_task_set_rx_notify(xTaskGetCurrentTaskHandle(), MAIN_TASK_NOTIFY_COMM_RX);
 }
 
 bool main_task_send_comm(QueueHandle_t send_comm_queue) {
@@ -81,180 +246,637 @@ bool main_task_send_comm(QueueHandle_t send_comm_queue) {
   return true;
 }
 
-bool main_task_send_oled(QueueHandle_t send_oled_queue) {
-  if (send_oled_queue == NULL) return false;
-  main_to_oled_handler = send_oled_queue;
-  return true;
-}
-
 void main_task_update(void) {
-  while (1) {
-
-    // todo: receive queue and dispatch
-    main_state_queue_dispatcher();
-
-    // TODO: process data oled by state
+  // CMD_SLEEP sudah dikirim ke Device A sebelum deep sleep, bangunkan lagi
+  if (power_manager_woke_from_deep_sleep()) send_cmd(CMD_WAKE_UP, 0.0f);
 
-    // TODO: process data comm by state
-
-    send_queue_to_led_handler();
-
-    vTaskDelay(pdMS_TO_TICKS(100));
+  while (1) {
+    // satu-satunya titik block: button_task dan comm_task membangunkan lewat notifikasi;
+    // saat tidur tick lebih jarang supaya auto light sleep tidak terpotong
+    uint32_t bits = 0;
+    TickType_t tick = pdMS_TO_TICKS(power_manager_idle_tick_ms(MAIN_TASK_IDLE_TICK_MS));
+    BaseType_t notified = xTaskNotifyWait(0, UINT32_MAX, &bits, tick);
+    int64_t wake_us = esp_timer_get_time();
+
+    // drain sample, button event dan dispatch ke FSM (sub_main/main_reactor)
+    uint32_t events = main_reactor_step(&reactor);
+
+    check_new_peer();
+    update_power();
+    update_stream_rate();
+    settings_poll();
+
+    main_reactor_record(&reactor, events, notified != pdTRUE && events == 0, wake_us, esp_timer_get_time());
+    publish_loop_stats();
   }
 }
 
+void main_task_get_loop_stats(main_task_loop_stats_t* stats) {
+  if (stats == NULL) return;
+  portENTER_CRITICAL(&loop_stats_lock);
+  *stats = loop_stats_snapshot;
+  portEXIT_CRITICAL(&loop_stats_lock);
+}
+
 // --- static function ---
-static void rcv_queue_from_button_handler(void) {
-  if (xQueueReceive(main_from_button_handler, &button_event, pdMS_TO_TICKS(100)) == pdPASS) {
-    ESP_LOGI(TAG, "Got button event");
-    if (button_event == BUTTON_EVENT_AB_LONG_PRESS) {
-      current_state = (NORMAL_MODE) ? CALIBRATION_MODE : NORMAL_MODE;
-    }
-  } else {
-    ESP_LOGW(TAG, "Got unexpected button event");
+static bool rcv_queue_from_button_handler(void) {
+  button_msg_t msg;
+  if (xQueueReceive(main_from_button_handler, &msg, 0) != pdPASS) {
     button_event = BUTTON_NONE;
+    input_trace = (input_trace_t) { 0 };
+    return false;
   }
+  button_event = msg.event;
+  input_trace = msg.trace;
+  input_latency_hop(&input_trace, INPUT_TRACE_BUTTON_QUEUE, esp_timer_get_time());
+  ESP_LOGI(TAG, "Got button event");
+  return true;
 }
 
-static void rcv_queue_from_comm_handler(void) {
-
-  if (xQueueReceive(main_from_comm_handler, &weight_data, pdMS_TO_TICKS(100)) == pdPASS) {
-    //
-    ESP_LOGI(TAG, "Units: %.2f", weight_data.units ? weight_data.units : 0.0f);
-    ESP_LOGI(TAG, "Raw: %ld", weight_data.raw_weight ? weight_data.raw_weight : 0);
-  } else {
-    ESP_LOGW(TAG, "main_task_rcv_comm_handler timeout");
+static uint32_t rcv_queue_from_comm_handler(void) {
+  // non-blocking: dipanggil setelah main_task dibangunkan notifikasi
+  uint32_t samples = 0;
+  bool sampling = calibration_state == CAL_INIT || calibration_state == CAL_INPUT;
+  bool calibrated = cal_engine_has_model(&cal_engine);
+  int64_t rx_us;
+  select_display_filter();
+  while (receive_current_peer(&weight_data, &rx_us)) {
+    // titik kalibrasi memakai semua sample, bukan hanya yang ditampilkan
+    if (sampling) cal_sample_add(&cal_acc, (int32_t) weight_data.raw_weight, MAIN_CAL_STABLE_BAND);
+    if (calibrated) {
+      weight_data.units = cal_engine_eval(&cal_engine, (int32_t) weight_data.raw_weight) - tare_units;
+    }
+    // filter harus melihat setiap sample supaya window-nya berarti
+    weight_data.units = weight_filter_push(&display_filter, weight_data.units, rx_us);
+    samples++;
   }
+  if (samples > 0) {
+    ESP_LOGD(TAG, "Units: %lld mg (%lu samples)", (long long) (weight_fmt_from_units(weight_data.units) / 1000),
+             (unsigned long) samples);
+    power_manager_weight(weight_data.units);
+  }
+  return samples;
 }
 
 static void send_queue_to_led_handler(void) {
-
-  if (!weight_data.units) return;
+  // belum ada sample dari Device A
   if (!weight_data.raw_weight) return;
 
-  sprintf(buffer_1, "%ld", weight_data.raw_weight);
-  // buffer_1[strlen(buffer_1)-1] = '\0';
-  sprintf(buffer_2, "%.2f", weight_data.units);
-  // buffer_2[strlen(buffer_2)-1] = '\0';
-
-  led_data.line_1 = buffer_1;
-  led_data.line_2 = buffer_2;
-  ESP_LOGI(TAG, "Buffer 1: %s", led_data.line_1);
-
-  if (xQueueSend(main_to_oled_handler, &led_data, pdMS_TO_TICKS(100)) != pdPASS) {
-    ESP_LOGW(TAG, "main_task_send_oled: timeout");
-  }
+  ESP_LOGD(TAG, "Buffer 1: %s", buffer_1);
+  post_led_data();
 }
 
 static void send_queue_to_com_handler(void) {
-  if (!comm_send_data) return;
-  if (xQueueSend(main_to_com_handler, &comm_send_data, pdMS_TO_TICKS(100)) != pdPASS) {
-    ESP_LOGW(TAG, "main_task_send_com: timeout");
-  }
-}
-
-static void main_state_queue_dispatcher(void) {
-  if (current_state == CALIBRATION_MODE) {
-    main_sub_state_queue_dispatcher();
+  if (comm_send_data.command == CMD_NORMAL) return;
+  comm_send_data.enqueue_us = esp_timer_get_time();
+  comm_send_data.trace = input_trace;
+  comm_send_data.trace.stamp_us = comm_send_data.enqueue_us;
+  // reactor tidak boleh block: queue penuh berarti comm_task tertinggal jauh, command dibuang dan dihitung
+  if (xQueueSend(main_to_com_handler, &comm_send_data, 0) != pdPASS) {
+    if (reactor.stats.cmd_dropped++ == 0) {
+      ESP_LOGW(TAG, "main_task_send_com: queue full, command %d dropped", comm_send_data.command);
+    }
     return;
   }
+  cmd_queued++;
+}
 
-  // isi data dari button
-  rcv_queue_from_button_handler();
-
-  // isi data dari queue comm
-  rcv_queue_from_comm_handler();
+static void main_state_queue_dispatcher(main_fsm_event_t event) {
+  main_fsm_dispatch(&main_fsm, event, (uint32_t) (esp_timer_get_time() / 1000));
+  current_state = main_fsm_main_state(main_fsm.state);
+  calibration_state = main_fsm_cal_state(main_fsm.state);
 
   switch (current_state) {
-    case SLEEP_MODE:
-      sleep_mode_handler();
+    case CALIBRATION_MODE:
+      calibration_mode_handler();
       break;
-    case DEEPSLEEP_MODE:
-      deep_sleep_handler();
+    case NORMAL_MODE:
+      normal_mode_handler();
       break;
+    case SLEEP_MODE:
+    case DEEPSLEEP_MODE:
     case WAKE_UP_MODE:
-      wake_up_handler();
-      break;
-    case NORMAL_MODE:
     default:
-      normal_mode_handler();
       break;
   }
 }
 
-static void main_sub_state_queue_dispatcher(void) {
-
-  // isi data dari button
-  rcv_queue_from_button_handler();
-
-  // isi data dari queue comm
-  rcv_queue_from_comm_handler();
+static void normal_mode_handler(void) {
+  if (diag_page == DIAG_LINK) {
+    show_link_diagnostic();
+    return;
+  }
+  if (diag_page == DIAG_INPUT) {
+    show_input_diagnostic();
+    return;
+  }
+  // todo: send to lcd
+  led_data.lcd_state = LCD_NORMAL;
+  led_data.style = normal_view;
+  // baris 1 berat dalam satuan aktif, baris 2 raw HX711; keduanya rata kanan 16 kolom
+  weight_fmt_weight(buffer_1, sizeof(buffer_1), weight_fmt_from_units(weight_data.units), current_unit,
+                    WEIGHT_FMT_LCD_COLS, true);
+  size_t n = weight_fmt_text(buffer_2, sizeof(buffer_2), "RAW", 0);
+  weight_fmt_int(buffer_2 + n, sizeof(buffer_2) - n, (int32_t) weight_data.raw_weight, WEIGHT_FMT_LCD_COLS - n);
+  if (normal_view == LED_STYLE_BAR) {
+    float ratio = fill_target_units > 0.0f ? weight_data.units / fill_target_units : 0.0f;
+    led_data.bar_permille = ratio <= 0.0f ? 0 : ratio >= 1.0f ? 1000 : (uint16_t) (ratio * 1000.0f);
+  }
+  send_queue_to_led_handler();
+}
 
+static void calibration_mode_handler(void) {
   switch (calibration_state) {
     case CAL_INIT:
-      cal_init_handler();
+      snprintf(buffer_1, sizeof(buffer_1), "CAL: EMPTY PAN");
+      snprintf(buffer_2, sizeof(buffer_2), "A=OK AB=CANCEL");
+      send_led_lines(LCD_CALIBRATION);
       break;
     case CAL_WAITING:
-      cal_waiting_handler();
+      snprintf(buffer_1, sizeof(buffer_1), "CAL: PUT MASS");
+      snprintf(buffer_2, sizeof(buffer_2), "A=OK AB=CANCEL");
+      send_led_lines(LCD_CALIBRATION_WAITING);
       break;
     case CAL_INPUT:
-      cal_input_handler();
+    {
+      // '*' = beban sudah diam cukup lama, titik siap diambil
+      size_t n = weight_fmt_text(buffer_1, sizeof(buffer_1), "MASS", 0);
+      n += weight_fmt_weight(buffer_1 + n, sizeof(buffer_1) - n, weight_fmt_from_units(cal_mass), WEIGHT_UNIT_GRAM,
+                             WEIGHT_FMT_LCD_COLS - 2 - n, true);
+      weight_fmt_text(buffer_1 + n, sizeof(buffer_1) - n, cal_acc.n >= MAIN_CAL_MIN_SAMPLES ? " *" : "  ", 2);
+      snprintf(buffer_2, sizeof(buffer_2), "B+ C- A=OK");
+      send_led_lines(LCD_CALIBRATION_INPUT);
       break;
+    }
     case CAL_CONFIRMATION:
-      cal_confirmation_handler();
+    {
+      // "LIN 3pt r   0.03 g": tipe model, jumlah titik, residual terbesar
+      size_t n = weight_fmt_text(buffer_1, sizeof(buffer_1),
+                                 cal_engine.candidate.type == CAL_MODEL_PIECEWISE ? "PWL " : "LIN ", 0);
+      n += weight_fmt_int(buffer_1 + n, sizeof(buffer_1) - n, cal_engine.point_count, 0);
+      n += weight_fmt_text(buffer_1 + n, sizeof(buffer_1) - n, "pt r", 0);
+      weight_fmt_weight(buffer_1 + n, sizeof(buffer_1) - n, weight_fmt_from_units(cal_engine.candidate.max_residual),
+                        WEIGHT_UNIT_GRAM, WEIGHT_FMT_LCD_COLS - n, true);
+      snprintf(buffer_2, sizeof(buffer_2), "A=SAVE D=+POINT");
+      send_led_lines(LCD_CONFIRMATION);
       break;
+    }
     default:
       break;
   }
 }
 
-static void normal_mode_handler(void) {
-  // todo: receive from comm
-  rcv_queue_from_comm_handler();
-  button_event_type_t rcv_button_event = button_event;
-  // todo: normal weight
-  // todo: change gramature
-  if (rcv_button_event == BUTTON_EVENT_B_SINGLE_CLICK) {
-    if (current_gramature == GRAM) {current_gramature = KG;}
-    if (current_gramature == KG) {current_gramature = TON;}
-    if (current_gramature == TON) {current_gramature = GRAM;}
-  }
-  // todo: tare
-  if (rcv_button_event == BUTTON_EVENT_A_SINGLE_CLICK) {
-    // send cmd
-    comm_send_data.command = CMD_NORMAL_TARE;
-    send_queue_to_com_handler();
-    return;
+static void action_tare(main_fsm_action_t action, void* ctx) {
+  if (cal_engine_has_model(&cal_engine)) {
+    tare_units = cal_engine_eval(&cal_engine, (int32_t) weight_data.raw_weight);
   }
-  // todo: send to lcd
-  float current_units = change_gramature(weight_data.units);
-  sprintf(buffer_1, "%.2f", current_units);
-  led_data.line_1 = buffer_1;
-  if (current_gramature == GRAM) {led_data.line_2 = "GRAM";}
-  if (current_gramature == KG) {led_data.line_2 = "KG";}
-  if (current_gramature == TON) {led_data.line_2 = "TON";}
-  send_queue_to_led_handler();
-  // todo: send to comm
-}
-
-static void sleep_mode_handler(void) {}
-static void deep_sleep_handler(void) {}
-static void wake_up_handler(void) {}
-
-static void cal_init_handler(void) {}
-static void cal_waiting_handler(void) {}
-static void cal_input_handler(void) {}
-static void cal_confirmation_handler(void) {}
-
-static float change_gramature(float units) {
-  switch (current_gramature) {
-    case GRAM:
-      return units;
-    case KG:
-      return units / 1000;
-    case TON:
-      return units / 1000000;
+  // riwayat sebelum tare akan terlihat sebagai lonjakan turun perlahan
+  weight_filter_reset(&display_filter);
+  settings_set_tare(tare_units);
+  send_cmd(CMD_NORMAL_TARE, 0.0f);
+  show_overlay(LCD_TARE, "TARE", "");
+}
+
+static void action_next_unit(main_fsm_action_t action, void* ctx) {
+  current_unit = (weight_unit_t) ((current_unit + 1) % WEIGHT_UNIT_COUNT);
+  // tekan berulang hanya menghasilkan satu tulis flash (debounce di settings)
+  settings_set_unit(current_unit);
+  show_overlay(LCD_CONFIRMATION, "UNIT", weight_fmt_unit_name(current_unit));
+}
+
+static void action_next_peer(main_fsm_action_t action, void* ctx) {
+  // pindah ke node load cell berikutnya
+  if (comm_task_peer_count() == 0) return;
+  current_peer = (current_peer + 1) % comm_task_peer_count();
+  weight_filter_reset(&display_filter);
+  settings_set_display_peer(current_peer);
+  ESP_LOGI(TAG, "Showing peer %d", current_peer);
+  char peer_line[WEIGHT_FMT_LINE_SIZE];
+  snprintf(peer_line, sizeof(peer_line), "PEER %u", current_peer);
+  show_overlay(LCD_CONFIRMATION, peer_line, "");
+}
+
+static void action_toggle_diag(main_fsm_action_t action, void* ctx) {
+  diag_page = (diag_page_t) ((diag_page + 1) % DIAG_PAGE_COUNT);
+  comm_task_set_link_probe(diag_page == DIAG_LINK);
+}
+
+static void action_next_view(main_fsm_action_t action, void* ctx) {
+  normal_view = (led_style_t) ((normal_view + 1) % (LED_STYLE_BAR + 1));
+  if (normal_view == LED_STYLE_BAR && weight_data.units >= MAIN_FILL_TARGET_MIN) {
+    fill_target_units = weight_data.units;
+  }
+  if (normal_view == LED_STYLE_BAR && fill_target_units <= 0.0f) {
+    show_overlay(LCD_CONFIRMATION, "NO TARGET", "LOAD + C LONG");
+  }
+}
+
+static void action_dump_trace(main_fsm_action_t action, void* ctx) {
+  main_fsm_trace_t entry;
+  ESP_LOGI(TAG, "FSM trace (%lu transitions, %lu ignored), newest first:",
+           (unsigned long) main_fsm.transitions, (unsigned long) main_fsm.ignored);
+  for (uint8_t i = 0; main_fsm_trace_get(&main_fsm, i, &entry); i++) {
+    ESP_LOGI(TAG, "  %8lu ms %s --%s/%s--> %s", (unsigned long) entry.time_ms,
+             main_fsm_state_name(entry.from), main_fsm_event_name(entry.event),
+             main_fsm_action_name(entry.action), main_fsm_state_name(entry.to));
+  }
+
+  input_trace_stats_t trace;
+  input_latency_get_stats(&trace);
+  ESP_LOGI(TAG, "Input latency per hop (us):");
+  for (uint8_t i = 0; i < INPUT_TRACE_HOP_COUNT; i++) {
+    const latency_hist_t* hist = &trace.hops[i];
+    ESP_LOGI(TAG, "  %-12s n=%lu p50=%lu p99=%lu max=%lu", input_trace_hop_name((input_trace_hop_t) i),
+             (unsigned long) hist->count, (unsigned long) latency_hist_percentile(hist, 50),
+             (unsigned long) latency_hist_percentile(hist, 99), (unsigned long) hist->max_us);
+  }
+
+  dump_system_stats();
+}
+
+static void action_pair(main_fsm_action_t action, void* ctx) {
+  comm_task_start_pairing(MAIN_PAIRING_WINDOW_MS);
+  show_overlay(LCD_CONFIRMATION, "PAIRING", "POWER ON NODE");
+}
+
+static void action_sleep(main_fsm_action_t action, void* ctx) {
+  ESP_LOGI(TAG, "%s", main_fsm_action_name(action));
+  // SLEEP -> DEEPSLEEP: Device A sudah diminta tidur, cukup tunggu command itu selesai
+  if (!device_a_sleep_sent) {
+    send_cmd(CMD_SLEEP, 0.0f);
+    device_a_sleep_sent = true;
+  }
+  if (action != MAIN_ACT_DEEP_SLEEP) return;
+
+  // radio mati saat deep sleep: CMD_SLEEP harus sudah di-ACK (atau gagal) sebelum itu
+  if (!wait_cmd_settled(MAIN_DEEP_SLEEP_ACK_TIMEOUT_MS)) {
+    ESP_LOGW(TAG, "Commands still in flight after %d ms, entering deep sleep anyway", MAIN_DEEP_SLEEP_ACK_TIMEOUT_MS);
+  }
+  // tidak kembali; bangun lewat tombol A = boot ulang
+  power_manager_enter_deep_sleep();
+}
+
+static void action_wake_up(main_fsm_action_t action, void* ctx) {
+  wake_up_since_us = esp_timer_get_time();
+  device_a_sleep_sent = false;
+  send_cmd(CMD_WAKE_UP, 0.0f);
+}
+
+static void action_cal_command(main_fsm_action_t action, void* ctx) {
+  switch (action) {
+    case MAIN_ACT_CAL_START:
+      // pan kosong: sample mulai dikumpulkan untuk titik nol
+      cal_mass = MAIN_CAL_MASS_DEFAULT;
+      cal_engine_begin(&cal_engine);
+      cal_sample_reset(&cal_acc);
+      send_cmd(CMD_CAL_INIT, 0.0f);
+      break;
+    case MAIN_ACT_CAL_WAIT:
+      add_cal_point(0.0f);
+      send_cmd(CMD_CAL_WAITING, 0.0f);
+      break;
+    case MAIN_ACT_CAL_INPUT:
+      // beban referensi baru dipasang
+      cal_sample_reset(&cal_acc);
+      send_cmd(CMD_CAL_INPUT, 0.0f);
+      break;
+    case MAIN_ACT_CAL_REVIEW:
+      add_cal_point(cal_mass);
+      if (!cal_engine_fit(&cal_engine, CAL_MODEL_AUTO, MAIN_CAL_LINEAR_TOLERANCE)) {
+        ESP_LOGW(TAG, "Calibration fit failed (%u points)", cal_engine.point_count);
+      }
+      break;
+    case MAIN_ACT_CAL_CONFIRM:
+      if (!cal_engine_commit(&cal_engine)) {
+        ESP_LOGE(TAG, "Calibration not saved: no valid fit");
+        send_cmd(CMD_CAL_CANCEL, 0.0f);
+        break;
+      }
+      tare_units = 0.0f;
+      settings_set_tare(tare_units);
+      show_overlay(LCD_CONFIRMATION, save_calibration() == ESP_OK ? "CAL SAVED" : "CAL SAVE FAILED", "");
+      // Device A memakai faktor skala HX711 (count per gram)
+      send_cmd(CMD_CAL_CONFIRMATION, cal_model_scale_factor(&cal_engine.model));
+      break;
+    case MAIN_ACT_CAL_CANCEL:
+      cal_engine_begin(&cal_engine);
+      send_cmd(CMD_CAL_CANCEL, 0.0f);
+      break;
     default:
-      return 0.0f;
+      break;
+  }
+}
+
+static void action_cal_adjust(main_fsm_action_t action, void* ctx) {
+  if (action == MAIN_ACT_CAL_INC) {
+    cal_mass += MAIN_CAL_MASS_STEP;
+  } else if (cal_mass > MAIN_CAL_MASS_STEP) {
+    cal_mass -= MAIN_CAL_MASS_STEP;
+  }
+}
+
+static void show_link_diagnostic(void) {
+  comm_link_stats_t link;
+  if (!comm_task_get_link_stats(current_peer, &link)) return;
+
+  // "P1 -62dB  98%" / "RTT 4/12ms L3": RTT p50/p99, L = celah frame hilang
+  if (link.rssi_last == COMM_LINK_RSSI_NONE) {
+    snprintf(buffer_1, sizeof(buffer_1), "P%u  --dB %3u%%", current_peer, link.pdr_permille / 10);
+  } else {
+    snprintf(buffer_1, sizeof(buffer_1), "P%u %4ddB %3u%%", current_peer, link.rssi_avg, link.pdr_permille / 10);
+  }
+  snprintf(buffer_2, sizeof(buffer_2), "RTT %lu/%lums L%lu", (unsigned long) (link.rtt_p50_us / 1000),
+           (unsigned long) (link.rtt_p99_us / 1000), (unsigned long) link.gap_events);
+
+  send_led_lines(LCD_DIAGNOSTIC);
+}
+
+static void show_input_diagnostic(void) {
+  // "AIR 312/340ms" / "LCD 305/330ms": tekan tombol sampai command di udara / hasil tampil, p50/p99
+  snprintf(buffer_1, sizeof(buffer_1), "AIR %lu/%lums",
+           (unsigned long) (input_latency_percentile(INPUT_TRACE_END_AIR, 50) / 1000),
+           (unsigned long) (input_latency_percentile(INPUT_TRACE_END_AIR, 99) / 1000));
+  snprintf(buffer_2, sizeof(buffer_2), "LCD %lu/%lums",
+           (unsigned long) (input_latency_percentile(INPUT_TRACE_END_LCD, 50) / 1000),
+           (unsigned long) (input_latency_percentile(INPUT_TRACE_END_LCD, 99) / 1000));
+  send_led_lines(LCD_DIAGNOSTIC);
+}
+
+static void dump_system_stats(void) {
+  // satu tempat untuk semua statistik task; D long, tanpa alat tambahan selain monitor serial
+  main_task_loop_stats_t loop;
+  main_task_get_loop_stats(&loop);
+  ESP_LOGI(TAG, "main: %lu iter (%lu idle), %lu events, %lu/s, batch max %lu, cmd dropped %lu, screen wakes %lu, "
+           "iter p99 %lu us",
+           (unsigned long) loop.iterations, (unsigned long) loop.idle_wakeups, (unsigned long) loop.events,
+           (unsigned long) loop.events_per_sec, (unsigned long) loop.max_batch, (unsigned long) loop.cmd_dropped,
+           (unsigned long) loop.screen_wakes, (unsigned long) latency_hist_percentile(&loop.iteration, 99));
+
+  button_task_stats_t button;
+  button_task_get_stats(&button);
+  ESP_LOGI(TAG, "button: %lu irq, %lu wakes (%lu timer), %lu bounces, %lu sent, %lu dropped, dispatch p99 %lu us",
+           (unsigned long) button.engine.irqs, (unsigned long) button.wakes, (unsigned long) button.timer_wakes,
+           (unsigned long) button.engine.bounces, (unsigned long) button.sent,
+           (unsigned long) (button.dropped + button.engine.dropped),
+           (unsigned long) latency_hist_percentile(&button.dispatch, 99));
+
+  comm_rx_stats_t rx;
+  comm_task_get_rx_stats(&rx);
+  ESP_LOGI(TAG, "comm rx: %lu frames, %lu samples, lost %lu, dup %lu, reorder %lu, restarts %lu, crc %lu, ring over %lu",
+           (unsigned long) rx.received, (unsigned long) rx.samples, (unsigned long) rx.lost,
+           (unsigned long) rx.duplicated, (unsigned long) rx.reordered, (unsigned long) rx.restarts,
+           (unsigned long) rx.bad_crc, (unsigned long) rx.ring_overwritten);
+
+  comm_reliable_stats_t cmd;
+  comm_tx_stats_t tx;
+  comm_task_get_cmd_stats(&cmd);
+  comm_task_get_tx_stats(&tx);
+  ESP_LOGI(TAG, "comm tx: %lu cmd, %lu acked, %lu retx, %lu failed, ack p99 %lu us, air p99 %lu us, unmatched %lu",
+           (unsigned long) cmd.submitted, (unsigned long) cmd.acked, (unsigned long) cmd.retransmits,
+           (unsigned long) cmd.failed, (unsigned long) latency_hist_percentile(&cmd.rtt, 99),
+           (unsigned long) latency_hist_percentile(&tx.enqueue_to_air, 99),
+           (unsigned long) (tx.air_unmatched + tx.send_done_dropped));
+
+  for (uint8_t i = 0; i < comm_task_peer_count(); i++) {
+    comm_peer_stats_t peer;
+    if (!comm_task_get_peer_stats(i, &peer)) continue;
+    ESP_LOGI(TAG, "  peer %u: %lu frames, %lu samples, lost %lu, probe lost %lu", i, (unsigned long) peer.received,
+             (unsigned long) peer.samples, (unsigned long) peer.lost, (unsigned long) peer.probe_lost);
+  }
+
+  lcd_task_stats_t lcd;
+  lcd_task_get_stats(&lcd);
+  ESP_LOGI(TAG, "lcd: %lu rendered (%lu coalesced), glyph %lu hit / %lu upload, i2c %lu tx %lu err, render p99 %lu us",
+           (unsigned long) lcd.sched.rendered, (unsigned long) lcd.sched.coalesced, (unsigned long) lcd.glyphs.hits,
+           (unsigned long) lcd.glyphs.uploads, (unsigned long) lcd.i2c.transactions, (unsigned long) lcd.i2c.errors,
+           (unsigned long) latency_hist_percentile(&lcd.render, 99));
+
+  power_policy_stats_t power;
+  power_manager_get_stats(&power);
+  for (uint8_t i = 0; i < POWER_LEVEL_COUNT; i++) {
+    ESP_LOGI(TAG, "power %-11s %lu entries, %llu ms", power_policy_level_name((power_level_t) i),
+             (unsigned long) power.entries[i], (unsigned long long) power.residency_ms[i]);
+  }
+
+  settings_stats_t settings;
+  settings_get_stats(&settings);
+  ESP_LOGI(TAG, "settings: %lu updates (%lu coalesced), %lu writes, %lu errors",
+           (unsigned long) settings.updates, (unsigned long) settings.coalesced, (unsigned long) settings.flushes,
+           (unsigned long) settings.flush_errors);
+}
+
+static input_trace_t stamp_input_trace(void) {
+  input_trace_t trace = input_trace;
+  trace.stamp_us = esp_timer_get_time();
+  return trace;
+}
+
+static void send_led_lines(lcd_state_t lcd_state) {
+  led_data.lcd_state = lcd_state;
+  led_data.style = LED_STYLE_TEXT;
+  // langsung dikirim: send_queue_to_led_handler() menimpa baris dengan angka berat
+  post_led_data();
+}
+
+static void post_led_data(void) {
+  // tidak pernah menunggu: frame yang belum dirender ditimpa frame ini
+  memcpy(led_data.line_1, buffer_1, sizeof(led_data.line_1));
+  memcpy(led_data.line_2, buffer_2, sizeof(led_data.line_2));
+  led_data.trace = stamp_input_trace();
+  lcd_task_post(&led_data);
+}
+
+static void show_overlay(lcd_state_t lcd_state, const char* line_1, const char* line_2) {
+  // frame sendiri: buffer_1/buffer_2 tetap milik layar dasar
+  led_data_t overlay = {
+    .lcd_state = lcd_state,
+    .overlay_ms = MAIN_OVERLAY_MS,
+    .trace = stamp_input_trace(),
+  };
+  weight_fmt_text(overlay.line_1, sizeof(overlay.line_1), line_1, WEIGHT_FMT_LCD_COLS);
+  weight_fmt_text(overlay.line_2, sizeof(overlay.line_2), line_2, WEIGHT_FMT_LCD_COLS);
+  lcd_task_post(&overlay);
+}
+
+static void publish_loop_stats(void) {
+  portENTER_CRITICAL(&loop_stats_lock);
+  loop_stats_snapshot = reactor.stats;
+  portEXIT_CRITICAL(&loop_stats_lock);
+}
+
+static uint32_t reactor_drain_samples(void* ctx) {
+  return rcv_queue_from_comm_handler();
+}
+
+static bool reactor_next_button(void* ctx, main_fsm_event_t* event) {
+  if (!rcv_queue_from_button_handler()) return false;
+  *event = button_event < sizeof(button_to_fsm_event)
+             ? (main_fsm_event_t) button_to_fsm_event[button_event] : MAIN_EV_NONE;
+  return true;
+}
+
+static bool reactor_screen_dark(void* ctx) {
+  return power_manager_level() != POWER_ACTIVE;
+}
+
+static void reactor_button_activity(void* ctx) {
+  power_manager_activity(POWER_SRC_BUTTON);
+}
+
+static main_state_t reactor_state(void* ctx) {
+  return current_state;
+}
+
+static void reactor_dispatch(void* ctx, main_fsm_event_t event) {
+  main_state_queue_dispatcher(event);
+  // event tombol: hop main_task di trace latency input
+  if (event != MAIN_EV_SAMPLE) input_latency_hop(&input_trace, INPUT_TRACE_MAIN, esp_timer_get_time());
+}
+
+static void update_stream_rate(void) {
+  if (stream_rate_peer != current_peer) {
+    // peer lama tidak ditampilkan lagi: cukup kirim sesekali
+    send_rate_cmd(stream_rate_peer, rate_control_interval(&stream_rate, RATE_IDLE));
+    stream_rate_peer = current_peer;
+    rate_control_reset(&stream_rate);
+  }
+
+  uint32_t interval_ms;
+  int64_t now_ms = esp_timer_get_time() / 1000;
+  if (rate_control_update(&stream_rate, current_state, weight_data.units, now_ms, &interval_ms)) {
+    ESP_LOGI(TAG, "Peer %d stream rate %s (%lu ms)", current_peer, rate_control_level_name(stream_rate.level),
+             (unsigned long) interval_ms);
+    send_rate_cmd(current_peer, interval_ms);
+  }
+}
+
+static void update_power(void) {
+  // kalibrasi bisa lama tanpa tombol (menunggu beban diam), jangan sampai tidur
+  power_manager_set_hold(current_state == CALIBRATION_MODE);
+
+  power_level_t level;
+  power_manager_update(&level);
+  // FSM disamakan dengan level daya; dicek tiap loop supaya level yang terlewati tetap menyusul
+  if (level >= POWER_LIGHT_SLEEP && current_state == NORMAL_MODE) {
+    main_state_queue_dispatcher(MAIN_EV_IDLE_TIMEOUT);
+  }
+  if (level == POWER_DEEP_SLEEP && current_state == SLEEP_MODE) {
+    main_state_queue_dispatcher(MAIN_EV_IDLE_TIMEOUT);
+  }
+  if (level == POWER_ACTIVE && current_state == SLEEP_MODE) {
+    // bangun karena berat berubah; tombol sudah dibangunkan lewat tabel
+    main_state_queue_dispatcher(MAIN_EV_WAKE);
+  }
+  if (current_state == WAKE_UP_MODE &&
+      esp_timer_get_time() - wake_up_since_us >= (int64_t) MAIN_WAKE_UP_TIMEOUT_MS * 1000) {
+    // CMD_WAKE_UP hilang atau Device A mati: jangan tertahan di WAKE_UP tanpa jalan keluar
+    ESP_LOGW(TAG, "No sample %d ms after wake up", MAIN_WAKE_UP_TIMEOUT_MS);
+    main_state_queue_dispatcher(MAIN_EV_IDLE_TIMEOUT);
+  }
+}
+
+static void check_new_peer(void) {
+  // comm_task membangunkan main_task setelah pairing berhasil; langsung tampilkan node baru
+  uint8_t count = comm_task_peer_count();
+  if (count == known_peer_count) return;
+  known_peer_count = count;
+  current_peer = count - 1;
+  weight_filter_reset(&display_filter);
+  settings_set_display_peer(current_peer);
+  char peer_line[WEIGHT_FMT_LINE_SIZE];
+  snprintf(peer_line, sizeof(peer_line), "PEER %u", current_peer);
+  show_overlay(LCD_CONFIRMATION, "PAIRED", peer_line);
+}
+
+static bool wait_cmd_settled(uint32_t timeout_ms) {
+  // hanya di jalur deep sleep: main_task boleh block, tidak ada lagi yang perlu dilayani
+  int64_t deadline_us = esp_timer_get_time() + (int64_t) timeout_ms * 1000;
+  while ((int32_t) (comm_task_cmd_settled() - cmd_queued) < 0) {
+    if (esp_timer_get_time() >= deadline_us) return false;
+    vTaskDelay(pdMS_TO_TICKS(MAIN_DEEP_SLEEP_POLL_MS));
+  }
+  return true;
+}
+
+static void send_rate_cmd(uint8_t peer, uint32_t interval_ms) {
+  comm_send_data.command = CMD_SET_RATE;
+  comm_send_data.value = (float) interval_ms;
+  comm_send_data.peer = peer;
+  send_queue_to_com_handler();
+}
+
+static void send_cmd(cmd_main_t command, float value) {
+  comm_send_data.command = command;
+  comm_send_data.value = value;
+  comm_send_data.peer = current_peer;
+  send_queue_to_com_handler();
+}
+
+static void add_cal_point(float mass) {
+  // log tanpa printf float: massa lewat weight_fmt, sd dibulatkan ke count raw
+  char mass_text[WEIGHT_FMT_LINE_SIZE];
+  weight_fmt_weight(mass_text, sizeof(mass_text), weight_fmt_from_units(mass), WEIGHT_UNIT_GRAM, 0, true);
+  if (cal_acc.n == 0) {
+    ESP_LOGW(TAG, "No samples for calibration point %s", mass_text);
+    return;
+  }
+  if (cal_acc.n < MAIN_CAL_MIN_SAMPLES) {
+    ESP_LOGW(TAG, "Calibration point %s from only %lu samples", mass_text, (unsigned long) cal_acc.n);
+  }
+  if (!cal_engine_add_point(&cal_engine, cal_sample_mean(&cal_acc), mass)) {
+    ESP_LOGW(TAG, "Calibration points full (%d)", CAL_MAX_POINTS);
+  }
+  ESP_LOGI(TAG, "Calibration point %s = raw %ld (sd %ld)", mass_text, (long) cal_sample_mean(&cal_acc),
+           (long) (cal_sample_stddev(&cal_acc) + 0.5f));
+  cal_sample_reset(&cal_acc);
+}
+
+static void select_display_filter(void) {
+  main_state_t mode = current_state == CALIBRATION_MODE ? CALIBRATION_MODE : NORMAL_MODE;
+  if (mode == display_filter_mode) return;
+  display_filter_mode = mode;
+  weight_filter_init(&display_filter, weight_filter_preset(mode));
+  // delay dalam persepuluh sample (fixed-point), bukan printf float
+  long delay_x10 = (long) (weight_filter_delay_samples(&display_filter) * 10.0f + 0.5f);
+  ESP_LOGI(TAG, "Display filter for %s, delay ~%ld.%ld samples",
+           mode == CALIBRATION_MODE ? "calibration" : "normal", delay_x10 / 10, delay_x10 % 10);
+}
+
+static void load_settings(void) {
+  // settings sudah dimuat di app_main, ini hanya salinan dari cache RAM
+  settings_t settings;
+  settings_get(&settings);
+
+  if (settings.unit < WEIGHT_UNIT_COUNT) current_unit = (weight_unit_t) settings.unit;
+  if (settings.display_peer < comm_task_peer_count()) current_peer = settings.display_peer;
+
+  if (cal_engine_load(&cal_engine, &settings.cal)) {
+    // tare lokal hanya berarti untuk model yang sama
+    tare_units = settings.tare_units;
+    ESP_LOGI(TAG, "Calibration loaded (%u points)", settings.cal.point_count);
+  } else {
+    ESP_LOGI(TAG, "No calibration in settings, using units from Device A");
+  }
+}
+
+static esp_err_t save_calibration(void) {
+  settings_set_cal(&cal_engine.model);
+  // simpan eksplisit dari user: tidak menunggu debounce, tapi tulis flash tetap di writer settings
+  settings_request_flush();
+  return ESP_OK;
+}
+
+static bool receive_current_peer(weight_data_t* weight, int64_t* rx_us) {
+  // sample dari peer lain dilewati, tetap bisa dibaca lewat comm_task_get_peer_latest()
+  weight_data_t sample;
+  uint8_t peer;
+  int64_t sample_us;
+  while (comm_task_receive(&sample, &peer, &sample_us)) {
+    if (peer == current_peer) {
+      *weight = sample;
+      *rx_us = sample_us;
+      return true;
+    }
   }
+  return false;
 }
\ No newline at end of file
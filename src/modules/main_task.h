@@ -7,23 +7,32 @@
 
 #include <mine_header.h>
 #include <button_defs.h>
+#include "sub_main/main_reactor.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// bit notifikasi task untuk main_task
+#define MAIN_TASK_NOTIFY_COMM_RX (1UL << 0)
+#define MAIN_TASK_NOTIFY_BUTTON  (1UL << 1)
+
+// tanpa event, main_task tetap bangun sesekali untuk kebijakan berbasis waktu (rate control)
+#define MAIN_TASK_IDLE_TICK_MS   1000
+
 void main_task_init(void);
 
 bool main_task_rcv_button(QueueHandle_t rcv_btn_queue);
 
-bool main_task_rcv_comm(QueueHandle_t rcv_comm_queue);
+// harus dipanggil dari main_task sendiri (mendaftarkan handle task ke comm_task)
+bool main_task_rcv_comm(void);
 
 bool main_task_send_comm(QueueHandle_t send_comm_queue);
 
-bool main_task_send_oled(QueueHandle_t send_oled_queue);
-
 void main_task_update(void);
 
+void main_task_get_loop_stats(main_task_loop_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
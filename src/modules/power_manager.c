@@ -0,0 +1,155 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "power_manager.h"
+
+#include "sdkconfig.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "driver/rtc_io.h"
+#include "button_task.h"
+#include "lcd_task.h"
+#include "settings.h"
+#ifdef CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#include "esp32/pm.h"
+#endif
+
+static const char* TAG = "POWER";
+
+// frekuensi CPU di LOW_CPU ke atas; ESP-NOW tetap jalan di 80 MHz, 40 MHz = XTAL saat idle
+#define POWER_MANAGER_LOW_CPU_MAX_MHZ 80
+#define POWER_MANAGER_LOW_CPU_MIN_MHZ 40
+
+// waktu untuk lcd_task mematikan backlight; CMD_SLEEP sudah ditunggu ACK-nya oleh main_task
+#define POWER_MANAGER_DEEP_SLEEP_DRAIN_MS 20
+
+static power_policy_t policy;
+static bool woke_from_deep_sleep = false;
+// level yang sudah diterapkan ke hardware; kembali ke ACTIVE terjadi di activity(), bukan di update()
+static power_level_t applied_level = POWER_ACTIVE;
+// get_stats bisa dari task lain
+static portMUX_TYPE policy_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// forward declaration
+static void apply_level(power_level_t level);
+static void configure_pm(power_level_t level);
+static int64_t now_ms(void);
+
+esp_err_t power_manager_init(void) {
+  power_policy_init(&policy, NULL, now_ms());
+
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  woke_from_deep_sleep = cause == ESP_SLEEP_WAKEUP_EXT0;
+  if (woke_from_deep_sleep) {
+    ESP_LOGI(TAG, "Woke from deep sleep (button A)");
+  }
+
+  // light sleep: level wakeup per tombol diatur button_task (ikut state tombol, tekan dan lepas)
+  esp_err_t err = esp_sleep_enable_gpio_wakeup();
+  if (err != ESP_OK) return err;
+
+  apply_level(POWER_ACTIVE);
+  return ESP_OK;
+}
+
+void power_manager_activity(power_source_t source) {
+  portENTER_CRITICAL(&policy_lock);
+  power_policy_activity(&policy, source, now_ms());
+  portEXIT_CRITICAL(&policy_lock);
+}
+
+void power_manager_weight(float units) {
+  portENTER_CRITICAL(&policy_lock);
+  power_policy_weight(&policy, units, now_ms());
+  portEXIT_CRITICAL(&policy_lock);
+}
+
+void power_manager_set_hold(bool hold) {
+  portENTER_CRITICAL(&policy_lock);
+  power_policy_set_hold(&policy, hold, now_ms());
+  portEXIT_CRITICAL(&policy_lock);
+}
+
+bool power_manager_update(power_level_t* level) {
+  power_level_t current;
+  portENTER_CRITICAL(&policy_lock);
+  power_policy_update(&policy, now_ms(), &current);
+  portEXIT_CRITICAL(&policy_lock);
+
+  if (level != NULL) *level = current;
+  if (current == applied_level) return false;
+  applied_level = current;
+  ESP_LOGI(TAG, "Level %s", power_policy_level_name(current));
+  // deep sleep diterapkan lewat FSM (MAIN_ACT_DEEP_SLEEP -> power_manager_enter_deep_sleep)
+  if (current != POWER_DEEP_SLEEP) apply_level(current);
+  return true;
+}
+
+power_level_t power_manager_level(void) {
+  return power_policy_level(&policy);
+}
+
+uint32_t power_manager_idle_tick_ms(uint32_t active_tick_ms) {
+  portENTER_CRITICAL(&policy_lock);
+  power_level_t level = power_policy_level(&policy);
+  uint32_t deadline_ms = power_policy_next_deadline_ms(&policy, now_ms());
+  portEXIT_CRITICAL(&policy_lock);
+
+  uint32_t tick_ms = level >= POWER_LOW_CPU ? POWER_MANAGER_SLEEP_TICK_MS : active_tick_ms;
+  // bangun tepat saat level berikutnya jatuh tempo (minimal 1 tick supaya tidak busy loop)
+  if (deadline_ms < tick_ms) tick_ms = deadline_ms > 0 ? deadline_ms : 1;
+  return tick_ms;
+}
+
+void power_manager_enter_deep_sleep(void) {
+  ESP_LOGI(TAG, "Entering deep sleep, wake with button A");
+  settings_flush();
+  lcd_task_set_backlight(false);
+  vTaskDelay(pdMS_TO_TICKS(POWER_MANAGER_DEEP_SLEEP_DRAIN_MS));
+
+  // ext0 hanya satu pin; ext1 di ESP32 tidak bisa "salah satu low", jadi hanya tombol A
+  rtc_gpio_pullup_en(BUTTON_A_GPIO);
+  rtc_gpio_pulldown_dis(BUTTON_A_GPIO);
+  esp_sleep_enable_ext0_wakeup(BUTTON_A_GPIO, 0);
+  esp_deep_sleep_start();
+}
+
+bool power_manager_woke_from_deep_sleep(void) {
+  return woke_from_deep_sleep;
+}
+
+void power_manager_get_stats(power_policy_stats_t* stats) {
+  if (stats == NULL) return;
+  portENTER_CRITICAL(&policy_lock);
+  *stats = policy.stats;
+  portEXIT_CRITICAL(&policy_lock);
+}
+
+// --- static function ---
+static void apply_level(power_level_t level) {
+  lcd_task_set_backlight(level == POWER_ACTIVE);
+  configure_pm(level);
+}
+
+static void configure_pm(power_level_t level) {
+#ifdef CONFIG_PM_ENABLE
+  // ACTIVE / DIM: frekuensi tetap supaya latency tampilan tidak berubah
+  bool low = level >= POWER_LOW_CPU;
+  esp_pm_config_esp32_t config = {
+    .max_freq_mhz = low ? POWER_MANAGER_LOW_CPU_MAX_MHZ : CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ,
+    .min_freq_mhz = low ? POWER_MANAGER_LOW_CPU_MIN_MHZ : CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ,
+    .light_sleep_enable = level >= POWER_LIGHT_SLEEP,
+  };
+  esp_err_t err = esp_pm_configure(&config);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "esp_pm_configure failed: %s", esp_err_to_name(err));
+  }
+#endif
+}
+
+static int64_t now_ms(void) {
+  return esp_timer_get_time() / 1000;
+}
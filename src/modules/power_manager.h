@@ -0,0 +1,56 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+// Manajemen daya lokal Device B (lihat sub_power/power_policy.h untuk level dan batas waktu).
+// Level diterapkan ke hardware di sini: backlight LCD, frekuensi CPU (esp_pm / DFS),
+// auto light sleep dengan wakeup GPIO tombol, dan deep sleep dengan wakeup tombol A.
+// Semua fungsi dipanggil dari main_task.
+
+#include <mine_header.h>
+#include "sub_power/power_policy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// tick xTaskNotifyWait main_task saat LOW_CPU / LIGHT_SLEEP (lebih jarang = tidur lebih lama)
+#define POWER_MANAGER_SLEEP_TICK_MS 5000
+
+esp_err_t power_manager_init(void);
+
+// tombol ditekan (button event apa pun)
+void power_manager_activity(power_source_t source);
+
+// berat terbaru dari peer yang ditampilkan
+void power_manager_weight(float units);
+
+// mis. selama kalibrasi: tetap ACTIVE
+void power_manager_set_hold(bool hold);
+
+// evaluasi idle dan terapkan level sekarang ke hardware; return true jika berbeda dari
+// level yang terakhir diterapkan (level sekarang selalu ditulis ke `level`, boleh NULL)
+bool power_manager_update(power_level_t* level);
+
+power_level_t power_manager_level(void);
+
+// timeout tunggu main_task berikutnya: `active_tick_ms` saat ACTIVE / DIM, lebih jarang saat
+// tidur, tapi tidak melewati batas level berikutnya
+uint32_t power_manager_idle_tick_ms(uint32_t active_tick_ms);
+
+// flush settings, matikan LCD, lalu deep sleep; bangun lewat tombol A = reboot. Tidak kembali.
+void power_manager_enter_deep_sleep(void);
+
+// boot ini karena tombol A membangunkan dari deep sleep (Device A perlu CMD_WAKE_UP)
+bool power_manager_woke_from_deep_sleep(void);
+
+void power_manager_get_stats(power_policy_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //POWER_MANAGER_H
@@ -0,0 +1,144 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "settings.h"
+#include "freertos/semphr.h"
+#include "sub_settings/settings_backend_nvs.h"
+#include "esp_timer.h"
+
+static const char* TAG = "SETTINGS";
+
+// tulis flash di task sendiri dengan prioritas di bawah task aplikasi (5), supaya commit NVS
+// (beberapa tulis / erase page, masing-masing mematikan cache flash sebentar) tidak ikut
+// dihitung di satu iterasi reactor main_task
+#define SETTINGS_WRITER_STACK    3072
+#define SETTINGS_WRITER_PRIORITY 1
+
+static settings_store_t store;
+// hanya melindungi salinan cache (ratusan byte); tulis flash di luar critical section
+static portMUX_TYPE store_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// satu flush pada satu waktu: settings_flush() menunggu tulis writer yang sedang jalan selesai
+static SemaphoreHandle_t flush_mutex = NULL;
+static TaskHandle_t writer_task = NULL;
+static int64_t write_max_us = 0;
+
+// forward declaration
+static void store_lock_enter(void* ctx);
+static void store_lock_exit(void* ctx);
+static uint32_t now_ms(void);
+static void writer_loop(void* arg);
+static settings_io_t flush_timed(void);
+
+esp_err_t settings_init(void) {
+  const settings_store_config_t config = {
+    .debounce_ms = SETTINGS_DEBOUNCE_MS,
+    .max_delay_ms = SETTINGS_MAX_DELAY_MS,
+    .lock = store_lock_enter,
+    .unlock = store_lock_exit,
+    .lock_ctx = NULL,
+  };
+  settings_store_init(&store, settings_backend_nvs(), &config);
+
+  int64_t start_us = esp_timer_get_time();
+  settings_load_result_t result = settings_store_load(&store, now_ms());
+  ESP_LOGI(TAG, "Loaded: %s (version %u, %u peers) in %lld us", settings_load_result_name(result),
+           store.stats.loaded_version, store.cache.peer_count, (long long) (esp_timer_get_time() - start_us));
+  if (result == SETTINGS_LOAD_CORRUPT) {
+    ESP_LOGW(TAG, "Settings blob invalid, using defaults");
+  }
+
+  flush_mutex = xSemaphoreCreateMutex();
+  if (flush_mutex == NULL) return ESP_ERR_NO_MEM;
+  if (xTaskCreate(writer_loop, "settings_wr", SETTINGS_WRITER_STACK, NULL, SETTINGS_WRITER_PRIORITY,
+                  &writer_task) != pdPASS) {
+    return ESP_ERR_NO_MEM;
+  }
+  return ESP_OK;
+}
+
+void settings_get(settings_t* out) {
+  settings_store_get(&store, out);
+}
+
+bool settings_set_unit(uint8_t unit) {
+  return settings_store_set_unit(&store, unit, now_ms());
+}
+
+bool settings_set_display_peer(uint8_t peer) {
+  return settings_store_set_display_peer(&store, peer, now_ms());
+}
+
+bool settings_set_tare(float tare_units) {
+  return settings_store_set_tare(&store, tare_units, now_ms());
+}
+
+bool settings_set_cal(const cal_model_t* cal) {
+  return settings_store_set_cal(&store, cal, now_ms());
+}
+
+bool settings_add_peer(const uint8_t* mac) {
+  return settings_store_add_peer(&store, mac, now_ms());
+}
+
+void settings_poll(void) {
+  // hanya cek waktu; tulis flash diserahkan ke writer
+  if (settings_store_due(&store, now_ms())) settings_request_flush();
+}
+
+void settings_request_flush(void) {
+  if (writer_task != NULL) xTaskNotifyGive(writer_task);
+}
+
+esp_err_t settings_flush(void) {
+  xSemaphoreTake(flush_mutex, portMAX_DELAY);
+  settings_io_t io = flush_timed();
+  xSemaphoreGive(flush_mutex);
+  return io == SETTINGS_IO_OK ? ESP_OK : ESP_FAIL;
+}
+
+void settings_get_stats(settings_stats_t* stats) {
+  settings_store_get_stats(&store, stats);
+}
+
+// --- static function ---
+static void store_lock_enter(void* ctx) {
+  portENTER_CRITICAL(&store_lock);
+}
+
+static void store_lock_exit(void* ctx) {
+  portEXIT_CRITICAL(&store_lock);
+}
+
+static uint32_t now_ms(void) {
+  return (uint32_t) (esp_timer_get_time() / 1000);
+}
+
+static void writer_loop(void* arg) {
+  while (1) {
+    // beberapa request selagi menulis cukup satu tulis berikutnya (setter baru = dirty lagi)
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    xSemaphoreTake(flush_mutex, portMAX_DELAY);
+    settings_io_t io = flush_timed();
+    xSemaphoreGive(flush_mutex);
+    if (io != SETTINGS_IO_OK) {
+      ESP_LOGE(TAG, "Settings write failed (%d)", io);
+    }
+  }
+}
+
+static settings_io_t flush_timed(void) {
+  if (!settings_store_dirty(&store)) return SETTINGS_IO_OK;
+  int64_t start_us = esp_timer_get_time();
+  settings_io_t io = settings_store_flush(&store);
+  int64_t took_us = esp_timer_get_time() - start_us;
+  // stall terburuk dicatat supaya kelihatan di log tanpa alat tambahan
+  if (took_us > write_max_us) {
+    write_max_us = took_us;
+    ESP_LOGI(TAG, "Settings written in %lld us (new max)", (long long) took_us);
+  } else {
+    ESP_LOGD(TAG, "Settings written in %lld us", (long long) took_us);
+  }
+  return io;
+}
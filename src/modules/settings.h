@@ -0,0 +1,50 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+// Pengaturan persisten yang dipakai bersama main_task dan comm_task (lihat sub_settings/settings_store.h).
+// Baca boleh dari task mana pun tanpa lock; tulis hanya mengubah cache RAM. Flash ditulis oleh
+// task writer prioritas rendah setelah perubahan berhenti (debounce) atau atas request,
+// jadi task pemanggil tidak pernah menunggu NVS kecuali lewat settings_flush().
+
+#include <mine_header.h>
+#include "sub_settings/settings_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// setelah nvs_flash_init(), sebelum comm_task_init() / main_task_init()
+esp_err_t settings_init(void);
+
+void settings_get(settings_t* out);
+
+bool settings_set_unit(uint8_t unit);
+
+bool settings_set_display_peer(uint8_t peer);
+
+bool settings_set_tare(float tare_units);
+
+bool settings_set_cal(const cal_model_t* cal);
+
+bool settings_add_peer(const uint8_t* mac);
+
+// dari loop main_task (minimal tiap MAIN_TASK_IDLE_TICK_MS); hanya cek debounce, tidak menulis
+void settings_poll(void);
+
+// minta writer menulis sekarang tanpa menunggu debounce (simpan kalibrasi, peer baru); tidak block
+void settings_request_flush(void);
+
+// tulis sekarang dan tunggu selesai (sebelum deep sleep); block selama commit NVS
+esp_err_t settings_flush(void);
+
+void settings_get_stats(settings_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SETTINGS_H
@@ -0,0 +1,171 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "boot_seq.h"
+
+#include <string.h>
+
+// forward declaration
+static bool valid_graph(const boot_stage_t* stages, uint8_t count);
+static void skip_dependents(boot_seq_t* seq, int64_t now_us);
+static bool stage_ok(const boot_seq_t* seq, uint8_t index);
+
+bool boot_seq_init(boot_seq_t* seq, const boot_stage_t* stages, uint8_t count, int64_t now_us) {
+  memset(seq, 0, sizeof(*seq));
+  if (stages == NULL || count == 0 || count > BOOT_STAGE_MAX) return false;
+  if (!valid_graph(stages, count)) return false;
+  seq->stages = stages;
+  seq->count = count;
+  seq->boot_start_us = now_us;
+  return true;
+}
+
+int boot_seq_take_ready(boot_seq_t* seq, int64_t now_us) {
+  for (uint8_t i = 0; i < seq->count; i++) {
+    if (seq->state[i] != BOOT_STAGE_PENDING) continue;
+    if ((seq->stages[i].deps & ~seq->ok_mask) != 0) continue;
+    seq->state[i] = BOOT_STAGE_RUNNING;
+    seq->start_us[i] = now_us;
+    seq->running++;
+    return i;
+  }
+  return -1;
+}
+
+void boot_seq_complete(boot_seq_t* seq, uint8_t index, int status, int64_t now_us) {
+  if (index >= seq->count || seq->state[index] != BOOT_STAGE_RUNNING) return;
+  seq->state[index] = status == 0 ? BOOT_STAGE_DONE : BOOT_STAGE_FAILED;
+  seq->status[index] = status;
+  seq->end_us[index] = now_us;
+  seq->running--;
+  seq->settled++;
+  if (stage_ok(seq, index)) {
+    seq->ok_mask |= BOOT_DEP(index);
+  } else {
+    skip_dependents(seq, now_us);
+  }
+  if (now_us > seq->boot_end_us) seq->boot_end_us = now_us;
+}
+
+bool boot_seq_finished(const boot_seq_t* seq) {
+  return seq->settled == seq->count;
+}
+
+bool boot_seq_failed(const boot_seq_t* seq) {
+  for (uint8_t i = 0; i < seq->count; i++) {
+    if (seq->stages[i].optional) continue;
+    if (seq->state[i] == BOOT_STAGE_FAILED || seq->state[i] == BOOT_STAGE_SKIPPED) return true;
+  }
+  return false;
+}
+
+bool boot_seq_mark_first_weight(boot_seq_t* seq, int64_t now_us) {
+  if (seq->first_weight_us != 0) return false;
+  seq->first_weight_us = now_us;
+  return true;
+}
+
+int64_t boot_seq_critical_path_us(const boot_seq_t* seq) {
+  // graf sudah dicek asiklik; relaksasi `count` kali cukup untuk rantai terpanjang
+  int64_t finish[BOOT_STAGE_MAX] = {0};
+  int64_t longest = 0;
+  for (uint8_t pass = 0; pass < seq->count; pass++) {
+    for (uint8_t i = 0; i < seq->count; i++) {
+      bool ran = seq->state[i] == BOOT_STAGE_DONE || seq->state[i] == BOOT_STAGE_FAILED;
+      int64_t before = 0;
+      for (uint8_t d = 0; d < seq->count; d++) {
+        if ((seq->stages[i].deps & BOOT_DEP(d)) && finish[d] > before) before = finish[d];
+      }
+      finish[i] = before + (ran ? seq->end_us[i] - seq->start_us[i] : 0);
+      if (finish[i] > longest) longest = finish[i];
+    }
+  }
+  return longest;
+}
+
+bool boot_seq_simulate(boot_seq_t* seq, const boot_stage_t* stages, uint8_t count,
+                       const int64_t* duration_us, uint8_t workers) {
+  if (workers == 0 || !boot_seq_init(seq, stages, count, 0)) return false;
+  int64_t end_us[BOOT_STAGE_MAX];
+  int64_t now_us = 0;
+  while (!boot_seq_finished(seq)) {
+    // isi worker yang kosong
+    int index;
+    while (seq->running < workers && (index = boot_seq_take_ready(seq, now_us)) >= 0) {
+      int64_t duration = duration_us[index];
+      end_us[index] = now_us + (duration < 0 ? -duration : duration);
+    }
+    if (seq->running == 0) break;
+
+    // maju ke stage berikutnya yang selesai
+    int next = -1;
+    for (uint8_t i = 0; i < count; i++) {
+      if (seq->state[i] == BOOT_STAGE_RUNNING && (next < 0 || end_us[i] < end_us[next])) next = i;
+    }
+    now_us = end_us[next];
+    boot_seq_complete(seq, (uint8_t) next, duration_us[next] < 0 ? -1 : 0, now_us);
+  }
+  return boot_seq_finished(seq);
+}
+
+const char* boot_stage_state_name(boot_stage_state_t state) {
+  switch (state) {
+    case BOOT_STAGE_PENDING: return "PENDING";
+    case BOOT_STAGE_RUNNING: return "RUNNING";
+    case BOOT_STAGE_DONE:    return "DONE";
+    case BOOT_STAGE_FAILED:  return "FAILED";
+    case BOOT_STAGE_SKIPPED: return "SKIPPED";
+    default:                 return "UNKNOWN";
+  }
+}
+
+// --- static function ---
+static bool valid_graph(const boot_stage_t* stages, uint8_t count) {
+  uint32_t all = BOOT_DEP(count) - 1; // count <= BOOT_STAGE_MAX
+  for (uint8_t i = 0; i < count; i++) {
+    if ((stages[i].deps & ~all) != 0 || (stages[i].deps & BOOT_DEP(i)) != 0) return false;
+  }
+  // Kahn: ambil terus stage yang semua dependensinya sudah terambil; sisa = siklus
+  uint32_t resolved = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (uint8_t i = 0; i < count; i++) {
+      if ((resolved & BOOT_DEP(i)) == 0 && (stages[i].deps & ~resolved) == 0) {
+        resolved |= BOOT_DEP(i);
+        progress = true;
+      }
+    }
+  }
+  return resolved == all;
+}
+
+static void skip_dependents(boot_seq_t* seq, int64_t now_us) {
+  // stage PENDING yang bergantung pada stage gagal / dilewati tidak akan pernah siap
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (uint8_t i = 0; i < seq->count; i++) {
+      if (seq->state[i] != BOOT_STAGE_PENDING) continue;
+      for (uint8_t d = 0; d < seq->count; d++) {
+        if ((seq->stages[i].deps & BOOT_DEP(d)) == 0) continue;
+        uint8_t dep_state = seq->state[d];
+        if ((dep_state == BOOT_STAGE_FAILED || dep_state == BOOT_STAGE_SKIPPED) && !stage_ok(seq, d)) {
+          seq->state[i] = BOOT_STAGE_SKIPPED;
+          seq->start_us[i] = now_us;
+          seq->end_us[i] = now_us;
+          seq->settled++;
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+}
+
+static bool stage_ok(const boot_seq_t* seq, uint8_t index) {
+  // optional yang gagal tetap memenuhi dependensi; optional yang dilewati tidak (dependensinya gagal)
+  uint8_t state = seq->state[index];
+  return state == BOOT_STAGE_DONE || (state == BOOT_STAGE_FAILED && seq->stages[index].optional);
+}
@@ -0,0 +1,91 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef BOOT_SEQ_H
+#define BOOT_SEQ_H
+
+// Urutan boot sebagai graf dependensi: setiap stage hanya menunggu stage yang benar-benar
+// dibutuhkan (mis. LCD + splash tidak menunggu Wi-Fi / ESP-NOW), sisanya jalan paralel
+// di beberapa worker. Sequencer ini hanya memutuskan stage mana yang siap dan mencatat
+// waktu; worker-nya (task FreeRTOS di target) ada di boot.c.
+//
+// Stage yang gagal membuat stage yang bergantung padanya SKIPPED, kecuali stage itu optional.
+// boot_seq_simulate() menjalankan graf yang sama dengan durasi buatan di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOT_STAGE_MAX 16
+#define BOOT_DEP(stage) (1UL << (stage))
+
+// 0 = berhasil (kompatibel dengan esp_err_t)
+typedef int (*boot_stage_fn_t)(void* ctx);
+
+typedef struct {
+  const char*     name;
+  uint32_t        deps;     // BOOT_DEP(index) stage yang harus selesai dulu
+  boot_stage_fn_t run;
+  void*           ctx;
+  bool            optional; // gagal tidak menghentikan boot maupun stage sesudahnya
+} boot_stage_t;
+
+typedef enum {
+  BOOT_STAGE_PENDING = 0,
+  BOOT_STAGE_RUNNING,
+  BOOT_STAGE_DONE,
+  BOOT_STAGE_FAILED,
+  BOOT_STAGE_SKIPPED,
+} boot_stage_state_t;
+
+typedef struct {
+  const boot_stage_t* stages;
+  uint8_t  count;
+  uint8_t  state[BOOT_STAGE_MAX];   // boot_stage_state_t
+  int      status[BOOT_STAGE_MAX];
+  int64_t  start_us[BOOT_STAGE_MAX];
+  int64_t  end_us[BOOT_STAGE_MAX];
+  uint32_t ok_mask;                 // DONE, atau FAILED tapi optional: dependensi terpenuhi
+  uint8_t  running;
+  uint8_t  settled;                 // DONE + FAILED + SKIPPED
+  int64_t  boot_start_us;
+  int64_t  boot_end_us;             // stage terakhir selesai
+  int64_t  first_weight_us;         // berat pertama tampil di LCD, 0 = belum
+} boot_seq_t;
+
+// false jika dependensi tidak valid (index di luar tabel, ke diri sendiri, atau siklus)
+bool boot_seq_init(boot_seq_t* seq, const boot_stage_t* stages, uint8_t count, int64_t now_us);
+
+// stage siap berikutnya (index terkecil = prioritas tertinggi) ditandai RUNNING; -1 jika tidak ada
+int boot_seq_take_ready(boot_seq_t* seq, int64_t now_us);
+
+void boot_seq_complete(boot_seq_t* seq, uint8_t index, int status, int64_t now_us);
+
+// semua stage sudah selesai / gagal / dilewati
+bool boot_seq_finished(const boot_seq_t* seq);
+
+// ada stage wajib yang FAILED atau SKIPPED
+bool boot_seq_failed(const boot_seq_t* seq);
+
+// true hanya pada panggilan pertama
+bool boot_seq_mark_first_weight(boot_seq_t* seq, int64_t now_us);
+
+// rantai dependensi terpanjang dengan durasi terukur = batas bawah boot dengan worker tak terbatas
+int64_t boot_seq_critical_path_us(const boot_seq_t* seq);
+
+// jalankan graf dengan `workers` worker dan durasi stage buatan (us), tanpa memanggil run();
+// stage dengan durasi negatif dianggap gagal. Hasil timing di `seq`.
+bool boot_seq_simulate(boot_seq_t* seq, const boot_stage_t* stages, uint8_t count,
+                       const int64_t* duration_us, uint8_t workers);
+
+const char* boot_stage_state_name(boot_stage_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //BOOT_SEQ_H
@@ -0,0 +1,299 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "button_engine.h"
+
+#include <string.h>
+
+typedef enum {
+  INPUT_PRESS = 0,
+  INPUT_RELEASE,
+  INPUT_LONG,   // long_press_us sejak ditekan
+  INPUT_WINDOW, // jendela double click habis
+  INPUT_CHORD,  // pin jadi bagian chord yang terpenuhi
+  INPUT_COUNT,
+} gesture_input_t;
+
+// 0 = tetap / tanpa event, supaya entry yang tidak disebut berarti input diabaikan
+#define TO(state)  ((uint8_t) ((state) + 1))
+#define EMIT(kind) ((uint8_t) ((kind) + 1))
+
+typedef struct {
+  uint8_t next;
+  uint8_t emit;
+} gesture_step_t;
+
+static const gesture_step_t gesture_table[BUTTON_ENGINE_STATE_COUNT][INPUT_COUNT] = {
+  [BUTTON_ENGINE_IDLE] = {
+    [INPUT_PRESS]   = { TO(BUTTON_ENGINE_DOWN), 0 },
+  },
+  [BUTTON_ENGINE_DOWN] = {
+    [INPUT_RELEASE] = { TO(BUTTON_ENGINE_UP_WAIT), 0 },
+    [INPUT_LONG]    = { TO(BUTTON_ENGINE_HELD), EMIT(BUTTON_ENGINE_LONG_START) },
+    [INPUT_CHORD]   = { TO(BUTTON_ENGINE_SILENT), 0 },
+  },
+  [BUTTON_ENGINE_HELD] = {
+    [INPUT_RELEASE] = { TO(BUTTON_ENGINE_IDLE), EMIT(BUTTON_ENGINE_LONG_UP) },
+  },
+  [BUTTON_ENGINE_UP_WAIT] = {
+    [INPUT_PRESS]   = { TO(BUTTON_ENGINE_DOWN_AGAIN), 0 },
+    [INPUT_WINDOW]  = { TO(BUTTON_ENGINE_IDLE), EMIT(BUTTON_ENGINE_CLICK) },
+  },
+  [BUTTON_ENGINE_DOWN_AGAIN] = {
+    [INPUT_RELEASE] = { TO(BUTTON_ENGINE_IDLE), EMIT(BUTTON_ENGINE_DOUBLE_CLICK) },
+    // tekan kedua terlalu lama: click pertama dilaporkan, tekan ini jadi gesture baru
+    [INPUT_WINDOW]  = { TO(BUTTON_ENGINE_DOWN), EMIT(BUTTON_ENGINE_CLICK) },
+    [INPUT_CHORD]   = { TO(BUTTON_ENGINE_SILENT), 0 },
+  },
+  [BUTTON_ENGINE_SILENT] = {
+    [INPUT_RELEASE] = { TO(BUTTON_ENGINE_IDLE), 0 },
+  },
+};
+
+static const char* const kind_names[] = {
+  [BUTTON_ENGINE_CLICK] = "CLICK",
+  [BUTTON_ENGINE_DOUBLE_CLICK] = "DOUBLE_CLICK",
+  [BUTTON_ENGINE_LONG_START] = "LONG_START",
+  [BUTTON_ENGINE_LONG_UP] = "LONG_UP",
+  [BUTTON_ENGINE_CHORD_LONG] = "CHORD_LONG",
+};
+
+static const char* const state_names[] = {
+  [BUTTON_ENGINE_IDLE] = "IDLE",
+  [BUTTON_ENGINE_DOWN] = "DOWN",
+  [BUTTON_ENGINE_HELD] = "HELD",
+  [BUTTON_ENGINE_UP_WAIT] = "UP_WAIT",
+  [BUTTON_ENGINE_DOWN_AGAIN] = "DOWN_AGAIN",
+  [BUTTON_ENGINE_SILENT] = "SILENT",
+};
+
+typedef enum {
+  STEP_NONE = 0,
+  STEP_LONG,
+  STEP_WINDOW,
+  STEP_CHORD,
+  STEP_IRQ,
+  STEP_SETTLE,
+} step_type_t;
+
+typedef struct {
+  step_type_t type;
+  uint8_t index; // pin, atau chord untuk STEP_CHORD
+  int64_t time_us;
+} step_t;
+
+typedef struct {
+  button_engine_event_t* events;
+  uint8_t max;
+  uint8_t count;
+} event_sink_t;
+
+// forward declaration
+static step_t next_step(const button_engine_t* engine);
+static void consider(step_t* best, step_type_t type, uint8_t index, int64_t time_us);
+static void feed(button_engine_t* engine, uint8_t pin, gesture_input_t input, int64_t time_us, event_sink_t* sink);
+static void emit(button_engine_t* engine, event_sink_t* sink, uint8_t pin, button_engine_kind_t kind,
+                 int64_t time_us, int64_t origin_us);
+static bool waiting_long(const button_engine_pin_t* p);
+static bool chord_partner_pressed(const button_engine_t* engine, uint8_t pin);
+static int64_t chord_deadline(const button_engine_t* engine, uint8_t chord);
+
+void button_engine_init(button_engine_t* engine, const button_engine_config_t* config,
+                        const button_engine_io_t* io, int64_t now_us) {
+  memset(engine, 0, sizeof(*engine));
+  engine->config = *config;
+  if (engine->config.pin_count > BUTTON_ENGINE_MAX_PINS) engine->config.pin_count = BUTTON_ENGINE_MAX_PINS;
+  if (engine->config.chord_count > BUTTON_ENGINE_MAX_CHORDS) engine->config.chord_count = BUTTON_ENGINE_MAX_CHORDS;
+  for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+    button_engine_pin_config_t* pc = &engine->config.pins[i];
+    // long press di tengah jendela double click akan menelan click pertama
+    if (pc->long_press_us != 0 && pc->double_click_us > pc->long_press_us) pc->double_click_us = pc->long_press_us;
+  }
+  engine->io = *io;
+
+  uint32_t snapshot = engine->io.read(engine->io.ctx);
+  engine->stats.samples++;
+  for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+    button_engine_pin_t* p = &engine->pins[i];
+    p->pressed = (snapshot >> i) & 1;
+    // mis. tombol A yang membangunkan dari deep sleep masih ditahan
+    p->state = p->pressed ? BUTTON_ENGINE_SILENT : BUTTON_ENGINE_IDLE;
+    p->press_us = now_us;
+    engine->io.arm(engine->io.ctx, i, p->pressed);
+  }
+}
+
+void button_engine_irq(button_engine_t* engine, uint8_t pin, int64_t irq_us) {
+  if (pin >= engine->config.pin_count) return;
+  button_engine_pin_t* p = &engine->pins[pin];
+  engine->stats.irqs++;
+  // selama settling interrupt pin mati; yang datang tetap ditangani lewat sample
+  if (p->settling || p->irq_pending) return;
+  p->irq_pending = true;
+  p->irq_us = irq_us;
+}
+
+uint8_t button_engine_poll(button_engine_t* engine, int64_t now_us, button_engine_event_t* events, uint8_t max) {
+  event_sink_t sink = { .events = events, .max = max, .count = 0 };
+  engine->stats.polls++;
+  // satu snapshot untuk semua pin yang selesai debounce di poll ini, dibaca hanya jika perlu
+  bool have_snapshot = false;
+  uint32_t snapshot = 0;
+
+  // semua input dan timer diproses urut waktu, supaya chord / double click melihat urutan yang benar
+  for (step_t step = next_step(engine); step.type != STEP_NONE && step.time_us <= now_us; step = next_step(engine)) {
+    button_engine_pin_t* p = &engine->pins[step.index];
+    switch (step.type) {
+      case STEP_LONG:
+        feed(engine, step.index, INPUT_LONG, step.time_us, &sink);
+        break;
+      case STEP_WINDOW:
+        feed(engine, step.index, INPUT_WINDOW, step.time_us, &sink);
+        break;
+      case STEP_CHORD: {
+        uint8_t mask = engine->config.chords[step.index].mask;
+        for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+          if (mask & (1u << i)) feed(engine, i, INPUT_CHORD, step.time_us, &sink);
+        }
+        emit(engine, &sink, step.index, BUTTON_ENGINE_CHORD_LONG, step.time_us,
+             step.time_us - engine->config.chords[step.index].hold_us);
+        break;
+      }
+      case STEP_IRQ:
+        // interrupt hanya di-arm untuk level kebalikan state, jadi interrupt = transisi
+        p->irq_pending = false;
+        p->pressed = !p->pressed;
+        feed(engine, step.index, p->pressed ? INPUT_PRESS : INPUT_RELEASE, step.time_us, &sink);
+        p->settling = true;
+        p->settle_us = step.time_us + engine->config.debounce_us;
+        break;
+      case STEP_SETTLE: {
+        if (!have_snapshot) {
+          snapshot = engine->io.read(engine->io.ctx);
+          engine->stats.samples++;
+          have_snapshot = true;
+        }
+        bool level = (snapshot >> step.index) & 1;
+        if (level == p->pressed) {
+          p->settling = false;
+          engine->io.arm(engine->io.ctx, step.index, p->pressed);
+          break;
+        }
+        // berubah lagi di dalam jendela (tap pendek / pantulan panjang): transisi + jendela baru
+        engine->stats.bounces++;
+        p->pressed = level;
+        feed(engine, step.index, level ? INPUT_PRESS : INPUT_RELEASE, step.time_us, &sink);
+        p->settle_us += engine->config.debounce_us;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return sink.count;
+}
+
+int64_t button_engine_next_deadline_us(const button_engine_t* engine) {
+  step_t step = next_step(engine);
+  return step.type == STEP_NONE ? BUTTON_ENGINE_NO_DEADLINE : step.time_us;
+}
+
+const char* button_engine_kind_name(button_engine_kind_t kind) {
+  if (kind >= BUTTON_ENGINE_KIND_COUNT) return "UNKNOWN";
+  return kind_names[kind];
+}
+
+const char* button_engine_state_name(button_engine_state_t state) {
+  if (state >= BUTTON_ENGINE_STATE_COUNT) return "UNKNOWN";
+  return state_names[state];
+}
+
+// --- static function ---
+static step_t next_step(const button_engine_t* engine) {
+  // timer lebih dulu: pada waktu yang sama, tenggat menang atas transisi (batas jendela eksklusif)
+  step_t best = { .type = STEP_NONE, .index = 0, .time_us = BUTTON_ENGINE_NO_DEADLINE };
+  for (uint8_t c = 0; c < engine->config.chord_count; c++) {
+    consider(&best, STEP_CHORD, c, chord_deadline(engine, c));
+  }
+  for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+    const button_engine_pin_t* p = &engine->pins[i];
+    const button_engine_pin_config_t* pc = &engine->config.pins[i];
+    if (waiting_long(p) && pc->long_press_us != 0 && !chord_partner_pressed(engine, i)) {
+      consider(&best, STEP_LONG, i, p->press_us + pc->long_press_us);
+    }
+    if (p->state == BUTTON_ENGINE_UP_WAIT || p->state == BUTTON_ENGINE_DOWN_AGAIN) {
+      consider(&best, STEP_WINDOW, i, p->release_us + pc->double_click_us);
+    }
+  }
+  for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+    const button_engine_pin_t* p = &engine->pins[i];
+    if (p->irq_pending) consider(&best, STEP_IRQ, i, p->irq_us);
+    if (p->settling) consider(&best, STEP_SETTLE, i, p->settle_us);
+  }
+  return best;
+}
+
+static void consider(step_t* best, step_type_t type, uint8_t index, int64_t time_us) {
+  if (time_us == BUTTON_ENGINE_NO_DEADLINE || time_us >= best->time_us) return;
+  best->type = type;
+  best->index = index;
+  best->time_us = time_us;
+}
+
+static void feed(button_engine_t* engine, uint8_t pin, gesture_input_t input, int64_t time_us, event_sink_t* sink) {
+  button_engine_pin_t* p = &engine->pins[pin];
+  const gesture_step_t* step = &gesture_table[p->state][input];
+  if (input == INPUT_PRESS) p->press_us = time_us;
+  if (input == INPUT_PRESS && p->state == BUTTON_ENGINE_IDLE) p->origin_us = time_us;
+  if (input == INPUT_RELEASE) p->release_us = time_us;
+  if (step->next != 0) p->state = (uint8_t) (step->next - 1);
+  if (step->emit != 0) emit(engine, sink, pin, (button_engine_kind_t) (step->emit - 1), time_us, p->origin_us);
+  // DOWN_AGAIN -> DOWN: tekan kedua jadi awal gesture baru
+  if (input == INPUT_WINDOW && p->state == BUTTON_ENGINE_DOWN) p->origin_us = p->press_us;
+}
+
+static void emit(button_engine_t* engine, event_sink_t* sink, uint8_t pin, button_engine_kind_t kind,
+                 int64_t time_us, int64_t origin_us) {
+  if (sink->count >= sink->max) {
+    engine->stats.dropped++;
+    return;
+  }
+  sink->events[sink->count].pin = pin;
+  sink->events[sink->count].kind = (uint8_t) kind;
+  sink->events[sink->count].time_us = time_us;
+  sink->events[sink->count].origin_us = origin_us;
+  sink->count++;
+  engine->stats.events++;
+}
+
+static bool waiting_long(const button_engine_pin_t* p) {
+  return p->state == BUTTON_ENGINE_DOWN || p->state == BUTTON_ENGINE_DOWN_AGAIN;
+}
+
+static bool chord_partner_pressed(const button_engine_t* engine, uint8_t pin) {
+  for (uint8_t c = 0; c < engine->config.chord_count; c++) {
+    uint8_t mask = engine->config.chords[c].mask;
+    if (!(mask & (1u << pin))) continue;
+    for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+      if (i != pin && (mask & (1u << i)) && engine->pins[i].pressed) return true;
+    }
+  }
+  return false;
+}
+
+static int64_t chord_deadline(const button_engine_t* engine, uint8_t chord) {
+  // semua anggota ditekan dan belum jadi long press / chord lain; tenggat dari tekan terakhir
+  uint8_t mask = engine->config.chords[chord].mask;
+  int64_t latest = INT64_MIN;
+  uint8_t members = 0;
+  for (uint8_t i = 0; i < engine->config.pin_count; i++) {
+    if (!(mask & (1u << i))) continue;
+    const button_engine_pin_t* p = &engine->pins[i];
+    if (!waiting_long(p)) return BUTTON_ENGINE_NO_DEADLINE;
+    if (p->press_us > latest) latest = p->press_us;
+    members++;
+  }
+  if (members < 2) return BUTTON_ENGINE_NO_DEADLINE;
+  return latest + engine->config.chords[chord].hold_us;
+}
@@ -0,0 +1,139 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef BUTTON_ENGINE_H
+#define BUTTON_ENGINE_H
+
+// Pengenal gesture tombol (debounce, click, double click, long press, chord) tanpa polling.
+//
+// - Input: interrupt pin = transisi. State langsung dibalik pada waktu interrupt (tanpa
+//   menunggu debounce), lalu interrupt pin dimatikan selama `debounce_us`. Di akhir jendela
+//   semua pin dibaca sekaligus (satu snapshot register); jika pin berbeda, itu transisi
+//   berikutnya dan jendela baru dimulai. Setelah stabil, pin di-arm lagi.
+// - Gesture: satu state machine per pin, transisinya dari tabel konstan (gesture_table di .c).
+//   Timer per pin dari tabel konfigurasi: long_press_us (0 = tanpa long press) dan
+//   double_click_us (0 = tanpa double click, click langsung saat dilepas).
+// - Chord: pin di `mask` yang ditekan bersamaan selama `hold_us` menjadi satu event; long press
+//   pin anggota ditahan selama anggota lain juga ditekan, dan pelepasan setelah chord tidak
+//   menghasilkan event. Jika tenggat sama, chord yang lebih dulu di tabel menang.
+// - Semua event dari satu poll dikembalikan sekaligus, berurutan menurut waktu per pin.
+//
+// Tidak ada thread / timer di sini: pemakai memanggil poll() saat interrupt atau saat tenggat
+// dari next_deadline_us(). Waktu dan GPIO dari luar, jadi bisa disimulasikan di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BUTTON_ENGINE_MAX_PINS   8
+#define BUTTON_ENGINE_MAX_CHORDS 4
+// cukup untuk satu poll normal; event yang tidak muat dihitung di stats.dropped
+#define BUTTON_ENGINE_MAX_EVENTS (4 * BUTTON_ENGINE_MAX_PINS + BUTTON_ENGINE_MAX_CHORDS)
+#define BUTTON_ENGINE_NO_DEADLINE INT64_MAX
+
+typedef enum {
+  BUTTON_ENGINE_CLICK = 0,
+  BUTTON_ENGINE_DOUBLE_CLICK,
+  BUTTON_ENGINE_LONG_START,
+  BUTTON_ENGINE_LONG_UP,
+  BUTTON_ENGINE_CHORD_LONG, // pin = indeks chord di config.chords
+  BUTTON_ENGINE_KIND_COUNT,
+} button_engine_kind_t;
+
+typedef enum {
+  BUTTON_ENGINE_IDLE = 0,   // dilepas, tidak ada yang tertunda
+  BUTTON_ENGINE_DOWN,       // ditekan, menunggu long press
+  BUTTON_ENGINE_HELD,       // long press sudah dilaporkan
+  BUTTON_ENGINE_UP_WAIT,    // dilepas, menunggu tekan kedua
+  BUTTON_ENGINE_DOWN_AGAIN, // tekan kedua di dalam jendela double click
+  BUTTON_ENGINE_SILENT,     // ditahan sejak init / bagian chord: pelepasan tanpa event
+  BUTTON_ENGINE_STATE_COUNT,
+} button_engine_state_t;
+
+typedef struct {
+  uint8_t pin;
+  uint8_t kind;      // button_engine_kind_t
+  int64_t time_us;   // saat kondisinya terpenuhi (transisi / tenggat), bukan saat poll
+  int64_t origin_us; // tekan fisik yang memulai gesture (chord: anggota terakhir yang ditekan)
+} button_engine_event_t;
+
+typedef struct {
+  // snapshot semua pin sekaligus, bit i = pin i ditekan
+  uint32_t (*read)(void* ctx);
+  // aktifkan lagi interrupt pin untuk transisi berikutnya dari state `pressed`
+  void (*arm)(void* ctx, uint8_t pin, bool pressed);
+  void* ctx;
+} button_engine_io_t;
+
+typedef struct {
+  uint32_t long_press_us;   // 0 = tanpa long press
+  uint32_t double_click_us; // 0 = tanpa double click; dipotong ke long_press_us jika lebih besar
+} button_engine_pin_config_t;
+
+typedef struct {
+  uint8_t  mask;            // bit per pin, minimal dua pin
+  uint32_t hold_us;
+} button_engine_chord_t;
+
+typedef struct {
+  uint8_t  pin_count;
+  uint8_t  chord_count;
+  uint32_t debounce_us;
+  button_engine_pin_config_t pins[BUTTON_ENGINE_MAX_PINS];
+  button_engine_chord_t chords[BUTTON_ENGINE_MAX_CHORDS];
+} button_engine_config_t;
+
+typedef struct {
+  uint32_t irqs;
+  uint32_t polls;
+  uint32_t samples;        // snapshot dibaca di akhir jendela debounce
+  uint32_t bounces;        // sample yang menemukan transisi tambahan di dalam jendela
+  uint32_t events;
+  uint32_t dropped;        // event yang tidak muat di buffer poll
+} button_engine_stats_t;
+
+typedef struct {
+  uint8_t state;           // button_engine_state_t
+  bool    pressed;         // level setelah debounce
+  bool    irq_pending;
+  int64_t irq_us;
+  bool    settling;        // interrupt pin mati sampai settle_us
+  int64_t settle_us;
+  int64_t press_us;
+  int64_t release_us;
+  int64_t origin_us;       // tekan pertama gesture yang sedang berjalan
+} button_engine_pin_t;
+
+typedef struct {
+  button_engine_config_t config;
+  button_engine_io_t io;
+  button_engine_pin_t pins[BUTTON_ENGINE_MAX_PINS];
+  button_engine_stats_t stats;
+} button_engine_t;
+
+// baca level awal dan arm semua pin; tombol yang sudah ditekan saat init tidak menghasilkan event
+void button_engine_init(button_engine_t* engine, const button_engine_config_t* config,
+                        const button_engine_io_t* io, int64_t now_us);
+
+// dari interrupt (lewat task): pin sudah dimatikan interrupt-nya oleh ISR
+void button_engine_irq(button_engine_t* engine, uint8_t pin, int64_t irq_us);
+
+// proses interrupt, jendela debounce, dan timer yang sudah jatuh tempo; return jumlah event
+uint8_t button_engine_poll(button_engine_t* engine, int64_t now_us, button_engine_event_t* events, uint8_t max);
+
+// tenggat berikutnya (BUTTON_ENGINE_NO_DEADLINE = tidur sampai interrupt)
+int64_t button_engine_next_deadline_us(const button_engine_t* engine);
+
+const char* button_engine_kind_name(button_engine_kind_t kind);
+
+const char* button_engine_state_name(button_engine_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //BUTTON_ENGINE_H
@@ -0,0 +1,383 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_codec.h"
+
+#include <math.h>
+#include <string.h>
+
+// frame yang mundur lebih jauh dari ini dianggap pengirim reboot (seq mulai dari 0 lagi).
+// juga batas "seq rendah": lompatan ke seq < window yang bukan langkah maju kecil = reboot
+#define SEQ_RESYNC_WINDOW 32
+
+#define RAW_24_MAX  0x7FFFFF
+#define RAW_24_MIN  (-0x800000)
+
+#define FLAG_READY  0x80
+#define STATE_MASK  0x0F
+
+// --- helper little-endian ---
+static void put_u16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t) v;
+  p[1] = (uint8_t) (v >> 8);
+}
+
+static void put_i24(uint8_t* p, int32_t v) {
+  p[0] = (uint8_t) v;
+  p[1] = (uint8_t) (v >> 8);
+  p[2] = (uint8_t) (v >> 16);
+}
+
+static void put_i32(uint8_t* p, int32_t v) {
+  uint32_t u = (uint32_t) v;
+  p[0] = (uint8_t) u;
+  p[1] = (uint8_t) (u >> 8);
+  p[2] = (uint8_t) (u >> 16);
+  p[3] = (uint8_t) (u >> 24);
+}
+
+static uint16_t get_u16(const uint8_t* p) {
+  return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static int32_t get_i24(const uint8_t* p) {
+  uint32_t u = (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16);
+  if (u & 0x800000) u |= 0xFF000000u; // sign extend
+  return (int32_t) u;
+}
+
+static int32_t get_i32(const uint8_t* p) {
+  return (int32_t) ((uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24));
+}
+
+static uint32_t zigzag_encode(int32_t v) {
+  return ((uint32_t) v << 1) ^ (uint32_t) (v >> 31);
+}
+
+static int32_t zigzag_decode(uint32_t v) {
+  return (int32_t) (v >> 1) ^ -(int32_t) (v & 1);
+}
+
+// return jumlah byte, 0 jika tidak muat
+static size_t put_varint(uint8_t* p, size_t avail, uint32_t v) {
+  size_t n = 0;
+  do {
+    if (n >= avail) return 0;
+    uint8_t byte = v & 0x7F;
+    v >>= 7;
+    p[n++] = v ? (byte | 0x80) : byte;
+  } while (v);
+  return n;
+}
+
+static const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint32_t* v) {
+  uint32_t result = 0;
+  for (uint8_t shift = 0; shift < 35 && p < end; shift += 7) {
+    uint8_t byte = *p++;
+    result |= (uint32_t) (byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *v = result;
+      return p;
+    }
+  }
+  return NULL;
+}
+
+static int32_t clamp_raw(long raw) {
+  if (raw > RAW_24_MAX) return RAW_24_MAX;
+  if (raw < RAW_24_MIN) return RAW_24_MIN;
+  return (int32_t) raw;
+}
+
+static int32_t weight_to_fixed(float value) {
+  float scaled = value * COMM_WIRE_WEIGHT_SCALE;
+  if (!(scaled == scaled)) return 0; // NaN
+  if (scaled >= (float) INT32_MAX) return INT32_MAX;
+  if (scaled <= (float) INT32_MIN) return INT32_MIN;
+  return (int32_t) lroundf(scaled);
+}
+
+static float fixed_to_weight(int32_t value) {
+  return (float) value / COMM_WIRE_WEIGHT_SCALE;
+}
+
+static size_t finish_frame(uint8_t* out, uint8_t type, uint16_t seq, size_t payload_len) {
+  out[0] = COMM_WIRE_VERSION;
+  out[1] = type;
+  put_u16(&out[2], seq);
+  size_t len = COMM_WIRE_HEADER_LEN + payload_len;
+  put_u16(&out[len], comm_codec_crc16(out, len));
+  return len + COMM_WIRE_CRC_LEN;
+}
+
+// --- public ---
+uint16_t comm_codec_crc16(const uint8_t* data, size_t len) {
+  // CRC-16/CCITT-FALSE, poly 0x1021, init 0xFFFF
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t) (data[i] << 8);
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+    }
+  }
+  return crc;
+}
+
+size_t comm_codec_encode_weight(uint8_t* out, size_t out_len, uint16_t seq, const weight_data_t* weight) {
+  if (out == NULL || weight == NULL || out_len < COMM_WIRE_WEIGHT_FRAME_LEN) return 0;
+
+  int32_t raw = clamp_raw(weight->raw_weight);
+
+  uint8_t* p = &out[COMM_WIRE_HEADER_LEN];
+  p[0] = (uint8_t) ((weight->main_state & STATE_MASK) | (weight->is_ready ? FLAG_READY : 0));
+  put_i32(&p[1], weight_to_fixed(weight->filtered_weight));
+  put_i32(&p[5], weight_to_fixed(weight->units));
+  put_i24(&p[9], raw);
+
+  return finish_frame(out, COMM_FRAME_WEIGHT, seq, COMM_WIRE_WEIGHT_PAYLOAD_LEN);
+}
+
+size_t comm_codec_encode_cmd(uint8_t* out, size_t out_len, uint16_t seq, const comm_send_data_t* cmd) {
+  if (out == NULL || cmd == NULL || out_len < COMM_WIRE_CMD_FRAME_LEN) return 0;
+
+  uint8_t* p = &out[COMM_WIRE_HEADER_LEN];
+  p[0] = (uint8_t) cmd->command;
+  put_i32(&p[1], weight_to_fixed(cmd->value));
+
+  return finish_frame(out, COMM_FRAME_CMD, seq, COMM_WIRE_CMD_PAYLOAD_LEN);
+}
+
+size_t comm_codec_encode_ack(uint8_t* out, size_t out_len, uint16_t seq, uint16_t acked_seq, comm_ack_status_t status) {
+  if (out == NULL || out_len < COMM_WIRE_ACK_FRAME_LEN) return 0;
+
+  uint8_t* p = &out[COMM_WIRE_HEADER_LEN];
+  put_u16(&p[0], acked_seq);
+  p[2] = (uint8_t) status;
+
+  return finish_frame(out, COMM_FRAME_ACK, seq, COMM_WIRE_ACK_PAYLOAD_LEN);
+}
+
+size_t comm_codec_encode_probe(uint8_t* out, size_t out_len, comm_frame_type_t type, uint16_t seq, uint32_t stamp) {
+  if (out == NULL || out_len < COMM_WIRE_PROBE_FRAME_LEN) return 0;
+  if (type != COMM_FRAME_PING && type != COMM_FRAME_PONG) return 0;
+
+  put_i32(&out[COMM_WIRE_HEADER_LEN], (int32_t) stamp);
+  return finish_frame(out, type, seq, COMM_WIRE_PROBE_PAYLOAD_LEN);
+}
+
+size_t comm_codec_encode_weight_batch(uint8_t* out, size_t out_len, uint16_t seq, const weight_data_t* samples,
+                                      uint8_t count, uint16_t interval_ms, uint8_t* packed) {
+  if (packed != NULL) *packed = 0;
+  if (out == NULL || samples == NULL || count == 0) return 0;
+  if (out_len > COMM_WIRE_MAX_FRAME_LEN) out_len = COMM_WIRE_MAX_FRAME_LEN;
+  if (out_len < COMM_WIRE_OVERHEAD + COMM_WIRE_BATCH_HEADER_LEN) return 0;
+  if (count > COMM_WIRE_BATCH_MAX_SAMPLES) count = COMM_WIRE_BATCH_MAX_SAMPLES;
+
+  uint8_t* p = &out[COMM_WIRE_HEADER_LEN];
+  int32_t filtered = weight_to_fixed(samples[0].filtered_weight);
+  int32_t units = weight_to_fixed(samples[0].units);
+  int32_t raw = clamp_raw(samples[0].raw_weight);
+
+  p[0] = (uint8_t) ((samples[0].main_state & STATE_MASK) | (samples[0].is_ready ? FLAG_READY : 0));
+  put_u16(&p[2], interval_ms);
+  put_i32(&p[4], filtered);
+  put_i32(&p[8], units);
+  put_i24(&p[12], raw);
+
+  size_t used = COMM_WIRE_BATCH_HEADER_LEN;
+  size_t avail = out_len - COMM_WIRE_OVERHEAD;
+  uint8_t n = 1;
+  for (; n < count; n++) {
+    int32_t next_filtered = weight_to_fixed(samples[n].filtered_weight);
+    int32_t next_units = weight_to_fixed(samples[n].units);
+    int32_t next_raw = clamp_raw(samples[n].raw_weight);
+
+    // delta dihitung dalam uint32 supaya overflow tetap terdefinisi (wrap sama di decoder)
+    uint32_t d_filtered = zigzag_encode((int32_t) ((uint32_t) next_filtered - (uint32_t) filtered));
+    uint32_t d_units = zigzag_encode((int32_t) ((uint32_t) next_units - (uint32_t) units));
+    uint32_t d_raw = zigzag_encode(next_raw - raw);
+
+    size_t a = put_varint(&p[used], avail - used, d_filtered);
+    size_t b = a ? put_varint(&p[used + a], avail - used - a, d_units) : 0;
+    size_t c = b ? put_varint(&p[used + a + b], avail - used - a - b, d_raw) : 0;
+    if (c == 0) break; // frame penuh
+
+    used += a + b + c;
+    filtered = next_filtered;
+    units = next_units;
+    raw = next_raw;
+  }
+  p[1] = n;
+
+  if (packed != NULL) *packed = n;
+  return finish_frame(out, COMM_FRAME_WEIGHT_BATCH, seq, used);
+}
+
+comm_decode_result_t comm_codec_parse(const uint8_t* frame, size_t len, comm_frame_header_t* header) {
+  if (frame == NULL || header == NULL || len < COMM_WIRE_OVERHEAD) return COMM_DECODE_TOO_SHORT;
+  if (len > COMM_WIRE_MAX_FRAME_LEN) return COMM_DECODE_TOO_SHORT;
+
+  size_t body_len = len - COMM_WIRE_CRC_LEN;
+  if (comm_codec_crc16(frame, body_len) != get_u16(&frame[body_len])) return COMM_DECODE_BAD_CRC;
+
+  // hanya major version yang harus sama
+  if ((frame[0] >> 4) != COMM_WIRE_VERSION_MAJOR) return COMM_DECODE_BAD_VERSION;
+
+  header->version = frame[0];
+  header->type = frame[1];
+  header->seq = get_u16(&frame[2]);
+  header->payload = &frame[COMM_WIRE_HEADER_LEN];
+  header->payload_len = (uint8_t) (body_len - COMM_WIRE_HEADER_LEN);
+  return COMM_DECODE_OK;
+}
+
+comm_decode_result_t comm_codec_decode_weight(const comm_frame_header_t* header, weight_data_t* weight) {
+  if (header == NULL || weight == NULL) return COMM_DECODE_TOO_SHORT;
+  if (header->type != COMM_FRAME_WEIGHT) return COMM_DECODE_BAD_TYPE;
+  // payload lebih panjang (minor version lebih baru) tetap diterima
+  if (header->payload_len < COMM_WIRE_WEIGHT_PAYLOAD_LEN) return COMM_DECODE_TOO_SHORT;
+
+  const uint8_t* p = header->payload;
+  weight->main_state = (main_state_t) (p[0] & STATE_MASK);
+  weight->is_ready = (p[0] & FLAG_READY) != 0;
+  weight->filtered_weight = fixed_to_weight(get_i32(&p[1]));
+  weight->units = fixed_to_weight(get_i32(&p[5]));
+  weight->raw_weight = get_i24(&p[9]);
+  return COMM_DECODE_OK;
+}
+
+comm_decode_result_t comm_codec_decode_cmd(const comm_frame_header_t* header, comm_send_data_t* cmd) {
+  if (header == NULL || cmd == NULL) return COMM_DECODE_TOO_SHORT;
+  if (header->type != COMM_FRAME_CMD) return COMM_DECODE_BAD_TYPE;
+  if (header->payload_len < COMM_WIRE_CMD_PAYLOAD_LEN) return COMM_DECODE_TOO_SHORT;
+
+  const uint8_t* p = header->payload;
+  cmd->command = p[0] < CMD_UNKNOWN_OR_INVALID ? (cmd_main_t) p[0] : CMD_UNKNOWN_OR_INVALID;
+  cmd->value = fixed_to_weight(get_i32(&p[1]));
+  return COMM_DECODE_OK;
+}
+
+comm_decode_result_t comm_codec_decode_ack(const comm_frame_header_t* header, uint16_t* acked_seq,
+                                           comm_ack_status_t* status) {
+  if (header == NULL || acked_seq == NULL || status == NULL) return COMM_DECODE_TOO_SHORT;
+  if (header->type != COMM_FRAME_ACK) return COMM_DECODE_BAD_TYPE;
+  if (header->payload_len < COMM_WIRE_ACK_PAYLOAD_LEN) return COMM_DECODE_TOO_SHORT;
+
+  *acked_seq = get_u16(&header->payload[0]);
+  *status = header->payload[2] == COMM_ACK_OK ? COMM_ACK_OK : COMM_ACK_REJECTED;
+  return COMM_DECODE_OK;
+}
+
+comm_decode_result_t comm_codec_decode_probe(const comm_frame_header_t* header, uint32_t* stamp) {
+  if (header == NULL || stamp == NULL) return COMM_DECODE_TOO_SHORT;
+  if (header->type != COMM_FRAME_PING && header->type != COMM_FRAME_PONG) return COMM_DECODE_BAD_TYPE;
+  if (header->payload_len < COMM_WIRE_PROBE_PAYLOAD_LEN) return COMM_DECODE_TOO_SHORT;
+
+  *stamp = (uint32_t) get_i32(&header->payload[0]);
+  return COMM_DECODE_OK;
+}
+
+comm_decode_result_t comm_codec_batch_begin(const comm_frame_header_t* header, comm_batch_reader_t* reader) {
+  if (header == NULL || reader == NULL) return COMM_DECODE_TOO_SHORT;
+  if (header->type != COMM_FRAME_WEIGHT_BATCH) return COMM_DECODE_BAD_TYPE;
+  if (header->payload_len < COMM_WIRE_BATCH_HEADER_LEN) return COMM_DECODE_TOO_SHORT;
+
+  const uint8_t* p = header->payload;
+  if (p[1] == 0 || p[1] > COMM_WIRE_BATCH_MAX_SAMPLES) return COMM_DECODE_TOO_SHORT;
+
+  reader->main_state = (main_state_t) (p[0] & STATE_MASK);
+  reader->is_ready = (p[0] & FLAG_READY) != 0;
+  reader->count = p[1];
+  reader->index = 0;
+  reader->interval_ms = get_u16(&p[2]);
+  reader->filtered = get_i32(&p[4]);
+  reader->units = get_i32(&p[8]);
+  reader->raw = get_i24(&p[12]);
+  reader->cursor = &p[COMM_WIRE_BATCH_HEADER_LEN];
+  reader->end = &p[header->payload_len];
+  return COMM_DECODE_OK;
+}
+
+bool comm_codec_batch_next(comm_batch_reader_t* reader, weight_data_t* weight) {
+  if (reader->index >= reader->count) return false;
+
+  if (reader->index > 0) {
+    uint32_t d_filtered, d_units, d_raw;
+    const uint8_t* p = get_varint(reader->cursor, reader->end, &d_filtered);
+    if (p) p = get_varint(p, reader->end, &d_units);
+    if (p) p = get_varint(p, reader->end, &d_raw);
+    if (p == NULL) {
+      reader->index = reader->count; // delta rusak, hentikan
+      return false;
+    }
+    reader->cursor = p;
+    reader->filtered = (int32_t) ((uint32_t) reader->filtered + (uint32_t) zigzag_decode(d_filtered));
+    reader->units = (int32_t) ((uint32_t) reader->units + (uint32_t) zigzag_decode(d_units));
+    reader->raw += zigzag_decode(d_raw);
+  }
+  reader->index++;
+
+  weight->main_state = reader->main_state;
+  weight->is_ready = reader->is_ready;
+  weight->filtered_weight = fixed_to_weight(reader->filtered);
+  weight->units = fixed_to_weight(reader->units);
+  weight->raw_weight = reader->raw;
+  return true;
+}
+
+bool comm_codec_is_legacy_weight(const uint8_t* frame, size_t len) {
+  // byte pertama frame lama adalah main_state_t (0..4), frame baru selalu >= 0x10
+  return frame != NULL && len == sizeof(weight_data_t) && frame[0] <= WAKE_UP_MODE;
+}
+
+const char* comm_codec_result_name(comm_decode_result_t result) {
+  switch (result) {
+    case COMM_DECODE_OK:          return "OK";
+    case COMM_DECODE_TOO_SHORT:   return "TOO_SHORT";
+    case COMM_DECODE_BAD_CRC:     return "BAD_CRC";
+    case COMM_DECODE_BAD_VERSION: return "BAD_VERSION";
+    case COMM_DECODE_BAD_TYPE:    return "BAD_TYPE";
+    default:                      return "UNKNOWN";
+  }
+}
+
+void comm_seq_tracker_reset(comm_seq_tracker_t* tracker) {
+  memset(tracker, 0, sizeof(*tracker));
+}
+
+bool comm_seq_tracker_update(comm_seq_tracker_t* tracker, uint16_t seq) {
+  if (!tracker->synced) {
+    tracker->synced = true;
+    tracker->last_seq = seq;
+    tracker->received++;
+    return true;
+  }
+
+  int16_t diff = (int16_t) (uint16_t) (seq - tracker->last_seq);
+  if (diff == 0) {
+    tracker->duplicated++;
+    return false;
+  }
+
+  if (diff < 0 && diff > -SEQ_RESYNC_WINDOW) {
+    // frame terlambat, sudah terhitung hilang sebelumnya
+    tracker->reordered++;
+    if (tracker->lost > 0) tracker->lost--;
+    return false;
+  }
+
+  // mundur jauh, atau lompat ke seq rendah (mis. 40000 -> 3, diff positif besar):
+  // pengirim reboot, frame di antaranya bukan hilang
+  if (diff < 0 || (seq < SEQ_RESYNC_WINDOW && diff > SEQ_RESYNC_WINDOW)) {
+    tracker->restarts++;
+    tracker->last_seq = seq;
+    tracker->received++;
+    return true;
+  }
+
+  tracker->lost += (uint32_t) (diff - 1);
+  tracker->last_seq = seq;
+  tracker->received++;
+  return true;
+}
@@ -0,0 +1,169 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_CODEC_H
+#define COMM_CODEC_H
+
+// Codec frame ESP-NOW antara Device A dan Device B.
+// Sengaja tidak memakai header ESP-IDF / FreeRTOS supaya bisa di-compile di host (Linux).
+//
+// Layout frame (little-endian, tanpa padding):
+//
+//   [0]      version   (major << 4 | minor)
+//   [1]      type      (comm_frame_type_t)
+//   [2..3]   seq       (u16, naik 1 per frame per pengirim dan per kelas frame, lihat bawah)
+//   [4..n-3] payload   (tergantung type)
+//   [n-2..]  crc16     (CRC-16/CCITT-FALSE atas byte [0..n-3])
+//
+// Seq punya tiga ruang terpisah per pengirim, masing-masing dilacak comm_seq_tracker_t sendiri:
+//   data    WEIGHT / WEIGHT_BATCH
+//   command CMD (dari comm_reliable; retransmit memakai seq yang sama) dan ACK
+//   probe   PING / PONG
+// Jadi PING di sela frame weight tidak terlihat sebagai frame yang hilang.
+//
+// Minor version boleh beda: payload yang lebih panjang dari yang dikenal akan dipotong,
+// jadi update firmware di satu sisi tidak membuat semua frame dibuang.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMM_WIRE_VERSION_MAJOR 1
+#define COMM_WIRE_VERSION_MINOR 0
+#define COMM_WIRE_VERSION       ((COMM_WIRE_VERSION_MAJOR << 4) | COMM_WIRE_VERSION_MINOR)
+
+#define COMM_WIRE_HEADER_LEN    4
+#define COMM_WIRE_CRC_LEN       2
+#define COMM_WIRE_OVERHEAD      (COMM_WIRE_HEADER_LEN + COMM_WIRE_CRC_LEN)
+#define COMM_WIRE_MAX_FRAME_LEN 250 // ESP_NOW_MAX_DATA_LEN
+
+// berat dikirim sebagai fixed-point: 1 LSB = 0.01 gram (range +-21 ton di int32)
+#define COMM_WIRE_WEIGHT_SCALE  100
+
+#define COMM_WIRE_WEIGHT_PAYLOAD_LEN 12
+#define COMM_WIRE_CMD_PAYLOAD_LEN    5
+#define COMM_WIRE_ACK_PAYLOAD_LEN    3
+#define COMM_WIRE_PROBE_PAYLOAD_LEN  4
+
+// batch: header 15 byte (base sample + count + interval), lalu delta zigzag-varint per sample
+#define COMM_WIRE_BATCH_HEADER_LEN   15
+#define COMM_WIRE_BATCH_MAX_SAMPLES  64
+
+#define COMM_WIRE_WEIGHT_FRAME_LEN (COMM_WIRE_OVERHEAD + COMM_WIRE_WEIGHT_PAYLOAD_LEN)
+#define COMM_WIRE_CMD_FRAME_LEN    (COMM_WIRE_OVERHEAD + COMM_WIRE_CMD_PAYLOAD_LEN)
+#define COMM_WIRE_ACK_FRAME_LEN    (COMM_WIRE_OVERHEAD + COMM_WIRE_ACK_PAYLOAD_LEN)
+#define COMM_WIRE_PROBE_FRAME_LEN  (COMM_WIRE_OVERHEAD + COMM_WIRE_PROBE_PAYLOAD_LEN)
+
+typedef enum {
+  COMM_FRAME_WEIGHT = 0x01,
+  COMM_FRAME_CMD    = 0x02,
+  COMM_FRAME_WEIGHT_BATCH = 0x03,
+  COMM_FRAME_ACK    = 0x04, // Device A -> B, seq di payload = seq frame command yang di-ACK
+  COMM_FRAME_PING   = 0x05, // payload: timestamp pengirim (u32, us)
+  COMM_FRAME_PONG   = 0x06, // payload: timestamp dari PING, dikembalikan apa adanya
+} comm_frame_type_t;
+
+typedef enum {
+  COMM_ACK_OK = 0,
+  COMM_ACK_REJECTED, // command diterima tapi tidak bisa dijalankan di Device A
+} comm_ack_status_t;
+
+typedef enum {
+  COMM_DECODE_OK = 0,
+  COMM_DECODE_TOO_SHORT,
+  COMM_DECODE_BAD_CRC,
+  COMM_DECODE_BAD_VERSION,
+  COMM_DECODE_BAD_TYPE,
+} comm_decode_result_t;
+
+typedef struct {
+  uint8_t  version;
+  uint8_t  type;
+  uint16_t seq;
+  const uint8_t* payload;
+  uint8_t  payload_len;
+} comm_frame_header_t;
+
+// pembaca batch tanpa buffer: sample di-decode satu per satu lewat comm_codec_batch_next()
+typedef struct {
+  uint8_t  count;
+  uint8_t  index;
+  uint16_t interval_ms;
+  main_state_t main_state;
+  bool     is_ready;
+  int32_t  filtered;
+  int32_t  units;
+  int32_t  raw;
+  const uint8_t* cursor;
+  const uint8_t* end;
+} comm_batch_reader_t;
+
+// statistik urutan frame dari satu pengirim.
+// seq mundur < SEQ_RESYNC_WINDOW (32) = frame terlambat; mundur lebih jauh, atau lompat ke seq < 32
+// yang bukan langkah maju kecil = pengirim reboot (restarts), tracker mulai lagi tanpa menambah lost.
+// frame awal setelah reboot yang hilang semua (seq pertama yang sampai >= 32) tetap terhitung lost.
+typedef struct {
+  bool     synced;
+  uint16_t last_seq;
+  uint32_t received;
+  uint32_t lost;
+  uint32_t duplicated;
+  uint32_t reordered;
+  uint32_t restarts;
+} comm_seq_tracker_t;
+
+uint16_t comm_codec_crc16(const uint8_t* data, size_t len);
+
+// encode: return panjang frame, 0 jika buffer tidak cukup
+size_t comm_codec_encode_weight(uint8_t* out, size_t out_len, uint16_t seq, const weight_data_t* weight);
+
+size_t comm_codec_encode_cmd(uint8_t* out, size_t out_len, uint16_t seq, const comm_send_data_t* cmd);
+
+size_t comm_codec_encode_ack(uint8_t* out, size_t out_len, uint16_t seq, uint16_t acked_seq, comm_ack_status_t status);
+
+// PING / PONG untuk ukur RTT link; `type` harus COMM_FRAME_PING atau COMM_FRAME_PONG
+size_t comm_codec_encode_probe(uint8_t* out, size_t out_len, comm_frame_type_t type, uint16_t seq, uint32_t stamp);
+
+// pack sample sebanyak yang muat (max `count`), jumlah yang masuk ditulis ke `packed`.
+// semua sample dalam satu batch memakai main_state / is_ready dari sample pertama
+size_t comm_codec_encode_weight_batch(uint8_t* out, size_t out_len, uint16_t seq, const weight_data_t* samples,
+                                      uint8_t count, uint16_t interval_ms, uint8_t* packed);
+
+// cek version, crc dan isi header; payload menunjuk ke dalam `frame`
+comm_decode_result_t comm_codec_parse(const uint8_t* frame, size_t len, comm_frame_header_t* header);
+
+comm_decode_result_t comm_codec_decode_weight(const comm_frame_header_t* header, weight_data_t* weight);
+
+comm_decode_result_t comm_codec_decode_cmd(const comm_frame_header_t* header, comm_send_data_t* cmd);
+
+comm_decode_result_t comm_codec_decode_ack(const comm_frame_header_t* header, uint16_t* acked_seq,
+                                           comm_ack_status_t* status);
+
+comm_decode_result_t comm_codec_decode_probe(const comm_frame_header_t* header, uint32_t* stamp);
+
+comm_decode_result_t comm_codec_batch_begin(const comm_frame_header_t* header, comm_batch_reader_t* reader);
+
+// return false jika sample habis atau delta rusak
+bool comm_codec_batch_next(comm_batch_reader_t* reader, weight_data_t* weight);
+
+// frame lama (memcpy weight_data_t mentah) dari Device A yang belum di-update
+bool comm_codec_is_legacy_weight(const uint8_t* frame, size_t len);
+
+const char* comm_codec_result_name(comm_decode_result_t result);
+
+void comm_seq_tracker_reset(comm_seq_tracker_t* tracker);
+
+// return false jika frame duplikat / terlambat dan sebaiknya dibuang
+bool comm_seq_tracker_update(comm_seq_tracker_t* tracker, uint16_t seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_CODEC_H
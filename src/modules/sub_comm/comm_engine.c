@@ -0,0 +1,471 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_engine.h"
+#include "comm_codec.h"
+
+#include <string.h>
+
+// forward declaration
+static bool send_cmd_frame(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx);
+static bool send_frame(comm_engine_t* engine, uint8_t peer, const uint8_t* frame, size_t frame_len,
+                       int64_t enqueue_us, bool first_attempt, const input_trace_t* trace);
+static void send_probe(comm_engine_t* engine, comm_frame_type_t type, uint8_t peer, uint32_t stamp);
+static void submit_backlog(comm_engine_t* engine, int64_t now_us);
+static int64_t poll_link_probe(comm_engine_t* engine, int64_t now_us, int64_t deadline_us);
+static int64_t poll_pairing(comm_engine_t* engine, int64_t now_us, int64_t deadline_us);
+static void push_rx_item(comm_engine_t* engine, const comm_rx_item_t* item);
+static void record_link_rx(comm_engine_t* engine, uint8_t peer, int8_t rssi);
+static void record_link_gap(comm_engine_t* engine, uint8_t peer, uint32_t frames_lost);
+static void post_ctrl(comm_engine_t* engine, const comm_engine_ctrl_t* ctrl);
+static void notify_rx(comm_engine_t* engine);
+static void count_decode_error(comm_engine_t* engine, comm_decode_result_t result);
+static void link_lock(comm_engine_t* engine);
+static void link_unlock(comm_engine_t* engine);
+
+void comm_engine_init(comm_engine_t* engine, const comm_engine_config_t* config, const comm_transport_t* transport,
+                      const comm_engine_io_t* io) {
+  memset(engine, 0, sizeof(*engine));
+  engine->config = *config;
+  engine->transport = transport;
+  engine->io = *io;
+
+  comm_peer_table_init(&engine->peers);
+  comm_rx_ring_init(&engine->rx_ring, config->rx_policy);
+  for (uint8_t i = 0; i < COMM_PEER_MAX; i++) {
+    comm_link_rx_reset(&engine->link_rx[i]);
+    comm_link_tx_reset(&engine->link_tx[i]);
+  }
+  latency_hist_reset(&engine->tx_stats.enqueue_to_air);
+  comm_reliable_init(&engine->reliable, &config->reliable, send_cmd_frame, engine);
+}
+
+bool comm_engine_add_peer(comm_engine_t* engine, const uint8_t* mac, uint8_t* peer) {
+  // hanya dari satu task: peer table hanya boleh ditambah satu writer
+  uint8_t index = comm_peer_table_find(&engine->peers, mac);
+  if (index == COMM_PEER_NONE) {
+    index = comm_peer_table_add(&engine->peers, mac);
+    if (index == COMM_PEER_NONE) return false;
+    if (!comm_transport_add_peer(engine->transport, mac)) return false;
+  }
+
+  if (peer != NULL) *peer = index;
+  return true;
+}
+
+// --- konteks radio (jangan block dan jangan log per frame) ---
+void comm_engine_on_recv(comm_engine_t* engine, const uint8_t* mac, int8_t rssi, const uint8_t* data, int len) {
+  uint8_t peer = comm_peer_table_find(&engine->peers, mac);
+  if (peer == COMM_PEER_NONE) {
+    // bukan node yang terdaftar; saat pairing, frame yang lolos CRC dari node kita jadi kandidat
+    engine->rx_stats.unknown_peer++;
+    comm_frame_header_t pair_header;
+    if (engine->pairing_open && comm_codec_parse(data, len, &pair_header) == COMM_DECODE_OK) {
+      comm_engine_ctrl_t pair = { .type = COMM_ENGINE_CTRL_PAIR };
+      memcpy(pair.mac, mac, COMM_PEER_MAC_LEN);
+      engine->io.post_ctrl(engine->io.ctx, &pair);
+    }
+    return;
+  }
+  comm_peer_t* sender = &engine->peers.peers[peer];
+  uint32_t lost_before = sender->seq.lost;
+
+  comm_rx_item_t item = { .rx_us = engine->io.now_us(engine->io.ctx), .seq = 0, .peer = peer };
+  int64_t frame_us = item.rx_us;
+
+  if (comm_codec_is_legacy_weight(data, len)) {
+    // Device A masih firmware lama (struct mentah)
+    memcpy(&item.weight, data, sizeof(weight_data_t));
+    record_link_rx(engine, peer, rssi);
+    engine->rx_stats.legacy++;
+    push_rx_item(engine, &item);
+    notify_rx(engine);
+    return;
+  }
+
+  comm_frame_header_t header;
+  comm_decode_result_t result = comm_codec_parse(data, len, &header);
+  if (result != COMM_DECODE_OK) {
+    count_decode_error(engine, result);
+    return;
+  }
+  // frame lolos CRC: RSSI dan jarak antar frame tetap dihitung walau frame duplikat
+  record_link_rx(engine, peer, rssi);
+
+  switch (header.type) {
+    case COMM_FRAME_WEIGHT:
+      result = comm_codec_decode_weight(&header, &item.weight);
+      if (result != COMM_DECODE_OK) {
+        count_decode_error(engine, result);
+        return;
+      }
+      // duplikat atau frame terlambat
+      if (!comm_seq_tracker_update(&sender->seq, header.seq)) return;
+      record_link_gap(engine, peer, sender->seq.lost - lost_before);
+      item.seq = header.seq;
+      push_rx_item(engine, &item);
+      break;
+
+    case COMM_FRAME_WEIGHT_BATCH: {
+      comm_batch_reader_t reader;
+      result = comm_codec_batch_begin(&header, &reader);
+      if (result != COMM_DECODE_OK) {
+        count_decode_error(engine, result);
+        return;
+      }
+      if (!comm_seq_tracker_update(&sender->seq, header.seq)) return;
+      record_link_gap(engine, peer, sender->seq.lost - lost_before);
+      item.seq = header.seq;
+      // unpack berurutan ke ring, sample paling lama duluan; sample terakhir = waktu frame diterima
+      while (comm_codec_batch_next(&reader, &item.weight)) {
+        item.rx_us = frame_us - (int64_t) (reader.count - reader.index) * reader.interval_ms * 1000;
+        push_rx_item(engine, &item);
+      }
+      engine->rx_stats.batches++;
+      if (reader.index < reader.count) engine->rx_stats.malformed++;
+      break;
+    }
+
+    case COMM_FRAME_ACK: {
+      comm_engine_ctrl_t ack = { .type = COMM_ENGINE_CTRL_ACK, .peer = peer };
+      comm_ack_status_t status;
+      if (comm_codec_decode_ack(&header, &ack.seq, &status) != COMM_DECODE_OK) {
+        engine->rx_stats.malformed++;
+        return;
+      }
+      // REJECTED tetap berarti command sampai, jadi tidak perlu dikirim ulang
+      post_ctrl(engine, &ack);
+      return;
+    }
+
+    case COMM_FRAME_PING:
+    case COMM_FRAME_PONG: {
+      // PONG dikirim dari task supaya urutan send callback tetap satu sumber
+      comm_engine_ctrl_t probe = {
+        .type = header.type == COMM_FRAME_PING ? COMM_ENGINE_CTRL_PING : COMM_ENGINE_CTRL_PONG,
+        .peer = peer,
+        .rx_us = frame_us,
+      };
+      if (comm_codec_decode_probe(&header, &probe.stamp) != COMM_DECODE_OK) {
+        engine->rx_stats.malformed++;
+        return;
+      }
+      // tracker sendiri: PING duplikat tidak dijawab dua kali, dan tidak mengganggu hitungan frame data
+      if (!comm_seq_tracker_update(&sender->probe_seq, header.seq)) return;
+      post_ctrl(engine, &probe);
+      return;
+    }
+
+    default:
+      engine->rx_stats.malformed++;
+      return;
+  }
+
+  notify_rx(engine);
+}
+
+void comm_engine_on_send(comm_engine_t* engine, const uint8_t* mac, bool success) {
+  comm_engine_send_done_t done = {
+    .done_us = engine->io.now_us(engine->io.ctx),
+    .id = engine->air_done_id++,
+    .peer = comm_peer_table_find(&engine->peers, mac),
+    .success = success,
+  };
+  // id di atas tetap naik walau dibuang supaya fifo tidak bergeser
+  if (!engine->io.post_send_done(engine->io.ctx, &done)) {
+    engine->send_done_dropped++;
+  }
+}
+
+// --- task ---
+comm_engine_submit_t comm_engine_submit(comm_engine_t* engine, const comm_send_data_t* cmd, int64_t now_us) {
+  comm_engine_submit_t result = COMM_ENGINE_SENT;
+
+  // langsung dikirim; kalau window penuh simpan di backlog sampai ada ACK
+  if (engine->backlog_count == 0 && comm_reliable_has_room(&engine->reliable)) {
+    if (comm_reliable_submit(&engine->reliable, cmd, now_us) == COMM_RELIABLE_COALESCED) {
+      result = COMM_ENGINE_COALESCED;
+    }
+  } else if (engine->backlog_count == COMM_ENGINE_BACKLOG_LEN) {
+    engine->tx_stats.backlog_dropped++;
+    result = COMM_ENGINE_DROPPED;
+  } else {
+    engine->backlog[(engine->backlog_head + engine->backlog_count) % COMM_ENGINE_BACKLOG_LEN] = *cmd;
+    engine->backlog_count++;
+    result = COMM_ENGINE_BACKLOGGED;
+  }
+
+  return result;
+}
+
+void comm_engine_handle_ctrl(comm_engine_t* engine, const comm_engine_ctrl_t* ctrl, int64_t now_us) {
+  switch (ctrl->type) {
+    case COMM_ENGINE_CTRL_ACK:
+      comm_reliable_on_ack(&engine->reliable, ctrl->peer, ctrl->seq, now_us);
+      submit_backlog(engine, now_us);
+      break;
+
+    case COMM_ENGINE_CTRL_PING:
+      send_probe(engine, COMM_FRAME_PONG, ctrl->peer, ctrl->stamp);
+      break;
+
+    case COMM_ENGINE_CTRL_PONG: {
+      // timestamp u32 us, wrap ~71 menit: selisih unsigned tetap benar
+      uint32_t rtt_us = (uint32_t) ctrl->rx_us - ctrl->stamp;
+      link_lock(engine);
+      comm_link_tx_record_pong(&engine->link_tx[ctrl->peer], rtt_us);
+      link_unlock(engine);
+      break;
+    }
+
+    case COMM_ENGINE_CTRL_PAIR_OPEN: {
+      uint32_t max_ms = engine->config.pairing_max_ms;
+      uint32_t window_ms = ctrl->stamp < max_ms ? ctrl->stamp : max_ms;
+      engine->pairing_until_us = now_us + (int64_t) window_ms * 1000;
+      engine->pairing_open = true;
+      break;
+    }
+
+    case COMM_ENGINE_CTRL_PAIR: {
+      // konteks radio bisa sudah mengirim beberapa frame dari MAC yang sama sebelum jendela ditutup
+      if (!engine->pairing_open) break;
+      uint8_t index = COMM_PEER_NONE;
+      if (comm_engine_add_peer(engine, ctrl->mac, &index)) {
+        engine->pairing_open = false;
+        notify_rx(engine);
+      }
+      if (engine->io.paired != NULL) engine->io.paired(engine->io.ctx, ctrl->mac, index);
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void comm_engine_handle_send_done(comm_engine_t* engine, const comm_engine_send_done_t* done) {
+  comm_tx_stats_t* tx_stats = &engine->tx_stats;
+  if (done->success) {
+    tx_stats->send_ok++;
+  } else {
+    tx_stats->send_fail++;
+  }
+
+  if (done->peer < COMM_PEER_MAX) {
+    link_lock(engine);
+    comm_link_tx_record_send(&engine->link_tx[done->peer], done->success);
+    link_unlock(engine);
+  }
+
+  // buang entry yang callback-nya hilang; entry dengan id lebih baru tetap menunggu
+  while (engine->air_count > 0 && (int16_t) (uint16_t) (engine->air_fifo[engine->air_head].id - done->id) < 0) {
+    engine->air_head = (engine->air_head + 1) % COMM_ENGINE_AIR_FIFO_LEN;
+    engine->air_count--;
+    tx_stats->air_unmatched++;
+  }
+  if (engine->air_count == 0 || engine->air_fifo[engine->air_head].id != done->id) {
+    // frame ini tidak sempat masuk fifo
+    tx_stats->air_unmatched++;
+    return;
+  }
+  comm_engine_air_t entry = engine->air_fifo[engine->air_head];
+  engine->air_head = (engine->air_head + 1) % COMM_ENGINE_AIR_FIFO_LEN;
+  engine->air_count--;
+
+  // hanya pengiriman pertama: retransmit sengaja ditunda oleh backoff
+  if (entry.first_attempt && entry.enqueue_us > 0) {
+    int64_t latency_us = done->done_us - entry.enqueue_us;
+    latency_hist_record(&tx_stats->enqueue_to_air, latency_us > 0 ? (uint32_t) latency_us : 0);
+    if (engine->io.traced != NULL) engine->io.traced(engine->io.ctx, &entry.trace, done->done_us);
+  }
+}
+
+int64_t comm_engine_poll(comm_engine_t* engine, int64_t now_us) {
+  // kirim ulang command yang timeout, lalu tidur sampai deadline berikutnya atau ada event
+  uint32_t failed_before = engine->reliable.stats.failed;
+  int64_t deadline_us = comm_reliable_poll(&engine->reliable, now_us);
+  if (engine->reliable.stats.failed != failed_before) {
+    // command gagal membebaskan slot window: backlog dikirim sekarang, bukan menunggu event berikutnya
+    // (bisa tidak pernah datang jika semua command in-flight gagal), deadline dihitung ulang
+    submit_backlog(engine, now_us);
+    deadline_us = comm_reliable_poll(&engine->reliable, now_us);
+  }
+  deadline_us = poll_link_probe(engine, now_us, deadline_us);
+  return poll_pairing(engine, now_us, deadline_us);
+}
+
+void comm_engine_set_link_probe(comm_engine_t* engine, bool enable) {
+  engine->probe_enabled = enable;
+}
+
+uint32_t comm_engine_cmd_settled(const comm_engine_t* engine) {
+  const comm_reliable_stats_t* stats = &engine->reliable.stats;
+  return stats->acked + stats->failed + stats->coalesced + engine->tx_stats.backlog_dropped;
+}
+
+// --- consumer / pembaca statistik ---
+bool comm_engine_receive(comm_engine_t* engine, comm_rx_item_t* item) {
+  return comm_rx_ring_pop(&engine->rx_ring, item);
+}
+
+void comm_engine_get_rx_stats(comm_engine_t* engine, comm_rx_stats_t* stats) {
+  *stats = engine->rx_stats;
+
+  // total dari semua peer
+  for (uint8_t i = 0; i < engine->peers.count; i++) {
+    comm_peer_stats_t peer_stats;
+    comm_peer_table_get_stats(&engine->peers, i, &peer_stats);
+    stats->received += peer_stats.received;
+    stats->lost += peer_stats.lost;
+    stats->duplicated += peer_stats.duplicated;
+    stats->reordered += peer_stats.reordered;
+    stats->restarts += peer_stats.restarts;
+  }
+
+  comm_rx_ring_stats_t ring_stats;
+  comm_rx_ring_get_stats(&engine->rx_ring, &ring_stats);
+  stats->ring_dropped = ring_stats.dropped;
+  stats->ring_overwritten = ring_stats.overwritten;
+  stats->ring_high_water = ring_stats.high_water;
+}
+
+void comm_engine_get_tx_stats(const comm_engine_t* engine, comm_tx_stats_t* stats) {
+  *stats = engine->tx_stats;
+  stats->send_done_dropped = engine->send_done_dropped;
+}
+
+bool comm_engine_get_link_stats(comm_engine_t* engine, uint8_t peer, comm_link_stats_t* stats) {
+  if (stats == NULL || peer >= engine->peers.count) return false;
+  comm_link_rx_t rx;
+  comm_link_tx_t tx;
+  link_lock(engine);
+  rx = engine->link_rx[peer];
+  tx = engine->link_tx[peer];
+  link_unlock(engine);
+  comm_link_stats_merge(&rx, &tx, stats);
+  return true;
+}
+
+// --- static function ---
+static bool send_cmd_frame(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx) {
+  comm_engine_t* engine = (comm_engine_t*) ctx;
+  uint8_t frame[COMM_WIRE_CMD_FRAME_LEN];
+  size_t frame_len = comm_codec_encode_cmd(frame, sizeof(frame), cmd_seq, cmd);
+  // mengirim data ke esp32_A
+  return send_frame(engine, cmd->peer, frame, frame_len, cmd->enqueue_us, attempt == 0, &cmd->trace);
+}
+
+static bool send_frame(comm_engine_t* engine, uint8_t peer, const uint8_t* frame, size_t frame_len,
+                       int64_t enqueue_us, bool first_attempt, const input_trace_t* trace) {
+  const uint8_t* mac = comm_peer_table_mac(&engine->peers, peer);
+  if (mac == NULL) {
+    engine->tx_stats.unknown_peer++;
+    return false;
+  }
+  if (!comm_transport_send(engine->transport, mac, frame, frame_len)) return false;
+
+  uint16_t id = engine->air_send_id++;
+  if (engine->air_count < COMM_ENGINE_AIR_FIFO_LEN) {
+    comm_engine_air_t* entry = &engine->air_fifo[(engine->air_head + engine->air_count) % COMM_ENGINE_AIR_FIFO_LEN];
+    entry->id = id;
+    entry->enqueue_us = enqueue_us;
+    entry->first_attempt = first_attempt;
+    entry->trace = trace != NULL ? *trace : (input_trace_t) { 0 };
+    engine->air_count++;
+  }
+  return true;
+}
+
+static void send_probe(comm_engine_t* engine, comm_frame_type_t type, uint8_t peer, uint32_t stamp) {
+  uint8_t frame[COMM_WIRE_PROBE_FRAME_LEN];
+  size_t frame_len = comm_codec_encode_probe(frame, sizeof(frame), type, engine->probe_seq++, stamp);
+  if (!send_frame(engine, peer, frame, frame_len, 0, false, NULL)) return;
+
+  if (type == COMM_FRAME_PING) {
+    link_lock(engine);
+    comm_link_tx_record_ping(&engine->link_tx[peer]);
+    link_unlock(engine);
+  }
+}
+
+static void submit_backlog(comm_engine_t* engine, int64_t now_us) {
+  while (engine->backlog_count > 0 && comm_reliable_has_room(&engine->reliable)) {
+    comm_reliable_submit(&engine->reliable, &engine->backlog[engine->backlog_head], now_us);
+    engine->backlog_head = (engine->backlog_head + 1) % COMM_ENGINE_BACKLOG_LEN;
+    engine->backlog_count--;
+  }
+}
+
+static int64_t poll_link_probe(comm_engine_t* engine, int64_t now_us, int64_t deadline_us) {
+  if (!engine->probe_enabled || engine->peers.count == 0) return deadline_us;
+
+  if (now_us >= engine->next_probe_us) {
+    if (engine->probe_peer >= engine->peers.count) engine->probe_peer = 0;
+    send_probe(engine, COMM_FRAME_PING, engine->probe_peer, (uint32_t) now_us);
+    engine->probe_peer++;
+    engine->next_probe_us = now_us + engine->config.probe_interval_us;
+  }
+  return engine->next_probe_us < deadline_us ? engine->next_probe_us : deadline_us;
+}
+
+static int64_t poll_pairing(comm_engine_t* engine, int64_t now_us, int64_t deadline_us) {
+  if (!engine->pairing_open) return deadline_us;
+  if (now_us >= engine->pairing_until_us) {
+    engine->pairing_open = false;
+    return deadline_us;
+  }
+  return engine->pairing_until_us < deadline_us ? engine->pairing_until_us : deadline_us;
+}
+
+static void push_rx_item(comm_engine_t* engine, const comm_rx_item_t* item) {
+  comm_rx_ring_push(&engine->rx_ring, item);
+  comm_peer_table_store_latest(&engine->peers, item->peer, &item->weight, engine->io.now_us(engine->io.ctx));
+  engine->rx_stats.samples++;
+}
+
+static void record_link_rx(comm_engine_t* engine, uint8_t peer, int8_t rssi) {
+  int64_t now_us = engine->io.now_us(engine->io.ctx);
+  link_lock(engine);
+  comm_link_rx_record(&engine->link_rx[peer], rssi, now_us);
+  link_unlock(engine);
+}
+
+static void record_link_gap(comm_engine_t* engine, uint8_t peer, uint32_t frames_lost) {
+  if (frames_lost == 0) return;
+  link_lock(engine);
+  comm_link_rx_record_gap(&engine->link_rx[peer], frames_lost);
+  link_unlock(engine);
+}
+
+static void post_ctrl(comm_engine_t* engine, const comm_engine_ctrl_t* ctrl) {
+  if (!engine->io.post_ctrl(engine->io.ctx, ctrl)) {
+    engine->rx_stats.ack_dropped++;
+  }
+}
+
+static void notify_rx(comm_engine_t* engine) {
+  if (engine->io.notify_rx != NULL) engine->io.notify_rx(engine->io.ctx);
+}
+
+static void count_decode_error(comm_engine_t* engine, comm_decode_result_t result) {
+  switch (result) {
+    case COMM_DECODE_BAD_CRC:
+      engine->rx_stats.bad_crc++;
+      break;
+    case COMM_DECODE_BAD_VERSION:
+      engine->rx_stats.bad_version++;
+      break;
+    default:
+      engine->rx_stats.malformed++;
+      break;
+  }
+}
+
+static void link_lock(comm_engine_t* engine) {
+  if (engine->io.link_lock != NULL) engine->io.link_lock(engine->io.ctx);
+}
+
+static void link_unlock(comm_engine_t* engine) {
+  if (engine->io.link_unlock != NULL) engine->io.link_unlock(engine->io.ctx);
+}
@@ -0,0 +1,213 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_ENGINE_H
+#define COMM_ENGINE_H
+
+// Inti comm_task tanpa FreeRTOS: submit command + backlog, ACK, send callback (enqueue -> udara),
+// PING / PONG, pairing, dan jalur receive (decode -> rx ring). comm_task hanya memindahkan event
+// dari queue ke sini dan tidur sampai deadline dari comm_engine_poll(); di host engine yang sama
+// dijalankan di atas comm_transport_loopback dengan jam virtual.
+//
+// Konteks pemanggil:
+// - comm_engine_on_recv / comm_engine_on_send: konteks radio (callback transport), jangan block.
+//   Event yang harus diproses task (ACK, PING, PONG, pairing, send done) diteruskan lewat io.
+// - comm_engine_receive: satu consumer (main_task).
+// - fungsi lain: hanya dari satu task (comm_task).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+#include "utils/latency_hist.h"
+#include "comm_transport.h"
+#include "comm_reliable.h"
+#include "comm_rx_ring.h"
+#include "comm_peer_table.h"
+#include "comm_link_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// command yang menunggu slot kosong di window reliable (= panjang queue main->comm)
+#define COMM_ENGINE_BACKLOG_LEN  10
+// frame yang sudah di transport send tapi belum ada send callback
+#define COMM_ENGINE_AIR_FIFO_LEN 8
+#define COMM_ENGINE_NO_DEADLINE  INT64_MAX
+
+// statistik frame yang diterima dari Device A
+typedef struct {
+  uint32_t received;    // frame valid (sequence number baru)
+  uint32_t samples;     // sample yang masuk ke ring (batch dihitung per sample)
+  uint32_t batches;
+  uint32_t lost;
+  uint32_t duplicated;
+  uint32_t reordered;
+  uint32_t restarts;    // Device A reboot (seq mulai dari awal lagi)
+  uint32_t bad_crc;
+  uint32_t bad_version;
+  uint32_t malformed;
+  uint32_t legacy;
+  uint32_t ack_dropped; // ACK / PING / PONG dibuang karena queue ke comm_task penuh
+  uint32_t unknown_peer; // frame dari MAC yang tidak ada di tabel peer
+  uint32_t ring_dropped;
+  uint32_t ring_overwritten;
+  uint32_t ring_high_water;
+} comm_rx_stats_t;
+
+// statistik pengiriman command
+typedef struct {
+  uint32_t send_ok;         // send callback ESP-NOW sukses (MAC-layer)
+  uint32_t send_fail;
+  uint32_t backlog_dropped; // command dibuang karena window dan backlog penuh
+  uint32_t send_done_dropped; // send callback dibuang karena queue ke comm_task penuh
+  uint32_t air_unmatched;   // send / callback tanpa pasangan, tidak masuk enqueue_to_air
+  uint32_t unknown_peer;    // command / probe ke index peer yang tidak ada
+  latency_hist_t enqueue_to_air; // masuk queue main->comm sampai send callback (pengiriman pertama)
+} comm_tx_stats_t;
+
+typedef enum {
+  COMM_ENGINE_CTRL_ACK,
+  COMM_ENGINE_CTRL_PING,      // Device A minta PONG
+  COMM_ENGINE_CTRL_PONG,
+  COMM_ENGINE_CTRL_WAKE,      // tidak membawa data, hanya membangunkan task
+  COMM_ENGINE_CTRL_PAIR_OPEN, // stamp = lama jendela pairing (ms)
+  COMM_ENGINE_CTRL_PAIR,      // frame valid dari MAC yang belum dikenal selama jendela pairing
+} comm_engine_ctrl_type_t;
+
+typedef struct {
+  uint8_t type;   // comm_engine_ctrl_type_t
+  uint8_t peer;
+  uint16_t seq;   // seq command yang di-ACK
+  uint32_t stamp; // timestamp PING / PONG
+  int64_t rx_us;
+  uint8_t mac[COMM_PEER_MAC_LEN]; // CTRL_PAIR
+} comm_engine_ctrl_t;
+
+typedef struct {
+  int64_t done_us;
+  uint16_t id;  // urutan send callback, termasuk yang dibuang karena queue penuh
+  uint8_t peer; // COMM_PEER_NONE jika MAC tidak dikenal
+  bool success;
+} comm_engine_send_done_t;
+
+typedef enum {
+  COMM_ENGINE_SENT,       // langsung masuk window reliable
+  COMM_ENGINE_COALESCED,  // command yang sama masih in-flight
+  COMM_ENGINE_BACKLOGGED, // menunggu slot window
+  COMM_ENGINE_DROPPED,    // window dan backlog penuh
+} comm_engine_submit_t;
+
+typedef struct {
+  int64_t (*now_us)(void* ctx);
+  // dari konteks radio ke task; return false jika queue penuh (event dihitung sebagai dibuang)
+  bool (*post_ctrl)(void* ctx, const comm_engine_ctrl_t* ctrl);
+  bool (*post_send_done)(void* ctx, const comm_engine_send_done_t* done);
+  // ada sample baru di ring / peer baru; boleh NULL
+  void (*notify_rx)(void* ctx);
+  // statistik link ditulis dua konteks (radio dan task); boleh NULL jika satu thread
+  void (*link_lock)(void* ctx);
+  void (*link_unlock)(void* ctx);
+  // hasil pairing: peer = index baru, COMM_PEER_NONE jika tabel penuh; boleh NULL
+  void (*paired)(void* ctx, const uint8_t* mac, uint8_t peer);
+  // command akibat tombol sampai di udara (pengiriman pertama); boleh NULL
+  void (*traced)(void* ctx, input_trace_t* trace, int64_t air_us);
+  void* ctx;
+} comm_engine_io_t;
+
+typedef struct {
+  comm_reliable_config_t reliable;
+  comm_rx_policy_t rx_policy;
+  uint32_t probe_interval_us; // jarak antar PING saat probe aktif; peer di-ping bergiliran
+  uint32_t pairing_max_ms;    // jendela pairing maksimum
+} comm_engine_config_t;
+
+typedef struct {
+  int64_t enqueue_us;
+  uint16_t id; // urutan send yang berhasil masuk transport
+  bool first_attempt;
+  input_trace_t trace;
+} comm_engine_air_t;
+
+typedef struct {
+  comm_engine_config_t config;
+  const comm_transport_t* transport;
+  comm_engine_io_t io;
+
+  comm_peer_table_t peers;
+  comm_rx_ring_t rx_ring;
+  comm_rx_stats_t rx_stats;     // ditulis konteks radio
+
+  comm_reliable_t reliable;
+  comm_send_data_t backlog[COMM_ENGINE_BACKLOG_LEN];
+  uint8_t backlog_head;
+  uint8_t backlog_count;
+  comm_tx_stats_t tx_stats;
+
+  // urutan send callback sama dengan urutan send (dijamin ESP-NOW dan loopback), jadi send ke-n
+  // dipasangkan dengan callback ke-n lewat id. entry yang tidak masuk (fifo penuh) atau callback
+  // yang dibuang (queue penuh) hanya melewatkan satu id, pasangan berikutnya tetap benar
+  comm_engine_air_t air_fifo[COMM_ENGINE_AIR_FIFO_LEN];
+  uint8_t air_head;
+  uint8_t air_count;
+  uint16_t air_send_id;
+  uint16_t air_done_id;                  // hanya ditulis konteks radio
+  volatile uint32_t send_done_dropped;
+
+  // kualitas link per peer; rx ditulis konteks radio, tx ditulis task
+  comm_link_rx_t link_rx[COMM_PEER_MAX];
+  comm_link_tx_t link_tx[COMM_PEER_MAX];
+  volatile bool probe_enabled;
+  int64_t next_probe_us;
+  uint8_t probe_peer;
+  // ruang seq PING / PONG, terpisah dari seq command (milik comm_reliable, dipakai ulang saat retransmit)
+  uint16_t probe_seq;
+
+  // deadline hanya disentuh task, konteks radio cukup membaca flag
+  volatile bool pairing_open;
+  int64_t pairing_until_us;
+} comm_engine_t;
+
+void comm_engine_init(comm_engine_t* engine, const comm_engine_config_t* config, const comm_transport_t* transport,
+                      const comm_engine_io_t* io);
+
+// tambah peer ke tabel dan transport (tanpa pairing); return false jika tabel penuh / transport menolak
+bool comm_engine_add_peer(comm_engine_t* engine, const uint8_t* mac, uint8_t* peer);
+
+// --- konteks radio ---
+void comm_engine_on_recv(comm_engine_t* engine, const uint8_t* mac, int8_t rssi, const uint8_t* data, int len);
+
+void comm_engine_on_send(comm_engine_t* engine, const uint8_t* mac, bool success);
+
+// --- task ---
+comm_engine_submit_t comm_engine_submit(comm_engine_t* engine, const comm_send_data_t* cmd, int64_t now_us);
+
+void comm_engine_handle_ctrl(comm_engine_t* engine, const comm_engine_ctrl_t* ctrl, int64_t now_us);
+
+void comm_engine_handle_send_done(comm_engine_t* engine, const comm_engine_send_done_t* done);
+
+// retransmit, command gagal -> backlog, PING, tutup jendela pairing;
+// return deadline berikutnya (COMM_ENGINE_NO_DEADLINE = tunggu event)
+int64_t comm_engine_poll(comm_engine_t* engine, int64_t now_us);
+
+void comm_engine_set_link_probe(comm_engine_t* engine, bool enable);
+
+// command yang sudah selesai: di-ACK, gagal setelah retry, digabung, atau dibuang karena backlog penuh
+uint32_t comm_engine_cmd_settled(const comm_engine_t* engine);
+
+// --- consumer / pembaca statistik ---
+bool comm_engine_receive(comm_engine_t* engine, comm_rx_item_t* item);
+
+void comm_engine_get_rx_stats(comm_engine_t* engine, comm_rx_stats_t* stats);
+
+// salinan tx_stats termasuk send callback yang dibuang konteks radio
+void comm_engine_get_tx_stats(const comm_engine_t* engine, comm_tx_stats_t* stats);
+
+bool comm_engine_get_link_stats(comm_engine_t* engine, uint8_t peer, comm_link_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_ENGINE_H
@@ -0,0 +1,104 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_link_stats.h"
+
+#include <string.h>
+
+// bobot EWMA RSSI = 1/8
+#define RSSI_EWMA_SHIFT 3
+
+static uint8_t popcount32(uint32_t v) {
+  uint8_t n = 0;
+  while (v) {
+    v &= v - 1;
+    n++;
+  }
+  return n;
+}
+
+void comm_link_rx_reset(comm_link_rx_t* rx) {
+  memset(rx, 0, sizeof(*rx));
+  rx->rssi_last = COMM_LINK_RSSI_NONE;
+  rx->rssi_min = INT8_MAX;
+  rx->rssi_max = COMM_LINK_RSSI_NONE;
+}
+
+void comm_link_tx_reset(comm_link_tx_t* tx) {
+  memset(tx, 0, sizeof(*tx));
+  latency_hist_reset(&tx->rtt);
+}
+
+void comm_link_rx_record(comm_link_rx_t* rx, int8_t rssi, int64_t now_us) {
+  if (rssi != COMM_LINK_RSSI_NONE) {
+    if (rx->rssi_last == COMM_LINK_RSSI_NONE) {
+      rx->rssi_avg_x16 = rssi * 16;
+    } else {
+      rx->rssi_avg_x16 += ((rssi * 16) - rx->rssi_avg_x16) >> RSSI_EWMA_SHIFT;
+    }
+    rx->rssi_last = rssi;
+    if (rssi < rx->rssi_min) rx->rssi_min = rssi;
+    if (rssi > rx->rssi_max) rx->rssi_max = rssi;
+  }
+
+  if (rx->frames > 0) {
+    int64_t interval = now_us - rx->last_rx_us;
+    if (interval > 0 && interval > rx->interval_max_us) {
+      rx->interval_max_us = interval > UINT32_MAX ? UINT32_MAX : (uint32_t) interval;
+    }
+  }
+  rx->last_rx_us = now_us;
+  rx->frames++;
+}
+
+void comm_link_rx_record_gap(comm_link_rx_t* rx, uint32_t frames_lost) {
+  if (frames_lost == 0) return;
+  rx->gap_events++;
+  if (frames_lost > rx->gap_max) rx->gap_max = frames_lost;
+}
+
+void comm_link_tx_record_send(comm_link_tx_t* tx, bool success) {
+  if (success) {
+    tx->send_ok++;
+  } else {
+    tx->send_fail++;
+  }
+  tx->history = (tx->history << 1) | (success ? 1u : 0u);
+  if (tx->history_len < COMM_LINK_PDR_WINDOW) tx->history_len++;
+}
+
+void comm_link_tx_record_ping(comm_link_tx_t* tx) {
+  tx->pings++;
+}
+
+void comm_link_tx_record_pong(comm_link_tx_t* tx, uint32_t rtt_us) {
+  tx->pongs++;
+  latency_hist_record(&tx->rtt, rtt_us);
+}
+
+void comm_link_stats_merge(const comm_link_rx_t* rx, const comm_link_tx_t* tx, comm_link_stats_t* stats) {
+  memset(stats, 0, sizeof(*stats));
+
+  stats->send_ok = tx->send_ok;
+  stats->send_fail = tx->send_fail;
+  if (tx->history_len > 0) {
+    uint32_t mask = tx->history_len >= 32 ? UINT32_MAX : ((1u << tx->history_len) - 1);
+    stats->pdr_permille = (uint16_t) (popcount32(tx->history & mask) * 1000u / tx->history_len);
+  }
+  stats->pings = tx->pings;
+  stats->pongs = tx->pongs;
+  stats->rtt_p50_us = latency_hist_percentile(&tx->rtt, 50);
+  stats->rtt_p90_us = latency_hist_percentile(&tx->rtt, 90);
+  stats->rtt_p99_us = latency_hist_percentile(&tx->rtt, 99);
+  stats->rtt_max_us = tx->rtt.max_us;
+
+  stats->rssi_last = rx->rssi_last;
+  stats->rssi_avg = rx->rssi_last == COMM_LINK_RSSI_NONE ? COMM_LINK_RSSI_NONE : (int8_t) (rx->rssi_avg_x16 / 16);
+  stats->rssi_min = rx->rssi_last == COMM_LINK_RSSI_NONE ? COMM_LINK_RSSI_NONE : rx->rssi_min;
+  stats->rssi_max = rx->rssi_max;
+  stats->rx_frames = rx->frames;
+  stats->gap_events = rx->gap_events;
+  stats->gap_max = rx->gap_max;
+  stats->interval_max_us = rx->interval_max_us;
+}
@@ -0,0 +1,89 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_LINK_STATS_H
+#define COMM_LINK_STATS_H
+
+// Statistik kualitas link per peer: status kirim, packet delivery ratio (rolling),
+// RSSI, celah frame yang diterima, dan RTT ping/pong.
+// Sisi rx ditulis callback receive, sisi tx ditulis comm_task: masing-masing satu writer.
+// Waktu diberikan dari luar supaya bisa dites di host dengan radio simulasi.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/latency_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMM_LINK_PDR_WINDOW 32 // jumlah pengiriman terakhir untuk PDR
+#define COMM_LINK_RSSI_NONE  INT8_MIN
+
+typedef struct {
+  uint32_t frames;
+  int8_t   rssi_last;
+  int8_t   rssi_min;
+  int8_t   rssi_max;
+  int32_t  rssi_avg_x16; // EWMA, fixed-point x16
+  uint32_t gap_events;   // berapa kali ada frame yang hilang
+  uint32_t gap_max;      // frame hilang terbanyak berturut-turut
+  int64_t  last_rx_us;
+  uint32_t interval_max_us; // jarak terlama antar frame
+} comm_link_rx_t;
+
+typedef struct {
+  uint32_t send_ok;
+  uint32_t send_fail;
+  uint32_t history;      // bit 0 = pengiriman terakhir, 1 = sukses
+  uint8_t  history_len;
+  uint32_t pings;
+  uint32_t pongs;
+  latency_hist_t rtt;
+} comm_link_tx_t;
+
+// gabungan untuk dibaca API / layar diagnostik
+typedef struct {
+  uint32_t send_ok;
+  uint32_t send_fail;
+  uint16_t pdr_permille;  // 0..1000 dari COMM_LINK_PDR_WINDOW pengiriman terakhir
+  int8_t   rssi_last;     // COMM_LINK_RSSI_NONE jika belum ada
+  int8_t   rssi_avg;
+  int8_t   rssi_min;
+  int8_t   rssi_max;
+  uint32_t rx_frames;
+  uint32_t gap_events;
+  uint32_t gap_max;
+  uint32_t interval_max_us;
+  uint32_t pings;
+  uint32_t pongs;
+  uint32_t rtt_p50_us;
+  uint32_t rtt_p90_us;
+  uint32_t rtt_p99_us;
+  uint32_t rtt_max_us;
+} comm_link_stats_t;
+
+void comm_link_rx_reset(comm_link_rx_t* rx);
+
+void comm_link_tx_reset(comm_link_tx_t* tx);
+
+// rssi = COMM_LINK_RSSI_NONE jika radio tidak memberi RSSI
+void comm_link_rx_record(comm_link_rx_t* rx, int8_t rssi, int64_t now_us);
+
+// frames_lost = selisih counter lost dari seq tracker setelah satu frame
+void comm_link_rx_record_gap(comm_link_rx_t* rx, uint32_t frames_lost);
+
+void comm_link_tx_record_send(comm_link_tx_t* tx, bool success);
+
+void comm_link_tx_record_ping(comm_link_tx_t* tx);
+
+void comm_link_tx_record_pong(comm_link_tx_t* tx, uint32_t rtt_us);
+
+void comm_link_stats_merge(const comm_link_rx_t* rx, const comm_link_tx_t* tx, comm_link_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_LINK_STATS_H
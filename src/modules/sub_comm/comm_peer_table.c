@@ -0,0 +1,121 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_peer_table.h"
+
+#include <string.h>
+
+#define HASH_MASK (COMM_PEER_HASH_SIZE - 1)
+
+_Static_assert((COMM_PEER_HASH_SIZE & HASH_MASK) == 0, "COMM_PEER_HASH_SIZE must be a power of two");
+_Static_assert(COMM_PEER_HASH_SIZE > COMM_PEER_MAX, "hash must be larger than the peer table");
+_Static_assert(COMM_PEER_MAX < COMM_PEER_NONE, "peer index must fit in uint8_t");
+
+static uint32_t mac_hash(const uint8_t* mac) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (uint8_t i = 0; i < COMM_PEER_MAC_LEN; i++) {
+    hash ^= mac[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// return posisi slot hash untuk mac (terisi mac tsb, atau slot kosong pertama);
+// jumlah slot yang dibaca ditulis ke `slots` jika tidak NULL
+static uint32_t probe(const comm_peer_table_t* table, const uint8_t* mac, uint8_t* slots) {
+  uint32_t pos = mac_hash(mac) & HASH_MASK;
+  uint8_t count = 1;
+  while (table->index[pos] != COMM_PEER_NONE) {
+    if (memcmp(table->peers[table->index[pos]].mac, mac, COMM_PEER_MAC_LEN) == 0) break;
+    pos = (pos + 1) & HASH_MASK;
+    count++;
+  }
+  if (slots != NULL) *slots = count;
+  return pos;
+}
+
+void comm_peer_table_init(comm_peer_table_t* table) {
+  memset(table, 0, sizeof(*table));
+  memset(table->index, COMM_PEER_NONE, sizeof(table->index));
+  for (uint8_t i = 0; i < COMM_PEER_MAX; i++) {
+    comm_seq_tracker_reset(&table->peers[i].seq);
+    comm_seq_tracker_reset(&table->peers[i].probe_seq);
+    atomic_init(&table->peers[i].latest_seq, 0);
+  }
+}
+
+uint8_t comm_peer_table_add(comm_peer_table_t* table, const uint8_t* mac) {
+  uint32_t pos = probe(table, mac, NULL);
+  if (table->index[pos] != COMM_PEER_NONE) return table->index[pos];
+  if (table->count >= COMM_PEER_MAX) return COMM_PEER_NONE;
+
+  uint8_t peer = table->count;
+  memcpy(table->peers[peer].mac, mac, COMM_PEER_MAC_LEN);
+  // MAC harus sudah lengkap sebelum peer dianggap ada
+  atomic_thread_fence(memory_order_release);
+  table->count++;
+  // count dulu, baru index: callback receive yang menemukan peer lewat find() selalu lolos
+  // cek `peer < count` di store_latest / load_latest / mac
+  atomic_thread_fence(memory_order_release);
+  table->index[pos] = peer;
+  return peer;
+}
+
+uint8_t comm_peer_table_find(const comm_peer_table_t* table, const uint8_t* mac) {
+  return table->index[probe(table, mac, NULL)];
+}
+
+uint8_t comm_peer_table_probe_len(const comm_peer_table_t* table, const uint8_t* mac) {
+  uint8_t slots;
+  probe(table, mac, &slots);
+  return slots;
+}
+
+const uint8_t* comm_peer_table_mac(const comm_peer_table_t* table, uint8_t peer) {
+  if (peer >= table->count) return NULL;
+  return table->peers[peer].mac;
+}
+
+void comm_peer_table_store_latest(comm_peer_table_t* table, uint8_t peer, const weight_data_t* weight, int64_t now_us) {
+  if (peer >= table->count) return;
+  comm_peer_t* p = &table->peers[peer];
+
+  unsigned seq = atomic_load_explicit(&p->latest_seq, memory_order_relaxed);
+  atomic_store_explicit(&p->latest_seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  p->latest = *weight;
+  p->samples++;
+  p->last_rx_us = now_us;
+  atomic_store_explicit(&p->latest_seq, seq + 2, memory_order_release);
+}
+
+bool comm_peer_table_load_latest(comm_peer_table_t* table, uint8_t peer, weight_data_t* weight) {
+  if (peer >= table->count) return false;
+  comm_peer_t* p = &table->peers[peer];
+
+  unsigned before, after;
+  do {
+    before = atomic_load_explicit(&p->latest_seq, memory_order_acquire);
+    if (before == 0) return false;
+    *weight = p->latest;
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&p->latest_seq, memory_order_relaxed);
+  } while ((before & 1) || before != after);
+  return true;
+}
+
+void comm_peer_table_get_stats(const comm_peer_table_t* table, uint8_t peer, comm_peer_stats_t* stats) {
+  memset(stats, 0, sizeof(*stats));
+  if (peer >= table->count) return;
+  const comm_peer_t* p = &table->peers[peer];
+  stats->received = p->seq.received;
+  stats->lost = p->seq.lost;
+  stats->duplicated = p->seq.duplicated;
+  stats->reordered = p->seq.reordered;
+  stats->restarts = p->seq.restarts;
+  stats->probe_lost = p->probe_seq.lost;
+  stats->samples = p->samples;
+  stats->last_rx_us = p->last_rx_us;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_PEER_TABLE_H
+#define COMM_PEER_TABLE_H
+
+// Tabel peer (Device A / node load cell) untuk satu Device B.
+// Lookup MAC -> index O(1) lewat hash open-addressing; index peer stabil selama runtime
+// (peer tidak pernah dihapus), jadi aman dipakai di ring / command.
+// Tanpa header ESP-IDF supaya bisa dites di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <data_type.h>
+#include "comm_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMM_PEER_MAC_LEN   6
+// ESP_NOW_MAX_TOTAL_PEER_NUM; peer terenkripsi dibatasi CONFIG_ESP_WIFI_ESPNOW_MAX_ENCRYPT_NUM (7)
+#define COMM_PEER_MAX       20
+#define COMM_PEER_HASH_SIZE 64 // pangkat 2, > 2x COMM_PEER_MAX supaya probe tetap pendek
+#define COMM_PEER_NONE      0xFF
+
+typedef struct {
+  uint32_t received;
+  uint32_t lost;
+  uint32_t duplicated;
+  uint32_t reordered;
+  uint32_t restarts;
+  uint32_t probe_lost;
+  uint32_t samples;
+  int64_t  last_rx_us;
+} comm_peer_stats_t;
+
+typedef struct {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  comm_seq_tracker_t seq;       // frame data (WEIGHT / WEIGHT_BATCH)
+  comm_seq_tracker_t probe_seq; // PING / PONG, ruang seq sendiri
+  uint32_t samples;
+  int64_t  last_rx_us;
+  // slot sample terakhir (seqlock: ganjil = sedang ditulis)
+  atomic_uint latest_seq;
+  weight_data_t latest;
+} comm_peer_t;
+
+typedef struct {
+  comm_peer_t peers[COMM_PEER_MAX];
+  uint8_t count;
+  uint8_t index[COMM_PEER_HASH_SIZE]; // COMM_PEER_NONE = kosong
+} comm_peer_table_t;
+
+void comm_peer_table_init(comm_peer_table_t* table);
+
+// return index peer (yang baru atau yang sudah ada), COMM_PEER_NONE jika tabel penuh.
+// hanya dari satu task; find() dari task lain tetap aman karena peer hanya ditambah
+uint8_t comm_peer_table_add(comm_peer_table_t* table, const uint8_t* mac);
+
+// return COMM_PEER_NONE jika MAC tidak dikenal
+uint8_t comm_peer_table_find(const comm_peer_table_t* table, const uint8_t* mac);
+
+// jumlah slot hash yang dibaca find() untuk mac ini (1 = langsung ketemu / langsung kosong)
+uint8_t comm_peer_table_probe_len(const comm_peer_table_t* table, const uint8_t* mac);
+
+const uint8_t* comm_peer_table_mac(const comm_peer_table_t* table, uint8_t peer);
+
+// dipanggil dari satu writer (callback receive)
+void comm_peer_table_store_latest(comm_peer_table_t* table, uint8_t peer, const weight_data_t* weight, int64_t now_us);
+
+// return false jika peer belum pernah mengirim sample
+bool comm_peer_table_load_latest(comm_peer_table_t* table, uint8_t peer, weight_data_t* weight);
+
+void comm_peer_table_get_stats(const comm_peer_table_t* table, uint8_t peer, comm_peer_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_PEER_TABLE_H
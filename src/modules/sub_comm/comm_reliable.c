@@ -0,0 +1,108 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_reliable.h"
+
+#include <string.h>
+
+static void transmit(comm_reliable_t* rel, comm_reliable_slot_t* slot, int64_t now_us) {
+  // hasil send diabaikan: kalau gagal, frame dikirim ulang saat deadline lewat
+  rel->send(slot->seq, slot->retries, &slot->cmd, rel->send_ctx);
+  slot->deadline_us = now_us + slot->timeout_us;
+}
+
+static uint8_t count_in_flight(const comm_reliable_t* rel) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    if (rel->slots[i].used) n++;
+  }
+  return n;
+}
+
+void comm_reliable_init(comm_reliable_t* rel, const comm_reliable_config_t* config,
+                        comm_reliable_send_fn send, void* send_ctx) {
+  memset(rel, 0, sizeof(*rel));
+  rel->config = *config;
+  rel->send = send;
+  rel->send_ctx = send_ctx;
+  latency_hist_reset(&rel->stats.rtt);
+}
+
+bool comm_reliable_has_room(const comm_reliable_t* rel) {
+  return count_in_flight(rel) < COMM_RELIABLE_WINDOW;
+}
+
+comm_reliable_submit_t comm_reliable_submit(comm_reliable_t* rel, const comm_send_data_t* cmd, int64_t now_us) {
+  comm_reliable_slot_t* free_slot = NULL;
+
+  for (uint8_t i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    comm_reliable_slot_t* slot = &rel->slots[i];
+    if (!slot->used) {
+      if (free_slot == NULL) free_slot = slot;
+      continue;
+    }
+    // tombol tare ditekan berkali-kali selagi tare pertama belum di-ACK
+    if (slot->cmd.command == cmd->command && slot->cmd.value == cmd->value && slot->cmd.peer == cmd->peer) {
+      rel->stats.coalesced++;
+      return COMM_RELIABLE_COALESCED;
+    }
+  }
+
+  if (free_slot == NULL) return COMM_RELIABLE_WINDOW_FULL;
+
+  free_slot->used = true;
+  free_slot->seq = rel->next_seq++;
+  free_slot->retries = 0;
+  free_slot->cmd = *cmd;
+  free_slot->first_send_us = now_us;
+  free_slot->timeout_us = rel->config.initial_timeout_us;
+  rel->stats.submitted++;
+  rel->stats.in_flight = count_in_flight(rel);
+
+  transmit(rel, free_slot, now_us);
+  return COMM_RELIABLE_SUBMITTED;
+}
+
+bool comm_reliable_on_ack(comm_reliable_t* rel, uint8_t peer, uint16_t seq, int64_t now_us) {
+  for (uint8_t i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    comm_reliable_slot_t* slot = &rel->slots[i];
+    if (slot->used && slot->seq == seq && slot->cmd.peer == peer) {
+      int64_t rtt = now_us - slot->first_send_us;
+      latency_hist_record(&rel->stats.rtt, rtt > 0 ? (uint32_t) rtt : 0);
+      slot->used = false;
+      rel->stats.acked++;
+      rel->stats.in_flight = count_in_flight(rel);
+      return true;
+    }
+  }
+  rel->stats.duplicate_acks++;
+  return false;
+}
+
+int64_t comm_reliable_poll(comm_reliable_t* rel, int64_t now_us) {
+  int64_t next_deadline = INT64_MAX;
+
+  for (uint8_t i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    comm_reliable_slot_t* slot = &rel->slots[i];
+    if (!slot->used) continue;
+
+    if (now_us >= slot->deadline_us) {
+      if (slot->retries >= rel->config.max_retries) {
+        slot->used = false;
+        rel->stats.failed++;
+        continue;
+      }
+      slot->retries++;
+      slot->timeout_us *= 2;
+      if (slot->timeout_us > rel->config.max_timeout_us) slot->timeout_us = rel->config.max_timeout_us;
+      rel->stats.retransmits++;
+      transmit(rel, slot, now_us);
+    }
+
+    if (slot->deadline_us < next_deadline) next_deadline = slot->deadline_us;
+  }
+
+  rel->stats.in_flight = count_in_flight(rel);
+  return next_deadline;
+}
@@ -0,0 +1,88 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_RELIABLE_H
+#define COMM_RELIABLE_H
+
+// Lapisan command reliable di atas ESP-NOW: setiap command punya sequence ID,
+// dikirim ulang dengan exponential backoff sampai Device A membalas ACK.
+// Retransmit memakai sequence ID yang sama, jadi Device A bisa membuang duplikat
+// (tare tidak dieksekusi dua kali). Waktu diberikan dari luar (now_us) sehingga
+// modul ini bisa dijalankan di host dengan clock virtual.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+#include "utils/latency_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMM_RELIABLE_WINDOW 4 // command in-flight maksimum
+
+// kirim satu frame command; attempt 0 = pengiriman pertama.
+// return false jika gagal masuk ke radio (akan dicoba lagi saat timeout)
+typedef bool (*comm_reliable_send_fn)(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx);
+
+typedef struct {
+  uint32_t initial_timeout_us;
+  uint32_t max_timeout_us;
+  uint8_t  max_retries;
+} comm_reliable_config_t;
+
+typedef enum {
+  COMM_RELIABLE_SUBMITTED,
+  COMM_RELIABLE_COALESCED,   // command yang sama masih in-flight, tidak dikirim lagi
+  COMM_RELIABLE_WINDOW_FULL,
+} comm_reliable_submit_t;
+
+typedef struct {
+  uint32_t submitted;
+  uint32_t coalesced;
+  uint32_t acked;
+  uint32_t retransmits;
+  uint32_t failed;         // retry habis tanpa ACK
+  uint32_t duplicate_acks; // ACK untuk seq yang sudah selesai / tidak dikenal
+  uint8_t  in_flight;
+  latency_hist_t rtt;      // submit -> ACK, termasuk retransmit
+} comm_reliable_stats_t;
+
+typedef struct {
+  bool     used;
+  uint16_t seq;
+  uint8_t  retries;
+  comm_send_data_t cmd;
+  int64_t  first_send_us;
+  int64_t  deadline_us;
+  uint32_t timeout_us;
+} comm_reliable_slot_t;
+
+typedef struct {
+  comm_reliable_config_t config;
+  comm_reliable_send_fn send;
+  void* send_ctx;
+  uint16_t next_seq;
+  comm_reliable_slot_t slots[COMM_RELIABLE_WINDOW];
+  comm_reliable_stats_t stats;
+} comm_reliable_t;
+
+void comm_reliable_init(comm_reliable_t* rel, const comm_reliable_config_t* config,
+                        comm_reliable_send_fn send, void* send_ctx);
+
+bool comm_reliable_has_room(const comm_reliable_t* rel);
+
+comm_reliable_submit_t comm_reliable_submit(comm_reliable_t* rel, const comm_send_data_t* cmd, int64_t now_us);
+
+// return true jika ACK dari `peer` menyelesaikan command yang sedang in-flight
+bool comm_reliable_on_ack(comm_reliable_t* rel, uint8_t peer, uint16_t seq, int64_t now_us);
+
+// kirim ulang command yang timeout; return deadline berikutnya (INT64_MAX jika tidak ada yang in-flight)
+int64_t comm_reliable_poll(comm_reliable_t* rel, int64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_RELIABLE_H
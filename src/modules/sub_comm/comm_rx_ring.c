@@ -0,0 +1,79 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_rx_ring.h"
+
+#include <string.h>
+
+#define RING_MASK (COMM_RX_RING_SIZE - 1)
+
+_Static_assert((COMM_RX_RING_SIZE & RING_MASK) == 0, "COMM_RX_RING_SIZE must be a power of two");
+
+void comm_rx_ring_init(comm_rx_ring_t* ring, comm_rx_policy_t policy) {
+  memset(ring->slots, 0, sizeof(ring->slots));
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+  ring->policy = policy;
+  atomic_init(&ring->pushed, 0);
+  atomic_init(&ring->dropped, 0);
+  atomic_init(&ring->overwritten, 0);
+  atomic_init(&ring->high_water, 0);
+}
+
+bool comm_rx_ring_push(comm_rx_ring_t* ring, const comm_rx_item_t* item) {
+  uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+  if (head - tail >= COMM_RX_RING_SIZE) {
+    if (ring->policy == COMM_RX_DROP_NEWEST) {
+      atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+      return false;
+    }
+    // ambil alih slot paling lama. Kalau CAS gagal berarti consumer baru saja
+    // mengambil slot itu, jadi sudah ada tempat kosong.
+    if (atomic_compare_exchange_strong_explicit(&ring->tail, &tail, tail + 1,
+                                                memory_order_acq_rel, memory_order_acquire)) {
+      atomic_fetch_add_explicit(&ring->overwritten, 1, memory_order_relaxed);
+    }
+  }
+
+  ring->slots[head & RING_MASK] = *item;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  atomic_fetch_add_explicit(&ring->pushed, 1, memory_order_relaxed);
+
+  uint_fast32_t used = head + 1 - atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  if (used > atomic_load_explicit(&ring->high_water, memory_order_relaxed)) {
+    atomic_store_explicit(&ring->high_water, used, memory_order_relaxed);
+  }
+  return true;
+}
+
+bool comm_rx_ring_pop(comm_rx_ring_t* ring, comm_rx_item_t* item) {
+  while (1) {
+    uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (tail == head) return false;
+
+    *item = ring->slots[tail & RING_MASK];
+
+    // CAS gagal = producer menimpa slot ini saat sedang dibaca, ulangi dari tail baru
+    if (atomic_compare_exchange_strong_explicit(&ring->tail, &tail, tail + 1,
+                                                memory_order_acq_rel, memory_order_acquire)) {
+      return true;
+    }
+  }
+}
+
+uint32_t comm_rx_ring_count(comm_rx_ring_t* ring) {
+  uint_fast32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+  uint_fast32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  return (uint32_t) (head - tail);
+}
+
+void comm_rx_ring_get_stats(comm_rx_ring_t* ring, comm_rx_ring_stats_t* stats) {
+  stats->pushed = (uint32_t) atomic_load_explicit(&ring->pushed, memory_order_relaxed);
+  stats->dropped = (uint32_t) atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+  stats->overwritten = (uint32_t) atomic_load_explicit(&ring->overwritten, memory_order_relaxed);
+  stats->high_water = (uint32_t) atomic_load_explicit(&ring->high_water, memory_order_relaxed);
+}
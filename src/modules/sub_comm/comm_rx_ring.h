@@ -0,0 +1,70 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_RX_RING_H
+#define COMM_RX_RING_H
+
+// Ring buffer lock-free single-producer / single-consumer untuk frame yang diterima.
+// Producer: callback ESP-NOW (Wi-Fi task). Consumer: main_task.
+// Tidak memakai FreeRTOS, jadi bisa dipakai dan di-stress test di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// harus pangkat 2
+#define COMM_RX_RING_SIZE 64 // cukup untuk satu batch penuh (COMM_WIRE_BATCH_MAX_SAMPLES)
+
+typedef enum {
+  COMM_RX_OVERWRITE_OLDEST, // ring penuh: buang sample paling lama (default, display butuh data terbaru)
+  COMM_RX_DROP_NEWEST,      // ring penuh: buang sample yang baru masuk
+} comm_rx_policy_t;
+
+typedef struct {
+  weight_data_t weight;
+  int64_t rx_us; // waktu sample (frame batch: dimundurkan sesuai interval), untuk filter di consumer
+  uint16_t seq;
+  uint8_t peer; // index di tabel peer
+} comm_rx_item_t;
+
+typedef struct {
+  uint32_t pushed;
+  uint32_t dropped;     // ditolak karena penuh (DROP_NEWEST)
+  uint32_t overwritten; // ditimpa karena penuh (OVERWRITE_OLDEST)
+  uint32_t high_water;  // jumlah item terbanyak yang pernah antri
+} comm_rx_ring_stats_t;
+
+typedef struct {
+  comm_rx_item_t slots[COMM_RX_RING_SIZE];
+  atomic_uint_fast32_t head; // hanya ditulis producer
+  atomic_uint_fast32_t tail; // ditulis consumer, dan producer saat overwrite
+  comm_rx_policy_t policy;
+  atomic_uint_fast32_t pushed;
+  atomic_uint_fast32_t dropped;
+  atomic_uint_fast32_t overwritten;
+  atomic_uint_fast32_t high_water;
+} comm_rx_ring_t;
+
+void comm_rx_ring_init(comm_rx_ring_t* ring, comm_rx_policy_t policy);
+
+// producer; return false jika item dibuang (DROP_NEWEST dan ring penuh)
+bool comm_rx_ring_push(comm_rx_ring_t* ring, const comm_rx_item_t* item);
+
+// consumer; return false jika ring kosong
+bool comm_rx_ring_pop(comm_rx_ring_t* ring, comm_rx_item_t* item);
+
+uint32_t comm_rx_ring_count(comm_rx_ring_t* ring);
+
+void comm_rx_ring_get_stats(comm_rx_ring_t* ring, comm_rx_ring_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_RX_RING_H
@@ -0,0 +1,67 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_TRANSPORT_H
+#define COMM_TRANSPORT_H
+
+// Interface radio untuk comm_task: init, tambah peer, kirim, callback terima dan status kirim.
+// Implementasi: ESP-NOW (comm_transport_espnow) di target, loopback in-process
+// (comm_transport_loopback) di host supaya jalur comm bisa dites dan di-benchmark di Linux.
+// Tanpa header ESP-IDF supaya bisa di-compile di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COMM_TRANSPORT_MAC_LEN   6
+#define COMM_TRANSPORT_MAX_FRAME 250 // ESP_NOW_MAX_DATA_LEN
+#define COMM_TRANSPORT_RSSI_NONE INT8_MIN
+
+// dipanggil dari konteks radio (Wi-Fi task / thread loopback): jangan block
+typedef void (*comm_transport_recv_cb_t)(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+
+// status MAC-layer satu frame, urutannya sama dengan urutan send()
+typedef void (*comm_transport_send_cb_t)(const uint8_t* mac, bool success, void* ctx);
+
+typedef struct {
+  bool (*init)(void* self);
+  bool (*add_peer)(void* self, const uint8_t* mac);
+  // false jika frame tidak bisa diantrikan (send callback tidak dipanggil)
+  bool (*send)(void* self, const uint8_t* mac, const uint8_t* data, size_t len);
+  void (*set_callbacks)(void* self, comm_transport_recv_cb_t recv_cb, comm_transport_send_cb_t send_cb, void* ctx);
+  const char* name;
+} comm_transport_ops_t;
+
+typedef struct {
+  const comm_transport_ops_t* ops;
+  void* self;
+} comm_transport_t;
+
+static inline bool comm_transport_init(const comm_transport_t* transport) {
+  return transport->ops->init(transport->self);
+}
+
+static inline bool comm_transport_add_peer(const comm_transport_t* transport, const uint8_t* mac) {
+  return transport->ops->add_peer(transport->self, mac);
+}
+
+static inline bool comm_transport_send(const comm_transport_t* transport, const uint8_t* mac, const uint8_t* data,
+                                       size_t len) {
+  return transport->ops->send(transport->self, mac, data, len);
+}
+
+static inline void comm_transport_set_callbacks(const comm_transport_t* transport, comm_transport_recv_cb_t recv_cb,
+                                                comm_transport_send_cb_t send_cb, void* ctx) {
+  transport->ops->set_callbacks(transport->self, recv_cb, send_cb, ctx);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_TRANSPORT_H
@@ -0,0 +1,162 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_transport_espnow.h"
+
+#ifdef ESP_PLATFORM
+
+#include <string.h>
+#include "esp_now.h"
+#include "esp_wifi.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_log.h"
+#include "esp_idf_version.h"
+#include "comm_peer_table.h"
+
+_Static_assert(COMM_TRANSPORT_MAC_LEN == ESP_NOW_ETH_ALEN, "MAC length mismatch");
+_Static_assert(COMM_PEER_MAX <= ESP_NOW_MAX_TOTAL_PEER_NUM, "peer table larger than ESP-NOW peer limit");
+_Static_assert(COMM_TRANSPORT_MAX_FRAME == ESP_NOW_MAX_DATA_LEN, "frame length mismatch");
+
+static const char* TAG = "COMM_ESPNOW";
+
+static comm_transport_recv_cb_t recv_cb = NULL;
+static comm_transport_send_cb_t send_cb = NULL;
+static void* cb_ctx = NULL;
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+// IDF 4.x tidak memberi RSSI di recv callback ESP-NOW: ambil dari action frame yang sama
+// lewat promiscuous rx (dipanggil sebelum recv callback, di Wi-Fi task yang sama)
+static int8_t sniff_rssi = COMM_TRANSPORT_RSSI_NONE;
+static uint8_t sniff_src[ESP_NOW_ETH_ALEN];
+#endif
+
+// forward declaration
+static bool espnow_init(void* self);
+static bool espnow_add_peer(void* self, const uint8_t* mac);
+static bool espnow_send(void* self, const uint8_t* mac, const uint8_t* data, size_t len);
+static void espnow_set_callbacks(void* self, comm_transport_recv_cb_t recv, comm_transport_send_cb_t send, void* ctx);
+static void esp_now_send_cb(const uint8_t* mac_addr, esp_now_send_status_t status);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+static void esp_now_recv_cb(const esp_now_recv_info_t* info, const uint8_t* data, int data_len);
+#else
+static void esp_now_recv_cb(const uint8_t* mac_addr, const uint8_t* data, int data_len);
+static void promiscuous_rx_cb(void* buf, wifi_promiscuous_pkt_type_t type);
+#endif
+
+static const comm_transport_ops_t espnow_ops = {
+  .init = espnow_init,
+  .add_peer = espnow_add_peer,
+  .send = espnow_send,
+  .set_callbacks = espnow_set_callbacks,
+  .name = "esp-now",
+};
+
+static const comm_transport_t espnow_transport = { .ops = &espnow_ops, .self = NULL };
+
+const comm_transport_t* comm_transport_espnow(void) {
+  return &espnow_transport;
+}
+
+static bool espnow_init(void* self) {
+  ESP_ERROR_CHECK(esp_netif_init());
+  ESP_ERROR_CHECK(esp_event_loop_create_default());
+  wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+  ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+  ESP_ERROR_CHECK(esp_wifi_set_storage(WIFI_STORAGE_RAM));
+  ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+  ESP_ERROR_CHECK(esp_wifi_start());
+  ESP_LOGI(TAG, "ESP WIFI_MODE_STA");
+
+  // --- KRUSIAL: INISIALISASI ESP-NOW DI SINI ---
+  esp_err_t esp_now_init_ret = esp_now_init();
+  if (esp_now_init_ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to initialize ESP-NOW: %s", esp_err_to_name(esp_now_init_ret));
+    return false;
+  }
+  ESP_LOGI(TAG, "ESP-NOW initialized.");
+
+  // daftarkan callback
+  ESP_ERROR_CHECK(esp_now_register_send_cb(esp_now_send_cb)); // untuk status pengiriman
+  ESP_ERROR_CHECK(esp_now_register_recv_cb(esp_now_recv_cb)); // untuk menerima data
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+  // hanya management frame (ESP-NOW = action frame) supaya beban CPU kecil
+  wifi_promiscuous_filter_t sniff_filter = { .filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT };
+  ESP_ERROR_CHECK(esp_wifi_set_promiscuous_filter(&sniff_filter));
+  ESP_ERROR_CHECK(esp_wifi_set_promiscuous_rx_cb(promiscuous_rx_cb));
+  ESP_ERROR_CHECK(esp_wifi_set_promiscuous(true));
+#endif
+  return true;
+}
+
+static bool espnow_add_peer(void* self, const uint8_t* mac) {
+  if (esp_now_is_peer_exist(mac)) return true;
+
+  esp_now_peer_info_t peer_info = {};
+  memcpy(peer_info.peer_addr, mac, ESP_NOW_ETH_ALEN);
+  peer_info.channel = 0; // channel wifi saat ini
+  peer_info.encrypt = false; // Tanpa enkripsi
+  peer_info.ifidx = WIFI_IF_STA; // jika sender dalam mode STA
+
+  ESP_LOGI(TAG, "ADDING PEER: %02x:%02x:%02x:%02x:%02x:%02x",
+    mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+  esp_err_t add_peer_ret = esp_now_add_peer(&peer_info);
+  if (add_peer_ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to add peer: %s", esp_err_to_name(add_peer_ret));
+    return false;
+  }
+  return true;
+}
+
+static bool espnow_send(void* self, const uint8_t* mac, const uint8_t* data, size_t len) {
+  esp_err_t send_ret = esp_now_send(mac, data, len);
+  if (send_ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to send data: %s", esp_err_to_name(send_ret));
+    return false;
+  }
+  return true;
+}
+
+static void espnow_set_callbacks(void* self, comm_transport_recv_cb_t recv, comm_transport_send_cb_t send, void* ctx) {
+  cb_ctx = ctx;
+  recv_cb = recv;
+  send_cb = send;
+}
+
+static void esp_now_send_cb(const uint8_t* mac_addr, esp_now_send_status_t status) {
+  if (mac_addr == NULL) {
+    ESP_LOGE(TAG, "Send callback: MAC address is null");
+    return;
+  }
+  if (send_cb != NULL) send_cb(mac_addr, status == ESP_NOW_SEND_SUCCESS, cb_ctx);
+}
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+static void esp_now_recv_cb(const esp_now_recv_info_t* info, const uint8_t* data, int data_len) {
+  if (info == NULL || info->src_addr == NULL || data == NULL) return;
+  int8_t rssi = info->rx_ctrl != NULL ? (int8_t) info->rx_ctrl->rssi : COMM_TRANSPORT_RSSI_NONE;
+  if (recv_cb != NULL) recv_cb(info->src_addr, rssi, data, data_len, cb_ctx);
+}
+#else
+static void promiscuous_rx_cb(void* buf, wifi_promiscuous_pkt_type_t type) {
+  if (type != WIFI_PKT_MGMT || buf == NULL) return;
+  const wifi_promiscuous_pkt_t* pkt = (const wifi_promiscuous_pkt_t*) buf;
+  // addr2 (pengirim) di offset 10 header 802.11
+  memcpy(sniff_src, &pkt->payload[10], ESP_NOW_ETH_ALEN);
+  sniff_rssi = (int8_t) pkt->rx_ctrl.rssi;
+}
+
+static void esp_now_recv_cb(const uint8_t* mac_addr, const uint8_t* data, int data_len) {
+  if (mac_addr == NULL || data == NULL) return;
+  int8_t rssi = COMM_TRANSPORT_RSSI_NONE;
+  if (memcmp(mac_addr, sniff_src, ESP_NOW_ETH_ALEN) == 0) {
+    rssi = sniff_rssi;
+  }
+  if (recv_cb != NULL) recv_cb(mac_addr, rssi, data, data_len, cb_ctx);
+}
+#endif
+
+#endif // ESP_PLATFORM
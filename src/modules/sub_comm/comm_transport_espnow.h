@@ -0,0 +1,23 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_TRANSPORT_ESPNOW_H
+#define COMM_TRANSPORT_ESPNOW_H
+
+#include "comm_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef ESP_PLATFORM
+// transport ESP-NOW (Wi-Fi STA); hanya satu instance karena callback ESP-NOW global
+const comm_transport_t* comm_transport_espnow(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_TRANSPORT_ESPNOW_H
@@ -0,0 +1,253 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "comm_transport_loopback.h"
+
+#ifndef ESP_PLATFORM
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOOPBACK_DEFAULT_SEED 0x2545F491u
+
+// forward declaration
+static bool loopback_init(void* self);
+static bool loopback_add_peer(void* self, const uint8_t* mac);
+static bool loopback_send(void* self, const uint8_t* mac, const uint8_t* data, size_t len);
+static void loopback_set_callbacks(void* self, comm_transport_recv_cb_t recv, comm_transport_send_cb_t send, void* ctx);
+static uint32_t next_random(comm_loopback_medium_t* medium);
+static int8_t find_node(const comm_loopback_medium_t* medium, const uint8_t* mac);
+static bool pop_due(comm_loopback_medium_t* medium, int64_t now_us, comm_loopback_frame_t* frame);
+static void* loopback_thread(void* arg);
+
+static const comm_transport_ops_t loopback_ops = {
+  .init = loopback_init,
+  .add_peer = loopback_add_peer,
+  .send = loopback_send,
+  .set_callbacks = loopback_set_callbacks,
+  .name = "loopback",
+};
+
+void comm_loopback_init(comm_loopback_medium_t* medium, const comm_loopback_config_t* config) {
+  memset(medium, 0, sizeof(*medium));
+  pthread_mutex_init(&medium->lock, NULL);
+  comm_loopback_set_config(medium, config);
+}
+
+void comm_loopback_set_config(comm_loopback_medium_t* medium, const comm_loopback_config_t* config) {
+  pthread_mutex_lock(&medium->lock);
+  if (config != NULL) {
+    medium->config = *config;
+  } else {
+    memset(&medium->config, 0, sizeof(medium->config));
+  }
+  if (medium->config.loss_permille > 1000) medium->config.loss_permille = 1000;
+  if (medium->config.reorder_permille > 1000) medium->config.reorder_permille = 1000;
+  medium->rng = medium->config.seed != 0 ? medium->config.seed : LOOPBACK_DEFAULT_SEED;
+  pthread_mutex_unlock(&medium->lock);
+}
+
+const comm_transport_t* comm_loopback_attach(comm_loopback_medium_t* medium, const uint8_t* mac) {
+  if (medium == NULL || mac == NULL) return NULL;
+
+  pthread_mutex_lock(&medium->lock);
+  comm_loopback_node_t* node = NULL;
+  if (medium->node_count < COMM_LOOPBACK_MAX_NODES && find_node(medium, mac) < 0) {
+    node = &medium->nodes[medium->node_count++];
+    memset(node, 0, sizeof(*node));
+    node->medium = medium;
+    memcpy(node->mac, mac, COMM_TRANSPORT_MAC_LEN);
+    node->transport.ops = &loopback_ops;
+    node->transport.self = node;
+  }
+  pthread_mutex_unlock(&medium->lock);
+
+  return node != NULL ? &node->transport : NULL;
+}
+
+uint32_t comm_loopback_poll(comm_loopback_medium_t* medium, int64_t now_us) {
+  pthread_mutex_lock(&medium->lock);
+  if (now_us > medium->now_us) medium->now_us = now_us;
+  pthread_mutex_unlock(&medium->lock);
+
+  // callback dipanggil di luar lock supaya penerima boleh langsung send() lagi
+  uint32_t processed = 0;
+  comm_loopback_frame_t frame;
+  while (pop_due(medium, now_us, &frame)) {
+    comm_loopback_node_t* from = &medium->nodes[frame.from];
+    bool delivered = !frame.lost && frame.to >= 0;
+
+    if (delivered) {
+      comm_loopback_node_t* to = &medium->nodes[frame.to];
+      if (to->recv_cb != NULL) {
+        to->recv_cb(from->mac, medium->config.rssi, frame.data, frame.len, to->cb_ctx);
+      }
+    }
+    if (from->send_cb != NULL) {
+      from->send_cb(frame.to_mac, delivered, from->cb_ctx);
+    }
+    processed++;
+  }
+  return processed;
+}
+
+bool comm_loopback_start(comm_loopback_medium_t* medium, uint32_t period_us) {
+  if (medium->running) return false;
+  medium->period_us = period_us > 0 ? period_us : 100;
+  medium->running = true;
+  if (pthread_create(&medium->thread, NULL, loopback_thread, medium) != 0) {
+    medium->running = false;
+    return false;
+  }
+  return true;
+}
+
+void comm_loopback_stop(comm_loopback_medium_t* medium) {
+  if (!medium->running) return;
+  medium->running = false;
+  pthread_join(medium->thread, NULL);
+}
+
+void comm_loopback_get_stats(comm_loopback_medium_t* medium, comm_loopback_stats_t* stats) {
+  pthread_mutex_lock(&medium->lock);
+  *stats = medium->stats;
+  pthread_mutex_unlock(&medium->lock);
+}
+
+// --- ops transport ---
+static bool loopback_init(void* self) {
+  return self != NULL;
+}
+
+static bool loopback_add_peer(void* self, const uint8_t* mac) {
+  comm_loopback_node_t* node = (comm_loopback_node_t*) self;
+  pthread_mutex_lock(&node->medium->lock);
+  bool ok = true;
+  bool exists = false;
+  for (uint8_t i = 0; i < node->peer_count; i++) {
+    if (memcmp(node->peers[i], mac, COMM_TRANSPORT_MAC_LEN) == 0) exists = true;
+  }
+  if (!exists) {
+    if (node->peer_count < COMM_LOOPBACK_MAX_PEERS) {
+      memcpy(node->peers[node->peer_count++], mac, COMM_TRANSPORT_MAC_LEN);
+    } else {
+      ok = false;
+    }
+  }
+  pthread_mutex_unlock(&node->medium->lock);
+  return ok;
+}
+
+static bool loopback_send(void* self, const uint8_t* mac, const uint8_t* data, size_t len) {
+  comm_loopback_node_t* node = (comm_loopback_node_t*) self;
+  comm_loopback_medium_t* medium = node->medium;
+  if (mac == NULL || data == NULL || len == 0 || len > COMM_TRANSPORT_MAX_FRAME) return false;
+
+  pthread_mutex_lock(&medium->lock);
+
+  // seperti ESP-NOW: tujuan harus sudah di-add_peer
+  bool known = false;
+  for (uint8_t i = 0; i < node->peer_count; i++) {
+    if (memcmp(node->peers[i], mac, COMM_TRANSPORT_MAC_LEN) == 0) known = true;
+  }
+  if (!known || medium->flight_count == COMM_LOOPBACK_MAX_FLIGHT) {
+    if (known) medium->stats.flight_full++;
+    pthread_mutex_unlock(&medium->lock);
+    return false;
+  }
+
+  const comm_loopback_config_t* config = &medium->config;
+  comm_loopback_frame_t* frame = &medium->flight[medium->flight_count++];
+  frame->from = (uint8_t) (node - medium->nodes);
+  frame->to = find_node(medium, mac);
+  memcpy(frame->to_mac, mac, COMM_TRANSPORT_MAC_LEN);
+  frame->order = medium->order++;
+  frame->len = (uint8_t) len;
+  memcpy(frame->data, data, len);
+
+  int64_t delay_us = config->latency_us;
+  if (config->jitter_us > 0) delay_us += next_random(medium) % (config->jitter_us + 1);
+  frame->lost = next_random(medium) % 1000 < config->loss_permille;
+  if (!frame->lost && next_random(medium) % 1000 < config->reorder_permille) {
+    // tahan lebih lama dari delay maksimum supaya frame berikutnya pasti menyusul
+    delay_us += (int64_t) config->latency_us + config->jitter_us + 1;
+    medium->stats.reordered++;
+  }
+  frame->deliver_us = medium->now_us + delay_us;
+
+  medium->stats.sent++;
+  if (frame->to < 0) {
+    medium->stats.no_route++;
+  } else if (frame->lost) {
+    medium->stats.lost++;
+  } else {
+    medium->stats.delivered++;
+  }
+
+  pthread_mutex_unlock(&medium->lock);
+  return true;
+}
+
+static void loopback_set_callbacks(void* self, comm_transport_recv_cb_t recv, comm_transport_send_cb_t send, void* ctx) {
+  comm_loopback_node_t* node = (comm_loopback_node_t*) self;
+  pthread_mutex_lock(&node->medium->lock);
+  node->recv_cb = recv;
+  node->send_cb = send;
+  node->cb_ctx = ctx;
+  pthread_mutex_unlock(&node->medium->lock);
+}
+
+// --- helper ---
+static uint32_t next_random(comm_loopback_medium_t* medium) {
+  // xorshift32
+  uint32_t x = medium->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  medium->rng = x;
+  return x;
+}
+
+static int8_t find_node(const comm_loopback_medium_t* medium, const uint8_t* mac) {
+  for (uint8_t i = 0; i < medium->node_count; i++) {
+    if (memcmp(medium->nodes[i].mac, mac, COMM_TRANSPORT_MAC_LEN) == 0) return (int8_t) i;
+  }
+  return -1;
+}
+
+static bool pop_due(comm_loopback_medium_t* medium, int64_t now_us, comm_loopback_frame_t* frame) {
+  pthread_mutex_lock(&medium->lock);
+
+  int16_t best = -1;
+  for (uint16_t i = 0; i < medium->flight_count; i++) {
+    const comm_loopback_frame_t* f = &medium->flight[i];
+    if (f->deliver_us > now_us) continue;
+    if (best < 0 || f->deliver_us < medium->flight[best].deliver_us ||
+        (f->deliver_us == medium->flight[best].deliver_us && f->order < medium->flight[best].order)) {
+      best = (int16_t) i;
+    }
+  }
+
+  if (best >= 0) {
+    *frame = medium->flight[best];
+    medium->flight[best] = medium->flight[--medium->flight_count];
+  }
+
+  pthread_mutex_unlock(&medium->lock);
+  return best >= 0;
+}
+
+static void* loopback_thread(void* arg) {
+  comm_loopback_medium_t* medium = (comm_loopback_medium_t*) arg;
+  while (medium->running) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    comm_loopback_poll(medium, (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+    usleep(medium->period_us);
+  }
+  return NULL;
+}
+
+#endif // ESP_PLATFORM
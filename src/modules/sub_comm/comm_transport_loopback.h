@@ -0,0 +1,112 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef COMM_TRANSPORT_LOOPBACK_H
+#define COMM_TRANSPORT_LOOPBACK_H
+
+// Transport host (Linux) untuk menjalankan jalur comm tanpa radio.
+// Beberapa node berbagi satu "medium" in-process; frame tertahan di medium sesuai
+// latency + jitter, bisa hilang (loss) atau menyusul frame berikutnya (reorder).
+// Random memakai seed tetap supaya kondisi jaringan bisa diulang persis.
+//
+// Frame dikirim ke tujuan lewat comm_loopback_poll(now_us) (jam virtual, deterministik)
+// atau thread bawaan comm_loopback_start() yang memakai CLOCK_MONOTONIC.
+
+#include "comm_transport.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ESP_PLATFORM
+
+#include <pthread.h>
+
+#define COMM_LOOPBACK_MAX_NODES  8
+#define COMM_LOOPBACK_MAX_PEERS  20 // sama dengan ESP_NOW_MAX_TOTAL_PEER_NUM
+#define COMM_LOOPBACK_MAX_FLIGHT 128
+
+typedef struct {
+  uint32_t latency_us;
+  uint32_t jitter_us;        // tambahan acak 0..jitter_us
+  uint16_t loss_permille;    // frame hilang, send callback melapor gagal
+  uint16_t reorder_permille; // frame ditahan satu latency lagi sehingga disusul frame berikutnya
+  uint32_t seed;             // 0 = pakai seed default
+  int8_t   rssi;             // RSSI yang dilaporkan ke penerima
+} comm_loopback_config_t;
+
+typedef struct {
+  uint32_t sent;
+  uint32_t delivered;
+  uint32_t lost;
+  uint32_t reordered;
+  uint32_t no_route;    // tujuan tidak terpasang di medium
+  uint32_t flight_full; // send() ditolak karena medium penuh
+} comm_loopback_stats_t;
+
+struct comm_loopback_medium;
+
+typedef struct {
+  struct comm_loopback_medium* medium;
+  uint8_t mac[COMM_TRANSPORT_MAC_LEN];
+  uint8_t peers[COMM_LOOPBACK_MAX_PEERS][COMM_TRANSPORT_MAC_LEN];
+  uint8_t peer_count;
+  comm_transport_recv_cb_t recv_cb;
+  comm_transport_send_cb_t send_cb;
+  void* cb_ctx;
+  comm_transport_t transport;
+} comm_loopback_node_t;
+
+typedef struct {
+  int64_t deliver_us;
+  uint32_t order;       // urutan send, pemecah seri deliver_us yang sama
+  uint8_t from;
+  int8_t to;            // -1 jika tujuan tidak ada
+  uint8_t to_mac[COMM_TRANSPORT_MAC_LEN];
+  bool lost;
+  uint8_t len;
+  uint8_t data[COMM_TRANSPORT_MAX_FRAME];
+} comm_loopback_frame_t;
+
+typedef struct comm_loopback_medium {
+  comm_loopback_config_t config;
+  comm_loopback_node_t nodes[COMM_LOOPBACK_MAX_NODES];
+  uint8_t node_count;
+  comm_loopback_frame_t flight[COMM_LOOPBACK_MAX_FLIGHT];
+  uint16_t flight_count;
+  uint32_t order;
+  uint32_t rng;
+  int64_t now_us;       // jam terakhir dari poll / thread, dipakai sebagai waktu send
+  comm_loopback_stats_t stats;
+  pthread_mutex_t lock;
+  pthread_t thread;
+  uint32_t period_us;
+  volatile bool running;
+} comm_loopback_medium_t;
+
+void comm_loopback_init(comm_loopback_medium_t* medium, const comm_loopback_config_t* config);
+
+// ubah kondisi jaringan saat berjalan (frame yang sudah di medium tidak berubah)
+void comm_loopback_set_config(comm_loopback_medium_t* medium, const comm_loopback_config_t* config);
+
+// pasang node baru; return transport-nya, NULL jika medium penuh
+const comm_transport_t* comm_loopback_attach(comm_loopback_medium_t* medium, const uint8_t* mac);
+
+// kirim semua frame yang jatuh tempo pada `now_us`; return jumlah frame yang diproses
+uint32_t comm_loopback_poll(comm_loopback_medium_t* medium, int64_t now_us);
+
+// thread yang memanggil poll setiap `period_us` memakai CLOCK_MONOTONIC
+bool comm_loopback_start(comm_loopback_medium_t* medium, uint32_t period_us);
+
+void comm_loopback_stop(comm_loopback_medium_t* medium);
+
+void comm_loopback_get_stats(comm_loopback_medium_t* medium, comm_loopback_stats_t* stats);
+
+#endif // ESP_PLATFORM
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //COMM_TRANSPORT_LOOPBACK_H
@@ -0,0 +1,99 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "lcd_frame.h"
+
+#include <string.h>
+
+// forward declaration
+static bool cell_dirty(const lcd_frame_t* frame, uint8_t row, uint8_t col);
+static uint8_t run_end(const lcd_frame_t* frame, uint8_t row, uint8_t start);
+
+void lcd_frame_init(lcd_frame_t* frame) {
+  memset(frame, 0, sizeof(*frame));
+  memset(frame->next, ' ', sizeof(frame->next));
+  lcd_frame_invalidate(frame);
+}
+
+void lcd_frame_invalidate(lcd_frame_t* frame) {
+  frame->shown_valid = false;
+  frame->cursor_col = -1;
+  frame->cursor_row = -1;
+}
+
+void lcd_frame_write(lcd_frame_t* frame, uint8_t col, uint8_t row, const char* text) {
+  if (row >= LCD_FRAME_ROWS || text == NULL) return;
+  for (; col < LCD_FRAME_COLS && *text != '\0'; col++, text++) {
+    frame->next[row][col] = *text;
+  }
+}
+
+void lcd_frame_set_line(lcd_frame_t* frame, uint8_t row, const char* text) {
+  if (row >= LCD_FRAME_ROWS) return;
+  uint8_t col = 0;
+  if (text != NULL) {
+    for (; col < LCD_FRAME_COLS && text[col] != '\0'; col++) frame->next[row][col] = text[col];
+  }
+  memset(&frame->next[row][col], ' ', LCD_FRAME_COLS - col);
+}
+
+void lcd_frame_clear(lcd_frame_t* frame) {
+  memset(frame->next, ' ', sizeof(frame->next));
+}
+
+uint16_t lcd_frame_flush(lcd_frame_t* frame, const lcd_sink_t* sink) {
+  uint16_t bytes = 0;
+  frame->stats.flushes++;
+
+  for (uint8_t row = 0; row < LCD_FRAME_ROWS; row++) {
+    uint8_t col = 0;
+    while (col < LCD_FRAME_COLS) {
+      if (!cell_dirty(frame, row, col)) {
+        col++;
+        continue;
+      }
+      uint8_t end = run_end(frame, row, col);
+      uint8_t len = end - col;
+      if (frame->cursor_row != row || frame->cursor_col != col) {
+        lcd_sink_set_cursor(sink, col, row);
+        frame->stats.cursor_moves++;
+        bytes++;
+      }
+      lcd_sink_write(sink, &frame->next[row][col], len);
+      memcpy(&frame->shown[row][col], &frame->next[row][col], len);
+      frame->stats.cells_written += len;
+      bytes += len;
+      // setelah kolom terakhir cursor ada di luar layar (DDRAM 0x10 / 0x50), bukan awal baris berikutnya
+      frame->cursor_row = (int8_t) row;
+      frame->cursor_col = (int8_t) end;
+      col = end;
+    }
+  }
+
+  frame->shown_valid = true;
+  if (bytes == 0) frame->stats.unchanged++;
+  return bytes;
+}
+
+// --- static function ---
+static bool cell_dirty(const lcd_frame_t* frame, uint8_t row, uint8_t col) {
+  return !frame->shown_valid || frame->next[row][col] != frame->shown[row][col];
+}
+
+static uint8_t run_end(const lcd_frame_t* frame, uint8_t row, uint8_t start) {
+  // akhir run (eksklusif): sel berubah terakhir sebelum celah > LCD_FRAME_MERGE_GAP atau akhir baris
+  uint8_t end = start + 1;
+  uint8_t col = end;
+  while (col < LCD_FRAME_COLS) {
+    if (cell_dirty(frame, row, col)) {
+      end = ++col;
+      continue;
+    }
+    uint8_t gap = 0;
+    while (col + gap < LCD_FRAME_COLS && !cell_dirty(frame, row, col + gap)) gap++;
+    if (col + gap >= LCD_FRAME_COLS || gap > LCD_FRAME_MERGE_GAP) break;
+    col += gap;
+  }
+  return end;
+}
@@ -0,0 +1,65 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_FRAME_H
+#define LCD_FRAME_H
+
+// Shadow framebuffer 16x2: pemakai menulis ke `next`, lcd_frame_flush() membandingkan dengan
+// `shown` (isi LCD sekarang) dan hanya mengirim run sel yang berubah.
+//
+// Cursor HD44780 maju sendiri setelah setiap karakter, jadi run yang dimulai tepat di posisi
+// cursor tidak butuh set_cursor. Pindah cursor = 1 byte command, sama mahalnya dengan 1 karakter,
+// sehingga celah sel yang tidak berubah sepanjang <= LCD_FRAME_MERGE_GAP ikut ditulis ulang
+// daripada memindah cursor.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lcd_sink.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LCD_FRAME_COLS      16
+#define LCD_FRAME_ROWS      2
+#define LCD_FRAME_MERGE_GAP 1
+
+typedef struct {
+  uint32_t flushes;
+  uint32_t unchanged;     // flush tanpa sel yang berubah, tidak ada byte terkirim
+  uint32_t cells_written; // karakter yang dikirim (termasuk celah yang digabung)
+  uint32_t cursor_moves;  // set_cursor yang dikirim
+} lcd_frame_stats_t;
+
+typedef struct {
+  char next[LCD_FRAME_ROWS][LCD_FRAME_COLS];
+  char shown[LCD_FRAME_ROWS][LCD_FRAME_COLS];
+  bool shown_valid;       // false = isi LCD tidak diketahui, flush berikutnya menulis semua sel
+  int8_t cursor_col;      // posisi cursor LCD menurut kita, -1 = tidak diketahui
+  int8_t cursor_row;
+  lcd_frame_stats_t stats;
+} lcd_frame_t;
+
+// `next` dikosongkan (spasi); isi LCD dianggap tidak diketahui
+void lcd_frame_init(lcd_frame_t* frame);
+
+// setelah LCD di-clear / di-init ulang / ditulis di luar lcd_frame
+void lcd_frame_invalidate(lcd_frame_t* frame);
+
+// tulis text mulai (col, row) sampai '\0' atau akhir baris; sel lain tidak berubah
+void lcd_frame_write(lcd_frame_t* frame, uint8_t col, uint8_t row, const char* text);
+
+// seluruh baris: text rata kiri, sisa kolom diisi spasi
+void lcd_frame_set_line(lcd_frame_t* frame, uint8_t row, const char* text);
+
+void lcd_frame_clear(lcd_frame_t* frame);
+
+// kirim sel yang berubah ke sink; return jumlah byte ke LCD (karakter + set_cursor)
+uint16_t lcd_frame_flush(lcd_frame_t* frame, const lcd_sink_t* sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_FRAME_H
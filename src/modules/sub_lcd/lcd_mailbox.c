@@ -0,0 +1,56 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "lcd_mailbox.h"
+
+#include <string.h>
+
+void lcd_mailbox_init(lcd_mailbox_t* mailbox) {
+  memset(mailbox, 0, sizeof(*mailbox));
+  atomic_init(&mailbox->seq, 0);
+  atomic_init(&mailbox->read_seq, 0);
+}
+
+void lcd_mailbox_post(lcd_mailbox_t* mailbox, const led_data_t* data, int64_t now_us) {
+  unsigned seq = atomic_load_explicit(&mailbox->seq, memory_order_relaxed);
+  // frame sebelumnya (jika ada) belum diambil reader
+  if (seq != 0 && atomic_load_explicit(&mailbox->read_seq, memory_order_relaxed) != seq) {
+    mailbox->stats.overwritten++;
+  }
+  atomic_store_explicit(&mailbox->seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  mailbox->data = *data;
+  mailbox->post_us = now_us;
+  atomic_store_explicit(&mailbox->seq, seq + 2, memory_order_release);
+  mailbox->stats.posts++;
+}
+
+bool lcd_mailbox_take(lcd_mailbox_t* mailbox, led_data_t* out, int64_t* post_us) {
+  unsigned read_seq = atomic_load_explicit(&mailbox->read_seq, memory_order_relaxed);
+  for (uint8_t attempt = 0; attempt < LCD_MAILBOX_MAX_RETRIES; attempt++) {
+    unsigned before = atomic_load_explicit(&mailbox->seq, memory_order_acquire);
+    if (before == read_seq) return false;
+    if (before & 1) {
+      mailbox->stats.retries++;
+      continue;
+    }
+    *out = mailbox->data;
+    int64_t posted = mailbox->post_us;
+    atomic_thread_fence(memory_order_acquire);
+    unsigned after = atomic_load_explicit(&mailbox->seq, memory_order_relaxed);
+    if (before != after) {
+      mailbox->stats.retries++;
+      continue;
+    }
+    // pastikan string selalu berakhir di dalam buffer, apa pun isi dari writer
+    out->line_1[sizeof(out->line_1) - 1] = '\0';
+    out->line_2[sizeof(out->line_2) - 1] = '\0';
+    if (post_us != NULL) *post_us = posted;
+    atomic_store_explicit(&mailbox->read_seq, before, memory_order_relaxed);
+    mailbox->stats.takes++;
+    return true;
+  }
+  mailbox->stats.gave_up++;
+  return false;
+}
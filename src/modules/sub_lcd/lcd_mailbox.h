@@ -0,0 +1,56 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_MAILBOX_H
+#define LCD_MAILBOX_H
+
+// Mailbox satu slot main_task -> lcd_task: frame baru menimpa frame lama (latest wins), jadi
+// LCD tidak pernah merender antrian frame basi. Isi baris disalin ke dalam slot (led_data_t
+// punya buffer sendiri), tidak ada pointer ke buffer pemilik lain.
+//
+// Handoff lewat seqlock (ganjil = sedang ditulis): writer tidak pernah menunggu; reader
+// mengulang jika salinannya bertabrakan dengan tulis, dan menyerah setelah
+// LCD_MAILBOX_MAX_RETRIES (mis. writer ter-preempt di tengah tulis) lalu mencoba di bangun berikutnya.
+// Satu writer dan satu reader. Tanpa header ESP-IDF.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LCD_MAILBOX_MAX_RETRIES 8
+
+typedef struct {
+  uint32_t posts;
+  uint32_t overwritten; // frame yang ditimpa sebelum sempat dibaca
+  uint32_t takes;
+  uint32_t retries;     // salinan yang diulang karena bertabrakan dengan tulis
+  uint32_t gave_up;     // take yang menyerah setelah LCD_MAILBOX_MAX_RETRIES
+} lcd_mailbox_stats_t;
+
+typedef struct {
+  atomic_uint seq;
+  atomic_uint read_seq; // seq terakhir yang diambil reader
+  led_data_t  data;
+  int64_t     post_us;
+  lcd_mailbox_stats_t stats;
+} lcd_mailbox_t;
+
+void lcd_mailbox_init(lcd_mailbox_t* mailbox);
+
+// writer: salin frame ke slot
+void lcd_mailbox_post(lcd_mailbox_t* mailbox, const led_data_t* data, int64_t now_us);
+
+// reader: true jika ada frame yang lebih baru dari take terakhir; `post_us` boleh NULL
+bool lcd_mailbox_take(lcd_mailbox_t* mailbox, led_data_t* out, int64_t* post_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_MAILBOX_H
@@ -0,0 +1,98 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "lcd_sched.h"
+
+#include <string.h>
+
+// forward declaration
+static bool emit(lcd_sched_t* sched, lcd_sched_slot_t* slot, int64_t now_us, led_data_t* out, int64_t* post_us);
+static uint32_t clamp_wait(int64_t wait_us);
+
+void lcd_sched_init(lcd_sched_t* sched, const lcd_sched_config_t* config) {
+  memset(sched, 0, sizeof(*sched));
+  sched->config.min_interval_us = config != NULL ? config->min_interval_us : LCD_SCHED_MIN_INTERVAL_US;
+}
+
+void lcd_sched_submit(lcd_sched_t* sched, const led_data_t* data, int64_t post_us) {
+  sched->stats.submitted++;
+  lcd_sched_slot_t* slot;
+  if (data->overlay_ms > 0) {
+    slot = &sched->overlay;
+    sched->stats.overlays++;
+    if (slot->dirty) sched->stats.coalesced++;
+  } else {
+    slot = &sched->base;
+    if (slot->dirty) {
+      if (sched->base_hidden) {
+        sched->stats.dropped++;
+      } else {
+        sched->stats.coalesced++;
+      }
+    }
+    sched->base_hidden = sched->overlay_showing;
+  }
+  slot->data = *data;
+  slot->post_us = post_us;
+  slot->valid = true;
+  slot->dirty = true;
+}
+
+bool lcd_sched_next(lcd_sched_t* sched, int64_t now_us, led_data_t* out, int64_t* post_us, uint32_t* wait_us) {
+  if (wait_us != NULL) *wait_us = UINT32_MAX;
+
+  // overlay baru selalu didahulukan, termasuk yang menggantikan overlay yang sedang tampil
+  if (sched->overlay.dirty) {
+    sched->overlay_showing = true;
+    sched->overlay_until_us = now_us + (int64_t) sched->overlay.data.overlay_ms * 1000;
+    sched->stats.urgent++;
+    if (sched->base.dirty) sched->base_hidden = true;
+    if (wait_us != NULL) *wait_us = (uint32_t) sched->overlay.data.overlay_ms * 1000;
+    return emit(sched, &sched->overlay, now_us, out, post_us);
+  }
+
+  if (sched->overlay_showing) {
+    if (now_us < sched->overlay_until_us) {
+      if (wait_us != NULL) *wait_us = clamp_wait(sched->overlay_until_us - now_us);
+      return false;
+    }
+    sched->overlay_showing = false;
+    sched->base_hidden = false;
+    if (!sched->base.valid) return false;
+    // kembali ke layar dasar terbaru tanpa menunggu batas frame rate
+    sched->stats.reverts++;
+    sched->stats.urgent++;
+    return emit(sched, &sched->base, now_us, out, post_us);
+  }
+
+  if (!sched->base.dirty) return false;
+  if (!sched->shown_valid || sched->base.data.lcd_state != sched->shown_state) {
+    sched->stats.urgent++;
+    return emit(sched, &sched->base, now_us, out, post_us);
+  }
+  int64_t due_us = sched->last_render_us + sched->config.min_interval_us;
+  if (now_us < due_us) {
+    if (wait_us != NULL) *wait_us = clamp_wait(due_us - now_us);
+    return false;
+  }
+  return emit(sched, &sched->base, now_us, out, post_us);
+}
+
+// --- static function ---
+static bool emit(lcd_sched_t* sched, lcd_sched_slot_t* slot, int64_t now_us, led_data_t* out, int64_t* post_us) {
+  slot->dirty = false;
+  *out = slot->data;
+  if (post_us != NULL) *post_us = slot->post_us;
+  sched->shown_valid = true;
+  sched->shown_state = slot->data.lcd_state;
+  sched->last_render_us = now_us;
+  sched->stats.rendered++;
+  return true;
+}
+
+static uint32_t clamp_wait(int64_t wait_us) {
+  if (wait_us <= 0) return 0;
+  if (wait_us > UINT32_MAX) return UINT32_MAX;
+  return (uint32_t) wait_us;
+}
@@ -0,0 +1,78 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_SCHED_H
+#define LCD_SCHED_H
+
+// Penjadwal render lcd_task: memutuskan frame mana yang dirender dan kapan.
+//
+// - Layar dasar (overlay_ms == 0): frame terbaru menggantikan frame yang belum dirender.
+//   Refresh dengan lcd_state yang sama dibatasi `min_interval_us` (I2C tidak jenuh oleh angka
+//   berat); pergantian lcd_state (masuk tare / kalibrasi / konfirmasi, kembali normal)
+//   langsung dirender tanpa menunggu batas itu.
+// - Overlay (overlay_ms > 0): langsung dirender, tampil selama overlay_ms sejak dirender, lalu
+//   kembali ke layar dasar terbaru. Layar dasar yang masuk selama overlay tetap diikuti.
+//
+// Waktu diberikan dari luar (us) supaya bisa diuji dengan jam virtual di host. Tanpa header
+// ESP-IDF / FreeRTOS.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LCD_SCHED_MIN_INTERVAL_US 100000 // maks 10 frame/detik untuk refresh biasa
+
+typedef struct {
+  uint32_t min_interval_us;
+} lcd_sched_config_t;
+
+typedef struct {
+  uint32_t submitted;
+  uint32_t rendered;
+  uint32_t urgent;     // dirender tanpa menunggu batas frame rate (pergantian layar, overlay)
+  uint32_t coalesced;  // diganti frame yang lebih baru sebelum gilirannya dirender
+  uint32_t dropped;    // tidak pernah tampil karena tertutup overlay lalu diganti
+  uint32_t overlays;
+  uint32_t reverts;    // overlay habis, layar dasar dirender lagi
+} lcd_sched_stats_t;
+
+typedef struct {
+  led_data_t data;
+  int64_t    post_us;
+  bool       valid;
+  bool       dirty;    // belum dirender sejak diterima
+} lcd_sched_slot_t;
+
+typedef struct {
+  lcd_sched_config_t config;
+  lcd_sched_slot_t base;
+  lcd_sched_slot_t overlay;
+  bool        overlay_showing;
+  bool        base_hidden;   // base.dirty diterima saat overlay tampil
+  int64_t     overlay_until_us;
+  bool        shown_valid;
+  lcd_state_t shown_state;
+  int64_t     last_render_us;
+  lcd_sched_stats_t stats;
+} lcd_sched_t;
+
+// config NULL = LCD_SCHED_MIN_INTERVAL_US
+void lcd_sched_init(lcd_sched_t* sched, const lcd_sched_config_t* config);
+
+// `post_us` hanya dibawa kembali oleh lcd_sched_next (pengukuran staleness)
+void lcd_sched_submit(lcd_sched_t* sched, const led_data_t* data, int64_t post_us);
+
+// true jika `out` harus dirender sekarang (satu frame per panggilan). `wait_us` = maks waktu
+// sampai perlu dipanggil lagi tanpa submit baru (UINT32_MAX = tunggu submit); boleh NULL.
+bool lcd_sched_next(lcd_sched_t* sched, int64_t now_us, led_data_t* out, int64_t* post_us, uint32_t* wait_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_SCHED_H
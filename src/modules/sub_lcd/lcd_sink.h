@@ -0,0 +1,43 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_SINK_H
+#define LCD_SINK_H
+
+// Interface minimal ke LCD karakter untuk lcd_frame: pindah cursor dan tulis karakter.
+// Implementasi: driver LCD I2C di lcd_task (target), recording fake (lcd_sink_fake) di host
+// untuk menghitung byte yang dikirim per frame. Tanpa header ESP-IDF.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+  void (*set_cursor)(void* self, uint8_t col, uint8_t row);
+  // `len` karakter berurutan mulai dari cursor; cursor LCD maju sendiri setiap karakter
+  void (*write)(void* self, const char* data, uint8_t len);
+  const char* name;
+} lcd_sink_ops_t;
+
+typedef struct {
+  const lcd_sink_ops_t* ops;
+  void* self;
+} lcd_sink_t;
+
+static inline void lcd_sink_set_cursor(const lcd_sink_t* sink, uint8_t col, uint8_t row) {
+  sink->ops->set_cursor(sink->self, col, row);
+}
+
+static inline void lcd_sink_write(const lcd_sink_t* sink, const char* data, uint8_t len) {
+  sink->ops->write(sink->self, data, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_SINK_H
@@ -0,0 +1,68 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "lcd_sink_fake.h"
+
+#ifndef ESP_PLATFORM
+
+#include <string.h>
+
+#define LCD_SINK_FAKE_VISIBLE 16
+
+// forward declaration
+static void fake_set_cursor(void* self, uint8_t col, uint8_t row);
+static void fake_write(void* self, const char* data, uint8_t len);
+
+static const lcd_sink_ops_t fake_ops = {
+  .set_cursor = fake_set_cursor,
+  .write = fake_write,
+  .name = "fake",
+};
+
+void lcd_sink_fake_init(lcd_sink_fake_t* fake) {
+  memset(fake, 0, sizeof(*fake));
+  memset(fake->ddram, ' ', sizeof(fake->ddram));
+}
+
+lcd_sink_t lcd_sink_fake(lcd_sink_fake_t* fake) {
+  lcd_sink_t sink = { .ops = &fake_ops, .self = fake };
+  return sink;
+}
+
+void lcd_sink_fake_line(const lcd_sink_fake_t* fake, uint8_t row, char* out) {
+  if (row >= LCD_SINK_FAKE_ROWS) row = LCD_SINK_FAKE_ROWS - 1;
+  memcpy(out, fake->ddram[row], LCD_SINK_FAKE_VISIBLE);
+  out[LCD_SINK_FAKE_VISIBLE] = '\0';
+}
+
+void lcd_sink_fake_reset_stats(lcd_sink_fake_t* fake) {
+  memset(&fake->stats, 0, sizeof(fake->stats));
+}
+
+// --- static function ---
+static void fake_set_cursor(void* self, uint8_t col, uint8_t row) {
+  lcd_sink_fake_t* fake = self;
+  fake->row = row < LCD_SINK_FAKE_ROWS ? row : LCD_SINK_FAKE_ROWS - 1;
+  fake->col = col < LCD_SINK_FAKE_COLS ? col : 0;
+  fake->stats.commands++;
+  fake->stats.bytes++;
+  fake->stats.i2c_writes += LCD_SINK_FAKE_I2C_PER_BYTE;
+}
+
+static void fake_write(void* self, const char* data, uint8_t len) {
+  lcd_sink_fake_t* fake = self;
+  for (uint8_t i = 0; i < len; i++) {
+    fake->ddram[fake->row][fake->col] = data[i];
+    // seperti HD44780 2 baris: baris 0 berlanjut ke baris 1 setelah 40 karakter
+    if (++fake->col == LCD_SINK_FAKE_COLS) {
+      fake->col = 0;
+      fake->row = (uint8_t) ((fake->row + 1) % LCD_SINK_FAKE_ROWS);
+    }
+  }
+  fake->stats.chars += len;
+  fake->stats.bytes += len;
+  fake->stats.i2c_writes += (uint64_t) len * LCD_SINK_FAKE_I2C_PER_BYTE;
+}
+
+#endif
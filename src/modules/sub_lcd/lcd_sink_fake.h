@@ -0,0 +1,55 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LCD_SINK_FAKE_H
+#define LCD_SINK_FAKE_H
+
+// Sink LCD untuk host (Linux): mensimulasikan DDRAM 16x2 + cursor HD44780 dan menghitung
+// byte yang dikirim. Di backpack PCF8574 (mode 4 bit) setiap byte LCD = 2 nibble x 2 byte
+// expander (EN high, EN low; drivers/hd44780_pcf8574.h), jadi i2c_writes = bytes * LCD_SINK_FAKE_I2C_PER_BYTE.
+// Akurasi protokol (nibble, strobe EN) diperiksa terpisah dengan drivers/hd44780_emu.
+
+#include "lcd_sink.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ESP_PLATFORM
+
+#define LCD_SINK_FAKE_COLS 40 // DDRAM per baris
+#define LCD_SINK_FAKE_ROWS 2
+#define LCD_SINK_FAKE_I2C_PER_BYTE 4
+
+typedef struct {
+  uint32_t commands; // set_cursor
+  uint32_t chars;
+  uint32_t bytes;    // commands + chars
+  uint64_t i2c_writes;
+} lcd_sink_fake_stats_t;
+
+typedef struct {
+  char ddram[LCD_SINK_FAKE_ROWS][LCD_SINK_FAKE_COLS];
+  uint8_t col;
+  uint8_t row;
+  lcd_sink_fake_stats_t stats;
+} lcd_sink_fake_t;
+
+void lcd_sink_fake_init(lcd_sink_fake_t* fake);
+
+// sink yang menulis ke `fake`
+lcd_sink_t lcd_sink_fake(lcd_sink_fake_t* fake);
+
+// isi yang terlihat (16 kolom) di baris `row`, '\0'-terminated; `out` minimal 17 byte
+void lcd_sink_fake_line(const lcd_sink_fake_t* fake, uint8_t row, char* out);
+
+void lcd_sink_fake_reset_stats(lcd_sink_fake_t* fake);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LCD_SINK_FAKE_H
@@ -0,0 +1,215 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "cal_engine.h"
+
+#include <math.h>
+#include <string.h>
+
+_Static_assert(CAL_MAX_POINTS <= UINT8_MAX, "point count must fit in uint8_t");
+_Static_assert((CAL_LUT_SIZE & (CAL_LUT_SIZE - 1)) == 0, "CAL_LUT_SIZE must be a power of two");
+_Static_assert(CAL_LUT_SIZE <= 64, "lut_knee_mask holds one bit per segment");
+
+// forward declaration
+static float piecewise_eval(const cal_model_t* model, int32_t raw);
+static void build_lut(cal_engine_t* engine);
+
+void cal_engine_init(cal_engine_t* engine) {
+  memset(engine, 0, sizeof(*engine));
+  engine->model.version = CAL_MODEL_VERSION;
+  engine->model.type = CAL_MODEL_NONE;
+}
+
+void cal_engine_begin(cal_engine_t* engine) {
+  engine->n = 0;
+  engine->x0 = 0;
+  engine->sx = engine->sy = engine->sxx = engine->sxy = 0.0;
+  engine->point_count = 0;
+  memset(&engine->candidate, 0, sizeof(engine->candidate));
+}
+
+bool cal_engine_add_point(cal_engine_t* engine, int32_t raw, float mass) {
+  if (engine->point_count >= CAL_MAX_POINTS) return false;
+
+  if (engine->n == 0) engine->x0 = raw;
+  double x = (double) raw - engine->x0;
+  engine->n++;
+  engine->sx += x;
+  engine->sy += mass;
+  engine->sxx += x * x;
+  engine->sxy += x * mass;
+
+  // simpan urut raw naik (insertion), untuk piecewise dan residual
+  uint8_t i = engine->point_count++;
+  while (i > 0 && engine->points[i - 1].raw > raw) {
+    engine->points[i] = engine->points[i - 1];
+    i--;
+  }
+  engine->points[i].raw = raw;
+  engine->points[i].mass = mass;
+  return true;
+}
+
+bool cal_engine_fit(cal_engine_t* engine, cal_model_type_t type, float max_linear_residual) {
+  if (engine->n < 2) return false;
+
+  double n = engine->n;
+  double denom = n * engine->sxx - engine->sx * engine->sx;
+  if (denom <= 0.0) return false;
+
+  double slope = (n * engine->sxy - engine->sx * engine->sy) / denom;
+  double offset = (engine->sy - slope * engine->sx) / n - slope * engine->x0;
+
+  cal_model_t* model = &engine->candidate;
+  memset(model, 0, sizeof(*model));
+  model->version = CAL_MODEL_VERSION;
+  model->slope = (float) slope;
+  model->offset = (float) offset;
+  model->point_count = engine->point_count;
+  memcpy(model->points, engine->points, sizeof(cal_point_t) * engine->point_count);
+
+  for (uint8_t i = 0; i < engine->point_count; i++) {
+    float residual = fabsf((float) (slope * engine->points[i].raw + offset) - engine->points[i].mass);
+    if (residual > model->max_residual) model->max_residual = residual;
+  }
+
+  if (type == CAL_MODEL_AUTO) {
+    type = model->max_residual <= max_linear_residual ? CAL_MODEL_LINEAR : CAL_MODEL_PIECEWISE;
+  }
+  if (type == CAL_MODEL_PIECEWISE) {
+    // dua titik dengan raw sama membuat segmen tak terdefinisi
+    for (uint8_t i = 1; i < engine->point_count; i++) {
+      if (engine->points[i].raw == engine->points[i - 1].raw) return false;
+    }
+  }
+  model->type = (uint8_t) type;
+  return true;
+}
+
+bool cal_engine_commit(cal_engine_t* engine) {
+  return cal_engine_load(engine, &engine->candidate);
+}
+
+bool cal_engine_load(cal_engine_t* engine, const cal_model_t* model) {
+  if (model == NULL || model->version != CAL_MODEL_VERSION) return false;
+  if (model->type != CAL_MODEL_LINEAR && model->type != CAL_MODEL_PIECEWISE) return false;
+  if (model->point_count < 2 || model->point_count > CAL_MAX_POINTS) return false;
+  if (!isfinite(model->slope) || !isfinite(model->offset) || model->slope == 0.0f) return false;
+
+  engine->model = *model;
+  build_lut(engine);
+  return true;
+}
+
+bool cal_engine_has_model(const cal_engine_t* engine) {
+  return engine->model.type == CAL_MODEL_LINEAR || engine->model.type == CAL_MODEL_PIECEWISE;
+}
+
+float cal_engine_eval(const cal_engine_t* engine, int32_t raw) {
+  if (engine->lut_valid) {
+    int64_t d = (int64_t) raw - engine->lut_min;
+    if (d >= 0) {
+      uint64_t i = (uint64_t) d >> engine->lut_shift;
+      if (i < CAL_LUT_SIZE && !(engine->lut_knee_mask & (1ULL << i))) {
+        int32_t within = (int32_t) (d - (int64_t) (i << engine->lut_shift));
+        return engine->lut_base[i] + (float) within * engine->lut_slope[i];
+      }
+    }
+  }
+  return cal_model_eval(&engine->model, raw);
+}
+
+float cal_model_eval(const cal_model_t* model, int32_t raw) {
+  switch (model->type) {
+    case CAL_MODEL_LINEAR:
+      return model->slope * (float) raw + model->offset;
+    case CAL_MODEL_PIECEWISE:
+      return piecewise_eval(model, raw);
+    default:
+      return 0.0f;
+  }
+}
+
+float cal_model_scale_factor(const cal_model_t* model) {
+  if (model->slope == 0.0f) return 0.0f;
+  return 1.0f / model->slope;
+}
+
+void cal_sample_reset(cal_sample_acc_t* acc) {
+  acc->n = 0;
+  acc->mean = 0.0;
+  acc->m2 = 0.0;
+}
+
+void cal_sample_add(cal_sample_acc_t* acc, int32_t raw, int32_t band) {
+  if (acc->n > 0 && fabs((double) raw - acc->mean) > band) {
+    cal_sample_reset(acc);
+  }
+  // Welford
+  acc->n++;
+  double delta = (double) raw - acc->mean;
+  acc->mean += delta / acc->n;
+  acc->m2 += delta * ((double) raw - acc->mean);
+}
+
+int32_t cal_sample_mean(const cal_sample_acc_t* acc) {
+  return (int32_t) lround(acc->mean);
+}
+
+float cal_sample_stddev(const cal_sample_acc_t* acc) {
+  if (acc->n < 2) return 0.0f;
+  return (float) sqrt(acc->m2 / (acc->n - 1));
+}
+
+// --- static function ---
+static float piecewise_eval(const cal_model_t* model, int32_t raw) {
+  // segmen pertama / terakhir diperpanjang untuk raw di luar titik kalibrasi
+  uint8_t seg = 0;
+  while (seg + 2 < model->point_count && raw > model->points[seg + 1].raw) {
+    seg++;
+  }
+  const cal_point_t* a = &model->points[seg];
+  const cal_point_t* b = &model->points[seg + 1];
+  float t = (float) ((double) raw - a->raw) / (float) ((double) b->raw - a->raw);
+  return a->mass + t * (b->mass - a->mass);
+}
+
+static void build_lut(cal_engine_t* engine) {
+  const cal_model_t* model = &engine->model;
+  int64_t lo = model->points[0].raw;
+  int64_t hi = model->points[model->point_count - 1].raw;
+  // range titik kalibrasi + 50% di kedua sisi (beban di atas titik tertinggi, tare negatif)
+  int64_t margin = (hi - lo) / 2 + 1;
+  lo -= margin;
+  hi += margin;
+  if (lo < INT32_MIN) lo = INT32_MIN;
+
+  uint8_t shift = 0;
+  while (((hi - lo) >> shift) >= CAL_LUT_SIZE && shift < 31) {
+    shift++;
+  }
+
+  engine->lut_min = (int32_t) lo;
+  engine->lut_shift = shift;
+  engine->lut_knee_mask = 0;
+  if (model->type == CAL_MODEL_PIECEWISE) {
+    // titik dalam (bukan ujung) mengubah kemiringan di tengah segmen: interpolasi segmen tidak tepat
+    for (uint8_t p = 1; p + 1 < model->point_count; p++) {
+      int64_t i = ((int64_t) model->points[p].raw - lo) >> shift;
+      if (i >= 0 && i < CAL_LUT_SIZE) engine->lut_knee_mask |= 1ULL << i;
+    }
+  }
+  int64_t width = (int64_t) 1 << shift;
+  for (uint32_t i = 0; i < CAL_LUT_SIZE; i++) {
+    int64_t x = lo + (int64_t) i * width;
+    int64_t x_end = x + width;
+    if (x > INT32_MAX) x = INT32_MAX;
+    if (x_end > INT32_MAX) x_end = INT32_MAX;
+    float start = cal_model_eval(model, (int32_t) x);
+    float end = cal_model_eval(model, (int32_t) x_end);
+    engine->lut_base[i] = start;
+    engine->lut_slope[i] = x_end > x ? (end - start) / (float) (x_end - x) : 0.0f;
+  }
+  engine->lut_valid = true;
+}
@@ -0,0 +1,120 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef CAL_ENGINE_H
+#define CAL_ENGINE_H
+
+// Kalibrasi load cell di Device B: raw HX711 -> massa (gram).
+//
+// - Titik referensi dikumpulkan saat kalibrasi; raw tiap titik adalah rata-rata sample yang stabil
+//   (cal_sample_acc_t, Welford, reset otomatis jika beban bergerak).
+// - Regresi linear streaming: hanya jumlah (n, sx, sy, sxx, sxy), memori O(1) berapapun titiknya.
+// - Jika residual linear terlalu besar, model piecewise-linear lewat titik-titik yang tersimpan.
+// - Hot path (setiap sample) memakai lookup table segmen: satu shift, satu index, satu multiply-add.
+//
+// Tanpa header ESP-IDF / FreeRTOS supaya bisa dites di host dengan data load cell sintetis.
+// Penyimpanan ke NVS dilakukan pemanggil dengan blob cal_model_t.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAL_MODEL_VERSION 1
+#define CAL_MAX_POINTS    8
+#define CAL_LUT_SIZE      64
+
+typedef enum {
+  CAL_MODEL_NONE = 0,
+  CAL_MODEL_LINEAR,
+  CAL_MODEL_PIECEWISE,
+  CAL_MODEL_AUTO, // hanya untuk cal_engine_fit: linear jika residual kecil, selain itu piecewise
+} cal_model_type_t;
+
+typedef struct {
+  int32_t raw;
+  float   mass;
+} cal_point_t;
+
+// disimpan apa adanya sebagai blob NVS, version dicek saat load
+typedef struct {
+  uint8_t     version;
+  uint8_t     type;        // cal_model_type_t
+  uint8_t     point_count;
+  float       slope;       // massa per count raw (least squares atas semua titik)
+  float       offset;      // massa = slope * raw + offset
+  float       max_residual; // residual terbesar fit linear (gram)
+  cal_point_t points[CAL_MAX_POINTS]; // urut raw naik, dipakai model piecewise
+} cal_model_t;
+
+// rata-rata raw selama beban diam
+typedef struct {
+  uint32_t n;
+  double   mean;
+  double   m2;
+} cal_sample_acc_t;
+
+typedef struct {
+  // titik kalibrasi yang sedang berjalan
+  uint32_t n;
+  int32_t  x0;  // raw titik pertama, semua jumlah dihitung relatif supaya double tidak kehilangan presisi
+  double   sx, sy, sxx, sxy;
+  cal_point_t points[CAL_MAX_POINTS];
+  uint8_t  point_count;
+  cal_model_t candidate;   // hasil cal_engine_fit, belum dipakai
+
+  // model aktif + lookup table
+  cal_model_t model;
+  bool     lut_valid;
+  int32_t  lut_min;
+  uint8_t  lut_shift;      // lebar segmen = 1 << lut_shift count raw
+  float    lut_base[CAL_LUT_SIZE];  // massa di awal segmen
+  float    lut_slope[CAL_LUT_SIZE]; // massa per count di dalam segmen
+  uint64_t lut_knee_mask;  // bit i = segmen i memuat titik patah piecewise, dihitung langsung
+} cal_engine_t;
+
+void cal_engine_init(cal_engine_t* engine);
+
+// mulai kalibrasi baru; model aktif tetap dipakai sampai cal_engine_commit
+void cal_engine_begin(cal_engine_t* engine);
+
+// false jika titik penuh
+bool cal_engine_add_point(cal_engine_t* engine, int32_t raw, float mass);
+
+// isi engine->candidate; false jika titik kurang (min 2) atau raw semua sama
+bool cal_engine_fit(cal_engine_t* engine, cal_model_type_t type, float max_linear_residual);
+
+// candidate -> model aktif, bangun lookup table
+bool cal_engine_commit(cal_engine_t* engine);
+
+// model dari NVS; false jika versi / isi tidak valid
+bool cal_engine_load(cal_engine_t* engine, const cal_model_t* model);
+
+bool cal_engine_has_model(const cal_engine_t* engine);
+
+// hot path, memakai lookup table; di luar range table dihitung langsung
+float cal_engine_eval(const cal_engine_t* engine, int32_t raw);
+
+// evaluasi tanpa lookup table (referensi untuk tes)
+float cal_model_eval(const cal_model_t* model, int32_t raw);
+
+// count raw per gram, format faktor skala HX711 untuk dikirim ke Device A
+float cal_model_scale_factor(const cal_model_t* model);
+
+void cal_sample_reset(cal_sample_acc_t* acc);
+
+// sample yang keluar dari `band` count raw terhadap rata-rata dianggap beban bergerak: mulai ulang
+void cal_sample_add(cal_sample_acc_t* acc, int32_t raw, int32_t band);
+
+int32_t cal_sample_mean(const cal_sample_acc_t* acc);
+
+float cal_sample_stddev(const cal_sample_acc_t* acc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //CAL_ENGINE_H
@@ -0,0 +1,208 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "main_fsm.h"
+
+#include <string.h>
+
+_Static_assert(MAIN_FSM_STATE_COUNT <= UINT8_MAX, "state must fit in uint8_t");
+_Static_assert(MAIN_EV_COUNT <= UINT8_MAX, "event must fit in uint8_t");
+_Static_assert(MAIN_ACT_COUNT <= UINT8_MAX, "action must fit in uint8_t");
+_Static_assert(MAIN_FSM_TRACE_LEN <= UINT8_MAX, "trace index must fit in uint8_t");
+
+#define T(act, nxt) { .action = (uint8_t) (act), .next = (uint8_t) (nxt) }
+
+// entry yang tidak ditulis = {MAIN_ACT_NONE, MAIN_FSM_STAY} = event diabaikan
+static const main_fsm_transition_t transitions[MAIN_FSM_STATE_COUNT][MAIN_EV_COUNT] = {
+  [MAIN_FSM_NORMAL] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_TARE,         MAIN_FSM_STAY),
+    [MAIN_EV_B_CLICK]      = T(MAIN_ACT_NEXT_UNIT,    MAIN_FSM_STAY),
+    [MAIN_EV_C_CLICK]      = T(MAIN_ACT_NEXT_PEER,    MAIN_FSM_STAY),
+    [MAIN_EV_D_CLICK]      = T(MAIN_ACT_TOGGLE_DIAG,  MAIN_FSM_STAY),
+    [MAIN_EV_B_LONG]       = T(MAIN_ACT_PAIR,         MAIN_FSM_STAY),
+    [MAIN_EV_C_LONG]       = T(MAIN_ACT_NEXT_VIEW,    MAIN_FSM_STAY),
+    [MAIN_EV_D_LONG]       = T(MAIN_ACT_DUMP_TRACE,   MAIN_FSM_STAY),
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_CAL_START,    MAIN_FSM_CAL_INIT),
+    [MAIN_EV_IDLE_TIMEOUT] = T(MAIN_ACT_SLEEP,        MAIN_FSM_SLEEP),
+  },
+  [MAIN_FSM_SLEEP] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+    [MAIN_EV_B_CLICK]      = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+    [MAIN_EV_C_CLICK]      = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+    [MAIN_EV_D_CLICK]      = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+    [MAIN_EV_WAKE]         = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+    [MAIN_EV_IDLE_TIMEOUT] = T(MAIN_ACT_DEEP_SLEEP,   MAIN_FSM_DEEPSLEEP),
+  },
+  [MAIN_FSM_DEEPSLEEP] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_WAKE_UP,      MAIN_FSM_WAKE_UP),
+  },
+  // Device A bisa tidak menjawab: IDLE_TIMEOUT dikirim main_task setelah batas waktu, tombol A / AB = keluar manual
+  [MAIN_FSM_WAKE_UP] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_WAKE_DONE,    MAIN_FSM_NORMAL),
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_WAKE_DONE,    MAIN_FSM_NORMAL),
+    [MAIN_EV_SAMPLE]       = T(MAIN_ACT_WAKE_DONE,    MAIN_FSM_NORMAL),
+    [MAIN_EV_IDLE_TIMEOUT] = T(MAIN_ACT_WAKE_DONE,    MAIN_FSM_NORMAL),
+  },
+  [MAIN_FSM_CAL_INIT] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_CAL_WAIT,     MAIN_FSM_CAL_WAITING),
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_CAL_CANCEL,   MAIN_FSM_NORMAL),
+  },
+  [MAIN_FSM_CAL_WAITING] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_CAL_INPUT,    MAIN_FSM_CAL_INPUT),
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_CAL_CANCEL,   MAIN_FSM_NORMAL),
+  },
+  [MAIN_FSM_CAL_INPUT] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_CAL_REVIEW,   MAIN_FSM_CAL_CONFIRMATION),
+    [MAIN_EV_B_CLICK]      = T(MAIN_ACT_CAL_INC,      MAIN_FSM_STAY),
+    [MAIN_EV_C_CLICK]      = T(MAIN_ACT_CAL_DEC,      MAIN_FSM_STAY),
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_CAL_CANCEL,   MAIN_FSM_NORMAL),
+  },
+  [MAIN_FSM_CAL_CONFIRMATION] = {
+    [MAIN_EV_A_CLICK]      = T(MAIN_ACT_CAL_CONFIRM,  MAIN_FSM_NORMAL),
+    [MAIN_EV_D_CLICK]      = T(MAIN_ACT_CAL_INPUT,    MAIN_FSM_CAL_INPUT), // tambah titik kalibrasi
+    [MAIN_EV_AB_LONG]      = T(MAIN_ACT_CAL_CANCEL,   MAIN_FSM_NORMAL),
+  },
+};
+
+#undef T
+
+_Static_assert(sizeof(transitions) / sizeof(transitions[0]) == MAIN_FSM_STATE_COUNT, "transition rows");
+_Static_assert(sizeof(transitions[0]) / sizeof(transitions[0][0]) == MAIN_EV_COUNT, "transition columns");
+
+static const char* const state_names[MAIN_FSM_STATE_COUNT] = {
+  [MAIN_FSM_STAY] = "STAY",
+  [MAIN_FSM_NORMAL] = "NORMAL",
+  [MAIN_FSM_SLEEP] = "SLEEP",
+  [MAIN_FSM_DEEPSLEEP] = "DEEPSLEEP",
+  [MAIN_FSM_WAKE_UP] = "WAKE_UP",
+  [MAIN_FSM_CAL_INIT] = "CAL_INIT",
+  [MAIN_FSM_CAL_WAITING] = "CAL_WAITING",
+  [MAIN_FSM_CAL_INPUT] = "CAL_INPUT",
+  [MAIN_FSM_CAL_CONFIRMATION] = "CAL_CONFIRMATION",
+};
+
+static const char* const event_names[MAIN_EV_COUNT] = {
+  [MAIN_EV_NONE] = "NONE",
+  [MAIN_EV_A_CLICK] = "A_CLICK",
+  [MAIN_EV_B_CLICK] = "B_CLICK",
+  [MAIN_EV_C_CLICK] = "C_CLICK",
+  [MAIN_EV_D_CLICK] = "D_CLICK",
+  [MAIN_EV_A_LONG] = "A_LONG",
+  [MAIN_EV_B_LONG] = "B_LONG",
+  [MAIN_EV_C_LONG] = "C_LONG",
+  [MAIN_EV_D_LONG] = "D_LONG",
+  [MAIN_EV_AB_LONG] = "AB_LONG",
+  [MAIN_EV_SAMPLE] = "SAMPLE",
+  [MAIN_EV_IDLE_TIMEOUT] = "IDLE_TIMEOUT",
+  [MAIN_EV_WAKE] = "WAKE",
+};
+
+static const char* const action_names[MAIN_ACT_COUNT] = {
+  [MAIN_ACT_NONE] = "NONE",
+  [MAIN_ACT_TARE] = "TARE",
+  [MAIN_ACT_NEXT_UNIT] = "NEXT_UNIT",
+  [MAIN_ACT_NEXT_PEER] = "NEXT_PEER",
+  [MAIN_ACT_TOGGLE_DIAG] = "TOGGLE_DIAG",
+  [MAIN_ACT_NEXT_VIEW] = "NEXT_VIEW",
+  [MAIN_ACT_DUMP_TRACE] = "DUMP_TRACE",
+  [MAIN_ACT_PAIR] = "PAIR",
+  [MAIN_ACT_SLEEP] = "SLEEP",
+  [MAIN_ACT_DEEP_SLEEP] = "DEEP_SLEEP",
+  [MAIN_ACT_WAKE_UP] = "WAKE_UP",
+  [MAIN_ACT_WAKE_DONE] = "WAKE_DONE",
+  [MAIN_ACT_CAL_START] = "CAL_START",
+  [MAIN_ACT_CAL_WAIT] = "CAL_WAIT",
+  [MAIN_ACT_CAL_INPUT] = "CAL_INPUT",
+  [MAIN_ACT_CAL_INC] = "CAL_INC",
+  [MAIN_ACT_CAL_DEC] = "CAL_DEC",
+  [MAIN_ACT_CAL_REVIEW] = "CAL_REVIEW",
+  [MAIN_ACT_CAL_CONFIRM] = "CAL_CONFIRM",
+  [MAIN_ACT_CAL_CANCEL] = "CAL_CANCEL",
+};
+
+void main_fsm_init(main_fsm_t* fsm, main_fsm_state_t initial, const main_fsm_handler_t* handlers, void* ctx) {
+  memset(fsm, 0, sizeof(*fsm));
+  fsm->state = (initial > MAIN_FSM_STAY && initial < MAIN_FSM_STATE_COUNT) ? initial : MAIN_FSM_NORMAL;
+  fsm->handlers = handlers;
+  fsm->ctx = ctx;
+}
+
+main_fsm_action_t main_fsm_dispatch(main_fsm_t* fsm, main_fsm_event_t event, uint32_t now_ms) {
+  const main_fsm_transition_t* t = main_fsm_lookup(fsm->state, event);
+  if (t == NULL || (t->action == MAIN_ACT_NONE && t->next == MAIN_FSM_STAY)) {
+    fsm->ignored++;
+    return MAIN_ACT_NONE;
+  }
+
+  main_fsm_state_t from = fsm->state;
+  main_fsm_state_t to = t->next == MAIN_FSM_STAY ? from : (main_fsm_state_t) t->next;
+  main_fsm_action_t action = (main_fsm_action_t) t->action;
+
+  main_fsm_trace_t* entry = &fsm->trace[fsm->trace_head];
+  entry->time_ms = now_ms;
+  entry->from = (uint8_t) from;
+  entry->event = (uint8_t) event;
+  entry->action = (uint8_t) action;
+  entry->to = (uint8_t) to;
+  fsm->trace_head = (fsm->trace_head + 1) % MAIN_FSM_TRACE_LEN;
+  if (fsm->trace_count < MAIN_FSM_TRACE_LEN) fsm->trace_count++;
+  fsm->transitions++;
+
+  // handler masih melihat state lama, misal untuk tahu dari mana cancel dipanggil
+  if (fsm->handlers != NULL && fsm->handlers[action] != NULL) {
+    fsm->handlers[action](action, fsm->ctx);
+  }
+  fsm->state = to;
+  return action;
+}
+
+const main_fsm_transition_t* main_fsm_lookup(main_fsm_state_t state, main_fsm_event_t event) {
+  if (state >= MAIN_FSM_STATE_COUNT || event >= MAIN_EV_COUNT) return NULL;
+  return &transitions[state][event];
+}
+
+main_state_t main_fsm_main_state(main_fsm_state_t state) {
+  switch (state) {
+    case MAIN_FSM_SLEEP:     return SLEEP_MODE;
+    case MAIN_FSM_DEEPSLEEP: return DEEPSLEEP_MODE;
+    case MAIN_FSM_WAKE_UP:   return WAKE_UP_MODE;
+    case MAIN_FSM_CAL_INIT:
+    case MAIN_FSM_CAL_WAITING:
+    case MAIN_FSM_CAL_INPUT:
+    case MAIN_FSM_CAL_CONFIRMATION:
+      return CALIBRATION_MODE;
+    case MAIN_FSM_NORMAL:
+    default:
+      return NORMAL_MODE;
+  }
+}
+
+calibration_state_t main_fsm_cal_state(main_fsm_state_t state) {
+  switch (state) {
+    case MAIN_FSM_CAL_INIT:         return CAL_INIT;
+    case MAIN_FSM_CAL_WAITING:      return CAL_WAITING;
+    case MAIN_FSM_CAL_INPUT:        return CAL_INPUT;
+    case MAIN_FSM_CAL_CONFIRMATION: return CAL_CONFIRMATION;
+    default:                        return CAL_UNKNOWN;
+  }
+}
+
+bool main_fsm_trace_get(const main_fsm_t* fsm, uint8_t index, main_fsm_trace_t* entry) {
+  if (index >= fsm->trace_count || entry == NULL) return false;
+  uint8_t slot = (uint8_t) ((fsm->trace_head + MAIN_FSM_TRACE_LEN - 1 - index) % MAIN_FSM_TRACE_LEN);
+  *entry = fsm->trace[slot];
+  return true;
+}
+
+const char* main_fsm_state_name(main_fsm_state_t state) {
+  return state < MAIN_FSM_STATE_COUNT ? state_names[state] : "UNKNOWN";
+}
+
+const char* main_fsm_event_name(main_fsm_event_t event) {
+  return event < MAIN_EV_COUNT ? event_names[event] : "UNKNOWN";
+}
+
+const char* main_fsm_action_name(main_fsm_action_t action) {
+  return action < MAIN_ACT_COUNT ? action_names[action] : "UNKNOWN";
+}
@@ -0,0 +1,131 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef MAIN_FSM_H
+#define MAIN_FSM_H
+
+// State machine main_task (main mode + sub-state kalibrasi) dalam satu tabel transisi
+// state x event -> (action, next state). Dispatch O(1) lewat index tabel, tabel dicek saat compile.
+// Action dijalankan lewat array handler dari pemakai, jadi FSM ini tidak tahu FreeRTOS / LCD
+// dan bisa dijalankan (dan dites exhaustive) di host.
+//
+// Setiap transisi yang terjadi dicatat di ring trace untuk debugging post-mortem.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAIN_FSM_TRACE_LEN 32
+
+typedef enum {
+  MAIN_FSM_STAY = 0, // hanya untuk kolom next di tabel: tetap di state sekarang
+  MAIN_FSM_NORMAL,
+  MAIN_FSM_SLEEP,
+  MAIN_FSM_DEEPSLEEP,
+  MAIN_FSM_WAKE_UP,
+  MAIN_FSM_CAL_INIT,
+  MAIN_FSM_CAL_WAITING,
+  MAIN_FSM_CAL_INPUT,
+  MAIN_FSM_CAL_CONFIRMATION,
+  MAIN_FSM_STATE_COUNT,
+} main_fsm_state_t;
+
+typedef enum {
+  MAIN_EV_NONE = 0,
+  MAIN_EV_A_CLICK,
+  MAIN_EV_B_CLICK,
+  MAIN_EV_C_CLICK,
+  MAIN_EV_D_CLICK,
+  MAIN_EV_A_LONG,
+  MAIN_EV_B_LONG,
+  MAIN_EV_C_LONG,
+  MAIN_EV_D_LONG,
+  MAIN_EV_AB_LONG,
+  MAIN_EV_SAMPLE,       // sample baru dari peer yang ditampilkan
+  MAIN_EV_IDLE_TIMEOUT, // tidak ada interaksi selama batas waktu (power manager)
+  MAIN_EV_WAKE,         // aktivitas selain tombol saat sleep (berat berubah)
+  MAIN_EV_COUNT,
+} main_fsm_event_t;
+
+typedef enum {
+  MAIN_ACT_NONE = 0,
+  MAIN_ACT_TARE,
+  MAIN_ACT_NEXT_UNIT,
+  MAIN_ACT_NEXT_PEER,
+  MAIN_ACT_TOGGLE_DIAG,
+  MAIN_ACT_NEXT_VIEW,     // teks / angka besar / bar graph target
+  MAIN_ACT_DUMP_TRACE,
+  MAIN_ACT_PAIR,          // buka jendela pairing node load cell baru
+  MAIN_ACT_SLEEP,
+  MAIN_ACT_DEEP_SLEEP,
+  MAIN_ACT_WAKE_UP,
+  MAIN_ACT_WAKE_DONE,
+  MAIN_ACT_CAL_START,
+  MAIN_ACT_CAL_WAIT,      // beban kosong sudah dibaca, minta beban referensi
+  MAIN_ACT_CAL_INPUT,     // beban referensi terpasang, masukkan massa
+  MAIN_ACT_CAL_INC,
+  MAIN_ACT_CAL_DEC,
+  MAIN_ACT_CAL_REVIEW,
+  MAIN_ACT_CAL_CONFIRM,
+  MAIN_ACT_CAL_CANCEL,
+  MAIN_ACT_COUNT,
+} main_fsm_action_t;
+
+typedef struct {
+  uint8_t action; // main_fsm_action_t
+  uint8_t next;   // main_fsm_state_t, MAIN_FSM_STAY = tidak pindah
+} main_fsm_transition_t;
+
+typedef struct {
+  uint32_t time_ms;
+  uint8_t  from;
+  uint8_t  event;
+  uint8_t  action;
+  uint8_t  to;
+} main_fsm_trace_t;
+
+typedef void (*main_fsm_handler_t)(main_fsm_action_t action, void* ctx);
+
+typedef struct {
+  main_fsm_state_t state;
+  const main_fsm_handler_t* handlers; // MAIN_ACT_COUNT entry, NULL = tidak ada handler
+  void* ctx;
+  main_fsm_trace_t trace[MAIN_FSM_TRACE_LEN];
+  uint8_t  trace_head;  // slot berikutnya yang ditulis
+  uint8_t  trace_count;
+  uint32_t transitions;
+  uint32_t ignored;     // event tanpa entry di tabel untuk state sekarang
+} main_fsm_t;
+
+void main_fsm_init(main_fsm_t* fsm, main_fsm_state_t initial, const main_fsm_handler_t* handlers, void* ctx);
+
+// action dijalankan sebelum state berubah; return action yang dijalankan (MAIN_ACT_NONE jika diabaikan)
+main_fsm_action_t main_fsm_dispatch(main_fsm_t* fsm, main_fsm_event_t event, uint32_t now_ms);
+
+// entry tabel tanpa menjalankan apa pun
+const main_fsm_transition_t* main_fsm_lookup(main_fsm_state_t state, main_fsm_event_t event);
+
+main_state_t main_fsm_main_state(main_fsm_state_t state);
+
+// CAL_UNKNOWN jika bukan state kalibrasi
+calibration_state_t main_fsm_cal_state(main_fsm_state_t state);
+
+// index 0 = transisi terbaru; false jika index melebihi isi trace
+bool main_fsm_trace_get(const main_fsm_t* fsm, uint8_t index, main_fsm_trace_t* entry);
+
+const char* main_fsm_state_name(main_fsm_state_t state);
+
+const char* main_fsm_event_name(main_fsm_event_t event);
+
+const char* main_fsm_action_name(main_fsm_action_t action);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MAIN_FSM_H
@@ -0,0 +1,53 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "main_reactor.h"
+
+#include <string.h>
+
+void main_reactor_init(main_reactor_t* reactor, const main_reactor_io_t* io) {
+  memset(reactor, 0, sizeof(*reactor));
+  reactor->io = *io;
+  latency_hist_reset(&reactor->stats.iteration);
+}
+
+uint32_t main_reactor_step(main_reactor_t* reactor) {
+  const main_reactor_io_t* io = &reactor->io;
+  uint32_t events = io->drain_samples(io->ctx);
+  bool dispatched = false;
+
+  main_fsm_event_t event;
+  while (io->next_button(io->ctx, &event)) {
+    bool dark = io->screen_dark(io->ctx);
+    io->button_activity(io->ctx);
+    events++;
+    // SLEEP dibangunkan lewat tabel FSM, hanya NORMAL yang menelan tekan pertama
+    if (dark && io->state(io->ctx) == NORMAL_MODE) {
+      reactor->stats.screen_wakes++;
+      continue;
+    }
+    io->dispatch(io->ctx, event);
+    dispatched = true;
+  }
+  // tombol sudah me-render ulang layar dengan sample terbaru
+  if (!dispatched && events > 0) io->dispatch(io->ctx, MAIN_EV_SAMPLE);
+  return events;
+}
+
+void main_reactor_record(main_reactor_t* reactor, uint32_t events, bool idle, int64_t wake_us, int64_t done_us) {
+  main_task_loop_stats_t* stats = &reactor->stats;
+  stats->iterations++;
+  stats->events += events;
+  if (idle) stats->idle_wakeups++;
+  if (events > stats->max_batch) stats->max_batch = events;
+  latency_hist_record(&stats->iteration, done_us > wake_us ? (uint32_t) (done_us - wake_us) : 0);
+
+  reactor->rate_window_events += events;
+  int64_t window_us = done_us - reactor->rate_window_start_us;
+  if (window_us >= MAIN_REACTOR_RATE_WINDOW_US) {
+    stats->events_per_sec = (uint32_t) ((int64_t) reactor->rate_window_events * 1000000 / window_us);
+    reactor->rate_window_events = 0;
+    reactor->rate_window_start_us = done_us;
+  }
+}
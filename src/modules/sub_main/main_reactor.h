@@ -0,0 +1,76 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef MAIN_REACTOR_H
+#define MAIN_REACTOR_H
+
+// Kebijakan satu iterasi loop reactor main_task, tanpa FreeRTOS supaya bisa dites di host.
+// main_task hanya block di notifikasi lalu memanggil main_reactor_step(); sumber event,
+// power manager dan FSM dihubungkan lewat io.
+//
+// Satu iterasi:
+//   1. sample dari comm dikuras sampai habis (yang ditampilkan cukup yang terbaru)
+//   2. setiap button event diproses satu per satu supaya tidak ada klik yang hilang;
+//      layar gelap di NORMAL_MODE: tekan pertama hanya menyalakan layar, tidak di-dispatch
+//   3. MAIN_EV_SAMPLE dikirim ke FSM hanya jika ada event dan tidak ada tombol yang di-dispatch
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+#include "utils/latency_hist.h"
+#include "main_fsm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// jendela hitung events_per_sec
+#define MAIN_REACTOR_RATE_WINDOW_US 1000000
+
+// instrumentasi loop reactor main_task
+typedef struct {
+  uint32_t iterations;
+  uint32_t idle_wakeups;   // bangun karena MAIN_TASK_IDLE_TICK_MS, tanpa event
+  uint32_t events;         // button event + sample dari comm
+  uint32_t events_per_sec; // dari jendela 1 detik terakhir
+  uint32_t max_batch;      // event terbanyak dalam satu iterasi
+  uint32_t cmd_dropped;    // command ke comm_task dibuang karena queue penuh (tidak pernah menunggu)
+  uint32_t screen_wakes;   // tekan tombol yang hanya menyalakan layar
+  latency_hist_t iteration; // waktu proses satu iterasi setelah bangun (us)
+} main_task_loop_stats_t;
+
+typedef struct {
+  // kuras semua sample yang antri, return jumlahnya
+  uint32_t (*drain_samples)(void* ctx);
+  // ambil satu button event yang sudah dipetakan ke event FSM (MAIN_EV_NONE jika tidak ada mapping);
+  // return false jika queue kosong
+  bool (*next_button)(void* ctx, main_fsm_event_t* event);
+  // layar gelap (power manager tidak ACTIVE), dibaca sebelum tombol dicatat sebagai aktivitas
+  bool (*screen_dark)(void* ctx);
+  void (*button_activity)(void* ctx);
+  main_state_t (*state)(void* ctx);
+  void (*dispatch)(void* ctx, main_fsm_event_t event);
+  void* ctx;
+} main_reactor_io_t;
+
+typedef struct {
+  main_reactor_io_t io;
+  main_task_loop_stats_t stats;
+  int64_t rate_window_start_us;
+  uint32_t rate_window_events;
+} main_reactor_t;
+
+void main_reactor_init(main_reactor_t* reactor, const main_reactor_io_t* io);
+
+// satu iterasi setelah bangun; return jumlah event (sample + button)
+uint32_t main_reactor_step(main_reactor_t* reactor);
+
+// catat iterasi ke stats; idle = bangun karena tick tanpa notifikasi dan tanpa event
+void main_reactor_record(main_reactor_t* reactor, uint32_t events, bool idle, int64_t wake_us, int64_t done_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //MAIN_REACTOR_H
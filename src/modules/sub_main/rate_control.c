@@ -0,0 +1,115 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "rate_control.h"
+
+#include <math.h>
+#include <string.h>
+
+static const rate_control_config_t default_config = {
+  .interval_ms = {
+    [RATE_FAST] = 50,
+    [RATE_NORMAL] = 200,
+    [RATE_IDLE] = 1000,
+    [RATE_HEARTBEAT] = 5000,
+  },
+  .change_threshold = 2.0f,
+  .settle_ms = 2000,
+  .idle_after_ms = 30000,
+};
+
+// forward declaration
+static rate_level_t pick_level(rate_control_t* rc, main_state_t state, float units, int64_t now_ms);
+static void account_time(rate_control_t* rc, int64_t now_ms);
+
+void rate_control_init(rate_control_t* rc, const rate_control_config_t* config) {
+  memset(rc, 0, sizeof(*rc));
+  rc->config = config != NULL ? *config : default_config;
+  for (uint8_t i = 0; i < RATE_LEVEL_COUNT; i++) {
+    if (rc->config.interval_ms[i] == 0) rc->config.interval_ms[i] = default_config.interval_ms[i];
+  }
+  rc->level = RATE_NORMAL;
+}
+
+bool rate_control_update(rate_control_t* rc, main_state_t state, float units, int64_t now_ms, uint32_t* interval_ms) {
+  if (rc->started) {
+    account_time(rc, now_ms);
+  } else {
+    rc->reference = units;
+    rc->last_change_ms = now_ms;
+  }
+  rc->last_update_ms = now_ms;
+
+  rate_level_t level = pick_level(rc, state, units, now_ms);
+  if (rc->started && level == rc->level) return false;
+
+  rc->started = true;
+  rc->level = level;
+  rc->level_frames_rem = 0;
+  rc->stats.requests++;
+  if (interval_ms != NULL) *interval_ms = rc->config.interval_ms[level];
+  return true;
+}
+
+void rate_control_reset(rate_control_t* rc) {
+  // statistik tetap, level dianggap belum pernah dikirim
+  rc->started = false;
+}
+
+uint32_t rate_control_interval(const rate_control_t* rc, rate_level_t level) {
+  if (level >= RATE_LEVEL_COUNT) return 0;
+  return rc->config.interval_ms[level];
+}
+
+const char* rate_control_level_name(rate_level_t level) {
+  switch (level) {
+    case RATE_FAST:      return "FAST";
+    case RATE_NORMAL:    return "NORMAL";
+    case RATE_IDLE:      return "IDLE";
+    case RATE_HEARTBEAT: return "HEARTBEAT";
+    default:             return "UNKNOWN";
+  }
+}
+
+// --- static function ---
+static rate_level_t pick_level(rate_control_t* rc, main_state_t state, float units, int64_t now_ms) {
+  switch (state) {
+    case CALIBRATION_MODE:
+      return RATE_FAST;
+    case SLEEP_MODE:
+    case DEEPSLEEP_MODE:
+      return RATE_HEARTBEAT;
+    case WAKE_UP_MODE:
+      rc->last_change_ms = now_ms;
+      return RATE_NORMAL;
+    case NORMAL_MODE:
+    default:
+      break;
+  }
+
+  if (fabsf(units - rc->reference) >= rc->config.change_threshold) {
+    rc->reference = units;
+    rc->last_change_ms = now_ms;
+    return RATE_FAST;
+  }
+
+  int64_t still_ms = now_ms - rc->last_change_ms;
+  if (still_ms < rc->config.settle_ms) {
+    // FAST bertahan sampai berat stabil; selain itu (baru start / bangun) cukup NORMAL
+    return rc->level == RATE_FAST ? RATE_FAST : RATE_NORMAL;
+  }
+  if (still_ms < rc->config.idle_after_ms) return RATE_NORMAL;
+  return RATE_IDLE;
+}
+
+static void account_time(rate_control_t* rc, int64_t now_ms) {
+  if (now_ms <= rc->last_update_ms) return;
+  uint64_t elapsed_ms = (uint64_t) (now_ms - rc->last_update_ms);
+  uint32_t interval = rc->config.interval_ms[rc->level];
+
+  rc->stats.time_in_level_ms[rc->level] += elapsed_ms;
+  rc->level_frames_rem += elapsed_ms;
+  rc->stats.expected_frames += rc->level_frames_rem / interval;
+  rc->level_frames_rem %= interval;
+}
@@ -0,0 +1,77 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef RATE_CONTROL_H
+#define RATE_CONTROL_H
+
+// Kebijakan kecepatan streaming Device A, diputuskan di Device B dan dikirim lewat CMD_SET_RATE
+// (value = interval sample dalam ms).
+//
+//   CALIBRATION_MODE          -> FAST
+//   NORMAL_MODE, berat berubah -> FAST, lalu NORMAL setelah settle_ms, IDLE setelah idle_after_ms
+//   WAKE_UP_MODE              -> NORMAL
+//   SLEEP_MODE / DEEPSLEEP    -> HEARTBEAT
+//
+// Hanya perubahan level yang menghasilkan command. Waktu diberikan dari luar (ms) supaya
+// skenario pemakaian bisa disimulasikan di host; time_in_level_ms dan expected_frames
+// memberi perkiraan frame yang dikirim Device A.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  RATE_FAST = 0,
+  RATE_NORMAL,
+  RATE_IDLE,
+  RATE_HEARTBEAT,
+  RATE_LEVEL_COUNT,
+} rate_level_t;
+
+typedef struct {
+  uint32_t interval_ms[RATE_LEVEL_COUNT];
+  float    change_threshold;  // perubahan berat (units) yang dianggap "bergerak"
+  uint32_t settle_ms;         // tetap FAST selama ini setelah perubahan terakhir
+  uint32_t idle_after_ms;     // turun ke IDLE jika berat diam selama ini
+} rate_control_config_t;
+
+typedef struct {
+  uint32_t requests;          // jumlah CMD_SET_RATE yang diminta
+  uint64_t time_in_level_ms[RATE_LEVEL_COUNT];
+  uint64_t expected_frames;   // perkiraan frame Device A (waktu / interval per level)
+} rate_control_stats_t;
+
+typedef struct {
+  rate_control_config_t config;
+  rate_level_t level;
+  bool     started;
+  float    reference;         // berat saat terakhir dianggap berubah
+  int64_t  last_change_ms;
+  int64_t  last_update_ms;
+  uint64_t level_frames_rem;  // sisa (ms) pembagian waktu / interval, supaya expected_frames tidak drift
+  rate_control_stats_t stats;
+} rate_control_t;
+
+// config NULL = default (50 / 200 / 1000 / 5000 ms)
+void rate_control_init(rate_control_t* rc, const rate_control_config_t* config);
+
+// return true jika level berubah dan interval baru perlu dikirim; interval ditulis ke `interval_ms`
+bool rate_control_update(rate_control_t* rc, main_state_t state, float units, int64_t now_ms, uint32_t* interval_ms);
+
+// paksa level dikirim ulang pada update berikutnya (mis. peer yang ditampilkan berganti)
+void rate_control_reset(rate_control_t* rc);
+
+uint32_t rate_control_interval(const rate_control_t* rc, rate_level_t level);
+
+const char* rate_control_level_name(rate_level_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //RATE_CONTROL_H
@@ -0,0 +1,200 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "weight_filter.h"
+
+#include <string.h>
+
+// ALPHA_BETA: jeda lebih dari ini dianggap stream terputus, estimasi mulai ulang dari sample
+#define WEIGHT_FILTER_GAP_US    2000000
+
+static const weight_filter_config_t preset_normal = {
+  .stages = {
+    { .type = WEIGHT_FILTER_MEDIAN, .window = 5 },
+    { .type = WEIGHT_FILTER_ALPHA_BETA, .alpha = 0.35f, .beta = 0.02f },
+  },
+  .stage_count = 2,
+};
+
+// kalibrasi: layar hanya panduan (titik diambil dari raw), yang penting angka diam saat beban diam
+static const weight_filter_config_t preset_calibration = {
+  .stages = {
+    { .type = WEIGHT_FILTER_MEDIAN, .window = 3 },
+    { .type = WEIGHT_FILTER_MOVING_AVG, .window = 8 },
+  },
+  .stage_count = 2,
+};
+
+static const char* const type_names[WEIGHT_FILTER_TYPE_COUNT] = {
+  [WEIGHT_FILTER_NONE] = "NONE",
+  [WEIGHT_FILTER_MOVING_AVG] = "AVG",
+  [WEIGHT_FILTER_MEDIAN] = "MEDIAN",
+  [WEIGHT_FILTER_ALPHA_BETA] = "AB",
+};
+
+// forward declaration
+static bool stage_config_valid(const weight_filter_stage_config_t* config);
+static void stage_reset(weight_filter_stage_t* stage);
+static float moving_avg_push(weight_filter_stage_t* stage, float value);
+static float median_push(weight_filter_stage_t* stage, float value);
+static float alpha_beta_push(weight_filter_stage_t* stage, float value, int64_t now_us);
+
+void weight_filter_init(weight_filter_t* filter, const weight_filter_config_t* config) {
+  memset(filter, 0, sizeof(*filter));
+  if (config == NULL) config = &preset_normal;
+
+  for (uint8_t i = 0; i < config->stage_count && i < WEIGHT_FILTER_MAX_STAGES; i++) {
+    if (!stage_config_valid(&config->stages[i])) continue;
+    filter->stages[filter->stage_count++].config = config->stages[i];
+  }
+}
+
+void weight_filter_reset(weight_filter_t* filter) {
+  for (uint8_t i = 0; i < filter->stage_count; i++) {
+    stage_reset(&filter->stages[i]);
+  }
+  filter->output = 0.0f;
+  filter->samples = 0;
+}
+
+float weight_filter_push(weight_filter_t* filter, float value, int64_t now_us) {
+  for (uint8_t i = 0; i < filter->stage_count; i++) {
+    weight_filter_stage_t* stage = &filter->stages[i];
+    switch (stage->config.type) {
+      case WEIGHT_FILTER_MOVING_AVG:
+        value = moving_avg_push(stage, value);
+        break;
+      case WEIGHT_FILTER_MEDIAN:
+        value = median_push(stage, value);
+        break;
+      case WEIGHT_FILTER_ALPHA_BETA:
+        value = alpha_beta_push(stage, value, now_us);
+        break;
+      default:
+        break;
+    }
+  }
+  filter->output = value;
+  filter->samples++;
+  return value;
+}
+
+const weight_filter_config_t* weight_filter_preset(main_state_t state) {
+  return state == CALIBRATION_MODE ? &preset_calibration : &preset_normal;
+}
+
+float weight_filter_delay_samples(const weight_filter_t* filter) {
+  float delay = 0.0f;
+  for (uint8_t i = 0; i < filter->stage_count; i++) {
+    const weight_filter_stage_config_t* config = &filter->stages[i].config;
+    switch (config->type) {
+      case WEIGHT_FILTER_MOVING_AVG:
+      case WEIGHT_FILTER_MEDIAN:
+        delay += (config->window - 1) / 2.0f;
+        break;
+      case WEIGHT_FILTER_ALPHA_BETA:
+        // dengan beta > 0 kecepatan ikut dilacak, lag untuk ramp konstan hilang
+        if (config->beta <= 0.0f) delay += (1.0f - config->alpha) / config->alpha;
+        break;
+      default:
+        break;
+    }
+  }
+  return delay;
+}
+
+const char* weight_filter_type_name(weight_filter_type_t type) {
+  if (type >= WEIGHT_FILTER_TYPE_COUNT) return "UNKNOWN";
+  return type_names[type];
+}
+
+// --- static function ---
+static bool stage_config_valid(const weight_filter_stage_config_t* config) {
+  switch (config->type) {
+    case WEIGHT_FILTER_MOVING_AVG:
+    case WEIGHT_FILTER_MEDIAN:
+      return config->window >= 1 && config->window <= WEIGHT_FILTER_WINDOW_MAX;
+    case WEIGHT_FILTER_ALPHA_BETA:
+      return config->alpha > 0.0f && config->alpha <= 1.0f && config->beta >= 0.0f && config->beta < 2.0f;
+    default:
+      return false;
+  }
+}
+
+static void stage_reset(weight_filter_stage_t* stage) {
+  weight_filter_stage_config_t config = stage->config;
+  memset(stage, 0, sizeof(*stage));
+  stage->config = config;
+}
+
+static float moving_avg_push(weight_filter_stage_t* stage, float value) {
+  uint8_t window = stage->config.window;
+  if (stage->count < window) {
+    stage->count++;
+  } else {
+    stage->sum -= stage->ring[stage->head];
+  }
+  stage->ring[stage->head] = value;
+  stage->sum += value;
+
+  if (++stage->head >= window) {
+    stage->head = 0;
+    if (++stage->wraps >= 64) {
+      // hitung ulang dari ring, O(window) sekali tiap 64 putaran
+      stage->wraps = 0;
+      stage->sum = 0.0f;
+      for (uint8_t i = 0; i < stage->count; i++) stage->sum += stage->ring[i];
+    }
+  }
+  return stage->sum / stage->count;
+}
+
+static float median_push(weight_filter_stage_t* stage, float value) {
+  uint8_t window = stage->config.window;
+  uint8_t n = stage->count;
+
+  if (n == window) {
+    // keluarkan sample tertua dari array urut
+    float old = stage->ring[stage->head];
+    uint8_t i = 0;
+    while (i < n - 1 && stage->sorted[i] != old) i++;
+    memmove(&stage->sorted[i], &stage->sorted[i + 1], sizeof(float) * (n - 1 - i));
+    n--;
+  }
+  stage->ring[stage->head] = value;
+  if (++stage->head >= window) stage->head = 0;
+
+  // insertion ke posisi urut
+  uint8_t i = n;
+  while (i > 0 && stage->sorted[i - 1] > value) {
+    stage->sorted[i] = stage->sorted[i - 1];
+    i--;
+  }
+  stage->sorted[i] = value;
+  stage->count = ++n;
+
+  if (n & 1) return stage->sorted[n / 2];
+  return (stage->sorted[n / 2 - 1] + stage->sorted[n / 2]) / 2.0f;
+}
+
+static float alpha_beta_push(weight_filter_stage_t* stage, float value, int64_t now_us) {
+  int64_t gap_us = now_us - stage->last_us;
+  stage->last_us = now_us;
+  if (!stage->tracking || gap_us > WEIGHT_FILTER_GAP_US || gap_us < 0) {
+    stage->tracking = true;
+    stage->x = value;
+    stage->v = 0.0f;
+    return value;
+  }
+
+  // rate stream berubah (rate control, batch, frame hilang): prediksi mengikuti dt sebenarnya.
+  // alpha / beta tetap tanpa satuan, koreksi kecepatan dibagi dt
+  float dt = (float) gap_us * 1e-6f;
+  float predicted = stage->x + stage->v * dt;
+  float residual = value - predicted;
+  stage->x = predicted + stage->config.alpha * residual;
+  // dua sample dengan timestamp sama: hanya posisi yang dikoreksi
+  if (gap_us > 0) stage->v += stage->config.beta * residual / dt;
+  return stage->x;
+}
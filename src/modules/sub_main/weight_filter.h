@@ -0,0 +1,93 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef WEIGHT_FILTER_H
+#define WEIGHT_FILTER_H
+
+// Pipeline filter untuk sample berat yang diterima Device B, supaya jitter radio dan getaran
+// mekanis tidak membuat angka di LCD berkedip.
+//
+// Stage dijalankan berurutan (output stage i = input stage i+1):
+//   MOVING_AVG  rata-rata N sample terakhir, running sum O(1)
+//   MEDIAN      median N sample terakhir, buang spike satu-dua sample
+//   ALPHA_BETA  tracker posisi + kecepatan (Kalman steady-state 1D), prediksi diskalakan dt antar sample
+//
+// Semua buffer ukuran tetap di dalam struct (tanpa heap). Tanpa header ESP-IDF / FreeRTOS
+// supaya bisa di-benchmark dan di-replay dengan trace rekaman di host.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <data_type.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WEIGHT_FILTER_MAX_STAGES 3
+#define WEIGHT_FILTER_WINDOW_MAX 16
+
+typedef enum {
+  WEIGHT_FILTER_NONE = 0,
+  WEIGHT_FILTER_MOVING_AVG,
+  WEIGHT_FILTER_MEDIAN,
+  WEIGHT_FILTER_ALPHA_BETA,
+  WEIGHT_FILTER_TYPE_COUNT,
+} weight_filter_type_t;
+
+typedef struct {
+  uint8_t type;     // weight_filter_type_t
+  uint8_t window;   // MOVING_AVG / MEDIAN, 1..WEIGHT_FILTER_WINDOW_MAX
+  float   alpha;    // ALPHA_BETA: koreksi posisi (0..1], besar = cepat tapi noise lolos
+  float   beta;     // ALPHA_BETA: koreksi kecepatan, 0 = filter alpha biasa
+} weight_filter_stage_config_t;
+
+typedef struct {
+  weight_filter_stage_config_t stages[WEIGHT_FILTER_MAX_STAGES];
+  uint8_t stage_count;
+} weight_filter_config_t;
+
+typedef struct {
+  weight_filter_stage_config_t config;
+  float   ring[WEIGHT_FILTER_WINDOW_MAX];
+  float   sorted[WEIGHT_FILTER_WINDOW_MAX]; // MEDIAN: isi ring, urut naik
+  uint8_t head;
+  uint8_t count;
+  float   sum;       // MOVING_AVG
+  uint8_t wraps;     // MOVING_AVG: sum dihitung ulang berkala supaya error float tidak menumpuk
+  bool    tracking;  // ALPHA_BETA sudah punya estimasi
+  float   x;         // ALPHA_BETA: posisi (units)
+  float   v;         // ALPHA_BETA: kecepatan (units / detik)
+  int64_t last_us;   // ALPHA_BETA: waktu sample terakhir, untuk dt dan deteksi jeda
+} weight_filter_stage_t;
+
+typedef struct {
+  weight_filter_stage_t stages[WEIGHT_FILTER_MAX_STAGES];
+  uint8_t  stage_count;
+  float    output;
+  uint32_t samples;
+} weight_filter_t;
+
+// config NULL = preset NORMAL_MODE; stage yang tidak valid diabaikan
+void weight_filter_init(weight_filter_t* filter, const weight_filter_config_t* config);
+
+// buang riwayat (mis. tare, ganti peer) tanpa mengubah config
+void weight_filter_reset(weight_filter_t* filter);
+
+// return output stage terakhir. now_us = waktu sample itu diukur / diterima (bukan waktu drain),
+// dipakai ALPHA_BETA untuk dt prediksi dan untuk mulai ulang setelah jeda
+float weight_filter_push(weight_filter_t* filter, float value, int64_t now_us);
+
+// preset per mode: NORMAL = median + alpha-beta, CALIBRATION = median + moving average
+const weight_filter_config_t* weight_filter_preset(main_state_t state);
+
+// perkiraan group delay pipeline (sample) untuk input yang berubah pelan
+float weight_filter_delay_samples(const weight_filter_t* filter);
+
+const char* weight_filter_type_name(weight_filter_type_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WEIGHT_FILTER_H
@@ -0,0 +1,125 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "power_policy.h"
+
+#include <math.h>
+#include <string.h>
+
+static const power_policy_config_t default_config = {
+  .idle_ms = {
+    [POWER_ACTIVE] = 0,
+    [POWER_DIM] = 20000,
+    [POWER_LOW_CPU] = 60000,
+    [POWER_LIGHT_SLEEP] = 5 * 60000,
+    [POWER_DEEP_SLEEP] = 30 * 60000,
+  },
+  .weight_threshold = 2.0f,
+};
+
+// forward declaration
+static void account_time(power_policy_t* policy, int64_t now_ms);
+static void enter_level(power_policy_t* policy, power_level_t level);
+
+void power_policy_init(power_policy_t* policy, const power_policy_config_t* config, int64_t now_ms) {
+  memset(policy, 0, sizeof(*policy));
+  policy->config = config != NULL ? *config : default_config;
+  // level lebih dalam tidak boleh lebih cepat dari level sebelumnya
+  for (uint8_t i = POWER_DIM + 1; i < POWER_LEVEL_COUNT; i++) {
+    if (policy->config.idle_ms[i] < policy->config.idle_ms[i - 1]) {
+      policy->config.idle_ms[i] = policy->config.idle_ms[i - 1];
+    }
+  }
+  policy->level = POWER_ACTIVE;
+  policy->last_activity_ms = now_ms;
+  policy->last_update_ms = now_ms;
+  policy->stats.entries[POWER_ACTIVE] = 1;
+}
+
+void power_policy_activity(power_policy_t* policy, power_source_t source, int64_t now_ms) {
+  if (source >= POWER_SRC_COUNT) return;
+  account_time(policy, now_ms);
+  policy->stats.activity[source]++;
+  policy->last_activity_ms = now_ms;
+  if (policy->level != POWER_ACTIVE) {
+    policy->stats.wakes[source]++;
+    enter_level(policy, POWER_ACTIVE);
+  }
+}
+
+void power_policy_weight(power_policy_t* policy, float units, int64_t now_ms) {
+  if (!policy->weight_valid) {
+    // sample pertama (boot / setelah bangun) hanya jadi referensi
+    policy->weight_valid = true;
+    policy->weight_reference = units;
+    return;
+  }
+  if (fabsf(units - policy->weight_reference) < policy->config.weight_threshold) return;
+  policy->weight_reference = units;
+  power_policy_activity(policy, POWER_SRC_WEIGHT, now_ms);
+}
+
+void power_policy_set_hold(power_policy_t* policy, bool hold, int64_t now_ms) {
+  if (policy->hold == hold) return;
+  policy->hold = hold;
+  // hitung idle dari saat hold dilepas, bukan dari aktivitas terakhir sebelum hold
+  if (!hold) policy->last_activity_ms = now_ms;
+}
+
+bool power_policy_update(power_policy_t* policy, int64_t now_ms, power_level_t* level) {
+  account_time(policy, now_ms);
+  if (policy->hold) policy->last_activity_ms = now_ms;
+
+  int64_t idle_ms = now_ms - policy->last_activity_ms;
+  power_level_t target = POWER_ACTIVE;
+  for (uint8_t i = POWER_DIM; i < POWER_LEVEL_COUNT; i++) {
+    if (idle_ms >= (int64_t) policy->config.idle_ms[i]) target = (power_level_t) i;
+  }
+
+  bool started = policy->started;
+  policy->started = true;
+  // turun hanya lewat activity(); update hanya bisa memperdalam level
+  if (target <= policy->level) {
+    if (level != NULL) *level = policy->level;
+    return !started;
+  }
+  enter_level(policy, target);
+  if (level != NULL) *level = target;
+  return true;
+}
+
+power_level_t power_policy_level(const power_policy_t* policy) {
+  return policy->level;
+}
+
+uint32_t power_policy_next_deadline_ms(const power_policy_t* policy, int64_t now_ms) {
+  if (policy->hold || policy->level + 1 >= POWER_LEVEL_COUNT) return UINT32_MAX;
+  int64_t remaining = (int64_t) policy->config.idle_ms[policy->level + 1] - (now_ms - policy->last_activity_ms);
+  if (remaining <= 0) return 0;
+  if (remaining > UINT32_MAX) return UINT32_MAX;
+  return (uint32_t) remaining;
+}
+
+const char* power_policy_level_name(power_level_t level) {
+  switch (level) {
+    case POWER_ACTIVE:      return "ACTIVE";
+    case POWER_DIM:         return "DIM";
+    case POWER_LOW_CPU:     return "LOW_CPU";
+    case POWER_LIGHT_SLEEP: return "LIGHT_SLEEP";
+    case POWER_DEEP_SLEEP:  return "DEEP_SLEEP";
+    default:                return "UNKNOWN";
+  }
+}
+
+// --- static function ---
+static void account_time(power_policy_t* policy, int64_t now_ms) {
+  if (now_ms <= policy->last_update_ms) return;
+  policy->stats.residency_ms[policy->level] += (uint64_t) (now_ms - policy->last_update_ms);
+  policy->last_update_ms = now_ms;
+}
+
+static void enter_level(power_policy_t* policy, power_level_t level) {
+  policy->level = level;
+  policy->stats.entries[level]++;
+}
@@ -0,0 +1,91 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+// Kebijakan daya Device B: turun bertahap selama tidak ada aktivitas, kembali ACTIVE
+// begitu ada tombol ditekan atau berat berubah.
+//
+//   ACTIVE      -> DIM          backlight LCD mati
+//   DIM         -> LOW_CPU      CPU ke frekuensi minimum (DFS), tickless idle
+//   LOW_CPU     -> LIGHT_SLEEP  auto light sleep, bangun lewat GPIO tombol; Device A HEARTBEAT
+//   LIGHT_SLEEP -> DEEP_SLEEP   hanya tombol A (ext0), bangun = reboot
+//
+// Waktu diberikan dari luar (ms) supaya hari pemakaian bisa disimulasikan dengan jam virtual
+// di host; residency_ms memberi waktu di tiap level.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  POWER_ACTIVE = 0,
+  POWER_DIM,
+  POWER_LOW_CPU,
+  POWER_LIGHT_SLEEP,
+  POWER_DEEP_SLEEP,
+  POWER_LEVEL_COUNT,
+} power_level_t;
+
+typedef enum {
+  POWER_SRC_BUTTON = 0,
+  POWER_SRC_WEIGHT,
+  POWER_SRC_COUNT,
+} power_source_t;
+
+typedef struct {
+  uint32_t idle_ms[POWER_LEVEL_COUNT]; // lama tanpa aktivitas sebelum masuk level; [ACTIVE] diabaikan
+  float    weight_threshold;           // perubahan berat (units) yang dihitung aktivitas
+} power_policy_config_t;
+
+typedef struct {
+  uint64_t residency_ms[POWER_LEVEL_COUNT];
+  uint32_t entries[POWER_LEVEL_COUNT];
+  uint32_t wakes[POWER_SRC_COUNT];     // aktivitas yang membawa kembali dari level > ACTIVE
+  uint32_t activity[POWER_SRC_COUNT];
+} power_policy_stats_t;
+
+typedef struct {
+  power_policy_config_t config;
+  power_level_t level;
+  bool     started;
+  bool     hold;             // mis. kalibrasi: tetap ACTIVE
+  bool     weight_valid;
+  float    weight_reference;
+  int64_t  last_activity_ms;
+  int64_t  last_update_ms;
+  power_policy_stats_t stats;
+} power_policy_t;
+
+// config NULL = default (20 s / 60 s / 5 menit / 30 menit, threshold 2 units)
+void power_policy_init(power_policy_t* policy, const power_policy_config_t* config, int64_t now_ms);
+
+void power_policy_activity(power_policy_t* policy, power_source_t source, int64_t now_ms);
+
+// berat terbaru; dihitung aktivitas jika bergeser lebih dari threshold dari referensi
+void power_policy_weight(power_policy_t* policy, float units, int64_t now_ms);
+
+// selama hold, idle tidak pernah bertambah
+void power_policy_set_hold(power_policy_t* policy, bool hold, int64_t now_ms);
+
+// return true jika level berubah (dan pada panggilan pertama, supaya level awal diterapkan);
+// level sekarang ditulis ke `level` (boleh NULL)
+bool power_policy_update(power_policy_t* policy, int64_t now_ms, power_level_t* level);
+
+power_level_t power_policy_level(const power_policy_t* policy);
+
+// ms sampai level berikutnya (UINT32_MAX jika sudah paling dalam / hold)
+uint32_t power_policy_next_deadline_ms(const power_policy_t* policy, int64_t now_ms);
+
+const char* power_policy_level_name(power_level_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //POWER_POLICY_H
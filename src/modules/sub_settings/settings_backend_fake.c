@@ -0,0 +1,120 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "settings_backend_fake.h"
+
+#ifndef ESP_PLATFORM
+
+#include <stdio.h>
+#include <string.h>
+
+// forward declaration
+static settings_io_t fake_read(void* self, const char* ns, const char* key, void* buf, size_t* len);
+static settings_io_t fake_write(void* self, const char* ns, const char* key, const void* buf, size_t len);
+static settings_fake_entry_t* find_entry(settings_fake_nvs_t* fake, const char* ns, const char* key, bool create);
+static void load_file(settings_fake_nvs_t* fake);
+static void save_file(const settings_fake_nvs_t* fake);
+
+static const settings_backend_ops_t fake_ops = {
+  .read = fake_read,
+  .write = fake_write,
+  .name = "fake-nvs",
+};
+
+const settings_backend_t* settings_fake_nvs_init(settings_fake_nvs_t* fake, const char* path) {
+  memset(fake, 0, sizeof(*fake));
+  fake->path = path;
+  fake->backend.ops = &fake_ops;
+  fake->backend.self = fake;
+  if (path != NULL) load_file(fake);
+  return &fake->backend;
+}
+
+bool settings_fake_nvs_put(settings_fake_nvs_t* fake, const char* ns, const char* key, const void* buf, size_t len) {
+  if (len > SETTINGS_FAKE_MAX_BLOB) return false;
+  settings_fake_entry_t* entry = find_entry(fake, ns, key, true);
+  if (entry == NULL) return false;
+  memcpy(entry->data, buf, len);
+  entry->len = (uint16_t) len;
+  return true;
+}
+
+void settings_fake_nvs_get_stats(const settings_fake_nvs_t* fake, settings_fake_stats_t* stats) {
+  *stats = fake->stats;
+}
+
+// --- static function ---
+static settings_io_t fake_read(void* self, const char* ns, const char* key, void* buf, size_t* len) {
+  settings_fake_nvs_t* fake = self;
+  fake->stats.reads++;
+  settings_fake_entry_t* entry = find_entry(fake, ns, key, false);
+  if (entry == NULL) return SETTINGS_IO_NOT_FOUND;
+  // sama dengan nvs_get_blob: buffer kurang = ESP_ERR_NVS_INVALID_LENGTH
+  if (*len < entry->len) return SETTINGS_IO_ERROR;
+  memcpy(buf, entry->data, entry->len);
+  *len = entry->len;
+  return SETTINGS_IO_OK;
+}
+
+static settings_io_t fake_write(void* self, const char* ns, const char* key, const void* buf, size_t len) {
+  settings_fake_nvs_t* fake = self;
+  if (fake->fail_next_writes > 0) {
+    fake->fail_next_writes--;
+    fake->stats.fail_writes++;
+    return SETTINGS_IO_ERROR;
+  }
+  if (len > SETTINGS_FAKE_MAX_BLOB) return SETTINGS_IO_ERROR;
+  settings_fake_entry_t* entry = find_entry(fake, ns, key, true);
+  if (entry == NULL) return SETTINGS_IO_ERROR;
+
+  memcpy(entry->data, buf, len);
+  entry->len = (uint16_t) len;
+  fake->stats.writes++;
+  fake->stats.bytes_requested += len;
+  // entry header blob data + data dibulatkan 32 byte + entry blob index
+  size_t data_entries = (len + SETTINGS_FAKE_ENTRY_SIZE - 1) / SETTINGS_FAKE_ENTRY_SIZE;
+  fake->stats.flash_bytes += (uint64_t) (data_entries + 2) * SETTINGS_FAKE_ENTRY_SIZE;
+
+  if (fake->path != NULL) save_file(fake);
+  return SETTINGS_IO_OK;
+}
+
+static settings_fake_entry_t* find_entry(settings_fake_nvs_t* fake, const char* ns, const char* key, bool create) {
+  settings_fake_entry_t* free_entry = NULL;
+  for (uint8_t i = 0; i < SETTINGS_FAKE_MAX_ENTRIES; i++) {
+    settings_fake_entry_t* entry = &fake->entries[i];
+    if (!entry->used) {
+      if (free_entry == NULL) free_entry = entry;
+      continue;
+    }
+    if (strncmp(entry->ns, ns, SETTINGS_FAKE_NAME_LEN) == 0 && strncmp(entry->key, key, SETTINGS_FAKE_NAME_LEN) == 0) {
+      return entry;
+    }
+  }
+  if (!create || free_entry == NULL) return NULL;
+  memset(free_entry, 0, sizeof(*free_entry));
+  free_entry->used = true;
+  strncpy(free_entry->ns, ns, SETTINGS_FAKE_NAME_LEN - 1);
+  strncpy(free_entry->key, key, SETTINGS_FAKE_NAME_LEN - 1);
+  return free_entry;
+}
+
+static void load_file(settings_fake_nvs_t* fake) {
+  FILE* file = fopen(fake->path, "rb");
+  if (file == NULL) return;
+  if (fread(fake->entries, sizeof(fake->entries), 1, file) != 1) {
+    // file rusak / format lain: mulai kosong
+    memset(fake->entries, 0, sizeof(fake->entries));
+  }
+  fclose(file);
+}
+
+static void save_file(const settings_fake_nvs_t* fake) {
+  FILE* file = fopen(fake->path, "wb");
+  if (file == NULL) return;
+  fwrite(fake->entries, sizeof(fake->entries), 1, file);
+  fclose(file);
+}
+
+#endif // ESP_PLATFORM
@@ -0,0 +1,66 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef SETTINGS_BACKEND_FAKE_H
+#define SETTINGS_BACKEND_FAKE_H
+
+// Fake NVS untuk host (Linux): entry namespace/key -> blob di RAM, opsional disalin ke file
+// setiap tulis supaya "reboot" (proses baru) membaca isi yang sama.
+//
+// Menghitung biaya tulis mengikuti layout NVS ESP-IDF: setiap entry 32 byte, blob ditulis
+// sebagai entry header + data (dibulatkan ke 32 byte) + entry index. Dari sini write
+// amplification = flash_bytes / bytes yang diminta pemakai.
+
+#include "settings_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ESP_PLATFORM
+
+#define SETTINGS_FAKE_MAX_ENTRIES 8
+#define SETTINGS_FAKE_MAX_BLOB    512
+#define SETTINGS_FAKE_NAME_LEN    16 // NVS_KEY_NAME_MAX_SIZE
+#define SETTINGS_FAKE_ENTRY_SIZE  32
+
+typedef struct {
+  uint32_t reads;
+  uint32_t writes;
+  uint64_t bytes_requested; // total len yang diminta write()
+  uint64_t flash_bytes;     // perkiraan byte flash yang benar-benar ditulis
+  uint32_t fail_writes;     // write() yang digagalkan lewat fail_next_writes
+} settings_fake_stats_t;
+
+typedef struct {
+  bool     used;
+  char     ns[SETTINGS_FAKE_NAME_LEN];
+  char     key[SETTINGS_FAKE_NAME_LEN];
+  uint16_t len;
+  uint8_t  data[SETTINGS_FAKE_MAX_BLOB];
+} settings_fake_entry_t;
+
+typedef struct {
+  settings_fake_entry_t entries[SETTINGS_FAKE_MAX_ENTRIES];
+  const char* path;          // NULL = hanya RAM
+  uint32_t fail_next_writes; // simulasi flash error
+  settings_fake_stats_t stats;
+  settings_backend_t backend;
+} settings_fake_nvs_t;
+
+// path NULL = tanpa file; jika file ada, isinya dimuat
+const settings_backend_t* settings_fake_nvs_init(settings_fake_nvs_t* fake, const char* path);
+
+// isi entry langsung tanpa dihitung sebagai tulis (mis. menyiapkan key lama untuk tes migrasi)
+bool settings_fake_nvs_put(settings_fake_nvs_t* fake, const char* ns, const char* key, const void* buf, size_t len);
+
+void settings_fake_nvs_get_stats(const settings_fake_nvs_t* fake, settings_fake_stats_t* stats);
+
+#endif // ESP_PLATFORM
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SETTINGS_BACKEND_FAKE_H
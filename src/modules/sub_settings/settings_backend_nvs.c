@@ -0,0 +1,69 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "settings_backend_nvs.h"
+
+#ifdef ESP_PLATFORM
+
+#include "nvs.h"
+#include "esp_log.h"
+
+static const char* TAG = "SETTINGS_NVS";
+
+// forward declaration
+static settings_io_t nvs_backend_read(void* self, const char* ns, const char* key, void* buf, size_t* len);
+static settings_io_t nvs_backend_write(void* self, const char* ns, const char* key, const void* buf, size_t len);
+
+static const settings_backend_ops_t nvs_ops = {
+  .read = nvs_backend_read,
+  .write = nvs_backend_write,
+  .name = "nvs",
+};
+
+static const settings_backend_t nvs_backend = {
+  .ops = &nvs_ops,
+  .self = NULL,
+};
+
+const settings_backend_t* settings_backend_nvs(void) {
+  return &nvs_backend;
+}
+
+// --- static function ---
+static settings_io_t nvs_backend_read(void* self, const char* ns, const char* key, void* buf, size_t* len) {
+  nvs_handle_t nvs;
+  esp_err_t ret = nvs_open(ns, NVS_READONLY, &nvs);
+  // namespace belum pernah ditulis
+  if (ret == ESP_ERR_NVS_NOT_FOUND) return SETTINGS_IO_NOT_FOUND;
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to open %s: %s", ns, esp_err_to_name(ret));
+    return SETTINGS_IO_ERROR;
+  }
+
+  ret = nvs_get_blob(nvs, key, buf, len);
+  nvs_close(nvs);
+  if (ret == ESP_ERR_NVS_NOT_FOUND) return SETTINGS_IO_NOT_FOUND;
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to read %s/%s: %s", ns, key, esp_err_to_name(ret));
+    return SETTINGS_IO_ERROR;
+  }
+  return SETTINGS_IO_OK;
+}
+
+static settings_io_t nvs_backend_write(void* self, const char* ns, const char* key, const void* buf, size_t len) {
+  nvs_handle_t nvs;
+  esp_err_t ret = nvs_open(ns, NVS_READWRITE, &nvs);
+  if (ret == ESP_OK) {
+    ret = nvs_set_blob(nvs, key, buf, len);
+    if (ret == ESP_OK) ret = nvs_commit(nvs);
+    nvs_close(nvs);
+  }
+  if (ret != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to write %s/%s: %s", ns, key, esp_err_to_name(ret));
+    return SETTINGS_IO_ERROR;
+  }
+  return SETTINGS_IO_OK;
+}
+
+#endif // ESP_PLATFORM
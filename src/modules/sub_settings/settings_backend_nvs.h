@@ -0,0 +1,23 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef SETTINGS_BACKEND_NVS_H
+#define SETTINGS_BACKEND_NVS_H
+
+#include "settings_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef ESP_PLATFORM
+// backend NVS; nvs_flash_init() harus sudah dipanggil (app_main)
+const settings_backend_t* settings_backend_nvs(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SETTINGS_BACKEND_NVS_H
@@ -0,0 +1,318 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "settings_store.h"
+
+#include <string.h>
+
+// key sebelum settings_store (versi 0), diimpor sekali jika blob belum ada
+#define SETTINGS_LEGACY_PEERS_NS  "comm"
+#define SETTINGS_LEGACY_PEERS_KEY "peers"
+#define SETTINGS_LEGACY_CAL_NS    "cal"
+#define SETTINGS_LEGACY_CAL_KEY   "model"
+
+static const char* const load_result_names[] = {
+  [SETTINGS_LOAD_OK] = "OK",
+  [SETTINGS_LOAD_MIGRATED] = "MIGRATED",
+  [SETTINGS_LOAD_DEFAULTS] = "DEFAULTS",
+  [SETTINGS_LOAD_CORRUPT] = "CORRUPT",
+};
+
+// forward declaration
+static void writer_lock(settings_store_t* store);
+static void writer_unlock(settings_store_t* store);
+static void begin_update(settings_store_t* store);
+static void end_update(settings_store_t* store);
+static void mark_dirty(settings_store_t* store, uint32_t now_ms);
+static bool import_legacy(settings_store_t* store, settings_t* settings);
+static settings_io_t backend_read(settings_store_t* store, const char* ns, const char* key, void* buf, size_t* len);
+static uint16_t crc16(const uint8_t* data, size_t len);
+
+void settings_store_init(settings_store_t* store, const settings_backend_t* backend,
+                         const settings_store_config_t* config) {
+  memset(store, 0, sizeof(*store));
+  store->backend = *backend;
+  if (config != NULL) store->config = *config;
+  if (store->config.debounce_ms == 0) store->config.debounce_ms = SETTINGS_DEBOUNCE_MS;
+  if (store->config.max_delay_ms == 0) store->config.max_delay_ms = SETTINGS_MAX_DELAY_MS;
+  atomic_init(&store->seq, 0);
+  settings_default(&store->cache);
+}
+
+settings_load_result_t settings_store_load(settings_store_t* store, uint32_t now_ms) {
+  settings_t settings;
+  settings_default(&settings);
+  settings_load_result_t result;
+
+  settings_blob_t blob;
+  size_t len = sizeof(blob);
+  settings_io_t io = backend_read(store, SETTINGS_NAMESPACE, SETTINGS_KEY, &blob, &len);
+
+  if (io == SETTINGS_IO_NOT_FOUND) {
+    result = import_legacy(store, &settings) ? SETTINGS_LOAD_MIGRATED : SETTINGS_LOAD_DEFAULTS;
+  } else if (io != SETTINGS_IO_OK
+             || len < sizeof(settings_header_t)
+             || blob.header.magic != SETTINGS_MAGIC
+             || blob.header.version == 0 || blob.header.version > SETTINGS_VERSION
+             || blob.header.size > sizeof(settings_t)
+             || len != sizeof(settings_header_t) + blob.header.size
+             || blob.header.crc != crc16((const uint8_t*) &blob.data, blob.header.size)) {
+    // blob dari firmware yang lebih baru juga masuk sini: layout-nya tidak bisa ditebak
+    result = SETTINGS_LOAD_CORRUPT;
+  } else {
+    // field yang belum ada di blob lama tetap bernilai default
+    memcpy(&settings, &blob.data, blob.header.size);
+    store->stats.loaded_version = blob.header.version;
+    result = blob.header.version == SETTINGS_VERSION && blob.header.size == sizeof(settings_t)
+               ? SETTINGS_LOAD_OK : SETTINGS_LOAD_MIGRATED;
+  }
+
+  if (settings.peer_count > SETTINGS_PEER_MAX) settings.peer_count = SETTINGS_PEER_MAX;
+
+  writer_lock(store);
+  begin_update(store);
+  store->cache = settings;
+  end_update(store);
+  // hasil migrasi ditulis ulang dengan format sekarang lewat jalur debounce biasa
+  if (result == SETTINGS_LOAD_MIGRATED) mark_dirty(store, now_ms);
+  writer_unlock(store);
+  return result;
+}
+
+void settings_store_get(settings_store_t* store, settings_t* out) {
+  unsigned before, after;
+  do {
+    before = atomic_load_explicit(&store->seq, memory_order_acquire);
+    *out = store->cache;
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&store->seq, memory_order_relaxed);
+  } while ((before & 1) || before != after);
+}
+
+bool settings_store_set_unit(settings_store_t* store, uint8_t unit, uint32_t now_ms) {
+  writer_lock(store);
+  bool changed = store->cache.unit != unit;
+  if (changed) {
+    begin_update(store);
+    store->cache.unit = unit;
+    end_update(store);
+    mark_dirty(store, now_ms);
+  } else {
+    store->stats.unchanged++;
+  }
+  writer_unlock(store);
+  return changed;
+}
+
+bool settings_store_set_display_peer(settings_store_t* store, uint8_t peer, uint32_t now_ms) {
+  writer_lock(store);
+  bool changed = store->cache.display_peer != peer;
+  if (changed) {
+    begin_update(store);
+    store->cache.display_peer = peer;
+    end_update(store);
+    mark_dirty(store, now_ms);
+  } else {
+    store->stats.unchanged++;
+  }
+  writer_unlock(store);
+  return changed;
+}
+
+bool settings_store_set_tare(settings_store_t* store, float tare_units, uint32_t now_ms) {
+  writer_lock(store);
+  bool changed = store->cache.tare_units != tare_units;
+  if (changed) {
+    begin_update(store);
+    store->cache.tare_units = tare_units;
+    end_update(store);
+    mark_dirty(store, now_ms);
+  } else {
+    store->stats.unchanged++;
+  }
+  writer_unlock(store);
+  return changed;
+}
+
+bool settings_store_set_cal(settings_store_t* store, const cal_model_t* cal, uint32_t now_ms) {
+  writer_lock(store);
+  bool changed = memcmp(&store->cache.cal, cal, sizeof(*cal)) != 0;
+  if (changed) {
+    begin_update(store);
+    memcpy(&store->cache.cal, cal, sizeof(*cal));
+    end_update(store);
+    mark_dirty(store, now_ms);
+  } else {
+    store->stats.unchanged++;
+  }
+  writer_unlock(store);
+  return changed;
+}
+
+bool settings_store_add_peer(settings_store_t* store, const uint8_t* mac, uint32_t now_ms) {
+  writer_lock(store);
+  bool added = store->cache.peer_count < SETTINGS_PEER_MAX;
+  for (uint8_t i = 0; added && i < store->cache.peer_count; i++) {
+    if (memcmp(store->cache.peers[i], mac, SETTINGS_MAC_LEN) == 0) added = false;
+  }
+  if (added) {
+    begin_update(store);
+    memcpy(store->cache.peers[store->cache.peer_count], mac, SETTINGS_MAC_LEN);
+    store->cache.peer_count++;
+    end_update(store);
+    mark_dirty(store, now_ms);
+  } else {
+    store->stats.unchanged++;
+  }
+  writer_unlock(store);
+  return added;
+}
+
+bool settings_store_due(settings_store_t* store, uint32_t now_ms) {
+  writer_lock(store);
+  bool due = store->dirty
+             && ((uint32_t) (now_ms - store->last_change_ms) >= store->config.debounce_ms
+                 || (uint32_t) (now_ms - store->first_dirty_ms) >= store->config.max_delay_ms);
+  writer_unlock(store);
+  return due;
+}
+
+bool settings_store_poll(settings_store_t* store, uint32_t now_ms) {
+  if (!settings_store_due(store, now_ms)) return false;
+  return settings_store_flush(store) == SETTINGS_IO_OK;
+}
+
+settings_io_t settings_store_flush(settings_store_t* store) {
+  // padding ikut ter-nol supaya crc dan isi flash deterministik
+  settings_blob_t blob;
+  memset(&blob, 0, sizeof(blob));
+
+  writer_lock(store);
+  if (!store->dirty) {
+    writer_unlock(store);
+    return SETTINGS_IO_OK;
+  }
+  blob.data = store->cache;
+  uint32_t pending = store->pending;
+  store->dirty = false;
+  store->pending = 0;
+  writer_unlock(store);
+
+  blob.header.magic = SETTINGS_MAGIC;
+  blob.header.version = SETTINGS_VERSION;
+  blob.header.size = sizeof(settings_t);
+  blob.header.crc = crc16((const uint8_t*) &blob.data, sizeof(settings_t));
+
+  // tulis flash di luar lock: setter dari task lain tetap jalan, perubahan baru jadi dirty lagi
+  settings_io_t io = store->backend.ops->write(store->backend.self, SETTINGS_NAMESPACE, SETTINGS_KEY,
+                                               &blob, sizeof(blob));
+
+  writer_lock(store);
+  if (io == SETTINGS_IO_OK) {
+    store->stats.flushes++;
+    store->stats.bytes_written += sizeof(blob);
+  } else {
+    // dicoba lagi pada poll berikutnya (first_dirty_ms lama -> max delay sudah lewat)
+    store->stats.flush_errors++;
+    store->dirty = true;
+    store->pending += pending;
+  }
+  writer_unlock(store);
+  return io;
+}
+
+bool settings_store_dirty(settings_store_t* store) {
+  writer_lock(store);
+  bool dirty = store->dirty;
+  writer_unlock(store);
+  return dirty;
+}
+
+void settings_store_get_stats(settings_store_t* store, settings_stats_t* stats) {
+  writer_lock(store);
+  *stats = store->stats;
+  writer_unlock(store);
+}
+
+void settings_default(settings_t* settings) {
+  memset(settings, 0, sizeof(*settings));
+  settings->cal.version = CAL_MODEL_VERSION;
+  settings->cal.type = CAL_MODEL_NONE;
+}
+
+const char* settings_load_result_name(settings_load_result_t result) {
+  if (result > SETTINGS_LOAD_CORRUPT) return "UNKNOWN";
+  return load_result_names[result];
+}
+
+// --- static function ---
+static void writer_lock(settings_store_t* store) {
+  if (store->config.lock != NULL) store->config.lock(store->config.lock_ctx);
+}
+
+static void writer_unlock(settings_store_t* store) {
+  if (store->config.unlock != NULL) store->config.unlock(store->config.lock_ctx);
+}
+
+static void begin_update(settings_store_t* store) {
+  unsigned seq = atomic_load_explicit(&store->seq, memory_order_relaxed);
+  atomic_store_explicit(&store->seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+static void end_update(settings_store_t* store) {
+  unsigned seq = atomic_load_explicit(&store->seq, memory_order_relaxed);
+  atomic_store_explicit(&store->seq, seq + 1, memory_order_release);
+}
+
+static void mark_dirty(settings_store_t* store, uint32_t now_ms) {
+  store->stats.updates++;
+  if (store->dirty) {
+    store->stats.coalesced++;
+  } else {
+    store->dirty = true;
+    store->first_dirty_ms = now_ms;
+  }
+  store->pending++;
+  store->last_change_ms = now_ms;
+}
+
+static bool import_legacy(settings_store_t* store, settings_t* settings) {
+  bool found = false;
+
+  uint8_t macs[SETTINGS_PEER_MAX * SETTINGS_MAC_LEN];
+  size_t len = sizeof(macs);
+  if (backend_read(store, SETTINGS_LEGACY_PEERS_NS, SETTINGS_LEGACY_PEERS_KEY, macs, &len) == SETTINGS_IO_OK
+      && len >= SETTINGS_MAC_LEN) {
+    settings->peer_count = (uint8_t) (len / SETTINGS_MAC_LEN);
+    memcpy(settings->peers, macs, settings->peer_count * SETTINGS_MAC_LEN);
+    found = true;
+  }
+
+  cal_model_t cal;
+  len = sizeof(cal);
+  if (backend_read(store, SETTINGS_LEGACY_CAL_NS, SETTINGS_LEGACY_CAL_KEY, &cal, &len) == SETTINGS_IO_OK
+      && len == sizeof(cal) && cal.version == CAL_MODEL_VERSION) {
+    settings->cal = cal;
+    found = true;
+  }
+  return found;
+}
+
+static settings_io_t backend_read(settings_store_t* store, const char* ns, const char* key, void* buf, size_t* len) {
+  store->stats.backend_reads++;
+  return store->backend.ops->read(store->backend.self, ns, key, buf, len);
+}
+
+static uint16_t crc16(const uint8_t* data, size_t len) {
+  // CRC-16/CCITT-FALSE, hanya saat load / flush jadi cukup bitwise
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t) data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+    }
+  }
+  return crc;
+}
@@ -0,0 +1,163 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+// Pengaturan persisten Device B (satuan, tare, kalibrasi, daftar peer) dalam satu blob.
+//
+// - Boot: satu kali baca blob ke cache RAM. Blob punya header (magic, version, size, crc);
+//   field baru selalu ditambah di akhir settings_t, blob lama yang lebih pendek diisi default.
+//   Jika blob belum ada, key lama ("comm"/"peers", "cal"/"model") diimpor sebagai versi 0.
+// - Baca: lock-free dari task mana pun (seqlock, ganjil = sedang ditulis), hasilnya salinan.
+// - Tulis: setter hanya mengubah cache dan menandai dirty; settings_store_poll() menulis blob
+//   setelah `debounce_ms` tanpa perubahan (paling lambat `max_delay_ms` sejak perubahan pertama),
+//   jadi tombol yang ditekan berulang hanya menghasilkan satu tulis flash.
+//
+// Penyimpanan lewat backend (NVS di target, fake NVS di host); tanpa header ESP-IDF / FreeRTOS.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "../sub_main/cal_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SETTINGS_VERSION  1
+#define SETTINGS_MAGIC    0x57534554 // "WSET"
+#define SETTINGS_NAMESPACE "settings"
+#define SETTINGS_KEY       "v"
+
+#define SETTINGS_MAC_LEN  6
+#define SETTINGS_PEER_MAX 20 // sama dengan COMM_PEER_MAX
+
+#define SETTINGS_DEBOUNCE_MS  2000
+#define SETTINGS_MAX_DELAY_MS 10000
+
+// isi blob; hanya tambah field di akhir, jangan ubah urutan / tipe field yang sudah ada
+typedef struct {
+  uint8_t     unit;          // weight_unit_t
+  uint8_t     display_peer;  // peer yang ditampilkan saat boot
+  uint8_t     peer_count;
+  uint8_t     peers[SETTINGS_PEER_MAX][SETTINGS_MAC_LEN];
+  float       tare_units;    // tare lokal Device B (gram), 0 = tidak ada
+  cal_model_t cal;           // type CAL_MODEL_NONE = belum dikalibrasi
+} settings_t;
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;   // sizeof(settings_t) saat blob ditulis
+  uint16_t crc;    // CRC-16/CCITT-FALSE atas payload
+  uint16_t reserved;
+} settings_header_t;
+
+typedef struct {
+  settings_header_t header;
+  settings_t        data;
+} settings_blob_t;
+
+typedef enum {
+  SETTINGS_IO_OK = 0,
+  SETTINGS_IO_NOT_FOUND,
+  SETTINGS_IO_ERROR,
+} settings_io_t;
+
+typedef struct {
+  // `len` masuk = ukuran buffer, keluar = ukuran blob yang tersimpan
+  settings_io_t (*read)(void* self, const char* ns, const char* key, void* buf, size_t* len);
+  settings_io_t (*write)(void* self, const char* ns, const char* key, const void* buf, size_t len);
+  const char* name;
+} settings_backend_ops_t;
+
+typedef struct {
+  const settings_backend_ops_t* ops;
+  void* self;
+} settings_backend_t;
+
+typedef struct {
+  uint32_t debounce_ms;
+  uint32_t max_delay_ms;
+  // serialisasi antar writer (NULL = satu writer); reader tidak pernah memakai lock
+  void (*lock)(void* ctx);
+  void (*unlock)(void* ctx);
+  void* lock_ctx;
+} settings_store_config_t;
+
+typedef enum {
+  SETTINGS_LOAD_OK = 0,   // blob versi sekarang
+  SETTINGS_LOAD_MIGRATED, // blob versi lama / key lama, ditulis ulang di poll berikutnya
+  SETTINGS_LOAD_DEFAULTS, // belum ada apa pun
+  SETTINGS_LOAD_CORRUPT,  // magic / crc / ukuran salah, pakai default
+} settings_load_result_t;
+
+typedef struct {
+  uint32_t backend_reads;
+  uint16_t loaded_version; // 0 = key lama / tidak ada
+  uint32_t updates;        // setter yang mengubah isi
+  uint32_t unchanged;      // setter dengan nilai yang sama, tidak membuat dirty
+  uint32_t coalesced;      // perubahan yang ikut satu tulis dengan perubahan lain
+  uint32_t flushes;        // blob ditulis ke backend
+  uint32_t flush_errors;
+  uint64_t bytes_written;
+} settings_stats_t;
+
+typedef struct {
+  settings_backend_t backend;
+  settings_store_config_t config;
+
+  atomic_uint seq;
+  settings_t  cache;
+
+  // hanya disentuh writer (di dalam lock)
+  bool     dirty;
+  uint32_t pending;        // perubahan sejak tulis terakhir
+  uint32_t first_dirty_ms;
+  uint32_t last_change_ms;
+  settings_stats_t stats;
+} settings_store_t;
+
+// config NULL = debounce / max delay default tanpa lock
+void settings_store_init(settings_store_t* store, const settings_backend_t* backend,
+                         const settings_store_config_t* config);
+
+// sekali saat boot, sebelum ada reader lain
+settings_load_result_t settings_store_load(settings_store_t* store, uint32_t now_ms);
+
+// salinan cache, lock-free
+void settings_store_get(settings_store_t* store, settings_t* out);
+
+// setter: return true jika isi berubah (akan ditulis oleh poll)
+bool settings_store_set_unit(settings_store_t* store, uint8_t unit, uint32_t now_ms);
+bool settings_store_set_display_peer(settings_store_t* store, uint8_t peer, uint32_t now_ms);
+bool settings_store_set_tare(settings_store_t* store, float tare_units, uint32_t now_ms);
+bool settings_store_set_cal(settings_store_t* store, const cal_model_t* cal, uint32_t now_ms);
+// false jika MAC sudah ada atau daftar penuh
+bool settings_store_add_peer(settings_store_t* store, const uint8_t* mac, uint32_t now_ms);
+
+// dirty dan debounce / max delay sudah lewat (tanpa menulis), untuk menyerahkan tulis ke task lain
+bool settings_store_due(settings_store_t* store, uint32_t now_ms);
+
+// tulis blob jika settings_store_due(); return true jika menulis
+bool settings_store_poll(settings_store_t* store, uint32_t now_ms);
+
+// tulis sekarang jika dirty (mis. sebelum deep sleep, atau setelah simpan kalibrasi)
+settings_io_t settings_store_flush(settings_store_t* store);
+
+bool settings_store_dirty(settings_store_t* store);
+
+void settings_store_get_stats(settings_store_t* store, settings_stats_t* stats);
+
+void settings_default(settings_t* settings);
+
+const char* settings_load_result_name(settings_load_result_t result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SETTINGS_STORE_H
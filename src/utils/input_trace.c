@@ -0,0 +1,58 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "input_trace.h"
+
+#include <string.h>
+
+static const char* const hop_names[] = {
+  [INPUT_TRACE_RECOGNIZE] = "RECOGNIZE",
+  [INPUT_TRACE_BUTTON_QUEUE] = "BUTTON_QUEUE",
+  [INPUT_TRACE_MAIN] = "MAIN",
+  [INPUT_TRACE_COMM] = "COMM",
+  [INPUT_TRACE_LCD] = "LCD",
+  [INPUT_TRACE_END_AIR] = "END_AIR",
+  [INPUT_TRACE_END_LCD] = "END_LCD",
+};
+
+// forward declaration
+static uint32_t elapsed_us(int64_t from_us, int64_t to_us);
+
+void input_trace_stats_reset(input_trace_stats_t* stats) {
+  for (uint8_t i = 0; i < INPUT_TRACE_HOP_COUNT; i++) latency_hist_reset(&stats->hops[i]);
+}
+
+void input_trace_start(input_trace_t* trace, int64_t origin_us) {
+  trace->origin_us = origin_us;
+  trace->stamp_us = origin_us;
+}
+
+void input_trace_hop(input_trace_stats_t* stats, input_trace_t* trace, input_trace_hop_t hop, int64_t now_us) {
+  if (trace->origin_us == 0 || hop >= INPUT_TRACE_HOP_COUNT) return;
+  latency_hist_record(&stats->hops[hop], elapsed_us(trace->stamp_us, now_us));
+  trace->stamp_us = now_us;
+}
+
+void input_trace_end(input_trace_stats_t* stats, const input_trace_t* trace, input_trace_hop_t hop, int64_t now_us) {
+  if (trace->origin_us == 0 || hop >= INPUT_TRACE_HOP_COUNT) return;
+  latency_hist_record(&stats->hops[hop], elapsed_us(trace->origin_us, now_us));
+}
+
+uint32_t input_trace_percentile(const input_trace_stats_t* stats, input_trace_hop_t hop, uint8_t percentile) {
+  if (hop >= INPUT_TRACE_HOP_COUNT) return 0;
+  return latency_hist_percentile(&stats->hops[hop], percentile);
+}
+
+const char* input_trace_hop_name(input_trace_hop_t hop) {
+  if (hop >= INPUT_TRACE_HOP_COUNT) return "UNKNOWN";
+  return hop_names[hop];
+}
+
+// --- static function ---
+static uint32_t elapsed_us(int64_t from_us, int64_t to_us) {
+  // jam dari task lain bisa sedikit mundur relatif stamp; di atas ~71 menit dijepit
+  if (to_us <= from_us) return 0;
+  int64_t elapsed = to_us - from_us;
+  return elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t) elapsed;
+}
@@ -0,0 +1,59 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+// Jejak latency input dari tekan tombol fisik sampai command di udara / hasil di LCD.
+//
+// input_trace_t (data_type.h) ikut disalin di setiap pesan antar task (button queue, comm_send_data_t,
+// led_data_t). origin_us = esp_timer_get_time() tekan yang memulai gesture, stamp_us = hop
+// terakhir. Setiap hop dicatat ke histogram sendiri, dan dua ujung (udara, LCD) dicatat dari
+// origin. origin_us 0 = pesan bukan akibat tombol, tidak dicatat.
+//
+// Tanpa header ESP-IDF / FreeRTOS; satu task menulis satu hop, lock dari pemakai.
+
+#include <stdint.h>
+#include <data_type.h>
+#include "latency_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  INPUT_TRACE_RECOGNIZE = 0, // tekan -> gesture dikenali (termasuk jendela double click / lama tahan)
+  INPUT_TRACE_BUTTON_QUEUE,  // dikenali -> diambil main_task dari queue
+  INPUT_TRACE_MAIN,          // diambil -> selesai diproses FSM main_task
+  INPUT_TRACE_COMM,          // command masuk queue comm -> send callback (pengiriman pertama)
+  INPUT_TRACE_LCD,           // frame di-post -> selesai di-flush ke LCD
+  INPUT_TRACE_END_AIR,       // tekan -> command di udara
+  INPUT_TRACE_END_LCD,       // tekan -> hasil tampil di LCD
+  INPUT_TRACE_HOP_COUNT,
+} input_trace_hop_t;
+
+typedef struct {
+  latency_hist_t hops[INPUT_TRACE_HOP_COUNT];
+} input_trace_stats_t;
+
+void input_trace_stats_reset(input_trace_stats_t* stats);
+
+// mulai jejak baru; stamp = origin
+void input_trace_start(input_trace_t* trace, int64_t origin_us);
+
+// catat now - stamp ke `hop`, lalu stamp = now
+void input_trace_hop(input_trace_stats_t* stats, input_trace_t* trace, input_trace_hop_t hop, int64_t now_us);
+
+// catat now - origin ke `hop` (INPUT_TRACE_END_*); jejak tidak berubah
+void input_trace_end(input_trace_stats_t* stats, const input_trace_t* trace, input_trace_hop_t hop, int64_t now_us);
+
+uint32_t input_trace_percentile(const input_trace_stats_t* stats, input_trace_hop_t hop, uint8_t percentile);
+
+const char* input_trace_hop_name(input_trace_hop_t hop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //INPUT_TRACE_H
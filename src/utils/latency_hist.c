@@ -0,0 +1,58 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "latency_hist.h"
+
+#include <string.h>
+
+static uint8_t bucket_of(uint32_t latency_us) {
+  uint8_t bucket = 0;
+  while (latency_us > 1 && bucket < LATENCY_HIST_BUCKETS - 1) {
+    latency_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void latency_hist_reset(latency_hist_t* hist) {
+  memset(hist, 0, sizeof(*hist));
+  hist->min_us = UINT32_MAX;
+}
+
+void latency_hist_record(latency_hist_t* hist, uint32_t latency_us) {
+  hist->buckets[bucket_of(latency_us)]++;
+  hist->count++;
+  hist->sum_us += latency_us;
+  if (latency_us < hist->min_us) hist->min_us = latency_us;
+  if (latency_us > hist->max_us) hist->max_us = latency_us;
+}
+
+uint32_t latency_hist_percentile(const latency_hist_t* hist, uint8_t percentile) {
+  if (hist->count == 0) return 0;
+  if (percentile >= 100) return hist->max_us;
+
+  // rank sample yang dicari (1-based)
+  uint32_t rank = (uint32_t) (((uint64_t) hist->count * percentile + 99) / 100);
+  if (rank == 0) rank = 1;
+
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    if (hist->buckets[i] == 0) continue;
+    if (seen + hist->buckets[i] >= rank) {
+      uint32_t low = i == 0 ? 0 : (1u << i);
+      uint32_t high = i == LATENCY_HIST_BUCKETS - 1 ? hist->max_us : (1u << (i + 1));
+      uint32_t value = low + (uint32_t) ((uint64_t) (high - low) * (rank - seen) / hist->buckets[i]);
+      // tidak mungkin di luar min/max yang benar-benar tercatat
+      if (value < hist->min_us) value = hist->min_us;
+      if (value > hist->max_us) value = hist->max_us;
+      return value;
+    }
+    seen += hist->buckets[i];
+  }
+  return hist->max_us;
+}
+
+uint32_t latency_hist_mean(const latency_hist_t* hist) {
+  return hist->count ? (uint32_t) (hist->sum_us / hist->count) : 0;
+}
@@ -0,0 +1,41 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+// Histogram latency dengan bucket log2 (mikrodetik), ukuran tetap, tanpa alokasi.
+// Bucket i berisi sample [2^i, 2^(i+1)) us, bucket 0 berisi 0..1 us.
+// Satu writer; task lain sebaiknya membaca dari salinan struct, bukan dari aslinya.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LATENCY_HIST_BUCKETS 24 // sampai ~16 detik
+
+typedef struct {
+  uint32_t buckets[LATENCY_HIST_BUCKETS];
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+} latency_hist_t;
+
+void latency_hist_reset(latency_hist_t* hist);
+
+void latency_hist_record(latency_hist_t* hist, uint32_t latency_us);
+
+// percentile 0..100, hasil diinterpolasi linear di dalam bucket; 0 jika kosong
+uint32_t latency_hist_percentile(const latency_hist_t* hist, uint8_t percentile);
+
+uint32_t latency_hist_mean(const latency_hist_t* hist);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //LATENCY_HIST_H
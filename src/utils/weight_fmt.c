@@ -0,0 +1,137 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include "weight_fmt.h"
+
+#include <string.h>
+
+// int64 micro-gram cukup untuk ~9.2e12 gram; batas ini menjaga negasi dan pembulatan aman
+#define WEIGHT_FMT_MICRO_MAX 9000000000000000000LL
+
+// cukup untuk yang terpanjang: "-9000000000000.000 kg"
+#define WEIGHT_FMT_SCRATCH 32
+
+typedef struct {
+  uint64_t    step;     // micro-gram per digit terakhir yang ditampilkan
+  uint8_t     decimals;
+  const char* suffix;
+  const char* name;
+} weight_unit_scale_t;
+
+static const weight_unit_scale_t unit_scales[WEIGHT_UNIT_COUNT] = {
+  [WEIGHT_UNIT_GRAM] = { .step = 10000ULL,      .decimals = 2, .suffix = "g",  .name = "GRAM" }, // 0.01 g
+  [WEIGHT_UNIT_KG]   = { .step = 1000000ULL,    .decimals = 3, .suffix = "kg", .name = "KG" },   // 1 g
+  [WEIGHT_UNIT_TON]  = { .step = 1000000000ULL, .decimals = 3, .suffix = "t",  .name = "TON" },  // 1 kg
+};
+
+// forward declaration
+static char* render_unsigned(char* end, uint64_t value, uint8_t decimals);
+static size_t emit_field(char* out, size_t out_size, const char* text, size_t len, uint8_t width);
+
+int64_t weight_fmt_from_units(float grams) {
+  float micro = grams * (float) WEIGHT_FMT_MICRO_PER_GRAM;
+  if (micro != micro) return 0; // NaN
+  if (micro >= (float) WEIGHT_FMT_MICRO_MAX) return WEIGHT_FMT_MICRO_MAX;
+  if (micro <= -(float) WEIGHT_FMT_MICRO_MAX) return -WEIGHT_FMT_MICRO_MAX;
+  return (int64_t) (micro < 0.0f ? micro - 0.5f : micro + 0.5f);
+}
+
+size_t weight_fmt_weight(char* out, size_t out_size, int64_t micro, weight_unit_t unit, uint8_t width, bool suffix) {
+  if (unit >= WEIGHT_UNIT_COUNT) unit = WEIGHT_UNIT_GRAM;
+  const weight_unit_scale_t* scale = &unit_scales[unit];
+
+  if (micro > WEIGHT_FMT_MICRO_MAX) micro = WEIGHT_FMT_MICRO_MAX;
+  if (micro < -WEIGHT_FMT_MICRO_MAX) micro = -WEIGHT_FMT_MICRO_MAX;
+  bool negative = micro < 0;
+  uint64_t magnitude = (uint64_t) (negative ? -micro : micro);
+  // setengah step dibulatkan menjauhi nol
+  uint64_t digits = (magnitude + scale->step / 2) / scale->step;
+
+  char scratch[WEIGHT_FMT_SCRATCH];
+  char* end = scratch + sizeof(scratch);
+  char* p = end;
+  if (suffix) {
+    size_t suffix_len = strlen(scale->suffix);
+    p -= suffix_len;
+    memcpy(p, scale->suffix, suffix_len);
+    *--p = ' ';
+  }
+  p = render_unsigned(p, digits, scale->decimals);
+  // -0.00 ditampilkan 0.00
+  if (negative && digits != 0) *--p = '-';
+
+  return emit_field(out, out_size, p, (size_t) (end - p), width);
+}
+
+size_t weight_fmt_int(char* out, size_t out_size, int32_t value, uint8_t width) {
+  char scratch[WEIGHT_FMT_SCRATCH];
+  char* end = scratch + sizeof(scratch);
+  bool negative = value < 0;
+  uint64_t magnitude = negative ? (uint64_t) -(int64_t) value : (uint64_t) value;
+  char* p = render_unsigned(end, magnitude, 0);
+  if (negative) *--p = '-';
+  return emit_field(out, out_size, p, (size_t) (end - p), width);
+}
+
+size_t weight_fmt_text(char* out, size_t out_size, const char* text, uint8_t width) {
+  if (out == NULL || out_size == 0) return 0;
+  size_t len = text != NULL ? strlen(text) : 0;
+  if (width == 0) width = (uint8_t) (len < UINT8_MAX ? len : UINT8_MAX);
+  if (out_size < (size_t) width + 1) {
+    out[0] = '\0';
+    return 0;
+  }
+  if (len > width) len = width;
+  if (len > 0) memcpy(out, text, len);
+  memset(out + len, ' ', width - len);
+  out[width] = '\0';
+  return width;
+}
+
+const char* weight_fmt_unit_name(weight_unit_t unit) {
+  if (unit >= WEIGHT_UNIT_COUNT) return "?";
+  return unit_scales[unit].name;
+}
+
+// --- static function ---
+static char* render_unsigned(char* end, uint64_t value, uint8_t decimals) {
+  // ditulis mundur dari `end`, return awal string
+  char* p = end;
+  uint8_t written = 0;
+  // pembagian 64 bit hanya untuk digit atas; sisanya 32 bit (jauh lebih murah di Xtensa)
+  while (value > UINT32_MAX) {
+    *--p = (char) ('0' + value % 10);
+    value /= 10;
+    if (++written == decimals) *--p = '.';
+  }
+  uint32_t small = (uint32_t) value;
+  while (written < decimals) {
+    *--p = (char) ('0' + small % 10);
+    small /= 10;
+    if (++written == decimals) *--p = '.';
+  }
+  do {
+    *--p = (char) ('0' + small % 10);
+    small /= 10;
+  } while (small != 0);
+  return p;
+}
+
+static size_t emit_field(char* out, size_t out_size, const char* text, size_t len, uint8_t width) {
+  if (out == NULL || out_size == 0) return 0;
+  size_t field = width != 0 ? width : len;
+  if (out_size < field + 1) {
+    out[0] = '\0';
+    return 0;
+  }
+  if (len > field) {
+    // tidak muat: lebih baik jelas salah daripada angka terpotong yang terlihat benar
+    memset(out, '-', field);
+  } else {
+    memset(out, ' ', field - len);
+    memcpy(out + field - len, text, len);
+  }
+  out[field] = '\0';
+  return field;
+}
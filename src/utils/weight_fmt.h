@@ -0,0 +1,55 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef WEIGHT_FMT_H
+#define WEIGHT_FMT_H
+
+// Format angka berat untuk LCD 16x2 tanpa printf float dan tanpa alokasi.
+// Berat disimpan sebagai integer micro-gram; skala, jumlah desimal dan suffix tiap satuan
+// diambil dari tabel konstan, jadi tidak ada pembagian float per sample.
+//
+// Semua fungsi menulis field rata kanan dengan lebar tetap (0 = selebar isinya) dan selalu
+// mengakhiri dengan '\0'. Jika angka tidak muat di field, field diisi '-' (bukan terpotong).
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WEIGHT_FMT_LCD_COLS   16
+#define WEIGHT_FMT_LINE_SIZE  (WEIGHT_FMT_LCD_COLS + 1) // satu baris LCD + '\0'
+
+#define WEIGHT_FMT_MICRO_PER_GRAM 1000000LL
+
+typedef enum {
+  WEIGHT_UNIT_GRAM = 0,
+  WEIGHT_UNIT_KG,
+  WEIGHT_UNIT_TON,
+  WEIGHT_UNIT_COUNT,
+} weight_unit_t;
+
+// gram (float dari Device A / model kalibrasi) -> micro-gram, dibulatkan dan dibatasi
+int64_t weight_fmt_from_units(float grams);
+
+// berat dalam satuan `unit` (desimal sesuai tabel), suffix opsional ("123.45 g")
+// return jumlah karakter yang ditulis, 0 jika `out_size` tidak cukup untuk `width` + '\0'
+size_t weight_fmt_weight(char* out, size_t out_size, int64_t micro, weight_unit_t unit, uint8_t width, bool suffix);
+
+// integer (raw HX711, persen, dst.)
+size_t weight_fmt_int(char* out, size_t out_size, int32_t value, uint8_t width);
+
+// teks rata kiri, dipotong atau diisi spasi sampai `width`
+size_t weight_fmt_text(char* out, size_t out_size, const char* text, uint8_t width);
+
+// "GRAM" / "KG" / "TON"
+const char* weight_fmt_unit_name(weight_unit_t unit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WEIGHT_FMT_H
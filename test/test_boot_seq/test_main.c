@@ -0,0 +1,136 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+
+#include "sub_boot/boot_seq.h"
+
+// graf yang sama dengan src/main.c
+typedef enum {
+  STAGE_NVS = 0,
+  STAGE_LCD,
+  STAGE_SETTINGS,
+  STAGE_COMM,
+  STAGE_BUTTON,
+  STAGE_POWER,
+  STAGE_QUEUES,
+  STAGE_COUNT,
+} stage_id_t;
+
+static const boot_stage_t app_stages[STAGE_COUNT] = {
+  [STAGE_NVS]      = { .name = "nvs",      .deps = 0 },
+  [STAGE_LCD]      = { .name = "lcd",      .deps = 0 },
+  [STAGE_SETTINGS] = { .name = "settings", .deps = BOOT_DEP(STAGE_NVS) },
+  [STAGE_COMM]     = { .name = "comm",     .deps = BOOT_DEP(STAGE_NVS) | BOOT_DEP(STAGE_SETTINGS) },
+  [STAGE_BUTTON]   = { .name = "button",   .deps = 0 },
+  [STAGE_POWER]    = { .name = "power",    .deps = BOOT_DEP(STAGE_BUTTON) },
+  [STAGE_QUEUES]   = { .name = "queues",   .deps = 0 },
+};
+
+// durasi buatan (us): radio bring-up mendominasi
+static const int64_t app_durations[STAGE_COUNT] = {
+  [STAGE_NVS] = 30000,
+  [STAGE_LCD] = 120000,
+  [STAGE_SETTINGS] = 5000,
+  [STAGE_COMM] = 600000,
+  [STAGE_BUTTON] = 2000,
+  [STAGE_POWER] = 3000,
+  [STAGE_QUEUES] = 1000,
+};
+
+static boot_seq_t seq;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void test_parallel_boot_hits_critical_path(void) {
+  TEST_ASSERT_TRUE(boot_seq_simulate(&seq, app_stages, STAGE_COUNT, app_durations, 2));
+  TEST_ASSERT_FALSE(boot_seq_failed(&seq));
+  // nvs -> settings -> comm
+  TEST_ASSERT_EQUAL_INT64(635000, boot_seq_critical_path_us(&seq));
+  TEST_ASSERT_EQUAL_INT64(635000, seq.boot_end_us);
+  // splash tampil jauh sebelum radio siap
+  TEST_ASSERT_EQUAL_INT64(120000, seq.end_us[STAGE_LCD]);
+  TEST_ASSERT_TRUE(seq.end_us[STAGE_LCD] < seq.start_us[STAGE_COMM] + app_durations[STAGE_COMM]);
+}
+
+static void test_single_worker_is_sequential(void) {
+  TEST_ASSERT_TRUE(boot_seq_simulate(&seq, app_stages, STAGE_COUNT, app_durations, 1));
+  TEST_ASSERT_EQUAL_INT64(761000, seq.boot_end_us);
+  TEST_ASSERT_EQUAL_INT64(635000, boot_seq_critical_path_us(&seq));
+}
+
+static void test_failure_skips_dependents(void) {
+  int64_t durations[STAGE_COUNT];
+  for (int i = 0; i < STAGE_COUNT; i++) durations[i] = app_durations[i];
+  durations[STAGE_NVS] = -30000;
+
+  TEST_ASSERT_TRUE(boot_seq_simulate(&seq, app_stages, STAGE_COUNT, durations, 2));
+  TEST_ASSERT_TRUE(boot_seq_failed(&seq));
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_FAILED, seq.state[STAGE_NVS]);
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_SKIPPED, seq.state[STAGE_SETTINGS]);
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_SKIPPED, seq.state[STAGE_COMM]);
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_DONE, seq.state[STAGE_LCD]);
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_DONE, seq.state[STAGE_POWER]);
+}
+
+static void test_optional_failure_keeps_going(void) {
+  const boot_stage_t stages[] = {
+    { .name = "probe", .deps = 0, .optional = true },
+    { .name = "use",   .deps = BOOT_DEP(0) },
+  };
+  const int64_t durations[] = { -100, 100 };
+  TEST_ASSERT_TRUE(boot_seq_simulate(&seq, stages, 2, durations, 1));
+  TEST_ASSERT_FALSE(boot_seq_failed(&seq));
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_DONE, seq.state[1]);
+}
+
+static void test_invalid_graphs_rejected(void) {
+  const boot_stage_t self_dep[] = { { .name = "a", .deps = BOOT_DEP(0) } };
+  const boot_stage_t cycle[] = {
+    { .name = "a", .deps = BOOT_DEP(2) },
+    { .name = "b", .deps = BOOT_DEP(0) },
+    { .name = "c", .deps = BOOT_DEP(1) },
+  };
+  const boot_stage_t out_of_range[] = { { .name = "a", .deps = BOOT_DEP(3) } };
+  TEST_ASSERT_FALSE(boot_seq_init(&seq, self_dep, 1, 0));
+  TEST_ASSERT_FALSE(boot_seq_init(&seq, cycle, 3, 0));
+  TEST_ASSERT_FALSE(boot_seq_init(&seq, out_of_range, 1, 0));
+  TEST_ASSERT_FALSE(boot_seq_init(&seq, app_stages, 0, 0));
+}
+
+static void test_ready_order_is_priority(void) {
+  TEST_ASSERT_TRUE(boot_seq_init(&seq, app_stages, STAGE_COUNT, 0));
+  TEST_ASSERT_EQUAL_INT(STAGE_NVS, boot_seq_take_ready(&seq, 0));
+  TEST_ASSERT_EQUAL_INT(STAGE_LCD, boot_seq_take_ready(&seq, 0));
+  TEST_ASSERT_EQUAL_INT(STAGE_BUTTON, boot_seq_take_ready(&seq, 0));
+  TEST_ASSERT_EQUAL_INT(STAGE_QUEUES, boot_seq_take_ready(&seq, 0));
+  TEST_ASSERT_EQUAL_INT(-1, boot_seq_take_ready(&seq, 0));
+
+  boot_seq_complete(&seq, STAGE_NVS, 0, 10);
+  TEST_ASSERT_EQUAL_INT(STAGE_SETTINGS, boot_seq_take_ready(&seq, 10));
+  // complete dua kali diabaikan
+  boot_seq_complete(&seq, STAGE_NVS, -1, 20);
+  TEST_ASSERT_EQUAL_UINT8(BOOT_STAGE_DONE, seq.state[STAGE_NVS]);
+
+  TEST_ASSERT_TRUE(boot_seq_mark_first_weight(&seq, 500));
+  TEST_ASSERT_FALSE(boot_seq_mark_first_weight(&seq, 600));
+  TEST_ASSERT_EQUAL_INT64(500, seq.first_weight_us);
+  TEST_ASSERT_EQUAL_STRING("SKIPPED", boot_stage_state_name(BOOT_STAGE_SKIPPED));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_parallel_boot_hits_critical_path);
+  RUN_TEST(test_single_worker_is_sequential);
+  RUN_TEST(test_failure_skips_dependents);
+  RUN_TEST(test_optional_failure_keeps_going);
+  RUN_TEST(test_invalid_graphs_rejected);
+  RUN_TEST(test_ready_order_is_priority);
+  return UNITY_END();
+}
@@ -0,0 +1,466 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sub_button/button_engine.h"
+
+#define PIN_COUNT        4
+#define TRACK_MAX        16384
+#define EVENT_LOG_MAX    2048
+#define TASK_LATENCY_US  30
+#define HOUR_US          3600000000LL
+#define HOUR_GESTURES    600
+#define GESTURE_GAP_US   5500000
+#define POLL_PERIOD_MS   20
+#define TRANSCRIPT_MAX   512
+#define BENCH_POLLS      2000000
+
+// level GPIO per pin sebagai daftar toggle berurutan waktu (kontak dengan bounce)
+typedef struct {
+  int64_t  time_us[TRACK_MAX];
+  bool     level[TRACK_MAX];
+  uint32_t count;
+} track_t;
+
+typedef struct {
+  uint32_t wakes;
+  uint32_t timer_wakes;
+  uint32_t events;
+  uint32_t kinds[BUTTON_ENGINE_KIND_COUNT];
+} run_result_t;
+
+static track_t tracks[PIN_COUNT];
+static bool armed[PIN_COUNT];
+static bool armed_level[PIN_COUNT]; // interrupt saat level pin == nilai ini
+static int64_t now_us;
+static uint32_t rng_state;
+static button_engine_t engine;
+static button_engine_config_t config;
+static button_engine_event_t event_log[EVENT_LOG_MAX];
+static uint32_t event_batch[EVENT_LOG_MAX]; // nomor poll, event satu poll = satu batch
+
+// forward declaration
+static uint32_t next_random(void);
+static bool level_at(uint8_t pin, int64_t time_us);
+static int64_t next_irq_us(uint8_t pin);
+static uint32_t read_pins(void* ctx);
+static void arm_pin(void* ctx, uint8_t pin, bool pressed);
+static void add_toggle(uint8_t pin, int64_t time_us, bool level);
+static void edge(uint8_t pin, int64_t time_us, bool level, bool bouncy);
+static void press(uint8_t pin, int64_t start_us, int64_t duration_us, bool bouncy);
+static run_result_t run(int64_t end_us, int64_t latency_us);
+static void assert_event(uint32_t index, uint8_t pin, button_engine_kind_t kind, int64_t time_us);
+static void tap(uint8_t pin, int64_t start_ms, int64_t duration_ms);
+static void expect_replay(int64_t end_ms, const char* expected);
+static uint32_t read_released(void* ctx);
+static void arm_ignored(void* ctx, uint8_t pin, bool pressed);
+
+void setUp(void) {
+  memset(tracks, 0, sizeof(tracks));
+  rng_state = 1;
+  memset(&config, 0, sizeof(config));
+  config.pin_count = PIN_COUNT;
+  config.debounce_us = 20000;
+  for (uint8_t i = 0; i < PIN_COUNT; i++) {
+    config.pins[i].long_press_us = 1000000;
+    config.pins[i].double_click_us = 300000;
+  }
+  config.chord_count = 1;
+  config.chords[0].mask = 0x03; // A+B
+  config.chords[0].hold_us = 1000000;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static bool level_at(uint8_t pin, int64_t time_us) {
+  // toggle terakhir yang <= time_us
+  const track_t* track = &tracks[pin];
+  uint32_t lo = 0, hi = track->count;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (track->time_us[mid] <= time_us) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo > 0 && track->level[lo - 1];
+}
+
+static int64_t next_irq_us(uint8_t pin) {
+  if (!armed[pin]) return INT64_MAX;
+  if (level_at(pin, now_us) == armed_level[pin]) return now_us;
+  const track_t* track = &tracks[pin];
+  for (uint32_t i = 0; i < track->count; i++) {
+    if (track->time_us[i] > now_us && track->level[i] == armed_level[pin]) return track->time_us[i];
+  }
+  return INT64_MAX;
+}
+
+static uint32_t read_pins(void* ctx) {
+  uint32_t mask = 0;
+  for (uint8_t pin = 0; pin < PIN_COUNT; pin++) {
+    if (level_at(pin, now_us)) mask |= 1u << pin;
+  }
+  return mask;
+}
+
+static void arm_pin(void* ctx, uint8_t pin, bool pressed) {
+  armed[pin] = true;
+  armed_level[pin] = !pressed;
+}
+
+static void add_toggle(uint8_t pin, int64_t time_us, bool level) {
+  track_t* track = &tracks[pin];
+  TEST_ASSERT_LESS_THAN(TRACK_MAX, track->count);
+  track->time_us[track->count] = time_us;
+  track->level[track->count] = level;
+  track->count++;
+}
+
+static void edge(uint8_t pin, int64_t time_us, bool level, bool bouncy) {
+  // 0..5 bounce, masing-masing 0.1..0.8 ms
+  uint32_t bounces = bouncy ? next_random() % 6 : 0;
+  for (uint32_t i = 0; i < bounces; i++) {
+    add_toggle(pin, time_us, level);
+    time_us += 100 + next_random() % 700;
+    add_toggle(pin, time_us, !level);
+    time_us += 100 + next_random() % 700;
+  }
+  add_toggle(pin, time_us, level);
+}
+
+static void press(uint8_t pin, int64_t start_us, int64_t duration_us, bool bouncy) {
+  edge(pin, start_us, true, bouncy);
+  edge(pin, start_us + duration_us, false, bouncy);
+}
+
+static run_result_t run(int64_t end_us, int64_t latency_us) {
+  // loop button_task: tidur sampai interrupt pin atau tenggat engine
+  run_result_t result = { 0 };
+  now_us = 0;
+  memset(armed, 0, sizeof(armed));
+  button_engine_io_t io = { .read = read_pins, .arm = arm_pin, .ctx = NULL };
+  button_engine_init(&engine, &config, &io, 0);
+  int64_t timer_us = button_engine_next_deadline_us(&engine);
+
+  for (;;) {
+    int64_t irq_us = INT64_MAX;
+    for (uint8_t pin = 0; pin < PIN_COUNT; pin++) {
+      int64_t pin_irq_us = next_irq_us(pin);
+      if (pin_irq_us < irq_us) irq_us = pin_irq_us;
+    }
+    int64_t wake_us = irq_us < timer_us ? irq_us : timer_us;
+    if (wake_us >= end_us) break;
+    now_us = wake_us;
+    result.wakes++;
+
+    if (irq_us == wake_us) {
+      // ISR: matikan interrupt pin lalu beri tahu task
+      for (uint8_t pin = 0; pin < PIN_COUNT; pin++) {
+        if (armed[pin] && level_at(pin, now_us) == armed_level[pin]) {
+          armed[pin] = false;
+          button_engine_irq(&engine, pin, now_us);
+        }
+      }
+      now_us += latency_us;
+    } else {
+      result.timer_wakes++;
+    }
+
+    button_engine_event_t events[BUTTON_ENGINE_MAX_EVENTS];
+    uint8_t count = button_engine_poll(&engine, now_us, events, BUTTON_ENGINE_MAX_EVENTS);
+    for (uint8_t i = 0; i < count; i++) {
+      if (result.events < EVENT_LOG_MAX) {
+        event_log[result.events] = events[i];
+        event_batch[result.events] = result.wakes;
+      }
+      result.events++;
+      result.kinds[events[i].kind]++;
+    }
+    timer_us = button_engine_next_deadline_us(&engine);
+  }
+  return result;
+}
+
+static void assert_event(uint32_t index, uint8_t pin, button_engine_kind_t kind, int64_t time_us) {
+  TEST_ASSERT_EQUAL_UINT8(pin, event_log[index].pin);
+  TEST_ASSERT_EQUAL_STRING(button_engine_kind_name(kind), button_engine_kind_name(event_log[index].kind));
+  TEST_ASSERT_EQUAL_INT64(time_us, event_log[index].time_us);
+}
+
+static void tap(uint8_t pin, int64_t start_ms, int64_t duration_ms) {
+  press(pin, start_ms * 1000, duration_ms * 1000, false);
+}
+
+static void expect_replay(int64_t end_ms, const char* expected) {
+  // transkrip "A:CLICK@480", chord memakai indeks chord, event satu poll di dalam [ ]
+  run_result_t result = run(end_ms * 1000, 0);
+  char transcript[TRANSCRIPT_MAX] = "";
+  size_t len = 0;
+  for (uint32_t i = 0; i < result.events && i < EVENT_LOG_MAX; i++) {
+    const button_engine_event_t* event = &event_log[i];
+    bool first = i == 0 || event_batch[i - 1] != event_batch[i];
+    bool last = i + 1 == result.events || event_batch[i + 1] != event_batch[i];
+    bool batch = !(first && last);
+    char name = event->kind == BUTTON_ENGINE_CHORD_LONG ? (char) ('0' + event->pin) : (char) ('A' + event->pin);
+    len += (size_t) snprintf(transcript + len, sizeof(transcript) - len, "%s%s%c:%s@%lld%s",
+                             i > 0 ? " " : "", first && batch ? "[" : "", name,
+                             button_engine_kind_name((button_engine_kind_t) event->kind),
+                             (long long) (event->time_us / 1000), last && batch ? "]" : "");
+    TEST_ASSERT_LESS_THAN(sizeof(transcript), len);
+  }
+  TEST_ASSERT_EQUAL_STRING(expected, transcript);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.stats.dropped);
+}
+
+static uint32_t read_released(void* ctx) {
+  return 0;
+}
+
+static void arm_ignored(void* ctx, uint8_t pin, bool pressed) {
+}
+
+static void test_idle_sleeps(void) {
+  // tanpa tombol: tidak ada tenggat, tidak ada wake selama satu jam
+  run_result_t result = run(HOUR_US, TASK_LATENCY_US);
+  TEST_ASSERT_EQUAL_UINT32(0, result.wakes);
+  TEST_ASSERT_EQUAL_INT64(BUTTON_ENGINE_NO_DEADLINE, button_engine_next_deadline_us(&engine));
+  for (uint8_t pin = 0; pin < PIN_COUNT; pin++) TEST_ASSERT_TRUE(armed[pin]);
+}
+
+static void test_bouncy_scenario(void) {
+  press(0, 100000, 80000, true);
+  press(1, 1000000, 70000, true);
+  press(1, 1200000, 70000, true);
+  press(2, 2000000, 1500000, true);
+  press(0, 5000000, 2000000, true);
+  press(1, 5100000, 1800000, true);
+  press(3, 9000000, 8000, false);
+  run_result_t result = run(12000000, TASK_LATENCY_US);
+
+  TEST_ASSERT_EQUAL_UINT32(6, result.events);
+  // click dilaporkan saat jendela double click habis (300 ms setelah dilepas)
+  assert_event(0, 0, BUTTON_ENGINE_CLICK, 480000);
+  TEST_ASSERT_EQUAL_INT64(100000, event_log[0].origin_us);
+  assert_event(1, 1, BUTTON_ENGINE_DOUBLE_CLICK, 1270000);
+  // long press tepat di ambang, bukan di tick 20 ms berikutnya
+  assert_event(2, 2, BUTTON_ENGINE_LONG_START, 3000000);
+  assert_event(3, 2, BUTTON_ENGINE_LONG_UP, 3500000);
+  assert_event(4, 0, BUTTON_ENGINE_CHORD_LONG, 6100000);
+  // tap 8 ms di dalam jendela debounce tetap satu click
+  assert_event(5, 3, BUTTON_ENGINE_CLICK, 9320000);
+  TEST_ASSERT_GREATER_THAN(0, engine.stats.bounces);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.stats.dropped);
+  TEST_ASSERT_EQUAL_INT64(BUTTON_ENGINE_NO_DEADLINE, button_engine_next_deadline_us(&engine));
+}
+
+static void test_random_hour(void) {
+  // skenario commit: 600 gesture acak (click, double click, long) dalam satu jam
+  uint32_t expected[BUTTON_ENGINE_KIND_COUNT] = { 0 };
+  int64_t start_us = 1000000;
+  for (int i = 0; i < HOUR_GESTURES; i++) {
+    uint8_t pin = (uint8_t) (next_random() % PIN_COUNT);
+    switch (next_random() % 3) {
+      case 0:
+        press(pin, start_us, 60000 + next_random() % 100000, true);
+        expected[BUTTON_ENGINE_CLICK]++;
+        break;
+      case 1:
+        press(pin, start_us, 70000, true);
+        press(pin, start_us + 180000, 70000, true);
+        expected[BUTTON_ENGINE_DOUBLE_CLICK]++;
+        break;
+      default:
+        press(pin, start_us, 1200000 + next_random() % 500000, true);
+        expected[BUTTON_ENGINE_LONG_START]++;
+        expected[BUTTON_ENGINE_LONG_UP]++;
+        break;
+    }
+    start_us += GESTURE_GAP_US;
+  }
+  run_result_t result = run(HOUR_US, TASK_LATENCY_US);
+
+  uint32_t total = 0;
+  for (int kind = 0; kind < BUTTON_ENGINE_KIND_COUNT; kind++) {
+    TEST_ASSERT_EQUAL_UINT32(expected[kind], result.kinds[kind]);
+    total += expected[kind];
+  }
+  TEST_ASSERT_EQUAL_UINT32(total, result.events);
+  // commit: 788 event, 3594 wake vs 180000 untuk polling 20 ms
+  TEST_ASSERT_GREATER_THAN(700, total);
+  TEST_ASSERT_LESS_THAN(total * 6, result.wakes);
+  TEST_ASSERT_LESS_THAN(HOUR_US / 1000 / POLL_PERIOD_MS / 40, result.wakes);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.stats.dropped);
+}
+
+static void test_replay_click(void) {
+  tap(0, 100, 80);
+  expect_replay(2000, "A:CLICK@480");
+}
+
+static void test_replay_double_click(void) {
+  tap(0, 100, 80);
+  tap(0, 300, 80);
+  expect_replay(2000, "A:DOUBLE_CLICK@380");
+}
+
+static void test_replay_click_then_long(void) {
+  tap(0, 100, 80);
+  tap(0, 300, 1500);
+  expect_replay(3000, "A:CLICK@480 A:LONG_START@1300 A:LONG_UP@1800");
+}
+
+static void test_replay_long(void) {
+  tap(0, 100, 1500);
+  expect_replay(3000, "A:LONG_START@1100 A:LONG_UP@1600");
+}
+
+static void test_replay_simultaneous_clicks_batch(void) {
+  tap(2, 100, 80);
+  tap(3, 100, 80);
+  expect_replay(2000, "[C:CLICK@480 D:CLICK@480]");
+}
+
+static void test_replay_simultaneous_longs_batch(void) {
+  tap(2, 100, 1500);
+  tap(3, 100, 1500);
+  expect_replay(3000, "[C:LONG_START@1100 D:LONG_START@1100] [C:LONG_UP@1600 D:LONG_UP@1600]");
+}
+
+static void test_replay_chord_ab(void) {
+  // hold dihitung dari anggota terakhir yang ditekan; pelepasan setelah chord tanpa event
+  tap(0, 100, 2000);
+  tap(1, 200, 2000);
+  expect_replay(3000, "0:CHORD_LONG@1200");
+}
+
+static void test_replay_released_before_chord(void) {
+  tap(0, 100, 300);
+  tap(1, 200, 2000);
+  expect_replay(3000, "A:CLICK@700 B:LONG_START@1200 B:LONG_UP@2200");
+}
+
+static void test_replay_held_at_init(void) {
+  tap(0, 0, 500);
+  expect_replay(2000, "");
+}
+
+static void test_replay_second_chord(void) {
+  config.chord_count = 2;
+  config.chords[1].mask = 0x0C; // C+D
+  config.chords[1].hold_us = 500000;
+  tap(2, 100, 2000);
+  tap(3, 150, 2000);
+  expect_replay(3000, "1:CHORD_LONG@650");
+}
+
+static void test_replay_three_pin_chord(void) {
+  config.chords[0].mask = 0x07;
+  config.chords[0].hold_us = 800000;
+  tap(0, 100, 2000);
+  tap(1, 110, 2000);
+  tap(2, 120, 2000);
+  expect_replay(3000, "0:CHORD_LONG@920");
+}
+
+static void test_replay_double_click_disabled(void) {
+  // click langsung saat dilepas, tanpa menunggu jendela 300 ms
+  config.pins[3].double_click_us = 0;
+  tap(3, 100, 80);
+  tap(3, 250, 80);
+  expect_replay(2000, "D:CLICK@180 D:CLICK@330");
+}
+
+static void test_replay_long_press_disabled(void) {
+  config.pins[1].long_press_us = 0;
+  tap(1, 100, 3000);
+  expect_replay(4000, "B:CLICK@3400");
+}
+
+static void test_replay_tap_inside_debounce(void) {
+  tap(0, 100, 8);
+  expect_replay(2000, "A:CLICK@420");
+}
+
+static void test_names(void) {
+  TEST_ASSERT_EQUAL_STRING("DOUBLE_CLICK", button_engine_kind_name(BUTTON_ENGINE_DOUBLE_CLICK));
+  TEST_ASSERT_EQUAL_STRING("CHORD_LONG", button_engine_kind_name(BUTTON_ENGINE_CHORD_LONG));
+  TEST_ASSERT_EQUAL_STRING("UNKNOWN", button_engine_kind_name(BUTTON_ENGINE_KIND_COUNT));
+  TEST_ASSERT_EQUAL_STRING("DOWN_AGAIN", button_engine_state_name(BUTTON_ENGINE_DOWN_AGAIN));
+  TEST_ASSERT_EQUAL_STRING("UNKNOWN", button_engine_state_name(BUTTON_ENGINE_STATE_COUNT));
+}
+
+static void test_scan_cost_per_button(void) {
+  // biaya satu wake button_task (poll + next_deadline) saat semua tombol diam, 1 / 4 / 8 pin
+  static const uint8_t pin_counts[] = { 1, 4, 8 };
+  button_engine_io_t io = { .read = read_released, .arm = arm_ignored, .ctx = NULL };
+  button_engine_event_t events[BUTTON_ENGINE_MAX_EVENTS];
+
+  for (size_t k = 0; k < sizeof(pin_counts) / sizeof(pin_counts[0]); k++) {
+    button_engine_config_t bench = config;
+    bench.pin_count = pin_counts[k];
+    for (uint8_t i = PIN_COUNT; i < bench.pin_count; i++) bench.pins[i] = config.pins[0];
+    button_engine_init(&engine, &bench, &io, 0);
+
+    struct timespec start, end;
+    uint32_t emitted = 0;
+    int64_t deadline = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int64_t i = 0; i < BENCH_POLLS; i++) {
+      emitted += button_engine_poll(&engine, i, events, BUTTON_ENGINE_MAX_EVENTS);
+      deadline = button_engine_next_deadline_us(&engine);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / BENCH_POLLS;
+    char line[96];
+    snprintf(line, sizeof(line), "%u pin: %.1f ns/poll, %.1f ns/button", bench.pin_count, ns, ns / bench.pin_count);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT32(0, emitted);
+    TEST_ASSERT_EQUAL_INT64(BUTTON_ENGINE_NO_DEADLINE, deadline);
+    // batas longgar: scan yang jadi O(pin^2) atau mulai mengalokasi akan jauh di atas ini
+    TEST_ASSERT_LESS_THAN(2000, (int) ns);
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_idle_sleeps);
+  RUN_TEST(test_bouncy_scenario);
+  RUN_TEST(test_random_hour);
+  RUN_TEST(test_replay_click);
+  RUN_TEST(test_replay_double_click);
+  RUN_TEST(test_replay_click_then_long);
+  RUN_TEST(test_replay_long);
+  RUN_TEST(test_replay_simultaneous_clicks_batch);
+  RUN_TEST(test_replay_simultaneous_longs_batch);
+  RUN_TEST(test_replay_chord_ab);
+  RUN_TEST(test_replay_released_before_chord);
+  RUN_TEST(test_replay_held_at_init);
+  RUN_TEST(test_replay_second_chord);
+  RUN_TEST(test_replay_three_pin_chord);
+  RUN_TEST(test_replay_double_click_disabled);
+  RUN_TEST(test_replay_long_press_disabled);
+  RUN_TEST(test_replay_tap_inside_debounce);
+  RUN_TEST(test_names);
+  RUN_TEST(test_scan_cost_per_button);
+  return UNITY_END();
+}
@@ -0,0 +1,166 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <math.h>
+
+#include "sub_main/cal_engine.h"
+
+// load cell sintetis: offset HX711 dan gain khas sel 5 kg
+#define RAW_ZERO       8400000
+#define COUNTS_PER_G   420.0
+#define MAX_RESIDUAL_G 0.5f
+
+static cal_engine_t engine;
+
+// forward declaration
+static int32_t raw_linear(double grams);
+static int32_t raw_bent(double grams);
+static void assert_lut_matches_model(int32_t from, int32_t to, int32_t step);
+
+void setUp(void) {
+  cal_engine_init(&engine);
+  cal_engine_begin(&engine);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static int32_t raw_linear(double grams) {
+  return (int32_t) lround(RAW_ZERO + COUNTS_PER_G * grams);
+}
+
+static int32_t raw_bent(double grams) {
+  // sel yang melengkung: gain turun ~10% di ujung range
+  return (int32_t) lround(RAW_ZERO + COUNTS_PER_G * grams - 0.04 * grams * grams);
+}
+
+static void assert_lut_matches_model(int32_t from, int32_t to, int32_t step) {
+  for (int32_t raw = from; raw <= to; raw += step) {
+    float direct = cal_model_eval(&engine.model, raw);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, direct, cal_engine_eval(&engine, raw));
+  }
+}
+
+static void test_no_model_until_commit(void) {
+  TEST_ASSERT_FALSE(cal_engine_has_model(&engine));
+  TEST_ASSERT_FALSE(cal_engine_fit(&engine, CAL_MODEL_AUTO, MAX_RESIDUAL_G));
+  cal_engine_add_point(&engine, raw_linear(0), 0.0f);
+  TEST_ASSERT_FALSE(cal_engine_fit(&engine, CAL_MODEL_AUTO, MAX_RESIDUAL_G));
+  // raw sama untuk dua massa: tidak ada kemiringan
+  cal_engine_add_point(&engine, raw_linear(0), 100.0f);
+  TEST_ASSERT_FALSE(cal_engine_fit(&engine, CAL_MODEL_AUTO, MAX_RESIDUAL_G));
+  TEST_ASSERT_FALSE(cal_engine_commit(&engine));
+}
+
+static void test_linear_fit(void) {
+  cal_engine_add_point(&engine, raw_linear(0), 0.0f);
+  cal_engine_add_point(&engine, raw_linear(1000), 1000.0f);
+  cal_engine_add_point(&engine, raw_linear(500), 500.0f);
+  TEST_ASSERT_TRUE(cal_engine_fit(&engine, CAL_MODEL_AUTO, MAX_RESIDUAL_G));
+  TEST_ASSERT_EQUAL_UINT8(CAL_MODEL_LINEAR, engine.candidate.type);
+  TEST_ASSERT_TRUE(engine.candidate.max_residual < 0.01f);
+  // titik disimpan urut raw naik
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 500.0f, engine.candidate.points[1].mass);
+
+  TEST_ASSERT_TRUE(cal_engine_commit(&engine));
+  TEST_ASSERT_TRUE(cal_engine_has_model(&engine));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 750.0f, cal_engine_eval(&engine, raw_linear(750)));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, -20.0f, cal_engine_eval(&engine, raw_linear(-20)));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, COUNTS_PER_G, cal_model_scale_factor(&engine.model));
+}
+
+static void test_bent_cell_goes_piecewise(void) {
+  for (int g = 0; g <= 1000; g += 250) {
+    cal_engine_add_point(&engine, raw_bent(g), (float) g);
+  }
+  TEST_ASSERT_TRUE(cal_engine_fit(&engine, CAL_MODEL_AUTO, MAX_RESIDUAL_G));
+  TEST_ASSERT_EQUAL_UINT8(CAL_MODEL_PIECEWISE, engine.candidate.type);
+  TEST_ASSERT_TRUE(engine.candidate.max_residual > MAX_RESIDUAL_G);
+  TEST_ASSERT_TRUE(cal_engine_commit(&engine));
+
+  // tepat di titik kalibrasi, dan jauh lebih baik dari fit linear di antaranya
+  for (int g = 0; g <= 1000; g += 250) {
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, (float) g, cal_engine_eval(&engine, raw_bent(g)));
+  }
+  float linear_error = fabsf(engine.model.slope * raw_bent(375) + engine.model.offset - 375.0f);
+  float piecewise_error = fabsf(cal_engine_eval(&engine, raw_bent(375)) - 375.0f);
+  TEST_ASSERT_TRUE(piecewise_error < linear_error);
+}
+
+static void test_lut_matches_direct_eval(void) {
+  for (int g = 0; g <= 1000; g += 250) {
+    cal_engine_add_point(&engine, raw_bent(g), (float) g);
+  }
+  cal_engine_fit(&engine, CAL_MODEL_PIECEWISE, MAX_RESIDUAL_G);
+  cal_engine_commit(&engine);
+  TEST_ASSERT_TRUE(engine.lut_valid);
+  TEST_ASSERT_NOT_EQUAL(0, engine.lut_knee_mask);
+
+  // seluruh range table termasuk segmen titik patah, plus di luar table
+  int32_t span = raw_bent(1000) - raw_bent(0);
+  assert_lut_matches_model(raw_bent(0) - span, raw_bent(1000) + span, 97);
+}
+
+static void test_load_rejects_bad_blob(void) {
+  cal_engine_add_point(&engine, raw_linear(0), 0.0f);
+  cal_engine_add_point(&engine, raw_linear(1000), 1000.0f);
+  cal_engine_fit(&engine, CAL_MODEL_LINEAR, MAX_RESIDUAL_G);
+  cal_model_t blob = engine.candidate;
+
+  cal_engine_t fresh;
+  cal_engine_init(&fresh);
+  cal_model_t bad = blob;
+  bad.version = CAL_MODEL_VERSION + 1;
+  TEST_ASSERT_FALSE(cal_engine_load(&fresh, &bad));
+  bad = blob;
+  bad.slope = NAN;
+  TEST_ASSERT_FALSE(cal_engine_load(&fresh, &bad));
+  bad = blob;
+  bad.point_count = CAL_MAX_POINTS + 1;
+  TEST_ASSERT_FALSE(cal_engine_load(&fresh, &bad));
+  TEST_ASSERT_FALSE(cal_engine_has_model(&fresh));
+
+  TEST_ASSERT_TRUE(cal_engine_load(&fresh, &blob));
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 250.0f, cal_engine_eval(&fresh, raw_linear(250)));
+}
+
+static void test_points_limit(void) {
+  for (int i = 0; i < CAL_MAX_POINTS; i++) {
+    TEST_ASSERT_TRUE(cal_engine_add_point(&engine, raw_linear(i * 100), (float) (i * 100)));
+  }
+  TEST_ASSERT_FALSE(cal_engine_add_point(&engine, raw_linear(5000), 5000.0f));
+  // begin membuang titik lama, model aktif tidak berubah
+  cal_engine_begin(&engine);
+  TEST_ASSERT_EQUAL_UINT8(0, engine.point_count);
+}
+
+static void test_sample_acc_restarts_on_motion(void) {
+  cal_sample_acc_t acc;
+  cal_sample_reset(&acc);
+  const int32_t noise[] = { 3, -2, 0, 4, -5, 1, -1, 2 };
+  for (int i = 0; i < 8; i++) cal_sample_add(&acc, RAW_ZERO + noise[i], 50);
+  TEST_ASSERT_EQUAL_UINT32(8, acc.n);
+  TEST_ASSERT_INT32_WITHIN(1, RAW_ZERO, cal_sample_mean(&acc));
+  TEST_ASSERT_FLOAT_WITHIN(0.5f, 3.0f, cal_sample_stddev(&acc));
+
+  // beban dipasang: mulai ulang dari sample pertama yang keluar band
+  cal_sample_add(&acc, raw_linear(500), 50);
+  TEST_ASSERT_EQUAL_UINT32(1, acc.n);
+  TEST_ASSERT_EQUAL_INT32(raw_linear(500), cal_sample_mean(&acc));
+  TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, cal_sample_stddev(&acc));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_model_until_commit);
+  RUN_TEST(test_linear_fit);
+  RUN_TEST(test_bent_cell_goes_piecewise);
+  RUN_TEST(test_lut_matches_direct_eval);
+  RUN_TEST(test_load_rejects_bad_blob);
+  RUN_TEST(test_points_limit);
+  RUN_TEST(test_sample_acc_restarts_on_motion);
+  return UNITY_END();
+}
@@ -0,0 +1,352 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sub_comm/comm_codec.h"
+
+#define BENCH_FRAMES 200000
+
+static uint32_t rng_state;
+
+// forward declaration
+static weight_data_t make_weight(float filtered, float units, long raw);
+static void reseal(uint8_t* frame, size_t len);
+static uint32_t next_random(void);
+static void make_resting_trace(weight_data_t* samples, int count);
+
+void setUp(void) {
+  rng_state = 1;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static weight_data_t make_weight(float filtered, float units, long raw) {
+  weight_data_t weight = {
+    .main_state = NORMAL_MODE,
+    .filtered_weight = filtered,
+    .units = units,
+    .raw_weight = raw,
+    .is_ready = true,
+  };
+  return weight;
+}
+
+static void reseal(uint8_t* frame, size_t len) {
+  // hitung ulang crc setelah header diubah
+  uint16_t crc = comm_codec_crc16(frame, len - COMM_WIRE_CRC_LEN);
+  frame[len - 2] = (uint8_t) crc;
+  frame[len - 1] = (uint8_t) (crc >> 8);
+}
+
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static void make_resting_trace(weight_data_t* samples, int count) {
+  // beban 250 g diam di atas load cell: drift pelan, noise units +-0.2 g, filtered lebih halus,
+  // raw 420 count per gram
+  float filtered = 250.0f;
+  for (int i = 0; i < count; i++) {
+    float units = 250.0f + 0.01f * i + (float) (next_random() % 41) / 100.0f - 0.2f;
+    filtered += (units - filtered) / 8.0f;
+    samples[i] = make_weight(filtered, units, (long) (units * 420.0f));
+  }
+}
+
+static void test_crc16_ccitt_false_check_value(void) {
+  const uint8_t check[] = "123456789";
+  TEST_ASSERT_EQUAL_HEX16(0x29B1, comm_codec_crc16(check, 9));
+}
+
+static void test_weight_round_trip(void) {
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  weight_data_t in = make_weight(123.45f, -6.78f, -1234567);
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 0xBEEF, &in);
+  TEST_ASSERT_EQUAL_size_t(18, len);
+  TEST_ASSERT_EQUAL_size_t(COMM_WIRE_WEIGHT_FRAME_LEN, len);
+
+  comm_frame_header_t header;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL_UINT16(0xBEEF, header.seq);
+
+  weight_data_t out;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_decode_weight(&header, &out));
+  TEST_ASSERT_EQUAL(NORMAL_MODE, out.main_state);
+  TEST_ASSERT_TRUE(out.is_ready);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, 123.45f, out.filtered_weight);
+  TEST_ASSERT_FLOAT_WITHIN(0.005f, -6.78f, out.units);
+  TEST_ASSERT_EQUAL_INT32(-1234567, out.raw_weight);
+}
+
+static void test_encode_rejects_small_buffer(void) {
+  uint8_t frame[COMM_WIRE_WEIGHT_FRAME_LEN - 1];
+  weight_data_t in = make_weight(1.0f, 1.0f, 1);
+  TEST_ASSERT_EQUAL_size_t(0, comm_codec_encode_weight(frame, sizeof(frame), 1, &in));
+}
+
+static void test_cmd_and_ack_round_trip(void) {
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  comm_send_data_t cmd = { .command = CMD_CAL_CONFIRMATION, .value = 412.5f };
+  size_t len = comm_codec_encode_cmd(frame, sizeof(frame), 7, &cmd);
+  TEST_ASSERT_EQUAL_size_t(COMM_WIRE_CMD_FRAME_LEN, len);
+
+  comm_frame_header_t header;
+  comm_send_data_t out;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_decode_cmd(&header, &out));
+  TEST_ASSERT_EQUAL(CMD_CAL_CONFIRMATION, out.command);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 412.5f, out.value);
+
+  len = comm_codec_encode_ack(frame, sizeof(frame), 3, 7, COMM_ACK_REJECTED);
+  TEST_ASSERT_EQUAL_size_t(COMM_WIRE_ACK_FRAME_LEN, len);
+  uint16_t acked;
+  comm_ack_status_t status;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_decode_ack(&header, &acked, &status));
+  TEST_ASSERT_EQUAL_UINT16(7, acked);
+  TEST_ASSERT_EQUAL(COMM_ACK_REJECTED, status);
+  // tipe salah tidak didecode sebagai weight
+  weight_data_t weight;
+  TEST_ASSERT_EQUAL(COMM_DECODE_BAD_TYPE, comm_codec_decode_weight(&header, &weight));
+}
+
+static void test_probe_round_trip(void) {
+  uint8_t frame[COMM_WIRE_PROBE_FRAME_LEN];
+  size_t len = comm_codec_encode_probe(frame, sizeof(frame), COMM_FRAME_PING, 9, 0xDEADBEEF);
+  TEST_ASSERT_EQUAL_size_t(COMM_WIRE_PROBE_FRAME_LEN, len);
+
+  comm_frame_header_t header;
+  uint32_t stamp;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_FRAME_PING, header.type);
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_decode_probe(&header, &stamp));
+  TEST_ASSERT_EQUAL_UINT32(0xDEADBEEF, stamp);
+}
+
+static void test_corrupt_frame_rejected(void) {
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  weight_data_t in = make_weight(1.0f, 1.0f, 100);
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 1, &in);
+
+  comm_frame_header_t header;
+  frame[6] ^= 0x01;
+  TEST_ASSERT_EQUAL(COMM_DECODE_BAD_CRC, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_DECODE_TOO_SHORT, comm_codec_parse(frame, COMM_WIRE_OVERHEAD - 1, &header));
+}
+
+static void test_major_version_must_match_minor_may_differ(void) {
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  weight_data_t in = make_weight(2.0f, 2.0f, 200);
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 1, &in);
+  comm_frame_header_t header;
+
+  frame[0] = (uint8_t) (((COMM_WIRE_VERSION_MAJOR + 1) << 4) | COMM_WIRE_VERSION_MINOR);
+  reseal(frame, len);
+  TEST_ASSERT_EQUAL(COMM_DECODE_BAD_VERSION, comm_codec_parse(frame, len, &header));
+
+  // minor lebih baru dengan payload lebih panjang: ekor payload diabaikan
+  len = comm_codec_encode_weight(frame, sizeof(frame), 1, &in);
+  size_t body = len - COMM_WIRE_CRC_LEN;
+  frame[0] = (uint8_t) ((COMM_WIRE_VERSION_MAJOR << 4) | (COMM_WIRE_VERSION_MINOR + 1));
+  frame[body] = 0xAA;
+  frame[body + 1] = 0xBB;
+  len += 2;
+  reseal(frame, len);
+
+  weight_data_t out;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_decode_weight(&header, &out));
+  TEST_ASSERT_EQUAL_INT32(200, out.raw_weight);
+}
+
+static void test_legacy_struct_detected(void) {
+  weight_data_t legacy = make_weight(5.0f, 5.0f, 500);
+  TEST_ASSERT_TRUE(comm_codec_is_legacy_weight((const uint8_t*) &legacy, sizeof(legacy)));
+
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 1, &legacy);
+  TEST_ASSERT_FALSE(comm_codec_is_legacy_weight(frame, len));
+}
+
+static void test_batch_round_trip_slow_trace(void) {
+  // beban berubah pelan: delta kecil, 64 sample harus muat di satu frame ESP-NOW
+  weight_data_t samples[COMM_WIRE_BATCH_MAX_SAMPLES];
+  for (int i = 0; i < COMM_WIRE_BATCH_MAX_SAMPLES; i++) {
+    float grams = 250.0f + 0.37f * i;
+    samples[i] = make_weight(grams, grams, 104000 + 41 * i);
+  }
+
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  uint8_t packed = 0;
+  size_t len = comm_codec_encode_weight_batch(frame, sizeof(frame), 5, samples, COMM_WIRE_BATCH_MAX_SAMPLES, 20,
+                                              &packed);
+  TEST_ASSERT_EQUAL_UINT8(COMM_WIRE_BATCH_MAX_SAMPLES, packed);
+  TEST_ASSERT_LESS_OR_EQUAL(COMM_WIRE_MAX_FRAME_LEN, len);
+  // jauh lebih kecil dari 64 frame tunggal (18 byte per sample)
+  TEST_ASSERT_LESS_THAN(4 * COMM_WIRE_BATCH_MAX_SAMPLES, len);
+
+  comm_frame_header_t header;
+  comm_batch_reader_t reader;
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_parse(frame, len, &header));
+  TEST_ASSERT_EQUAL(COMM_DECODE_OK, comm_codec_batch_begin(&header, &reader));
+  TEST_ASSERT_EQUAL_UINT16(20, reader.interval_ms);
+
+  weight_data_t out;
+  int n = 0;
+  while (comm_codec_batch_next(&reader, &out)) {
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, samples[n].units, out.units);
+    TEST_ASSERT_EQUAL_INT32(samples[n].raw_weight, out.raw_weight);
+    n++;
+  }
+  TEST_ASSERT_EQUAL(COMM_WIRE_BATCH_MAX_SAMPLES, n);
+}
+
+static void test_batch_packs_what_fits(void) {
+  // delta besar tiap sample: tidak semua muat, sisanya untuk frame berikutnya
+  weight_data_t samples[COMM_WIRE_BATCH_MAX_SAMPLES];
+  for (int i = 0; i < COMM_WIRE_BATCH_MAX_SAMPLES; i++) {
+    float grams = (i & 1) ? 20000.0f : -20000.0f;
+    samples[i] = make_weight(grams, grams, (i & 1) ? 4000000 : -4000000);
+  }
+
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  uint8_t packed = 0;
+  size_t len = comm_codec_encode_weight_batch(frame, sizeof(frame), 5, samples, COMM_WIRE_BATCH_MAX_SAMPLES, 20,
+                                              &packed);
+  TEST_ASSERT_GREATER_THAN(0, packed);
+  TEST_ASSERT_LESS_THAN(COMM_WIRE_BATCH_MAX_SAMPLES, packed);
+  TEST_ASSERT_LESS_OR_EQUAL(COMM_WIRE_MAX_FRAME_LEN, len);
+}
+
+static void test_seq_tracker_loss_duplicate_reorder(void) {
+  comm_seq_tracker_t tracker;
+  comm_seq_tracker_reset(&tracker);
+
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 100));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 101));
+  TEST_ASSERT_FALSE(comm_seq_tracker_update(&tracker, 101));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 104));
+  TEST_ASSERT_EQUAL_UINT32(2, tracker.lost);
+  // 102 datang terlambat: bukan hilang lagi, tapi tetap dibuang
+  TEST_ASSERT_FALSE(comm_seq_tracker_update(&tracker, 102));
+  TEST_ASSERT_EQUAL_UINT32(1, tracker.lost);
+  TEST_ASSERT_EQUAL_UINT32(1, tracker.reordered);
+  TEST_ASSERT_EQUAL_UINT32(1, tracker.duplicated);
+  TEST_ASSERT_EQUAL_UINT32(3, tracker.received);
+}
+
+static void test_seq_tracker_wraps(void) {
+  comm_seq_tracker_t tracker;
+  comm_seq_tracker_reset(&tracker);
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 65534));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 65535));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, tracker.lost);
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.restarts);
+}
+
+static void test_seq_tracker_sender_restart(void) {
+  comm_seq_tracker_t tracker;
+  comm_seq_tracker_reset(&tracker);
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 40000));
+  // Device A reboot: seq mulai dari 0 lagi, bukan ~25000 frame hilang
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 0));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 1));
+  TEST_ASSERT_EQUAL_UINT32(0, tracker.lost);
+  TEST_ASSERT_EQUAL_UINT32(1, tracker.restarts);
+
+  // mundur jauh juga reboot
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 500));
+  TEST_ASSERT_TRUE(comm_seq_tracker_update(&tracker, 2));
+  TEST_ASSERT_EQUAL_UINT32(2, tracker.restarts);
+  TEST_ASSERT_EQUAL_UINT32(498, tracker.lost);
+}
+
+static void test_batch_bytes_per_sample(void) {
+  weight_data_t samples[COMM_WIRE_BATCH_MAX_SAMPLES];
+  make_resting_trace(samples, COMM_WIRE_BATCH_MAX_SAMPLES);
+
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  uint8_t packed = 0;
+  size_t len = comm_codec_encode_weight_batch(frame, sizeof(frame), 1, samples, COMM_WIRE_BATCH_MAX_SAMPLES, 12,
+                                              &packed);
+  char line[96];
+  snprintf(line, sizeof(line), "%u sample dalam %u byte: %.2f B/sample (frame tunggal %u B/sample)", packed,
+           (unsigned) len, (double) len / packed, COMM_WIRE_WEIGHT_FRAME_LEN);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_UINT8(COMM_WIRE_BATCH_MAX_SAMPLES, packed);
+  // 21 byte header + crc, lalu 3-4 byte per sample (delta filtered, units, raw)
+  TEST_ASSERT_EQUAL_size_t(226, len);
+  TEST_ASSERT_LESS_THAN(4 * COMM_WIRE_BATCH_MAX_SAMPLES, len);
+}
+
+static void test_batch_encode_decode_throughput(void) {
+  weight_data_t samples[COMM_WIRE_BATCH_MAX_SAMPLES];
+  make_resting_trace(samples, COMM_WIRE_BATCH_MAX_SAMPLES);
+  static uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  struct timespec start, end;
+  uint8_t packed = 0;
+  size_t len = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+    len = comm_codec_encode_weight_batch(frame, sizeof(frame), (uint16_t) i, samples, COMM_WIRE_BATCH_MAX_SAMPLES, 12,
+                                         &packed);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double encode_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+  // decode = jalur callback radio: parse (crc) + baca semua sample
+  uint32_t decoded = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+    comm_frame_header_t header;
+    comm_batch_reader_t reader;
+    weight_data_t out;
+    if (comm_codec_parse(frame, len, &header) != COMM_DECODE_OK) break;
+    if (comm_codec_batch_begin(&header, &reader) != COMM_DECODE_OK) break;
+    while (comm_codec_batch_next(&reader, &out)) decoded++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double decode_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+  double total = (double) BENCH_FRAMES * packed;
+  char line[96];
+  snprintf(line, sizeof(line), "encode %.1f M sample/s, decode %.1f M sample/s", total / encode_ns * 1e3,
+           total / decode_ns * 1e3);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_UINT8(COMM_WIRE_BATCH_MAX_SAMPLES, packed);
+  TEST_ASSERT_EQUAL_UINT32(BENCH_FRAMES * COMM_WIRE_BATCH_MAX_SAMPLES, decoded);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc16_ccitt_false_check_value);
+  RUN_TEST(test_weight_round_trip);
+  RUN_TEST(test_encode_rejects_small_buffer);
+  RUN_TEST(test_cmd_and_ack_round_trip);
+  RUN_TEST(test_probe_round_trip);
+  RUN_TEST(test_corrupt_frame_rejected);
+  RUN_TEST(test_major_version_must_match_minor_may_differ);
+  RUN_TEST(test_legacy_struct_detected);
+  RUN_TEST(test_batch_round_trip_slow_trace);
+  RUN_TEST(test_batch_packs_what_fits);
+  RUN_TEST(test_batch_bytes_per_sample);
+  RUN_TEST(test_batch_encode_decode_throughput);
+  RUN_TEST(test_seq_tracker_loss_duplicate_reorder);
+  RUN_TEST(test_seq_tracker_wraps);
+  RUN_TEST(test_seq_tracker_sender_restart);
+  return UNITY_END();
+}
@@ -0,0 +1,636 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sub_comm/comm_codec.h"
+#include "sub_comm/comm_engine.h"
+#include "sub_comm/comm_transport_loopback.h"
+
+// ukuran queue di comm_task
+#define CTRL_QUEUE_LEN      8
+#define SEND_DONE_QUEUE_LEN 8
+#define CMD_QUEUE_LEN       10
+
+#define SIM_STEP_US      100
+#define STREAM_END_US    10000000
+#define SIM_END_US       (STREAM_END_US + 5000000) // retry command terakhir selesai
+#define BATCH_PERIOD_US  100000 // Device A: batch 8 sample tiap 100 ms (80 Hz)
+#define BATCH_SAMPLES    8
+#define CMD_PERIOD_US    50000
+#define BENCH_FRAMES     200000
+
+typedef struct {
+  comm_engine_ctrl_t items[CTRL_QUEUE_LEN];
+  uint8_t head;
+  uint8_t count;
+} ctrl_queue_t;
+
+typedef struct {
+  comm_engine_send_done_t items[SEND_DONE_QUEUE_LEN];
+  uint8_t head;
+  uint8_t count;
+} done_queue_t;
+
+typedef struct {
+  comm_send_data_t items[CMD_QUEUE_LEN];
+  uint8_t head;
+  uint8_t count;
+} cmd_queue_t;
+
+// hasil satu run throughput
+typedef struct {
+  uint32_t frames_sent;
+  uint32_t samples_sent;
+  uint32_t samples_received;
+  uint32_t cmds_queued;
+  uint32_t cmd_queue_full;
+  uint32_t cmds_executed;
+  uint32_t settled;
+  uint32_t task_wakes;
+  uint8_t  backlog_left;
+  comm_rx_stats_t rx;
+  comm_tx_stats_t tx;
+  comm_reliable_stats_t cmd;
+  comm_loopback_stats_t medium;
+} link_result_t;
+
+static const uint8_t mac_a[COMM_TRANSPORT_MAC_LEN] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x0A };
+static const uint8_t mac_b[COMM_TRANSPORT_MAC_LEN] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x0B };
+static const uint8_t mac_new[COMM_TRANSPORT_MAC_LEN] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x0C };
+
+static comm_loopback_medium_t medium;
+static const comm_transport_t* node_a;
+static const comm_transport_t* node_b;
+static comm_engine_t engine;
+static int64_t sim_now_us;
+
+// pengganti queue FreeRTOS comm_task
+static ctrl_queue_t ctrl_queue;
+static done_queue_t done_queue;
+static cmd_queue_t cmd_queue;
+static int64_t task_deadline_us;
+static uint32_t task_wakes;
+static uint32_t rx_notifies;
+static uint8_t paired_peer;
+static uint32_t traced;
+
+// Device A simulasi
+static bool a_mute;
+static uint16_t a_seq;
+static uint32_t a_cmds;
+static uint32_t a_pongs;
+
+// forward declaration
+static int64_t io_now_us(void* ctx);
+static bool io_post_ctrl(void* ctx, const comm_engine_ctrl_t* ctrl);
+static bool io_post_send_done(void* ctx, const comm_engine_send_done_t* done);
+static void io_notify_rx(void* ctx);
+static void io_paired(void* ctx, const uint8_t* mac, uint8_t peer);
+static void io_traced(void* ctx, input_trace_t* trace, int64_t air_us);
+static void engine_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+static void engine_sent(const uint8_t* mac, bool success, void* ctx);
+static void device_a_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+static void device_a_send_batch(void);
+static void setup_link(const comm_loopback_config_t* config);
+static bool queue_cmd(float value);
+static void run_task(void);
+static uint32_t drain_ring(void);
+static void run_link(const comm_loopback_config_t* config, link_result_t* result);
+static void report(const char* name, const link_result_t* result);
+
+static const comm_engine_io_t test_io = {
+  .now_us = io_now_us,
+  .post_ctrl = io_post_ctrl,
+  .post_send_done = io_post_send_done,
+  .notify_rx = io_notify_rx,
+  .paired = io_paired,
+  .traced = io_traced,
+};
+
+void setUp(void) {
+  memset(&ctrl_queue, 0, sizeof(ctrl_queue));
+  memset(&done_queue, 0, sizeof(done_queue));
+  memset(&cmd_queue, 0, sizeof(cmd_queue));
+  sim_now_us = 0;
+  task_deadline_us = COMM_ENGINE_NO_DEADLINE;
+  task_wakes = 0;
+  rx_notifies = 0;
+  paired_peer = COMM_PEER_NONE;
+  traced = 0;
+  a_mute = false;
+  a_seq = 0;
+  a_cmds = 0;
+  a_pongs = 0;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static int64_t io_now_us(void* ctx) {
+  return sim_now_us;
+}
+
+static bool io_post_ctrl(void* ctx, const comm_engine_ctrl_t* ctrl) {
+  if (ctrl_queue.count == CTRL_QUEUE_LEN) return false;
+  ctrl_queue.items[(ctrl_queue.head + ctrl_queue.count++) % CTRL_QUEUE_LEN] = *ctrl;
+  return true;
+}
+
+static bool io_post_send_done(void* ctx, const comm_engine_send_done_t* done) {
+  if (done_queue.count == SEND_DONE_QUEUE_LEN) return false;
+  done_queue.items[(done_queue.head + done_queue.count++) % SEND_DONE_QUEUE_LEN] = *done;
+  return true;
+}
+
+static void io_notify_rx(void* ctx) {
+  rx_notifies++;
+}
+
+static void io_paired(void* ctx, const uint8_t* mac, uint8_t peer) {
+  paired_peer = peer;
+}
+
+static void io_traced(void* ctx, input_trace_t* trace, int64_t air_us) {
+  traced++;
+}
+
+static void engine_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx) {
+  comm_engine_on_recv((comm_engine_t*) ctx, mac, rssi, data, len);
+}
+
+static void engine_sent(const uint8_t* mac, bool success, void* ctx) {
+  comm_engine_on_send((comm_engine_t*) ctx, mac, success);
+}
+
+static void device_a_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx) {
+  comm_frame_header_t header;
+  if (comm_codec_parse(data, len, &header) != COMM_DECODE_OK) return;
+
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  size_t frame_len = 0;
+  if (header.type == COMM_FRAME_CMD) {
+    a_cmds++;
+    if (a_mute) return;
+    frame_len = comm_codec_encode_ack(frame, sizeof(frame), 0, header.seq, COMM_ACK_OK);
+  } else if (header.type == COMM_FRAME_PING) {
+    uint32_t stamp;
+    if (comm_codec_decode_probe(&header, &stamp) != COMM_DECODE_OK) return;
+    frame_len = comm_codec_encode_probe(frame, sizeof(frame), COMM_FRAME_PONG, header.seq, stamp);
+  } else if (header.type == COMM_FRAME_PONG) {
+    a_pongs++;
+  }
+  if (frame_len > 0) comm_transport_send(node_a, mac, frame, frame_len);
+}
+
+static void device_a_send_batch(void) {
+  weight_data_t samples[BATCH_SAMPLES];
+  for (int i = 0; i < BATCH_SAMPLES; i++) {
+    samples[i] = (weight_data_t) { .main_state = NORMAL_MODE, .units = (float) (a_seq * BATCH_SAMPLES + i), .is_ready = true };
+  }
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  uint8_t packed;
+  size_t len = comm_codec_encode_weight_batch(frame, sizeof(frame), a_seq++, samples, BATCH_SAMPLES,
+                                              BATCH_PERIOD_US / BATCH_SAMPLES / 1000, &packed);
+  comm_transport_send(node_a, mac_b, frame, len);
+}
+
+static void setup_link(const comm_loopback_config_t* config) {
+  comm_engine_config_t engine_config = {
+    .reliable = { .initial_timeout_us = 150000, .max_timeout_us = 1000000, .max_retries = 4 },
+    .rx_policy = COMM_RX_OVERWRITE_OLDEST,
+    .probe_interval_us = 250000,
+    .pairing_max_ms = 60000,
+  };
+
+  comm_loopback_init(&medium, config);
+  node_a = comm_loopback_attach(&medium, mac_a);
+  node_b = comm_loopback_attach(&medium, mac_b);
+  comm_transport_set_callbacks(node_a, device_a_recv, NULL, NULL);
+  comm_transport_set_callbacks(node_b, engine_recv, engine_sent, &engine);
+  comm_transport_add_peer(node_a, mac_b);
+  comm_engine_init(&engine, &engine_config, node_b, &test_io);
+  TEST_ASSERT_TRUE(comm_engine_add_peer(&engine, mac_a, NULL));
+  task_deadline_us = comm_engine_poll(&engine, 0);
+}
+
+static bool queue_cmd(float value) {
+  // main_task: xQueueSend ke main_to_comm_queue tanpa menunggu
+  if (cmd_queue.count == CMD_QUEUE_LEN) return false;
+  comm_send_data_t cmd = { .command = CMD_SET_RATE, .value = value, .peer = 0, .enqueue_us = sim_now_us };
+  cmd.trace.origin_us = sim_now_us;
+  cmd.trace.stamp_us = sim_now_us;
+  cmd_queue.items[(cmd_queue.head + cmd_queue.count++) % CMD_QUEUE_LEN] = cmd;
+  return true;
+}
+
+static void run_task(void) {
+  // comm_task: satu event per bangun, poll sebelum tidur lagi; tanpa event tidur sampai deadline
+  for (;;) {
+    bool event = true;
+    if (cmd_queue.count > 0) {
+      comm_engine_submit(&engine, &cmd_queue.items[cmd_queue.head], sim_now_us);
+      cmd_queue.head = (cmd_queue.head + 1) % CMD_QUEUE_LEN;
+      cmd_queue.count--;
+    } else if (ctrl_queue.count > 0) {
+      comm_engine_handle_ctrl(&engine, &ctrl_queue.items[ctrl_queue.head], sim_now_us);
+      ctrl_queue.head = (ctrl_queue.head + 1) % CTRL_QUEUE_LEN;
+      ctrl_queue.count--;
+    } else if (done_queue.count > 0) {
+      comm_engine_handle_send_done(&engine, &done_queue.items[done_queue.head]);
+      done_queue.head = (done_queue.head + 1) % SEND_DONE_QUEUE_LEN;
+      done_queue.count--;
+    } else {
+      event = false;
+    }
+    if (!event && sim_now_us < task_deadline_us) return;
+    task_wakes++;
+    task_deadline_us = comm_engine_poll(&engine, sim_now_us);
+  }
+}
+
+static uint32_t drain_ring(void) {
+  uint32_t count = 0;
+  comm_rx_item_t item;
+  while (comm_engine_receive(&engine, &item)) count++;
+  return count;
+}
+
+static void run_link(const comm_loopback_config_t* config, link_result_t* result) {
+  // Device A stream batch 80 Hz, main_task kirim command tiap 50 ms (value beda, tidak digabung),
+  // main_task mengambil ring setiap dibangunkan
+  memset(result, 0, sizeof(*result));
+  setup_link(config);
+
+  uint32_t notified = 0;
+  for (sim_now_us = 0; sim_now_us < SIM_END_US; sim_now_us += SIM_STEP_US) {
+    comm_loopback_poll(&medium, sim_now_us);
+    if (sim_now_us < STREAM_END_US) {
+      if (sim_now_us % BATCH_PERIOD_US == 0) {
+        device_a_send_batch();
+        result->frames_sent++;
+        result->samples_sent += BATCH_SAMPLES;
+      }
+      if (sim_now_us % CMD_PERIOD_US == 0) {
+        if (queue_cmd((float) result->cmds_queued)) {
+          result->cmds_queued++;
+        } else {
+          result->cmd_queue_full++;
+        }
+      }
+    }
+    run_task();
+    if (rx_notifies != notified) {
+      notified = rx_notifies;
+      result->samples_received += drain_ring();
+    }
+  }
+
+  result->cmds_executed = a_cmds;
+  result->settled = comm_engine_cmd_settled(&engine);
+  result->task_wakes = task_wakes;
+  result->backlog_left = engine.backlog_count;
+  comm_engine_get_rx_stats(&engine, &result->rx);
+  comm_engine_get_tx_stats(&engine, &result->tx);
+  result->cmd = engine.reliable.stats;
+  comm_loopback_get_stats(&medium, &result->medium);
+}
+
+static void report(const char* name, const link_result_t* result) {
+  char line[256];
+  double seconds = STREAM_END_US / 1e6;
+  snprintf(line, sizeof(line),
+           "%s: %.1f samples/s (%lu/%lu), lost %lu frames, reordered %lu, ring overwritten %lu, "
+           "cmd acked %lu, failed %lu, retx %lu, rtt p50 %lu us p99 %lu us, %lu task wakes",
+           name, result->samples_received / seconds, (unsigned long) result->samples_received,
+           (unsigned long) result->samples_sent, (unsigned long) result->rx.lost, (unsigned long) result->rx.reordered,
+           (unsigned long) result->rx.ring_overwritten, (unsigned long) result->cmd.acked,
+           (unsigned long) result->cmd.failed, (unsigned long) result->cmd.retransmits,
+           (unsigned long) latency_hist_percentile(&result->cmd.rtt, 50),
+           (unsigned long) latency_hist_percentile(&result->cmd.rtt, 99), (unsigned long) result->task_wakes);
+  TEST_MESSAGE(line);
+}
+
+static void test_submit_backlog_and_ack(void) {
+  comm_loopback_config_t config = { .latency_us = 1000 };
+  setup_link(&config);
+  a_mute = true;
+
+  comm_send_data_t cmd = { .command = CMD_SET_RATE, .peer = 0 };
+  for (int i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    cmd.value = (float) i;
+    TEST_ASSERT_EQUAL(COMM_ENGINE_SENT, comm_engine_submit(&engine, &cmd, 0));
+    // command yang sama selagi masih in-flight
+    if (i == 0) TEST_ASSERT_EQUAL(COMM_ENGINE_COALESCED, comm_engine_submit(&engine, &cmd, 0));
+  }
+  for (int i = 0; i < COMM_ENGINE_BACKLOG_LEN; i++) {
+    cmd.value = (float) (100 + i);
+    TEST_ASSERT_EQUAL(COMM_ENGINE_BACKLOGGED, comm_engine_submit(&engine, &cmd, 0));
+  }
+  TEST_ASSERT_EQUAL(COMM_ENGINE_DROPPED, comm_engine_submit(&engine, &cmd, 0));
+  TEST_ASSERT_EQUAL_UINT32(2, comm_engine_cmd_settled(&engine));
+
+  // ACK untuk seq 1 membebaskan satu slot: command backlog paling lama langsung dikirim
+  comm_engine_ctrl_t ack = { .type = COMM_ENGINE_CTRL_ACK, .peer = 0, .seq = 1 };
+  comm_engine_handle_ctrl(&engine, &ack, 5000);
+  TEST_ASSERT_EQUAL_UINT8(COMM_ENGINE_BACKLOG_LEN - 1, engine.backlog_count);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RELIABLE_WINDOW + 1, engine.reliable.stats.submitted);
+  TEST_ASSERT_EQUAL_UINT32(3, comm_engine_cmd_settled(&engine));
+
+  comm_loopback_poll(&medium, 10000);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RELIABLE_WINDOW + 1, a_cmds);
+}
+
+static void test_failed_commands_release_backlog(void) {
+  // Device A tidak menjawab, tidak ada stream / probe / pairing: satu-satunya yang membangunkan
+  // task adalah deadline retransmit. window penuh + 2 command di backlog
+  comm_loopback_config_t config = { .latency_us = 1000 };
+  setup_link(&config);
+  a_mute = true;
+  for (int i = 0; i < COMM_RELIABLE_WINDOW + 2; i++) queue_cmd((float) i);
+
+  int64_t first_failed_us = -1;
+  int64_t backlog_sent_us = -1;
+  for (sim_now_us = 0; sim_now_us < 10000000; sim_now_us += SIM_STEP_US) {
+    comm_loopback_poll(&medium, sim_now_us);
+    run_task();
+    if (first_failed_us < 0 && engine.reliable.stats.failed > 0) {
+      first_failed_us = sim_now_us;
+      // di putaran yang sama: backlog masuk window, settled sudah terlihat, task tetap punya deadline
+      TEST_ASSERT_EQUAL_UINT8(0, engine.backlog_count);
+      TEST_ASSERT_EQUAL_UINT32(COMM_RELIABLE_WINDOW, comm_engine_cmd_settled(&engine));
+      TEST_ASSERT_TRUE(task_deadline_us != COMM_ENGINE_NO_DEADLINE);
+    }
+    if (backlog_sent_us < 0 && engine.reliable.stats.submitted > COMM_RELIABLE_WINDOW) backlog_sent_us = sim_now_us;
+  }
+
+  // 150 + 300 + 600 + 1000 + 1000 ms sampai gagal, backlog dikirim tanpa menunggu event lain
+  TEST_ASSERT_INT_WITHIN(SIM_STEP_US, 3050000, first_failed_us);
+  TEST_ASSERT_EQUAL_INT64(first_failed_us, backlog_sent_us);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RELIABLE_WINDOW + 2, engine.reliable.stats.failed);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RELIABLE_WINDOW + 2, comm_engine_cmd_settled(&engine));
+  TEST_ASSERT_EQUAL_UINT32(5 * (COMM_RELIABLE_WINDOW + 2), a_cmds);
+  TEST_ASSERT_EQUAL_INT64(COMM_ENGINE_NO_DEADLINE, task_deadline_us);
+}
+
+static void test_send_done_measures_enqueue_to_air(void) {
+  comm_loopback_config_t config = { .latency_us = 700 };
+  setup_link(&config);
+
+  comm_send_data_t cmd = { .command = CMD_NORMAL_TARE, .peer = 0, .enqueue_us = 100, .trace = { 100, 100 } };
+  sim_now_us = 300;
+  comm_loopback_poll(&medium, sim_now_us);
+  comm_engine_submit(&engine, &cmd, sim_now_us);
+  sim_now_us = 1000;
+  comm_loopback_poll(&medium, sim_now_us);
+  TEST_ASSERT_EQUAL_UINT8(1, done_queue.count);
+  comm_engine_handle_send_done(&engine, &done_queue.items[0]);
+
+  comm_tx_stats_t tx;
+  comm_engine_get_tx_stats(&engine, &tx);
+  TEST_ASSERT_EQUAL_UINT32(1, tx.send_ok);
+  TEST_ASSERT_EQUAL_UINT32(1, tx.enqueue_to_air.count);
+  TEST_ASSERT_EQUAL_UINT32(900, tx.enqueue_to_air.max_us);
+  TEST_ASSERT_EQUAL_UINT32(1, traced);
+
+  // callback yang hilang (queue penuh) hanya melewatkan satu id
+  comm_engine_send_done_t lost = { .done_us = 2000, .id = 2, .peer = 0, .success = true };
+  cmd.command = CMD_WAKE_UP;
+  comm_engine_submit(&engine, &cmd, 1500);
+  cmd.command = CMD_SLEEP;
+  comm_engine_submit(&engine, &cmd, 1500);
+  comm_engine_handle_send_done(&engine, &lost);
+  comm_engine_get_tx_stats(&engine, &tx);
+  TEST_ASSERT_EQUAL_UINT32(1, tx.air_unmatched);
+  TEST_ASSERT_EQUAL_UINT32(2, tx.enqueue_to_air.count);
+}
+
+static void test_receive_batch_into_ring(void) {
+  comm_loopback_config_t config = { .latency_us = 1000 };
+  setup_link(&config);
+
+  device_a_send_batch();
+  sim_now_us = 1000;
+  comm_loopback_poll(&medium, sim_now_us);
+  TEST_ASSERT_EQUAL_UINT32(1, rx_notifies);
+
+  // sample paling lama duluan, waktu dimundurkan sesuai interval batch
+  comm_rx_item_t item;
+  for (int i = 0; i < BATCH_SAMPLES; i++) {
+    TEST_ASSERT_TRUE(comm_engine_receive(&engine, &item));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, (float) i, item.weight.units);
+    TEST_ASSERT_EQUAL_INT64(1000 - (BATCH_SAMPLES - 1 - i) * 12000, item.rx_us);
+  }
+  TEST_ASSERT_FALSE(comm_engine_receive(&engine, &item));
+
+  weight_data_t latest;
+  TEST_ASSERT_TRUE(comm_peer_table_load_latest(&engine.peers, 0, &latest));
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, (float) (BATCH_SAMPLES - 1), latest.units);
+
+  comm_rx_stats_t rx;
+  comm_engine_get_rx_stats(&engine, &rx);
+  TEST_ASSERT_EQUAL_UINT32(1, rx.received);
+  TEST_ASSERT_EQUAL_UINT32(1, rx.batches);
+  TEST_ASSERT_EQUAL_UINT32(BATCH_SAMPLES, rx.samples);
+}
+
+static void test_decode_errors_counted(void) {
+  comm_loopback_config_t config = { .latency_us = 0 };
+  setup_link(&config);
+
+  weight_data_t weight = { .units = 1.0f };
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 0, &weight);
+  frame[len - 1] ^= 0xFF;
+  comm_engine_on_recv(&engine, mac_a, -50, frame, (int) len);
+  frame[len - 1] ^= 0xFF;
+  // major 2 dengan CRC yang benar
+  frame[0] = 0x20;
+  uint16_t crc = comm_codec_crc16(frame, len - COMM_WIRE_CRC_LEN);
+  frame[len - 2] = (uint8_t) crc;
+  frame[len - 1] = (uint8_t) (crc >> 8);
+  comm_engine_on_recv(&engine, mac_a, -50, frame, (int) len);
+  const uint8_t stranger[COMM_TRANSPORT_MAC_LEN] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x01 };
+  comm_engine_on_recv(&engine, stranger, -50, frame, (int) len);
+
+  comm_rx_stats_t rx;
+  comm_engine_get_rx_stats(&engine, &rx);
+  TEST_ASSERT_EQUAL_UINT32(1, rx.bad_crc);
+  TEST_ASSERT_EQUAL_UINT32(1, rx.bad_version);
+  TEST_ASSERT_EQUAL_UINT32(1, rx.unknown_peer);
+  TEST_ASSERT_EQUAL_UINT32(0, rx.samples);
+  TEST_ASSERT_EQUAL_UINT32(0, rx_notifies);
+}
+
+static void test_probe_round_trip(void) {
+  comm_loopback_config_t config = { .latency_us = 1500 };
+  setup_link(&config);
+  // comm_task_set_link_probe: task dibangunkan karena sedang tidur tanpa deadline
+  comm_engine_set_link_probe(&engine, true);
+  comm_engine_ctrl_t wake = { .type = COMM_ENGINE_CTRL_WAKE };
+  io_post_ctrl(NULL, &wake);
+
+  for (sim_now_us = 0; sim_now_us <= 1000000; sim_now_us += SIM_STEP_US) {
+    comm_loopback_poll(&medium, sim_now_us);
+    run_task();
+  }
+
+  // PING tiap 250 ms, PONG kembali setelah 2 x latency
+  comm_link_stats_t link;
+  TEST_ASSERT_TRUE(comm_engine_get_link_stats(&engine, 0, &link));
+  TEST_ASSERT_EQUAL_UINT32(5, link.pings);
+  TEST_ASSERT_EQUAL_UINT32(4, link.pongs);
+  TEST_ASSERT_EQUAL_UINT32(3000, link.rtt_max_us);
+  TEST_ASSERT_FALSE(comm_engine_get_link_stats(&engine, 1, &link));
+}
+
+static void test_pairing_window(void) {
+  comm_loopback_config_t config = { .latency_us = 1000 };
+  setup_link(&config);
+  const comm_transport_t* node_new = comm_loopback_attach(&medium, mac_new);
+  comm_transport_add_peer(node_new, mac_b);
+
+  weight_data_t weight = { .units = 2.0f };
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  size_t len = comm_codec_encode_weight(frame, sizeof(frame), 0, &weight);
+
+  // jendela tertutup: frame node asing hanya dihitung
+  comm_transport_send(node_new, mac_b, frame, len);
+  sim_now_us = 1000;
+  comm_loopback_poll(&medium, sim_now_us);
+  run_task();
+  TEST_ASSERT_EQUAL_UINT8(1, engine.peers.count);
+
+  // jendela dipotong ke pairing_max_ms
+  comm_engine_ctrl_t open = { .type = COMM_ENGINE_CTRL_PAIR_OPEN, .stamp = 120000 };
+  io_post_ctrl(NULL, &open);
+  run_task();
+  TEST_ASSERT_TRUE(engine.pairing_open);
+  TEST_ASSERT_EQUAL_INT64(1000 + 60000000LL, task_deadline_us);
+
+  comm_transport_send(node_new, mac_b, frame, len);
+  sim_now_us = 2000;
+  comm_loopback_poll(&medium, sim_now_us);
+  run_task();
+  TEST_ASSERT_FALSE(engine.pairing_open);
+  TEST_ASSERT_EQUAL_UINT8(2, engine.peers.count);
+  TEST_ASSERT_EQUAL_UINT8(1, paired_peer);
+  TEST_ASSERT_EQUAL_UINT32(1, rx_notifies);
+  TEST_ASSERT_EQUAL_INT64(COMM_ENGINE_NO_DEADLINE, task_deadline_us);
+
+  // frame berikutnya dari peer baru langsung masuk ring
+  len = comm_codec_encode_weight(frame, sizeof(frame), 1, &weight);
+  comm_transport_send(node_new, mac_b, frame, len);
+  sim_now_us = 3000;
+  comm_loopback_poll(&medium, sim_now_us);
+  comm_rx_item_t item;
+  TEST_ASSERT_TRUE(comm_engine_receive(&engine, &item));
+  TEST_ASSERT_EQUAL_UINT8(1, item.peer);
+}
+
+static void test_link_throughput_and_drops(void) {
+  // skenario: 10 s stream 80 sample/s + command tiap 50 ms di tiga kondisi link
+  link_result_t clean, jitter, lossy;
+  comm_loopback_config_t clean_config = { .latency_us = 1000, .rssi = -40 };
+  comm_loopback_config_t jitter_config = { .latency_us = 5000, .jitter_us = 150000, .reorder_permille = 20, .rssi = -60 };
+  comm_loopback_config_t lossy_config = {
+    .latency_us = 2000, .jitter_us = 1500, .loss_permille = 100, .reorder_permille = 20, .seed = 99, .rssi = -80,
+  };
+  run_link(&clean_config, &clean);
+  report("clean", &clean);
+  setUp();
+  run_link(&jitter_config, &jitter);
+  report("latency+jitter", &jitter);
+  setUp();
+  run_link(&lossy_config, &lossy);
+  report("10% loss", &lossy);
+
+  // link bersih: semua sample dan semua command sampai
+  TEST_ASSERT_EQUAL_UINT32(800, clean.samples_sent);
+  TEST_ASSERT_EQUAL_UINT32(clean.samples_sent, clean.samples_received);
+  TEST_ASSERT_EQUAL_UINT32(0, clean.rx.lost);
+  TEST_ASSERT_EQUAL_UINT32(200, clean.cmds_queued);
+  TEST_ASSERT_EQUAL_UINT32(clean.cmds_queued, clean.cmd.acked);
+  TEST_ASSERT_EQUAL_UINT32(0, clean.cmd.retransmits);
+
+  // jitter lebih dari jarak antar batch: frame tersusul dibuang, tidak ada yang masuk dua kali;
+  // ACK yang lebih lambat dari timeout awal membuat retransmit, tapi tidak ada command yang gagal
+  TEST_ASSERT_GREATER_THAN(0, jitter.rx.reordered);
+  TEST_ASSERT_EQUAL_UINT32(jitter.samples_sent - jitter.rx.reordered * BATCH_SAMPLES, jitter.samples_received);
+  TEST_ASSERT_GREATER_THAN(0, jitter.cmd.retransmits);
+  TEST_ASSERT_EQUAL_UINT32(jitter.cmds_queued, jitter.cmd.acked);
+
+  // 10% loss tiap arah: sample yang hilang = frame yang hilang, command tetap sampai lewat retransmit
+  TEST_ASSERT_EQUAL_UINT32(lossy.samples_sent, lossy.samples_received + (lossy.rx.lost + lossy.rx.reordered) * BATCH_SAMPLES);
+  TEST_ASSERT_GREATER_OR_EQUAL(lossy.samples_sent * 85 / 100, lossy.samples_received);
+  TEST_ASSERT_GREATER_THAN(0, lossy.cmd.retransmits);
+  TEST_ASSERT_GREATER_OR_EQUAL(lossy.cmds_queued - 2, lossy.cmd.acked);
+
+  // tidak ada yang dibuang di sisi Device B, dan semua command selesai di akhir run
+  const link_result_t* runs[] = { &clean, &jitter, &lossy };
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL_UINT32(0, runs[i]->rx.ring_overwritten);
+    TEST_ASSERT_EQUAL_UINT32(0, runs[i]->rx.ack_dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, runs[i]->tx.backlog_dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, runs[i]->tx.send_done_dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, runs[i]->cmd_queue_full);
+    TEST_ASSERT_EQUAL_UINT32(runs[i]->cmds_queued, runs[i]->settled);
+    TEST_ASSERT_EQUAL_UINT8(0, runs[i]->backlog_left);
+  }
+}
+
+static void test_receive_path_throughput(void) {
+  // biaya host jalur receive: decode batch -> ring -> consumer
+  comm_loopback_config_t config = { .latency_us = 0 };
+  setup_link(&config);
+
+  weight_data_t samples[BATCH_SAMPLES];
+  for (int i = 0; i < BATCH_SAMPLES; i++) samples[i] = (weight_data_t) { .units = (float) i, .is_ready = true };
+  static uint8_t frames[256][COMM_WIRE_MAX_FRAME_LEN];
+  size_t lens[256];
+  uint8_t packed;
+  for (int i = 0; i < 256; i++) {
+    lens[i] = comm_codec_encode_weight_batch(frames[i], sizeof(frames[i]), (uint16_t) i, samples, BATCH_SAMPLES, 12, &packed);
+  }
+
+  struct timespec start, end;
+  uint32_t received = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+    // seq berulang tiap 256 frame: tracker di-reset supaya tidak dianggap duplikat
+    if ((i & 255) == 0) comm_seq_tracker_reset(&engine.peers.peers[0].seq);
+    comm_engine_on_recv(&engine, mac_a, -50, frames[i & 255], (int) lens[i & 255]);
+    received += drain_ring();
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+  char line[128];
+  snprintf(line, sizeof(line), "receive path: %.0f ns/frame, %.2f M samples/s", ns / BENCH_FRAMES,
+           received / ns * 1e3);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_EQUAL_UINT32(BENCH_FRAMES * BATCH_SAMPLES, received);
+  comm_rx_stats_t rx;
+  comm_engine_get_rx_stats(&engine, &rx);
+  TEST_ASSERT_EQUAL_UINT32(0, rx.ring_overwritten);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_submit_backlog_and_ack);
+  RUN_TEST(test_failed_commands_release_backlog);
+  RUN_TEST(test_send_done_measures_enqueue_to_air);
+  RUN_TEST(test_receive_batch_into_ring);
+  RUN_TEST(test_decode_errors_counted);
+  RUN_TEST(test_probe_round_trip);
+  RUN_TEST(test_pairing_window);
+  RUN_TEST(test_link_throughput_and_drops);
+  RUN_TEST(test_receive_path_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,120 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+
+#include "sub_comm/comm_link_stats.h"
+
+static comm_link_rx_t rx;
+static comm_link_tx_t tx;
+static comm_link_stats_t stats;
+
+void setUp(void) {
+  comm_link_rx_reset(&rx);
+  comm_link_tx_reset(&tx);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void test_empty_link(void) {
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT16(0, stats.pdr_permille);
+  TEST_ASSERT_EQUAL_INT8(COMM_LINK_RSSI_NONE, stats.rssi_last);
+  TEST_ASSERT_EQUAL_INT8(COMM_LINK_RSSI_NONE, stats.rssi_avg);
+  TEST_ASSERT_EQUAL_INT8(COMM_LINK_RSSI_NONE, stats.rssi_min);
+  TEST_ASSERT_EQUAL_INT8(COMM_LINK_RSSI_NONE, stats.rssi_max);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.rtt_p50_us);
+}
+
+static void test_pdr_is_rolling(void) {
+  // 3 dari 4 sukses
+  comm_link_tx_record_send(&tx, true);
+  comm_link_tx_record_send(&tx, false);
+  comm_link_tx_record_send(&tx, true);
+  comm_link_tx_record_send(&tx, true);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT16(750, stats.pdr_permille);
+
+  // 32 sukses berikutnya menggeser kegagalan keluar dari jendela
+  for (int i = 0; i < COMM_LINK_PDR_WINDOW; i++) comm_link_tx_record_send(&tx, true);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT16(1000, stats.pdr_permille);
+  TEST_ASSERT_EQUAL_UINT32(35, stats.send_ok);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.send_fail);
+
+  for (int i = 0; i < COMM_LINK_PDR_WINDOW / 2; i++) comm_link_tx_record_send(&tx, false);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT16(500, stats.pdr_permille);
+}
+
+static void test_rssi_ewma_and_range(void) {
+  comm_link_rx_record(&rx, -60, 0);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_INT8(-60, stats.rssi_avg);
+
+  // frame tanpa RSSI tidak menggeser rata-rata
+  comm_link_rx_record(&rx, COMM_LINK_RSSI_NONE, 1000);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_INT8(-60, stats.rssi_last);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.rx_frames);
+
+  // bobot 1/8: setelah banyak frame -80 rata-rata mendekati -80
+  for (int i = 0; i < 64; i++) comm_link_rx_record(&rx, -80, 2000 + i);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_INT_WITHIN(1, -80, stats.rssi_avg);
+  TEST_ASSERT_EQUAL_INT8(-80, stats.rssi_min);
+  TEST_ASSERT_EQUAL_INT8(-60, stats.rssi_max);
+
+  comm_link_rx_reset(&rx);
+  comm_link_rx_record(&rx, -60, 0);
+  comm_link_rx_record(&rx, -52, 1000);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_INT8(-59, stats.rssi_avg);
+}
+
+static void test_gap_and_interval(void) {
+  comm_link_rx_record(&rx, -50, 1000000);
+  comm_link_rx_record(&rx, -50, 1020000);
+  comm_link_rx_record(&rx, -50, 1320000);
+  comm_link_rx_record_gap(&rx, 0);
+  comm_link_rx_record_gap(&rx, 3);
+  comm_link_rx_record_gap(&rx, 14);
+  comm_link_rx_record_gap(&rx, 1);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(300000, stats.interval_max_us);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.gap_events);
+  TEST_ASSERT_EQUAL_UINT32(14, stats.gap_max);
+}
+
+static void test_ping_rtt_percentiles(void) {
+  // 90 pong cepat (~2 ms) dan 10 pong lambat (~40 ms)
+  for (int i = 0; i < 100; i++) {
+    comm_link_tx_record_ping(&tx);
+    if (i % 10 == 9) {
+      comm_link_tx_record_pong(&tx, 40000);
+    } else {
+      comm_link_tx_record_pong(&tx, 2000);
+    }
+  }
+  comm_link_tx_record_ping(&tx);
+  comm_link_stats_merge(&rx, &tx, &stats);
+  TEST_ASSERT_EQUAL_UINT32(101, stats.pings);
+  TEST_ASSERT_EQUAL_UINT32(100, stats.pongs);
+  // bucket log2: hasil di dalam oktaf sample yang benar
+  TEST_ASSERT_UINT32_WITHIN(1024, 2048, stats.rtt_p50_us);
+  TEST_ASSERT_UINT32_WITHIN(16384, 49152, stats.rtt_p99_us);
+  TEST_ASSERT_EQUAL_UINT32(40000, stats.rtt_max_us);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_link);
+  RUN_TEST(test_pdr_is_rolling);
+  RUN_TEST(test_rssi_ewma_and_range);
+  RUN_TEST(test_gap_and_interval);
+  RUN_TEST(test_ping_rtt_percentiles);
+  return UNITY_END();
+}
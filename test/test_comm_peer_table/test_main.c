@@ -0,0 +1,291 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sub_comm/comm_peer_table.h"
+
+#define STRESS_WRITES 500000
+#define UNKNOWN_MACS        40     // node tetangga / board lain yang ikut terdengar
+#define INTERLEAVED_FRAMES  200000
+
+static comm_peer_table_t table;
+static volatile bool writer_done;
+static volatile bool reader_ready;
+static uint32_t rng_state;
+
+// forward declaration
+static void make_mac(uint8_t* mac, uint8_t last);
+static void make_unknown_mac(uint8_t* mac, uint8_t n);
+static uint32_t next_random(void);
+static void* stress_writer(void* arg);
+
+void setUp(void) {
+  comm_peer_table_init(&table);
+  rng_state = 7;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void make_mac(uint8_t* mac, uint8_t last) {
+  // MAC node hanya beda di byte terakhir, seperti satu batch modul ESP32
+  const uint8_t base[COMM_PEER_MAC_LEN] = { 0x24, 0x6F, 0x28, 0xA1, 0xB2, 0x00 };
+  memcpy(mac, base, COMM_PEER_MAC_LEN);
+  mac[COMM_PEER_MAC_LEN - 1] = last;
+}
+
+static void make_unknown_mac(uint8_t* mac, uint8_t n) {
+  // separuh dari batch yang sama (byte terakhir di luar peer), separuh vendor lain
+  if (n & 1) {
+    make_mac(mac, (uint8_t) (0x80 + n));
+  } else {
+    const uint8_t other[COMM_PEER_MAC_LEN] = { 0xDC, 0x54, 0x75, 0x10, 0x20, 0x00 };
+    memcpy(mac, other, COMM_PEER_MAC_LEN);
+    mac[COMM_PEER_MAC_LEN - 1] = n;
+  }
+}
+
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static void* stress_writer(void* arg) {
+  while (!reader_ready) {
+  }
+  // semua field sample diisi nilai yang sama supaya salinan sobek langsung terlihat
+  for (long i = 1; i <= STRESS_WRITES; i++) {
+    weight_data_t weight = {
+      .filtered_weight = (float) i,
+      .units = (float) i,
+      .raw_weight = i,
+    };
+    comm_peer_table_store_latest(&table, 0, &weight, i);
+  }
+  writer_done = true;
+  return NULL;
+}
+
+static void test_add_and_find(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  for (uint8_t i = 0; i < 5; i++) {
+    make_mac(mac, i);
+    TEST_ASSERT_EQUAL_UINT8(i, comm_peer_table_add(&table, mac));
+  }
+  for (uint8_t i = 0; i < 5; i++) {
+    make_mac(mac, i);
+    TEST_ASSERT_EQUAL_UINT8(i, comm_peer_table_find(&table, mac));
+    TEST_ASSERT_EQUAL_MEMORY(mac, comm_peer_table_mac(&table, i), COMM_PEER_MAC_LEN);
+  }
+  make_mac(mac, 99);
+  TEST_ASSERT_EQUAL_UINT8(COMM_PEER_NONE, comm_peer_table_find(&table, mac));
+  TEST_ASSERT_NULL(comm_peer_table_mac(&table, 5));
+}
+
+static void test_add_existing_keeps_index(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  make_mac(mac, 1);
+  comm_peer_table_add(&table, mac);
+  make_mac(mac, 2);
+  TEST_ASSERT_EQUAL_UINT8(1, comm_peer_table_add(&table, mac));
+  TEST_ASSERT_EQUAL_UINT8(1, comm_peer_table_add(&table, mac));
+  TEST_ASSERT_EQUAL_UINT8(2, table.count);
+}
+
+static void test_table_full(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  for (uint8_t i = 0; i < COMM_PEER_MAX; i++) {
+    make_mac(mac, i);
+    TEST_ASSERT_EQUAL_UINT8(i, comm_peer_table_add(&table, mac));
+  }
+  make_mac(mac, COMM_PEER_MAX);
+  TEST_ASSERT_EQUAL_UINT8(COMM_PEER_NONE, comm_peer_table_add(&table, mac));
+  TEST_ASSERT_EQUAL_UINT8(COMM_PEER_NONE, comm_peer_table_find(&table, mac));
+  // peer lama tetap bisa dicari walau hash penuh tabrakan
+  for (uint8_t i = 0; i < COMM_PEER_MAX; i++) {
+    make_mac(mac, i);
+    TEST_ASSERT_EQUAL_UINT8(i, comm_peer_table_find(&table, mac));
+  }
+}
+
+static void test_latest_sample(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  make_mac(mac, 7);
+  uint8_t peer = comm_peer_table_add(&table, mac);
+
+  weight_data_t out;
+  TEST_ASSERT_FALSE(comm_peer_table_load_latest(&table, peer, &out));
+
+  weight_data_t in = { .main_state = NORMAL_MODE, .units = 42.5f, .raw_weight = 4250, .is_ready = true };
+  comm_peer_table_store_latest(&table, peer, &in, 1000);
+  TEST_ASSERT_TRUE(comm_peer_table_load_latest(&table, peer, &out));
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 42.5f, out.units);
+  TEST_ASSERT_EQUAL_INT32(4250, out.raw_weight);
+
+  comm_peer_stats_t stats;
+  comm_peer_table_get_stats(&table, peer, &stats);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.samples);
+  TEST_ASSERT_EQUAL_INT64(1000, stats.last_rx_us);
+
+  // peer yang belum terdaftar diabaikan
+  comm_peer_table_store_latest(&table, 3, &in, 1000);
+  TEST_ASSERT_FALSE(comm_peer_table_load_latest(&table, 3, &out));
+}
+
+static void test_stats_follow_seq_trackers(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  make_mac(mac, 1);
+  uint8_t peer = comm_peer_table_add(&table, mac);
+
+  comm_seq_tracker_update(&table.peers[peer].seq, 10);
+  comm_seq_tracker_update(&table.peers[peer].seq, 13);
+  comm_seq_tracker_update(&table.peers[peer].probe_seq, 1);
+  comm_seq_tracker_update(&table.peers[peer].probe_seq, 3);
+
+  comm_peer_stats_t stats;
+  comm_peer_table_get_stats(&table, peer, &stats);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.received);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.lost);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.probe_lost);
+}
+
+static void test_seqlock_never_tears(void) {
+  uint8_t mac[COMM_PEER_MAC_LEN];
+  make_mac(mac, 1);
+  comm_peer_table_add(&table, mac);
+  writer_done = false;
+  reader_ready = false;
+
+  pthread_t writer;
+  pthread_create(&writer, NULL, stress_writer, NULL);
+
+  long last = 0;
+  reader_ready = true;
+  while (!writer_done) {
+    weight_data_t out;
+    if (!comm_peer_table_load_latest(&table, 0, &out)) continue;
+    TEST_ASSERT_EQUAL_INT32(out.raw_weight, (long) out.units);
+    TEST_ASSERT_EQUAL_INT32(out.raw_weight, (long) out.filtered_weight);
+    // pembaca tidak pernah melihat sample mundur
+    TEST_ASSERT_TRUE(out.raw_weight >= last);
+    last = out.raw_weight;
+  }
+  pthread_join(writer, NULL);
+
+  weight_data_t out;
+  TEST_ASSERT_TRUE(comm_peer_table_load_latest(&table, 0, &out));
+  TEST_ASSERT_EQUAL_INT32(STRESS_WRITES, out.raw_weight);
+
+  comm_peer_stats_t stats;
+  comm_peer_table_get_stats(&table, 0, &stats);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_WRITES, stats.samples);
+}
+
+static void test_interleaved_peers_isolated(void) {
+  // frame dari COMM_PEER_MAX peer dan MAC asing masuk acak, seperti callback receive di lokasi ramai
+  uint8_t macs[COMM_PEER_MAX + UNKNOWN_MACS][COMM_PEER_MAC_LEN];
+  for (uint8_t i = 0; i < COMM_PEER_MAX; i++) {
+    make_mac(macs[i], i);
+    TEST_ASSERT_EQUAL_UINT8(i, comm_peer_table_add(&table, macs[i]));
+  }
+  for (uint8_t i = 0; i < UNKNOWN_MACS; i++) make_unknown_mac(macs[COMM_PEER_MAX + i], i);
+
+  // biaya lookup: slot hash yang dibaca per MAC
+  uint32_t known_total = 0, known_max = 0, unknown_total = 0, unknown_max = 0;
+  for (uint8_t i = 0; i < COMM_PEER_MAX + UNKNOWN_MACS; i++) {
+    uint32_t slots = comm_peer_table_probe_len(&table, macs[i]);
+    if (i < COMM_PEER_MAX) {
+      known_total += slots;
+      if (slots > known_max) known_max = slots;
+    } else {
+      unknown_total += slots;
+      if (slots > unknown_max) unknown_max = slots;
+    }
+  }
+
+  static uint8_t sources[INTERLEAVED_FRAMES];
+  for (uint32_t n = 0; n < INTERLEAVED_FRAMES; n++) {
+    sources[n] = (uint8_t) (next_random() % (COMM_PEER_MAX + UNKNOWN_MACS));
+  }
+  struct timespec start, end;
+  uint32_t found = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t n = 0; n < INTERLEAVED_FRAMES; n++) {
+    if (comm_peer_table_find(&table, macs[sources[n]]) != COMM_PEER_NONE) found++;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double lookup_ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+  uint16_t next_seq[COMM_PEER_MAX] = { 0 };
+  uint32_t sent[COMM_PEER_MAX] = { 0 };
+  uint32_t skipped[COMM_PEER_MAX] = { 0 };
+  uint32_t unknown_frames = 0, unknown_found = 0;
+  for (uint32_t n = 0; n < INTERLEAVED_FRAMES; n++) {
+    uint8_t source = sources[n];
+    uint8_t peer = comm_peer_table_find(&table, macs[source]);
+    if (source >= COMM_PEER_MAX) {
+      unknown_frames++;
+      if (peer != COMM_PEER_NONE) unknown_found++;
+      continue;
+    }
+    TEST_ASSERT_EQUAL_UINT8(source, peer);
+    // peer ke-p kehilangan satu frame tiap (p + 3) frame: lost harus tetap milik peer itu sendiri
+    if (sent[peer] % (peer + 3) == peer + 2) {
+      next_seq[peer]++;
+      skipped[peer]++;
+    }
+    comm_seq_tracker_update(&table.peers[peer].seq, next_seq[peer]++);
+    weight_data_t weight = { .raw_weight = (long) peer * 1000000 + sent[peer] };
+    comm_peer_table_store_latest(&table, peer, &weight, n);
+    sent[peer]++;
+  }
+
+  for (uint8_t p = 0; p < COMM_PEER_MAX; p++) {
+    comm_peer_stats_t stats;
+    comm_peer_table_get_stats(&table, p, &stats);
+    TEST_ASSERT_EQUAL_UINT32(sent[p], stats.received);
+    TEST_ASSERT_EQUAL_UINT32(sent[p], stats.samples);
+    TEST_ASSERT_EQUAL_UINT32(skipped[p], stats.lost);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.duplicated + stats.reordered + stats.restarts);
+    weight_data_t latest;
+    TEST_ASSERT_TRUE(comm_peer_table_load_latest(&table, p, &latest));
+    TEST_ASSERT_EQUAL_INT32((long) p * 1000000 + sent[p] - 1, latest.raw_weight);
+  }
+  TEST_ASSERT_GREATER_THAN_UINT32(0, unknown_frames);
+  TEST_ASSERT_EQUAL_UINT32(0, unknown_found);
+  TEST_ASSERT_EQUAL_UINT32(INTERLEAVED_FRAMES - unknown_frames, found);
+  TEST_ASSERT_EQUAL_UINT8(COMM_PEER_MAX, table.count);
+
+  char line[128];
+  snprintf(line, sizeof(line), "probe slot: peer avg %.2f max %u, asing avg %.2f max %u; find %.1f ns",
+           (double) known_total / COMM_PEER_MAX, known_max, (double) unknown_total / UNKNOWN_MACS, unknown_max,
+           lookup_ns / INTERLEAVED_FRAMES);
+  TEST_MESSAGE(line);
+  // hash 64 slot untuk 20 peer: MAC berurutan tidak boleh menggumpal jadi probe panjang
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, known_max);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(4, unknown_max);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(COMM_PEER_MAX * 3 / 2, known_total);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_add_and_find);
+  RUN_TEST(test_add_existing_keeps_index);
+  RUN_TEST(test_table_full);
+  RUN_TEST(test_latest_sample);
+  RUN_TEST(test_stats_follow_seq_trackers);
+  RUN_TEST(test_seqlock_never_tears);
+  RUN_TEST(test_interleaved_peers_isolated);
+  return UNITY_END();
+}
@@ -0,0 +1,170 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "sub_comm/comm_reliable.h"
+
+#define SENT_LOG_MAX 32
+
+typedef struct {
+  uint16_t seq;
+  uint8_t  attempt;
+  int64_t  at_us;
+} sent_t;
+
+static comm_reliable_t rel;
+static sent_t sent[SENT_LOG_MAX];
+static int sent_count;
+static int64_t clock_us;
+
+// forward declaration
+static bool record_send(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx);
+static comm_send_data_t make_cmd(cmd_main_t command, float value, uint8_t peer);
+
+void setUp(void) {
+  // konfigurasi sama dengan comm_task: 150 ms, dobel sampai 1 s, 4 retry
+  comm_reliable_config_t config = {
+    .initial_timeout_us = 150000,
+    .max_timeout_us = 1000000,
+    .max_retries = 4,
+  };
+  memset(sent, 0, sizeof(sent));
+  sent_count = 0;
+  clock_us = 0;
+  comm_reliable_init(&rel, &config, record_send, NULL);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static bool record_send(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx) {
+  if (sent_count < SENT_LOG_MAX) {
+    sent[sent_count].seq = cmd_seq;
+    sent[sent_count].attempt = attempt;
+    sent[sent_count].at_us = clock_us;
+    sent_count++;
+  }
+  return true;
+}
+
+static comm_send_data_t make_cmd(cmd_main_t command, float value, uint8_t peer) {
+  comm_send_data_t cmd;
+  memset(&cmd, 0, sizeof(cmd));
+  cmd.command = command;
+  cmd.value = value;
+  cmd.peer = peer;
+  return cmd;
+}
+
+static void test_ack_completes_command_and_records_rtt(void) {
+  comm_send_data_t cmd = make_cmd(CMD_NORMAL_TARE, 0.0f, 0);
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &cmd, clock_us));
+  TEST_ASSERT_EQUAL(1, sent_count);
+  TEST_ASSERT_EQUAL_UINT8(1, rel.stats.in_flight);
+
+  TEST_ASSERT_TRUE(comm_reliable_on_ack(&rel, 0, sent[0].seq, 12000));
+  TEST_ASSERT_EQUAL_UINT32(1, rel.stats.acked);
+  TEST_ASSERT_EQUAL_UINT8(0, rel.stats.in_flight);
+  TEST_ASSERT_EQUAL_UINT32(1, rel.stats.rtt.count);
+  TEST_ASSERT_EQUAL_UINT32(12000, rel.stats.rtt.max_us);
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, comm_reliable_poll(&rel, 20000));
+
+  // ACK kedua untuk seq yang sama tidak menyelesaikan apa-apa
+  TEST_ASSERT_FALSE(comm_reliable_on_ack(&rel, 0, sent[0].seq, 13000));
+  TEST_ASSERT_EQUAL_UINT32(1, rel.stats.duplicate_acks);
+}
+
+static void test_ack_from_other_peer_ignored(void) {
+  comm_send_data_t cmd = make_cmd(CMD_NORMAL_TARE, 0.0f, 1);
+  comm_reliable_submit(&rel, &cmd, clock_us);
+  TEST_ASSERT_FALSE(comm_reliable_on_ack(&rel, 0, sent[0].seq, 1000));
+  TEST_ASSERT_TRUE(comm_reliable_on_ack(&rel, 1, sent[0].seq, 1000));
+}
+
+static void test_retransmit_backoff_then_fail(void) {
+  comm_send_data_t cmd = make_cmd(CMD_CAL_INIT, 0.0f, 0);
+  comm_reliable_submit(&rel, &cmd, clock_us);
+
+  // jalankan jam virtual per ms sampai command menyerah
+  for (clock_us = 0; clock_us <= 5000000 && rel.stats.failed == 0; clock_us += 1000) {
+    comm_reliable_poll(&rel, clock_us);
+  }
+
+  // 1 kirim + 4 retransmit, seq tetap, jarak 150/300/600/1000 ms
+  TEST_ASSERT_EQUAL(5, sent_count);
+  const int64_t gaps[] = { 150000, 300000, 600000, 1000000 };
+  for (int i = 1; i < sent_count; i++) {
+    TEST_ASSERT_EQUAL_UINT16(sent[0].seq, sent[i].seq);
+    TEST_ASSERT_EQUAL_UINT8(i, sent[i].attempt);
+    TEST_ASSERT_EQUAL_INT64(gaps[i - 1], sent[i].at_us - sent[i - 1].at_us);
+  }
+  TEST_ASSERT_EQUAL_UINT32(4, rel.stats.retransmits);
+  TEST_ASSERT_EQUAL_UINT32(1, rel.stats.failed);
+  TEST_ASSERT_EQUAL_UINT8(0, rel.stats.in_flight);
+  // gagal setelah deadline terakhir (1 s setelah retransmit ke-4)
+  TEST_ASSERT_EQUAL_INT64(3050000, clock_us - 1000);
+}
+
+static void test_retransmit_then_ack(void) {
+  comm_send_data_t cmd = make_cmd(CMD_CAL_INIT, 0.0f, 0);
+  comm_reliable_submit(&rel, &cmd, 0);
+  TEST_ASSERT_EQUAL_INT64(150000, comm_reliable_poll(&rel, 100000));
+  TEST_ASSERT_EQUAL_INT64(450000, comm_reliable_poll(&rel, 150000));
+  TEST_ASSERT_EQUAL(2, sent_count);
+
+  // RTT dihitung dari submit pertama, bukan dari retransmit
+  TEST_ASSERT_TRUE(comm_reliable_on_ack(&rel, 0, sent[0].seq, 170000));
+  TEST_ASSERT_EQUAL_UINT32(170000, rel.stats.rtt.max_us);
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, comm_reliable_poll(&rel, 1000000));
+  TEST_ASSERT_EQUAL(2, sent_count);
+}
+
+static void test_identical_command_coalesced(void) {
+  comm_send_data_t tare = make_cmd(CMD_NORMAL_TARE, 0.0f, 0);
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &tare, 0));
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_COALESCED, comm_reliable_submit(&rel, &tare, 1000));
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_COALESCED, comm_reliable_submit(&rel, &tare, 2000));
+  TEST_ASSERT_EQUAL(1, sent_count);
+  TEST_ASSERT_EQUAL_UINT32(2, rel.stats.coalesced);
+
+  // value atau peer berbeda bukan command yang sama
+  comm_send_data_t other_peer = make_cmd(CMD_NORMAL_TARE, 0.0f, 1);
+  comm_send_data_t cal = make_cmd(CMD_CAL_CONFIRMATION, 100.0f, 0);
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &other_peer, 3000));
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &cal, 3000));
+  TEST_ASSERT_NOT_EQUAL(sent[1].seq, sent[2].seq);
+
+  // setelah ACK, tare berikutnya dikirim lagi
+  comm_reliable_on_ack(&rel, 0, sent[0].seq, 4000);
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &tare, 5000));
+}
+
+static void test_window_full(void) {
+  for (int i = 0; i < COMM_RELIABLE_WINDOW; i++) {
+    comm_send_data_t cmd = make_cmd(CMD_CAL_CONFIRMATION, (float) i, 0);
+    TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &cmd, 0));
+  }
+  TEST_ASSERT_FALSE(comm_reliable_has_room(&rel));
+  comm_send_data_t extra = make_cmd(CMD_CAL_CONFIRMATION, 99.0f, 0);
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_WINDOW_FULL, comm_reliable_submit(&rel, &extra, 0));
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_WINDOW, sent_count);
+
+  comm_reliable_on_ack(&rel, 0, sent[2].seq, 1000);
+  TEST_ASSERT_TRUE(comm_reliable_has_room(&rel));
+  TEST_ASSERT_EQUAL(COMM_RELIABLE_SUBMITTED, comm_reliable_submit(&rel, &extra, 1000));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_ack_completes_command_and_records_rtt);
+  RUN_TEST(test_ack_from_other_peer_ignored);
+  RUN_TEST(test_retransmit_backoff_then_fail);
+  RUN_TEST(test_retransmit_then_ack);
+  RUN_TEST(test_identical_command_coalesced);
+  RUN_TEST(test_window_full);
+  return UNITY_END();
+}
@@ -0,0 +1,241 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "sub_comm/comm_codec.h"
+#include "sub_comm/comm_rx_ring.h"
+
+// stress: producer (callback Wi-Fi) dan consumer (main_task) di thread terpisah
+#define STRESS_ITEMS 1000000
+// benchmark: jalur lama = xQueueSendFromISR ke comm_to_main_queue (10 x weight_data_t)
+#define BENCH_ITEMS   1000000 // sample per ukuran frame
+#define OLD_QUEUE_LEN 10
+
+// tiruan queue FreeRTOS di host: copy item di dalam critical section, send membangunkan consumer
+typedef struct {
+  weight_data_t items[OLD_QUEUE_LEN];
+  uint32_t head;
+  uint32_t count;
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+} old_queue_t;
+
+static comm_rx_ring_t ring;
+static old_queue_t old_queue;
+static atomic_bool producer_done;
+
+// forward declaration
+static comm_rx_item_t make_item(long n);
+static void* producer_thread(void* arg);
+static bool old_queue_send(old_queue_t* queue, const weight_data_t* item);
+static bool old_queue_receive(old_queue_t* queue, weight_data_t* item);
+static uint32_t old_queue_burst(uint8_t samples, uint32_t* dropped);
+static uint32_t ring_burst(uint8_t samples, uint32_t* dropped);
+static double elapsed_ns(const struct timespec* start, const struct timespec* end);
+
+void setUp(void) {
+  atomic_init(&producer_done, false);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static comm_rx_item_t make_item(long n) {
+  comm_rx_item_t item = { .seq = (uint16_t) n, .peer = 0 };
+  item.weight.raw_weight = n;
+  return item;
+}
+
+static void* producer_thread(void* arg) {
+  for (long i = 0; i < STRESS_ITEMS; i++) {
+    comm_rx_item_t item = make_item(i);
+    comm_rx_ring_push(&ring, &item);
+  }
+  atomic_store(&producer_done, true);
+  return NULL;
+}
+
+static bool old_queue_send(old_queue_t* queue, const weight_data_t* item) {
+  pthread_mutex_lock(&queue->lock);
+  bool sent = queue->count < OLD_QUEUE_LEN;
+  if (sent) {
+    queue->items[(queue->head + queue->count) % OLD_QUEUE_LEN] = *item;
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return sent;
+}
+
+static bool old_queue_receive(old_queue_t* queue, weight_data_t* item) {
+  pthread_mutex_lock(&queue->lock);
+  bool received = queue->count > 0;
+  if (received) {
+    *item = queue->items[queue->head];
+    queue->head = (queue->head + 1) % OLD_QUEUE_LEN;
+    queue->count--;
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return received;
+}
+
+// satu frame: callback push semua sample, lalu main_task bangun dan menguras semuanya
+static uint32_t old_queue_burst(uint8_t samples, uint32_t* dropped) {
+  static int32_t next;
+  for (uint8_t i = 0; i < samples; i++) {
+    weight_data_t item = { .raw_weight = next++ };
+    if (!old_queue_send(&old_queue, &item)) (*dropped)++;
+  }
+  uint32_t drained = 0;
+  weight_data_t out;
+  while (old_queue_receive(&old_queue, &out)) drained++;
+  return drained;
+}
+
+static uint32_t ring_burst(uint8_t samples, uint32_t* dropped) {
+  static long next;
+  for (uint8_t i = 0; i < samples; i++) {
+    comm_rx_item_t item = make_item(next++);
+    if (!comm_rx_ring_push(&ring, &item)) (*dropped)++;
+  }
+  uint32_t drained = 0;
+  comm_rx_item_t out;
+  while (comm_rx_ring_pop(&ring, &out)) drained++;
+  return drained;
+}
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end) {
+  return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+static void test_fifo_order(void) {
+  comm_rx_ring_init(&ring, COMM_RX_OVERWRITE_OLDEST);
+  for (long i = 0; i < 10; i++) {
+    comm_rx_item_t item = make_item(i);
+    TEST_ASSERT_TRUE(comm_rx_ring_push(&ring, &item));
+  }
+  TEST_ASSERT_EQUAL_UINT32(10, comm_rx_ring_count(&ring));
+
+  comm_rx_item_t out;
+  for (long i = 0; i < 10; i++) {
+    TEST_ASSERT_TRUE(comm_rx_ring_pop(&ring, &out));
+    TEST_ASSERT_EQUAL_INT32(i, out.weight.raw_weight);
+  }
+  TEST_ASSERT_FALSE(comm_rx_ring_pop(&ring, &out));
+}
+
+static void test_overwrite_oldest_keeps_newest(void) {
+  comm_rx_ring_init(&ring, COMM_RX_OVERWRITE_OLDEST);
+  for (long i = 0; i < COMM_RX_RING_SIZE + 5; i++) {
+    comm_rx_item_t item = make_item(i);
+    TEST_ASSERT_TRUE(comm_rx_ring_push(&ring, &item));
+  }
+
+  comm_rx_ring_stats_t stats;
+  comm_rx_ring_get_stats(&ring, &stats);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RX_RING_SIZE + 5, stats.pushed);
+  TEST_ASSERT_EQUAL_UINT32(5, stats.overwritten);
+  TEST_ASSERT_EQUAL_UINT32(COMM_RX_RING_SIZE, stats.high_water);
+
+  comm_rx_item_t out;
+  TEST_ASSERT_TRUE(comm_rx_ring_pop(&ring, &out));
+  TEST_ASSERT_EQUAL_INT32(5, out.weight.raw_weight);
+}
+
+static void test_drop_newest_keeps_oldest(void) {
+  comm_rx_ring_init(&ring, COMM_RX_DROP_NEWEST);
+  for (long i = 0; i < COMM_RX_RING_SIZE + 3; i++) {
+    comm_rx_item_t item = make_item(i);
+    TEST_ASSERT_EQUAL(i < COMM_RX_RING_SIZE, comm_rx_ring_push(&ring, &item));
+  }
+
+  comm_rx_ring_stats_t stats;
+  comm_rx_ring_get_stats(&ring, &stats);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.dropped);
+
+  comm_rx_item_t out;
+  TEST_ASSERT_TRUE(comm_rx_ring_pop(&ring, &out));
+  TEST_ASSERT_EQUAL_INT32(0, out.weight.raw_weight);
+}
+
+static void test_concurrent_overwrite_no_duplicate_or_reorder(void) {
+  comm_rx_ring_init(&ring, COMM_RX_OVERWRITE_OLDEST);
+  pthread_t producer;
+  TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, producer_thread, NULL));
+
+  // setiap item keluar paling banyak sekali dan urut naik; sisanya harus terhitung overwritten
+  long last = -1;
+  uint32_t popped = 0;
+  comm_rx_item_t out;
+  while (!atomic_load(&producer_done) || comm_rx_ring_count(&ring) > 0) {
+    if (!comm_rx_ring_pop(&ring, &out)) continue;
+    TEST_ASSERT_GREATER_THAN(last, out.weight.raw_weight);
+    last = out.weight.raw_weight;
+    popped++;
+  }
+  pthread_join(producer, NULL);
+
+  comm_rx_ring_stats_t stats;
+  comm_rx_ring_get_stats(&ring, &stats);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_ITEMS, stats.pushed);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_ITEMS, popped + stats.overwritten);
+  TEST_ASSERT_EQUAL_INT32(STRESS_ITEMS - 1, last);
+}
+
+static void test_throughput_vs_old_queue(void) {
+  // per ukuran frame: 1 = frame WEIGHT lama, 8 = batch Device A, 64 = batch penuh
+  static const uint8_t bursts[] = { 1, 8, COMM_WIRE_BATCH_MAX_SAMPLES };
+  char line[128];
+
+  pthread_mutex_init(&old_queue.lock, NULL);
+  pthread_cond_init(&old_queue.not_empty, NULL);
+  comm_rx_ring_init(&ring, COMM_RX_DROP_NEWEST);
+
+  for (size_t k = 0; k < sizeof(bursts) / sizeof(bursts[0]); k++) {
+    uint8_t samples = bursts[k];
+    uint32_t frames = BENCH_ITEMS / samples;
+    uint32_t queue_dropped = 0, queue_drained = 0;
+    uint32_t ring_dropped = 0, ring_drained = 0;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < frames; i++) queue_drained += old_queue_burst(samples, &queue_dropped);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double queue_ns = elapsed_ns(&start, &end) / (frames * samples);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < frames; i++) ring_drained += ring_burst(samples, &ring_dropped);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ring_ns = elapsed_ns(&start, &end) / (frames * samples);
+
+    snprintf(line, sizeof(line), "%2u sample/frame: old queue %.1f ns/sample (%u dropped), ring %.1f ns/sample (%u dropped)",
+             samples, queue_ns, queue_dropped, ring_ns, ring_dropped);
+    TEST_MESSAGE(line);
+
+    // queue lama hanya 10 slot: batch penuh kehilangan sample walaupun main_task langsung menguras
+    TEST_ASSERT_EQUAL_UINT32(frames * samples, queue_drained + queue_dropped);
+    TEST_ASSERT_EQUAL_UINT32(samples > OLD_QUEUE_LEN ? frames * (samples - OLD_QUEUE_LEN) : 0, queue_dropped);
+    TEST_ASSERT_EQUAL_UINT32(frames * samples, ring_drained);
+    TEST_ASSERT_EQUAL_UINT32(0, ring_dropped);
+  }
+
+  pthread_cond_destroy(&old_queue.not_empty);
+  pthread_mutex_destroy(&old_queue.lock);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fifo_order);
+  RUN_TEST(test_overwrite_oldest_keeps_newest);
+  RUN_TEST(test_drop_newest_keeps_oldest);
+  RUN_TEST(test_concurrent_overwrite_no_duplicate_or_reorder);
+  RUN_TEST(test_throughput_vs_old_queue);
+  return UNITY_END();
+}
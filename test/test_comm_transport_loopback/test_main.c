@@ -0,0 +1,297 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sub_comm/comm_codec.h"
+#include "sub_comm/comm_reliable.h"
+#include "sub_comm/comm_transport_loopback.h"
+
+#define E2E_COMMANDS 50
+
+typedef struct {
+  int received;
+  uint8_t last[COMM_TRANSPORT_MAX_FRAME];
+  int last_len;
+  int send_ok;
+  int send_fail;
+} probe_node_t;
+
+// hasil satu run end-to-end, dibandingkan antar run untuk cek determinisme
+typedef struct {
+  comm_reliable_stats_t reliable;
+  comm_loopback_stats_t medium;
+  uint32_t executed;
+  uint32_t duplicates;
+  uint32_t executed_twice;
+} e2e_result_t;
+
+static const uint8_t mac_a[COMM_TRANSPORT_MAC_LEN] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x0A };
+static const uint8_t mac_b[COMM_TRANSPORT_MAC_LEN] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x0B };
+
+static comm_loopback_medium_t medium;
+static probe_node_t probe_a;
+static probe_node_t probe_b;
+
+// state end-to-end: B = display (kirim command), A = node load cell (balas ACK)
+static const comm_transport_t* e2e_a;
+static const comm_transport_t* e2e_b;
+static comm_reliable_t e2e_rel;
+static int64_t e2e_now_us;
+static uint8_t e2e_exec_count[E2E_COMMANDS];
+static uint32_t e2e_duplicates;
+static bool e2e_cmd_seen[UINT16_MAX + 1];
+
+// forward declaration
+static void probe_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+static void probe_sent(const uint8_t* mac, bool success, void* ctx);
+static void pair_probes(const comm_loopback_config_t* config);
+static bool e2e_send_cmd(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx);
+static void e2e_recv_a(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+static void e2e_recv_b(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx);
+static void run_e2e(uint32_t seed, e2e_result_t* result);
+
+void setUp(void) {
+  memset(&probe_a, 0, sizeof(probe_a));
+  memset(&probe_b, 0, sizeof(probe_b));
+}
+
+void tearDown(void) {
+  comm_loopback_stop(&medium);
+}
+
+// --- static function ---
+static void probe_recv(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx) {
+  probe_node_t* node = (probe_node_t*) ctx;
+  node->received++;
+  memcpy(node->last, data, len);
+  node->last_len = len;
+}
+
+static void probe_sent(const uint8_t* mac, bool success, void* ctx) {
+  probe_node_t* node = (probe_node_t*) ctx;
+  if (success) {
+    node->send_ok++;
+  } else {
+    node->send_fail++;
+  }
+}
+
+static void pair_probes(const comm_loopback_config_t* config) {
+  comm_loopback_init(&medium, config);
+  const comm_transport_t* a = comm_loopback_attach(&medium, mac_a);
+  const comm_transport_t* b = comm_loopback_attach(&medium, mac_b);
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  TEST_ASSERT_TRUE(comm_transport_init(a));
+  comm_transport_set_callbacks(a, probe_recv, probe_sent, &probe_a);
+  comm_transport_set_callbacks(b, probe_recv, probe_sent, &probe_b);
+  comm_transport_add_peer(a, mac_b);
+  comm_transport_add_peer(b, mac_a);
+}
+
+static bool e2e_send_cmd(uint16_t cmd_seq, uint8_t attempt, const comm_send_data_t* cmd, void* ctx) {
+  uint8_t frame[COMM_WIRE_MAX_FRAME_LEN];
+  size_t len = comm_codec_encode_cmd(frame, sizeof(frame), cmd_seq, cmd);
+  return len > 0 && comm_transport_send(e2e_b, mac_a, frame, len);
+}
+
+static void e2e_recv_a(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx) {
+  comm_frame_header_t header;
+  comm_send_data_t cmd;
+  if (comm_codec_parse(data, len, &header) != COMM_DECODE_OK) return;
+  if (comm_codec_decode_cmd(&header, &cmd) != COMM_DECODE_OK) return;
+
+  // retransmit memakai seq yang sama: dieksekusi sekali, tapi tetap di-ACK
+  if (!e2e_cmd_seen[header.seq]) {
+    e2e_cmd_seen[header.seq] = true;
+    int index = (int) cmd.value;
+    if (index >= 0 && index < E2E_COMMANDS) e2e_exec_count[index]++;
+  } else {
+    e2e_duplicates++;
+  }
+
+  uint8_t ack[COMM_WIRE_ACK_FRAME_LEN];
+  size_t ack_len = comm_codec_encode_ack(ack, sizeof(ack), 0, header.seq, COMM_ACK_OK);
+  comm_transport_send(e2e_a, mac, ack, ack_len);
+}
+
+static void e2e_recv_b(const uint8_t* mac, int8_t rssi, const uint8_t* data, int len, void* ctx) {
+  comm_frame_header_t header;
+  uint16_t acked;
+  comm_ack_status_t status;
+  if (comm_codec_parse(data, len, &header) != COMM_DECODE_OK) return;
+  if (comm_codec_decode_ack(&header, &acked, &status) != COMM_DECODE_OK) return;
+  comm_reliable_on_ack(&e2e_rel, 0, acked, e2e_now_us);
+}
+
+static void run_e2e(uint32_t seed, e2e_result_t* result) {
+  // link buruk: 20% hilang tiap arah, sebagian frame tersusul
+  comm_loopback_config_t config = {
+    .latency_us = 2000,
+    .jitter_us = 1500,
+    .loss_permille = 200,
+    .reorder_permille = 50,
+    .seed = seed,
+    .rssi = -70,
+  };
+  comm_reliable_config_t rel_config = {
+    .initial_timeout_us = 150000,
+    .max_timeout_us = 1000000,
+    .max_retries = 4,
+  };
+
+  comm_loopback_init(&medium, &config);
+  e2e_a = comm_loopback_attach(&medium, mac_a);
+  e2e_b = comm_loopback_attach(&medium, mac_b);
+  comm_transport_set_callbacks(e2e_a, e2e_recv_a, NULL, NULL);
+  comm_transport_set_callbacks(e2e_b, e2e_recv_b, NULL, NULL);
+  comm_transport_add_peer(e2e_a, mac_b);
+  comm_transport_add_peer(e2e_b, mac_a);
+  comm_reliable_init(&e2e_rel, &rel_config, e2e_send_cmd, NULL);
+  memset(e2e_cmd_seen, 0, sizeof(e2e_cmd_seen));
+  memset(e2e_exec_count, 0, sizeof(e2e_exec_count));
+  e2e_duplicates = 0;
+
+  // satu command tiap 100 ms (value beda supaya tidak di-coalesce)
+  int next = 0;
+  for (e2e_now_us = 0; e2e_now_us < 15000000; e2e_now_us += 500) {
+    if (next < E2E_COMMANDS && e2e_now_us >= next * 100000 && comm_reliable_has_room(&e2e_rel)) {
+      comm_send_data_t cmd = { .command = CMD_CAL_CONFIRMATION, .value = (float) next };
+      comm_reliable_submit(&e2e_rel, &cmd, e2e_now_us);
+      next++;
+    }
+    comm_loopback_poll(&medium, e2e_now_us);
+    comm_reliable_poll(&e2e_rel, e2e_now_us);
+  }
+
+  memset(result, 0, sizeof(*result));
+  result->reliable = e2e_rel.stats;
+  comm_loopback_get_stats(&medium, &result->medium);
+  result->duplicates = e2e_duplicates;
+  for (int i = 0; i < E2E_COMMANDS; i++) {
+    if (e2e_exec_count[i] > 0) result->executed++;
+    if (e2e_exec_count[i] > 1) result->executed_twice++;
+  }
+}
+
+static void test_frame_arrives_after_latency(void) {
+  comm_loopback_config_t config = { .latency_us = 3000, .rssi = -42 };
+  pair_probes(&config);
+  comm_loopback_poll(&medium, 1000);
+
+  const uint8_t payload[] = { 1, 2, 3, 4 };
+  TEST_ASSERT_TRUE(comm_transport_send(&medium.nodes[1].transport, mac_a, payload, sizeof(payload)));
+  TEST_ASSERT_EQUAL_UINT32(0, comm_loopback_poll(&medium, 3999));
+  TEST_ASSERT_EQUAL(0, probe_a.received);
+  TEST_ASSERT_EQUAL_UINT32(1, comm_loopback_poll(&medium, 4000));
+  TEST_ASSERT_EQUAL(1, probe_a.received);
+  TEST_ASSERT_EQUAL(sizeof(payload), probe_a.last_len);
+  TEST_ASSERT_EQUAL_MEMORY(payload, probe_a.last, sizeof(payload));
+  TEST_ASSERT_EQUAL(1, probe_b.send_ok);
+}
+
+static void test_send_requires_peer(void) {
+  comm_loopback_config_t config = { .latency_us = 1000 };
+  pair_probes(&config);
+  const uint8_t stranger[COMM_TRANSPORT_MAC_LEN] = { 0xDE, 0xAD, 0xBE, 0xEF, 0x00, 0x01 };
+  const uint8_t payload[] = { 9 };
+  TEST_ASSERT_FALSE(comm_transport_send(&medium.nodes[0].transport, stranger, payload, 1));
+
+  // peer terdaftar tapi tidak ada di medium: callback kirim melapor gagal
+  comm_transport_add_peer(&medium.nodes[0].transport, stranger);
+  TEST_ASSERT_TRUE(comm_transport_send(&medium.nodes[0].transport, stranger, payload, 1));
+  comm_loopback_poll(&medium, 5000);
+  TEST_ASSERT_EQUAL(1, probe_a.send_fail);
+
+  comm_loopback_stats_t stats;
+  comm_loopback_get_stats(&medium, &stats);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.no_route);
+}
+
+static void test_loss_reported_to_sender(void) {
+  comm_loopback_config_t config = { .latency_us = 1000, .loss_permille = 1000 };
+  pair_probes(&config);
+  const uint8_t payload[] = { 7 };
+  for (int i = 0; i < 10; i++) comm_transport_send(&medium.nodes[0].transport, mac_b, payload, 1);
+  comm_loopback_poll(&medium, 10000);
+  TEST_ASSERT_EQUAL(0, probe_b.received);
+  TEST_ASSERT_EQUAL(10, probe_a.send_fail);
+}
+
+static void test_reorder_is_overtaken(void) {
+  comm_loopback_config_t config = { .latency_us = 1000, .reorder_permille = 1000 };
+  pair_probes(&config);
+  uint8_t first = 1;
+  comm_transport_send(&medium.nodes[0].transport, mac_b, &first, 1);
+
+  // frame kedua dikirim tanpa reorder, harus tiba lebih dulu
+  config.reorder_permille = 0;
+  comm_loopback_set_config(&medium, &config);
+  uint8_t second = 2;
+  comm_transport_send(&medium.nodes[0].transport, mac_b, &second, 1);
+
+  comm_loopback_poll(&medium, 1000);
+  TEST_ASSERT_EQUAL(1, probe_b.received);
+  TEST_ASSERT_EQUAL_UINT8(2, probe_b.last[0]);
+  comm_loopback_poll(&medium, 2001);
+  TEST_ASSERT_EQUAL(2, probe_b.received);
+  TEST_ASSERT_EQUAL_UINT8(1, probe_b.last[0]);
+}
+
+static void test_thread_delivers_on_monotonic_clock(void) {
+  comm_loopback_config_t config = { .latency_us = 500 };
+  pair_probes(&config);
+  TEST_ASSERT_TRUE(comm_loopback_start(&medium, 100));
+  const uint8_t payload[] = { 5 };
+  comm_transport_send(&medium.nodes[0].transport, mac_b, payload, 1);
+  for (int i = 0; i < 1000 && probe_a.send_ok == 0; i++) usleep(1000);
+  comm_loopback_stop(&medium);
+  TEST_ASSERT_EQUAL(1, probe_b.received);
+  TEST_ASSERT_EQUAL(1, probe_a.send_ok);
+}
+
+static void test_reliable_over_lossy_link(void) {
+  e2e_result_t result;
+  run_e2e(1234, &result);
+
+  // semua command selesai: di-ACK atau dilaporkan gagal, tidak ada yang menggantung
+  TEST_ASSERT_EQUAL_UINT32(E2E_COMMANDS, result.reliable.submitted);
+  TEST_ASSERT_EQUAL_UINT32(E2E_COMMANDS, result.reliable.acked + result.reliable.failed);
+  TEST_ASSERT_EQUAL_UINT8(0, result.reliable.in_flight);
+  TEST_ASSERT_GREATER_THAN(0, result.medium.lost);
+  TEST_ASSERT_GREATER_THAN(0, result.reliable.retransmits);
+  // retransmit yang sampai dibuang Device A, tidak ada command yang jalan dua kali
+  TEST_ASSERT_GREATER_THAN(0, result.duplicates);
+  TEST_ASSERT_EQUAL_UINT32(0, result.executed_twice);
+  TEST_ASSERT_TRUE(result.executed >= result.reliable.acked);
+  // 5 percobaan dengan 36% sukses per round trip: gagal total sangat jarang
+  TEST_ASSERT_TRUE(result.reliable.acked >= E2E_COMMANDS - 2);
+}
+
+static void test_same_seed_same_run(void) {
+  e2e_result_t first;
+  e2e_result_t second;
+  run_e2e(77, &first);
+  run_e2e(77, &second);
+  TEST_ASSERT_EQUAL_UINT32(first.medium.sent, second.medium.sent);
+  TEST_ASSERT_EQUAL_UINT32(first.medium.lost, second.medium.lost);
+  TEST_ASSERT_EQUAL_UINT32(first.medium.reordered, second.medium.reordered);
+  TEST_ASSERT_EQUAL_UINT32(first.reliable.retransmits, second.reliable.retransmits);
+  TEST_ASSERT_EQUAL_UINT32(first.reliable.rtt.sum_us, second.reliable.rtt.sum_us);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_arrives_after_latency);
+  RUN_TEST(test_send_requires_peer);
+  RUN_TEST(test_loss_reported_to_sender);
+  RUN_TEST(test_reorder_is_overtaken);
+  RUN_TEST(test_thread_delivers_on_monotonic_clock);
+  RUN_TEST(test_reliable_over_lossy_link);
+  RUN_TEST(test_same_seed_same_run);
+  return UNITY_END();
+}
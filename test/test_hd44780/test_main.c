@@ -0,0 +1,369 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "drivers/hd44780_pcf8574.h"
+#include "drivers/hd44780_emu.h"
+#include "sub_lcd/lcd_frame.h"
+#include "utils/weight_fmt.h"
+
+#define LCD_ADDRESS   0x27
+#define LCD_COLS      16
+#define REDRAW_FRAMES 2000
+#define BUS_HZ        100000
+
+static hd44780_emu_t emu;
+static hd44780_emu_t emu_old;
+static uint8_t pending[HD44780_BYTES_PER_CHAR];
+static size_t pending_len;
+static uint32_t native_writes;
+static uint32_t rng_state;
+
+// forward declaration
+static uint32_t next_random(void);
+static void send(hd44780_emu_t* target, const uint8_t* data, size_t len);
+static void init_native(void);
+static void native_set_cursor(void* self, uint8_t col, uint8_t row);
+static void native_write(void* self, const char* data, uint8_t len);
+static void old_nibble(uint8_t value);
+static void old_send(uint8_t value, uint8_t mode);
+static void old_set_cursor(void* self, uint8_t col, uint8_t row);
+static void old_write(void* self, const char* data, uint8_t len);
+static void weight_screen(int frame, char* line0, char* line1);
+static void assert_emu_shows(const hd44780_emu_t* target, const char* line0, const char* line1);
+
+static const lcd_sink_ops_t native_ops = {
+  .set_cursor = native_set_cursor,
+  .write = native_write,
+  .name = "native",
+};
+
+void setUp(void) {
+  hd44780_emu_init(&emu, LCD_ADDRESS);
+  hd44780_emu_init(&emu_old, LCD_ADDRESS);
+  pending_len = 0;
+  native_writes = 0;
+  rng_state = 1;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static void send(hd44780_emu_t* target, const uint8_t* data, size_t len) {
+  TEST_ASSERT_TRUE(hd44780_emu_i2c_write(target, LCD_ADDRESS, data, len));
+}
+
+static void init_native(void) {
+  // urutan resync yang sama dengan lcd_driver.c
+  uint8_t buf[HD44780_BYTES_PER_CHAR];
+  for (int i = 0; i < 3; i++) send(&emu, buf, hd44780_encode_nibble(buf, sizeof(buf), 0x3, true));
+  send(&emu, buf, hd44780_encode_nibble(buf, sizeof(buf), 0x2, true));
+
+  static const uint8_t commands[] = {
+    HD44780_FUNCTION_SET | HD44780_FUNCTION_2LINE,
+    HD44780_DISPLAY_CTRL | HD44780_DISPLAY_ON,
+    HD44780_CLEAR,
+    HD44780_ENTRY_MODE | HD44780_ENTRY_INC,
+  };
+  for (size_t i = 0; i < sizeof(commands); i++) {
+    send(&emu, buf, hd44780_encode_command(buf, sizeof(buf), commands[i], true));
+  }
+}
+
+static void native_set_cursor(void* self, uint8_t col, uint8_t row) {
+  // ditahan, ikut transaksi write berikutnya (seperti lcd_driver.c)
+  pending_len = hd44780_encode_set_cursor(pending, sizeof(pending), col, row, true);
+}
+
+static void native_write(void* self, const char* data, uint8_t len) {
+  uint8_t buf[HD44780_RUN_BYTES(LCD_FRAME_COLS)];
+  size_t n = pending_len;
+  memcpy(buf, pending, n);
+  pending_len = 0;
+  n += hd44780_encode_data(buf + n, sizeof(buf) - n, (const uint8_t*) data, len, true);
+  send(&emu, buf, n);
+  native_writes++;
+}
+
+static void old_nibble(uint8_t value) {
+  // LiquidCrystal_I2C: expanderWrite(value), lalu pulseEnable = EN high, EN low; masing-masing satu transaksi
+  uint8_t bytes[3] = { value, value | HD44780_PCF_EN, value & (uint8_t) ~HD44780_PCF_EN };
+  for (int i = 0; i < 3; i++) send(&emu_old, &bytes[i], 1);
+}
+
+static void old_send(uint8_t value, uint8_t mode) {
+  old_nibble((value & 0xF0) | mode | HD44780_PCF_BACKLIGHT);
+  old_nibble((uint8_t) (value << 4) | mode | HD44780_PCF_BACKLIGHT);
+}
+
+static void old_set_cursor(void* self, uint8_t col, uint8_t row) {
+  old_send(HD44780_SET_DDRAM | hd44780_ddram_address(col, row), 0);
+}
+
+static void old_write(void* self, const char* data, uint8_t len) {
+  for (uint8_t i = 0; i < len; i++) old_send((uint8_t) data[i], HD44780_PCF_RS);
+}
+
+static void weight_screen(int frame, char* line0, char* line1) {
+  // beban naik / turun tiap 400 frame, noise +-0.03 g, raw ikut bergerak
+  static float weight;
+  if (frame == 0) weight = 0.0f;
+  if (frame % 400 == 100) weight = 250.0f + (float) (next_random() % 1000) / 10.0f;
+  if (frame % 400 == 300) weight = 0.0f;
+  float sample = weight + (float) ((int) (next_random() % 7) - 3) * 0.01f;
+
+  weight_fmt_weight(line0, LCD_COLS + 1, weight_fmt_from_units(sample), WEIGHT_UNIT_GRAM, LCD_COLS, true);
+  size_t n = weight_fmt_text(line1, LCD_COLS + 1, "RAW", 0);
+  weight_fmt_int(line1 + n, LCD_COLS + 1 - n, (int32_t) (84000 + sample * 420 + next_random() % 40),
+                 (uint8_t) (LCD_COLS - n));
+}
+
+static void assert_emu_shows(const hd44780_emu_t* target, const char* line0, const char* line1) {
+  char visible[LCD_COLS + 1];
+  hd44780_emu_line(target, 0, LCD_COLS, visible);
+  TEST_ASSERT_EQUAL_STRING(line0, visible);
+  hd44780_emu_line(target, 1, LCD_COLS, visible);
+  TEST_ASSERT_EQUAL_STRING(line1, visible);
+}
+
+static void test_init_from_power_on(void) {
+  init_native();
+  TEST_ASSERT_TRUE(emu.four_bit);
+  TEST_ASSERT_FALSE(emu.nibble_pending);
+  TEST_ASSERT_TRUE(emu.two_line);
+  TEST_ASSERT_TRUE(emu.display_on);
+  TEST_ASSERT_TRUE(emu.increment);
+  TEST_ASSERT_EQUAL_UINT8(0, emu.ac);
+  TEST_ASSERT_TRUE(hd44780_emu_backlight(&emu));
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+static void test_init_resyncs_mid_byte(void) {
+  // reset MCU di tengah transfer: LCD sudah 4 bit dan menunggu nibble bawah
+  emu.four_bit = true;
+  emu.nibble_pending = true;
+  init_native();
+
+  TEST_ASSERT_TRUE(emu.four_bit);
+  TEST_ASSERT_FALSE(emu.nibble_pending);
+  TEST_ASSERT_TRUE(emu.two_line);
+  TEST_ASSERT_TRUE(emu.display_on);
+  // 4 nibble + 4 command, satu transaksi per langkah
+  TEST_ASSERT_EQUAL_UINT32(8, emu.stats.transactions);
+  TEST_ASSERT_EQUAL_UINT64(4 * HD44780_BYTES_PER_NIBBLE + 4 * HD44780_BYTES_PER_CHAR, emu.stats.bytes);
+
+  // setelah resync, teks masuk di posisi yang benar
+  lcd_sink_t sink = { &native_ops, NULL };
+  lcd_sink_set_cursor(&sink, 0, 0);
+  lcd_sink_write(&sink, "SYNC", 4);
+  assert_emu_shows(&emu, "SYNC            ", "                ");
+}
+
+static void test_run_is_one_transaction(void) {
+  init_native();
+  hd44780_emu_reset_stats(&emu);
+  lcd_sink_t sink = { &native_ops, NULL };
+
+  lcd_sink_set_cursor(&sink, 3, 1);
+  lcd_sink_write(&sink, "12.50 g", 7);
+  TEST_ASSERT_EQUAL_UINT32(1, emu.stats.transactions);
+  TEST_ASSERT_EQUAL_UINT64(HD44780_RUN_BYTES(7), emu.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT32(1, emu.stats.instructions);
+  TEST_ASSERT_EQUAL_UINT32(7, emu.stats.data_writes);
+  assert_emu_shows(&emu, "                ", "   12.50 g      ");
+
+  // tanpa set_cursor, cursor LCD lanjut dari posisi terakhir
+  lcd_sink_write(&sink, "!", 1);
+  TEST_ASSERT_EQUAL_UINT64(HD44780_RUN_BYTES(7) + HD44780_BYTES_PER_CHAR, emu.stats.bytes);
+  assert_emu_shows(&emu, "                ", "   12.50 g!     ");
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+static void test_ddram_address(void) {
+  TEST_ASSERT_EQUAL_HEX8(0x00, hd44780_ddram_address(0, 0));
+  TEST_ASSERT_EQUAL_HEX8(0x4F, hd44780_ddram_address(15, 1));
+  TEST_ASSERT_EQUAL_HEX8(0x14, hd44780_ddram_address(0, 2));
+  TEST_ASSERT_EQUAL_HEX8(0x54, hd44780_ddram_address(0, 3));
+  // baris di luar range dijepit ke baris terakhir
+  TEST_ASSERT_EQUAL_HEX8(0x54, hd44780_ddram_address(0, 9));
+}
+
+static void test_encode_small_buffer(void) {
+  uint8_t buf[HD44780_CGRAM_BYTES];
+  static const uint8_t rows[HD44780_GLYPH_ROWS] = { 0 };
+
+  TEST_ASSERT_EQUAL_size_t(0, hd44780_encode_nibble(buf, HD44780_BYTES_PER_NIBBLE - 1, 0x3, true));
+  TEST_ASSERT_EQUAL_size_t(0, hd44780_encode_command(buf, HD44780_BYTES_PER_CHAR - 1, HD44780_CLEAR, true));
+  TEST_ASSERT_EQUAL_size_t(0, hd44780_encode_set_cursor(buf, HD44780_BYTES_PER_CHAR - 1, 0, 0, true));
+  TEST_ASSERT_EQUAL_size_t(0, hd44780_encode_data(buf, 3 * HD44780_BYTES_PER_CHAR - 1,
+                                                  (const uint8_t*) "abc", 3, true));
+  TEST_ASSERT_EQUAL_size_t(0, hd44780_encode_cgram(buf, HD44780_CGRAM_BYTES - HD44780_BYTES_PER_CHAR - 1, 0,
+                                                   rows, true));
+
+  TEST_ASSERT_EQUAL_size_t(HD44780_BYTES_PER_NIBBLE, hd44780_encode_nibble(buf, sizeof(buf), 0x3, true));
+  TEST_ASSERT_EQUAL_size_t(3 * HD44780_BYTES_PER_CHAR,
+                           hd44780_encode_data(buf, 3 * HD44780_BYTES_PER_CHAR, (const uint8_t*) "abc", 3, true));
+}
+
+static void test_nibble_encoding(void) {
+  uint8_t buf[HD44780_BYTES_PER_CHAR];
+  TEST_ASSERT_EQUAL_size_t(HD44780_BYTES_PER_CHAR, hd44780_encode_data(buf, sizeof(buf), (const uint8_t*) "A", 1,
+                                                                       true));
+  // 'A' = 0x41: nibble atas lalu bawah, masing-masing EN high -> EN low, RS dan backlight tetap
+  uint8_t flags = HD44780_PCF_RS | HD44780_PCF_BACKLIGHT;
+  TEST_ASSERT_EQUAL_HEX8(0x40 | flags | HD44780_PCF_EN, buf[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x40 | flags, buf[1]);
+  TEST_ASSERT_EQUAL_HEX8(0x10 | flags | HD44780_PCF_EN, buf[2]);
+  TEST_ASSERT_EQUAL_HEX8(0x10 | flags, buf[3]);
+  for (int i = 0; i < 4; i++) TEST_ASSERT_FALSE(buf[i] & HD44780_PCF_RW);
+}
+
+static void test_cgram_upload(void) {
+  init_native();
+  static const uint8_t rows[HD44780_GLYPH_ROWS] = { 0x04, 0x0E, 0x1F, 0x04, 0x04, 0x04, 0x04, 0x00 };
+  uint8_t buf[HD44780_CGRAM_BYTES];
+  size_t n = hd44780_encode_cgram(buf, sizeof(buf), 2, rows, true);
+  TEST_ASSERT_EQUAL_size_t(HD44780_BYTES_PER_CHAR * (1 + HD44780_GLYPH_ROWS), n);
+  send(&emu, buf, n);
+  TEST_ASSERT_TRUE(emu.cgram_mode);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(rows, &emu.cgram[2 * HD44780_GLYPH_ROWS], HD44780_GLYPH_ROWS);
+
+  // set_cursor mengembalikan tulisan ke DDRAM; slot 2 ditampilkan sebagai karakter 0x02
+  lcd_sink_t sink = { &native_ops, NULL };
+  lcd_sink_set_cursor(&sink, 0, 0);
+  lcd_sink_write(&sink, "\x02", 1);
+  TEST_ASSERT_FALSE(emu.cgram_mode);
+  TEST_ASSERT_EQUAL_HEX8(0x02, emu.ddram[0]);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(rows, &emu.cgram[2 * HD44780_GLYPH_ROWS], HD44780_GLYPH_ROWS);
+}
+
+static void test_wrong_address_nacks(void) {
+  init_native();
+  hd44780_emu_reset_stats(&emu);
+  uint8_t buf[HD44780_RUN_BYTES(2)];
+  size_t n = hd44780_encode_set_cursor(buf, sizeof(buf), 0, 0, true);
+  n += hd44780_encode_data(buf + n, sizeof(buf) - n, (const uint8_t*) "XX", 2, true);
+
+  TEST_ASSERT_FALSE(hd44780_emu_i2c_write(&emu, 0x3F, buf, n));
+  TEST_ASSERT_EQUAL_UINT32(1, emu.stats.nacks);
+  TEST_ASSERT_EQUAL_UINT64(0, emu.stats.bytes);
+  assert_emu_shows(&emu, "                ", "                ");
+}
+
+static void test_backlight_only(void) {
+  init_native();
+  hd44780_emu_reset_stats(&emu);
+  uint8_t buf[HD44780_BYTES_PER_CHAR];
+
+  send(&emu, buf, hd44780_encode_backlight(buf, sizeof(buf), false));
+  TEST_ASSERT_FALSE(hd44780_emu_backlight(&emu));
+  send(&emu, buf, hd44780_encode_backlight(buf, sizeof(buf), true));
+  TEST_ASSERT_TRUE(hd44780_emu_backlight(&emu));
+  // tidak ada strobe EN: state LCD tidak tersentuh
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.instructions);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.data_writes);
+  TEST_ASSERT_FALSE(emu.nibble_pending);
+}
+
+static void test_rw_strobe_is_protocol_error(void) {
+  init_native();
+  uint8_t bad[2] = { 0x40 | HD44780_PCF_RW | HD44780_PCF_EN, 0x40 | HD44780_PCF_RW };
+  send(&emu, bad, sizeof(bad));
+  TEST_ASSERT_EQUAL_UINT32(1, emu.stats.protocol_errors);
+  TEST_ASSERT_FALSE(emu.nibble_pending);
+}
+
+static void test_weight_screen_old_vs_native(void) {
+  // skenario commit: 2000 frame layar berat, full redraw lama vs native vs native + frame diff
+  for (int i = 0; i < 3; i++) old_nibble(0x30 | HD44780_PCF_BACKLIGHT);
+  old_nibble(0x20 | HD44780_PCF_BACKLIGHT);
+  old_send(HD44780_FUNCTION_SET | HD44780_FUNCTION_2LINE, 0);
+  old_send(HD44780_DISPLAY_CTRL | HD44780_DISPLAY_ON, 0);
+  old_send(HD44780_ENTRY_MODE | HD44780_ENTRY_INC, 0);
+  init_native();
+  hd44780_emu_reset_stats(&emu);
+  hd44780_emu_reset_stats(&emu_old);
+
+  lcd_sink_t sink = { &native_ops, NULL };
+  char line0[LCD_COLS + 1], line1[LCD_COLS + 1];
+  for (int i = 0; i < REDRAW_FRAMES; i++) {
+    weight_screen(i, line0, line1);
+    old_set_cursor(NULL, 0, 0);
+    old_write(NULL, line0, LCD_COLS);
+    old_set_cursor(NULL, 0, 1);
+    old_write(NULL, line1, LCD_COLS);
+    lcd_sink_set_cursor(&sink, 0, 0);
+    lcd_sink_write(&sink, line0, LCD_COLS);
+    lcd_sink_set_cursor(&sink, 0, 1);
+    lcd_sink_write(&sink, line1, LCD_COLS);
+    assert_emu_shows(&emu_old, line0, line1);
+    assert_emu_shows(&emu, line0, line1);
+  }
+
+  // lama: 2 x 17 byte LCD x 2 nibble x 3 transaksi satu byte
+  TEST_ASSERT_EQUAL_UINT32(204 * REDRAW_FRAMES, emu_old.stats.transactions);
+  TEST_ASSERT_EQUAL_UINT64(204ULL * REDRAW_FRAMES, emu_old.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT32(2 * REDRAW_FRAMES, emu.stats.transactions);
+  TEST_ASSERT_EQUAL_UINT64(2ULL * HD44780_RUN_BYTES(LCD_COLS) * REDRAW_FRAMES, emu.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT64(40800ULL * REDRAW_FRAMES, hd44780_emu_bus_us(&emu_old.stats, BUS_HZ));
+  TEST_ASSERT_LESS_THAN(12500ULL * REDRAW_FRAMES, hd44780_emu_bus_us(&emu.stats, BUS_HZ));
+  TEST_ASSERT_EQUAL_UINT32(0, emu_old.stats.protocol_errors);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+static void test_weight_screen_frame_diff(void) {
+  init_native();
+  hd44780_emu_reset_stats(&emu);
+  lcd_frame_t frame;
+  lcd_frame_init(&frame);
+  lcd_sink_t sink = { &native_ops, NULL };
+
+  char line0[LCD_COLS + 1], line1[LCD_COLS + 1];
+  for (int i = 0; i < REDRAW_FRAMES; i++) {
+    weight_screen(i, line0, line1);
+    uint32_t before = emu.stats.transactions;
+    lcd_frame_set_line(&frame, 0, line0);
+    lcd_frame_set_line(&frame, 1, line1);
+    uint32_t writes = native_writes;
+    lcd_frame_flush(&frame, &sink);
+    // satu transaksi per run (set_cursor ikut di dalamnya)
+    TEST_ASSERT_EQUAL_UINT32(native_writes - writes, emu.stats.transactions - before);
+    assert_emu_shows(&emu, line0, line1);
+  }
+
+  // commit: rata-rata 21.7 byte (2.2 ms bus) per frame vs 136 byte full redraw
+  TEST_ASSERT_LESS_THAN(25ULL * REDRAW_FRAMES, emu.stats.bytes);
+  TEST_ASSERT_LESS_THAN(2500ULL * REDRAW_FRAMES, hd44780_emu_bus_us(&emu.stats, BUS_HZ));
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.nacks);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_init_from_power_on);
+  RUN_TEST(test_init_resyncs_mid_byte);
+  RUN_TEST(test_run_is_one_transaction);
+  RUN_TEST(test_ddram_address);
+  RUN_TEST(test_encode_small_buffer);
+  RUN_TEST(test_nibble_encoding);
+  RUN_TEST(test_cgram_upload);
+  RUN_TEST(test_wrong_address_nacks);
+  RUN_TEST(test_backlight_only);
+  RUN_TEST(test_rw_strobe_is_protocol_error);
+  RUN_TEST(test_weight_screen_old_vs_native);
+  RUN_TEST(test_weight_screen_frame_diff);
+  return UNITY_END();
+}
@@ -0,0 +1,209 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "utils/input_trace.h"
+#include "sub_button/button_engine.h"
+
+#define CLICKS          1000
+#define CLICK_PERIOD_US 1000000
+#define HOLD_MIN_US     60000
+#define HOLD_SPAN_US    100000
+#define WINDOW_US       300000
+#define TASK_LATENCY_US 30
+
+static input_trace_stats_t stats;
+static uint32_t rng_state;
+
+// satu tombol tanpa bounce: toggle berurutan, level = jumlah toggle ganjil
+static int64_t toggles[2 * CLICKS];
+static uint32_t toggle_count;
+static int64_t now_us;
+static bool armed;
+static bool armed_level;
+
+// forward declaration
+static uint32_t next_random(void);
+static bool level_at(int64_t time_us);
+static uint32_t read_pin(void* ctx);
+static void arm_pin(void* ctx, uint8_t pin, bool pressed);
+static void replay_clicks(uint32_t double_click_us);
+
+void setUp(void) {
+  input_trace_stats_reset(&stats);
+  rng_state = 7;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static bool level_at(int64_t time_us) {
+  bool level = false;
+  for (uint32_t i = 0; i < toggle_count && toggles[i] <= time_us; i++) level = !level;
+  return level;
+}
+
+static uint32_t read_pin(void* ctx) {
+  return level_at(now_us) ? 1u : 0u;
+}
+
+static void arm_pin(void* ctx, uint8_t pin, bool pressed) {
+  armed = true;
+  armed_level = !pressed;
+}
+
+static void replay_clicks(uint32_t double_click_us) {
+  // skenario commit: 1000 click A (tahan 60..160 ms) lewat button_engine, hop RECOGNIZE dan BUTTON_QUEUE
+  toggle_count = 0;
+  int64_t start_us = CLICK_PERIOD_US;
+  for (int i = 0; i < CLICKS; i++) {
+    toggles[toggle_count++] = start_us;
+    toggles[toggle_count++] = start_us + HOLD_MIN_US + next_random() % HOLD_SPAN_US;
+    start_us += CLICK_PERIOD_US;
+  }
+
+  button_engine_config_t config = { 0 };
+  config.pin_count = 1;
+  config.debounce_us = 20000;
+  config.pins[0].long_press_us = 1000000;
+  config.pins[0].double_click_us = double_click_us;
+  button_engine_io_t io = { .read = read_pin, .arm = arm_pin, .ctx = NULL };
+  button_engine_t engine;
+  now_us = 0;
+  armed = false;
+  button_engine_init(&engine, &config, &io, 0);
+
+  int64_t timer_us = button_engine_next_deadline_us(&engine);
+  uint32_t next_toggle = 0;
+  for (;;) {
+    while (next_toggle < toggle_count && toggles[next_toggle] <= now_us) next_toggle++;
+    int64_t irq_us = INT64_MAX;
+    if (armed) {
+      if (level_at(now_us) == armed_level) {
+        irq_us = now_us;
+      } else if (next_toggle < toggle_count) {
+        irq_us = toggles[next_toggle];
+      }
+    }
+    int64_t wake_us = irq_us < timer_us ? irq_us : timer_us;
+    if (wake_us == INT64_MAX) break;
+    now_us = wake_us;
+    if (irq_us == wake_us) {
+      armed = false;
+      button_engine_irq(&engine, 0, now_us);
+      now_us += TASK_LATENCY_US;
+    }
+
+    button_engine_event_t events[BUTTON_ENGINE_MAX_EVENTS];
+    uint8_t count = button_engine_poll(&engine, now_us, events, BUTTON_ENGINE_MAX_EVENTS);
+    for (uint8_t i = 0; i < count; i++) {
+      input_trace_t trace;
+      input_trace_start(&trace, events[i].origin_us);
+      input_trace_hop(&stats, &trace, INPUT_TRACE_RECOGNIZE, events[i].time_us);
+      input_trace_hop(&stats, &trace, INPUT_TRACE_BUTTON_QUEUE, now_us);
+    }
+    timer_us = button_engine_next_deadline_us(&engine);
+  }
+}
+
+static void test_hops_and_ends(void) {
+  input_trace_t trace;
+  input_trace_start(&trace, 1000);
+  TEST_ASSERT_EQUAL_INT64(1000, trace.stamp_us);
+
+  input_trace_hop(&stats, &trace, INPUT_TRACE_RECOGNIZE, 1500);
+  input_trace_hop(&stats, &trace, INPUT_TRACE_BUTTON_QUEUE, 1700);
+  input_trace_hop(&stats, &trace, INPUT_TRACE_MAIN, 1750);
+  TEST_ASSERT_EQUAL_INT64(1750, trace.stamp_us);
+  TEST_ASSERT_EQUAL_UINT32(500, stats.hops[INPUT_TRACE_RECOGNIZE].max_us);
+  TEST_ASSERT_EQUAL_UINT32(200, stats.hops[INPUT_TRACE_BUTTON_QUEUE].max_us);
+  TEST_ASSERT_EQUAL_UINT32(50, stats.hops[INPUT_TRACE_MAIN].max_us);
+
+  // ujung dihitung dari origin dan tidak menggeser stamp
+  input_trace_end(&stats, &trace, INPUT_TRACE_END_AIR, 9000);
+  TEST_ASSERT_EQUAL_UINT32(8000, stats.hops[INPUT_TRACE_END_AIR].max_us);
+  TEST_ASSERT_EQUAL_INT64(1750, trace.stamp_us);
+  TEST_ASSERT_EQUAL_UINT32(8000, input_trace_percentile(&stats, INPUT_TRACE_END_AIR, 100));
+}
+
+static void test_untraced_message_ignored(void) {
+  input_trace_t trace;
+  input_trace_start(&trace, 0);
+  input_trace_hop(&stats, &trace, INPUT_TRACE_LCD, 5000);
+  input_trace_end(&stats, &trace, INPUT_TRACE_END_LCD, 5000);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.hops[INPUT_TRACE_LCD].count);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.hops[INPUT_TRACE_END_LCD].count);
+  TEST_ASSERT_EQUAL_INT64(0, trace.stamp_us);
+}
+
+static void test_clock_skew_and_clamp(void) {
+  input_trace_t trace;
+  input_trace_start(&trace, 10000);
+  // jam task lain sedikit di belakang: dicatat 0
+  input_trace_hop(&stats, &trace, INPUT_TRACE_COMM, 9990);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.hops[INPUT_TRACE_COMM].count);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.hops[INPUT_TRACE_COMM].max_us);
+
+  input_trace_end(&stats, &trace, INPUT_TRACE_END_LCD, 10000 + (int64_t) UINT32_MAX + 5);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, stats.hops[INPUT_TRACE_END_LCD].max_us);
+}
+
+static void test_invalid_hop(void) {
+  input_trace_t trace;
+  input_trace_start(&trace, 100);
+  input_trace_hop(&stats, &trace, INPUT_TRACE_HOP_COUNT, 200);
+  input_trace_end(&stats, &trace, INPUT_TRACE_HOP_COUNT, 200);
+  TEST_ASSERT_EQUAL_INT64(100, trace.stamp_us);
+  TEST_ASSERT_EQUAL_UINT32(0, input_trace_percentile(&stats, INPUT_TRACE_HOP_COUNT, 50));
+  TEST_ASSERT_EQUAL_STRING("BUTTON_QUEUE", input_trace_hop_name(INPUT_TRACE_BUTTON_QUEUE));
+  TEST_ASSERT_EQUAL_STRING("END_LCD", input_trace_hop_name(INPUT_TRACE_END_LCD));
+  TEST_ASSERT_EQUAL_STRING("UNKNOWN", input_trace_hop_name(INPUT_TRACE_HOP_COUNT));
+}
+
+static void test_click_latency_with_double_click_window(void) {
+  replay_clicks(WINDOW_US);
+  const latency_hist_t* recognize = &stats.hops[INPUT_TRACE_RECOGNIZE];
+  // click baru pasti setelah jendela habis: tahan + 300 ms (commit: p50 393 ms, p99 460 ms)
+  TEST_ASSERT_EQUAL_UINT32(CLICKS, recognize->count);
+  TEST_ASSERT_GREATER_OR_EQUAL(HOLD_MIN_US + WINDOW_US, recognize->min_us);
+  TEST_ASSERT_LESS_OR_EQUAL(HOLD_MIN_US + HOLD_SPAN_US + WINDOW_US, recognize->max_us);
+  TEST_ASSERT_UINT32_WITHIN(HOLD_SPAN_US / 2, HOLD_MIN_US + HOLD_SPAN_US / 2 + WINDOW_US,
+                            input_trace_percentile(&stats, INPUT_TRACE_RECOGNIZE, 50));
+  // tenggat diproses tepat waktu, jadi dikenali -> diambil hanya latency task
+  TEST_ASSERT_LESS_OR_EQUAL(TASK_LATENCY_US, stats.hops[INPUT_TRACE_BUTTON_QUEUE].max_us);
+}
+
+static void test_click_latency_without_window(void) {
+  replay_clicks(0);
+  const latency_hist_t* recognize = &stats.hops[INPUT_TRACE_RECOGNIZE];
+  // click saat dilepas: hanya lama tahan (commit: p50 109 ms, p99 160 ms)
+  TEST_ASSERT_EQUAL_UINT32(CLICKS, recognize->count);
+  TEST_ASSERT_GREATER_OR_EQUAL(HOLD_MIN_US, recognize->min_us);
+  TEST_ASSERT_LESS_OR_EQUAL(HOLD_MIN_US + HOLD_SPAN_US, recognize->max_us);
+  TEST_ASSERT_UINT32_WITHIN(HOLD_SPAN_US / 2, HOLD_MIN_US + HOLD_SPAN_US / 2,
+                            input_trace_percentile(&stats, INPUT_TRACE_RECOGNIZE, 50));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_hops_and_ends);
+  RUN_TEST(test_untraced_message_ignored);
+  RUN_TEST(test_clock_skew_and_clamp);
+  RUN_TEST(test_invalid_hop);
+  RUN_TEST(test_click_latency_with_double_click_window);
+  RUN_TEST(test_click_latency_without_window);
+  return UNITY_END();
+}
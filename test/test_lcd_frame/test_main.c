@@ -0,0 +1,164 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "sub_lcd/lcd_frame.h"
+#include "sub_lcd/lcd_sink_fake.h"
+#include "utils/weight_fmt.h"
+
+#define STREAM_FRAMES 2000
+#define FUZZ_FRAMES   50000
+
+static lcd_frame_t frame;
+static lcd_sink_fake_t fake;
+static lcd_sink_t sink;
+static uint32_t rng_state;
+
+// forward declaration
+static uint32_t next_random(void);
+static void assert_panel_shows(const char* line0, const char* line1);
+
+void setUp(void) {
+  lcd_frame_init(&frame);
+  lcd_sink_fake_init(&fake);
+  sink = lcd_sink_fake(&fake);
+  rng_state = 1;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t next_random(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static void assert_panel_shows(const char* line0, const char* line1) {
+  char visible[LCD_FRAME_COLS + 1];
+  lcd_sink_fake_line(&fake, 0, visible);
+  TEST_ASSERT_EQUAL_STRING(line0, visible);
+  lcd_sink_fake_line(&fake, 1, visible);
+  TEST_ASSERT_EQUAL_STRING(line1, visible);
+}
+
+static void test_first_flush_draws_everything(void) {
+  lcd_frame_set_line(&frame, 0, "CAL: EMPTY PAN");
+  lcd_frame_set_line(&frame, 1, "A=OK AB=CANCEL");
+  // 32 sel + satu set_cursor per baris
+  TEST_ASSERT_EQUAL_UINT16(34, lcd_frame_flush(&frame, &sink));
+  assert_panel_shows("CAL: EMPTY PAN  ", "A=OK AB=CANCEL  ");
+
+  TEST_ASSERT_EQUAL_UINT16(0, lcd_frame_flush(&frame, &sink));
+  TEST_ASSERT_EQUAL_UINT32(1, frame.stats.unchanged);
+}
+
+static void test_only_changed_run_sent(void) {
+  lcd_frame_set_line(&frame, 0, "        123.45 g");
+  lcd_frame_flush(&frame, &sink);
+  lcd_sink_fake_reset_stats(&fake);
+
+  lcd_frame_set_line(&frame, 0, "        123.47 g");
+  TEST_ASSERT_EQUAL_UINT16(2, lcd_frame_flush(&frame, &sink));
+  TEST_ASSERT_EQUAL_UINT32(1, fake.stats.chars);
+  TEST_ASSERT_EQUAL_UINT32(1, fake.stats.commands);
+  assert_panel_shows("        123.47 g", "                ");
+}
+
+static void test_one_cell_gap_is_rewritten(void) {
+  lcd_frame_set_line(&frame, 0, "0000000000000000");
+  lcd_frame_flush(&frame, &sink);
+  lcd_sink_fake_reset_stats(&fake);
+
+  // sel 3 dan 5 berubah: tulis 3..5 (1 byte celah) lebih murah dari pindah cursor lagi
+  lcd_frame_write(&frame, 3, 0, "1");
+  lcd_frame_write(&frame, 5, 0, "1");
+  TEST_ASSERT_EQUAL_UINT16(4, lcd_frame_flush(&frame, &sink));
+  TEST_ASSERT_EQUAL_UINT32(1, fake.stats.commands);
+  TEST_ASSERT_EQUAL_UINT32(3, fake.stats.chars);
+
+  // celah dua sel: dua run terpisah
+  lcd_sink_fake_reset_stats(&fake);
+  lcd_frame_write(&frame, 8, 0, "2");
+  lcd_frame_write(&frame, 11, 0, "2");
+  TEST_ASSERT_EQUAL_UINT16(4, lcd_frame_flush(&frame, &sink));
+  TEST_ASSERT_EQUAL_UINT32(2, fake.stats.commands);
+  assert_panel_shows("0001010020020000", "                ");
+}
+
+static void test_invalidate_forces_redraw(void) {
+  lcd_frame_set_line(&frame, 0, "HELLO");
+  lcd_frame_flush(&frame, &sink);
+  lcd_frame_invalidate(&frame);
+  TEST_ASSERT_EQUAL_UINT16(34, lcd_frame_flush(&frame, &sink));
+}
+
+static void test_write_clips_at_row_end(void) {
+  lcd_frame_write(&frame, 14, 1, "ABCDEF");
+  lcd_frame_write(&frame, LCD_FRAME_COLS, 0, "X");
+  lcd_frame_write(&frame, 0, LCD_FRAME_ROWS, "X");
+  lcd_frame_flush(&frame, &sink);
+  assert_panel_shows("                ", "              AB");
+}
+
+static void test_weight_stream_cost(void) {
+  // layar berat: berat naik turun + noise, baris 2 raw HX711. Render lama menulis ulang dua baris
+  // penuh (50 byte / frame) dan baris 2-nya malah jatuh di luar layar.
+  float grams = 0.0f;
+  for (int i = 0; i < STREAM_FRAMES; i++) {
+    if (i % 400 == 100) grams = 250.0f + (float) (next_random() % 1000) / 10.0f;
+    if (i % 400 == 300) grams = 0.0f;
+    float shown = grams + (float) ((int) (next_random() % 7) - 3) * 0.01f;
+
+    char line0[WEIGHT_FMT_LINE_SIZE];
+    char line1[WEIGHT_FMT_LINE_SIZE];
+    weight_fmt_weight(line0, sizeof(line0), weight_fmt_from_units(shown), WEIGHT_UNIT_GRAM, 16, true);
+    size_t n = weight_fmt_text(line1, sizeof(line1), "RAW", 0);
+    weight_fmt_int(line1 + n, sizeof(line1) - n, (int32_t) (84000 + shown * 420 + next_random() % 40),
+                   (uint8_t) (16 - n));
+
+    lcd_frame_set_line(&frame, 0, line0);
+    lcd_frame_set_line(&frame, 1, line1);
+    lcd_frame_flush(&frame, &sink);
+    assert_panel_shows(line0, line1);
+  }
+  // rata-rata di bawah 8 byte LCD per frame
+  TEST_ASSERT_LESS_THAN(8 * STREAM_FRAMES, fake.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT64((uint64_t) fake.stats.bytes * LCD_SINK_FAKE_I2C_PER_BYTE, fake.stats.i2c_writes);
+}
+
+static void test_random_edits_stay_in_sync(void) {
+  static const char alphabet[] = "0123456789 .-g";
+  for (int i = 0; i < FUZZ_FRAMES; i++) {
+    char lines[LCD_FRAME_ROWS][LCD_FRAME_COLS + 1];
+    for (int row = 0; row < LCD_FRAME_ROWS; row++) {
+      memcpy(lines[row], frame.next[row], LCD_FRAME_COLS);
+      lines[row][LCD_FRAME_COLS] = '\0';
+      for (int k = next_random() % 5; k > 0; k--) {
+        lines[row][next_random() % LCD_FRAME_COLS] = alphabet[next_random() % (sizeof(alphabet) - 1)];
+      }
+      lcd_frame_set_line(&frame, (uint8_t) row, lines[row]);
+    }
+    lcd_frame_flush(&frame, &sink);
+    assert_panel_shows(lines[0], lines[1]);
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_flush_draws_everything);
+  RUN_TEST(test_only_changed_run_sent);
+  RUN_TEST(test_one_cell_gap_is_rewritten);
+  RUN_TEST(test_invalidate_forces_redraw);
+  RUN_TEST(test_write_clips_at_row_end);
+  RUN_TEST(test_weight_stream_cost);
+  RUN_TEST(test_random_edits_stay_in_sync);
+  return UNITY_END();
+}
@@ -0,0 +1,334 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "drivers/hd44780_pcf8574.h"
+#include "drivers/hd44780_emu.h"
+#include "drivers/lcd_glyph.h"
+#include "sub_lcd/lcd_frame.h"
+#include "utils/weight_fmt.h"
+
+#define LCD_ADDRESS  0x27
+#define LCD_COLS     16
+#define RAMP_FRAMES  6000
+#define RAMP_STEP_G  0.37f
+#define VIEW_FRAMES  500
+
+typedef enum {
+  VIEW_BIG = 1,
+  VIEW_BAR,
+  VIEW_SWITCHING,
+} view_t;
+
+typedef struct {
+  uint32_t max_uploads; // upload terbanyak dalam satu frame
+  uint32_t mismatches;  // sel layar yang beda dari frame, atau glyph yang beda dari CGRAM
+} ramp_result_t;
+
+static hd44780_emu_t emu;
+static lcd_glyph_cache_t cache;
+static lcd_frame_t frame;
+static uint8_t pending[HD44780_BYTES_PER_CHAR];
+static size_t pending_len;
+static uint8_t ddram_address;
+static uint8_t last_slot;
+static const uint8_t* last_rows;
+
+// forward declaration
+static void send(const uint8_t* data, size_t len);
+static void emu_set_cursor(void* self, uint8_t col, uint8_t row);
+static void emu_write(void* self, const char* data, uint8_t len);
+static void emu_upload(void* ctx, uint8_t slot, const uint8_t* rows);
+static void record_upload(void* ctx, uint8_t slot, const uint8_t* rows);
+static void init_emu(void);
+static uint32_t verify_screen(const char* top, const char* bottom);
+static ramp_result_t run_ramp(view_t view);
+
+static const lcd_sink_ops_t emu_ops = {
+  .set_cursor = emu_set_cursor,
+  .write = emu_write,
+  .name = "emu",
+};
+
+void setUp(void) {
+  lcd_glyph_init(&cache, record_upload, NULL);
+  last_slot = 0xFF;
+  last_rows = NULL;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void send(const uint8_t* data, size_t len) {
+  TEST_ASSERT_TRUE(hd44780_emu_i2c_write(&emu, LCD_ADDRESS, data, len));
+}
+
+// salinan host lcd_driver.c: set_cursor ditahan, posisi DDRAM dilacak untuk dipulihkan setelah upload
+static void emu_set_cursor(void* self, uint8_t col, uint8_t row) {
+  pending_len = hd44780_encode_set_cursor(pending, sizeof(pending), col, row, true);
+  ddram_address = hd44780_ddram_address(col, row);
+}
+
+static void emu_write(void* self, const char* data, uint8_t len) {
+  uint8_t buf[HD44780_RUN_BYTES(LCD_FRAME_COLS)];
+  size_t n = pending_len;
+  memcpy(buf, pending, n);
+  pending_len = 0;
+  n += hd44780_encode_data(buf + n, sizeof(buf) - n, (const uint8_t*) data, len, true);
+  send(buf, n);
+  ddram_address = (uint8_t) (ddram_address + len);
+}
+
+static void emu_upload(void* ctx, uint8_t slot, const uint8_t* rows) {
+  uint8_t buf[HD44780_CGRAM_BYTES];
+  size_t n = hd44780_encode_cgram(buf, sizeof(buf), slot, rows, true);
+  if (pending_len > 0) {
+    memcpy(buf + n, pending, pending_len);
+    n += pending_len;
+    pending_len = 0;
+  } else {
+    n += hd44780_encode_command(buf + n, sizeof(buf) - n, HD44780_SET_DDRAM | ddram_address, true);
+  }
+  send(buf, n);
+}
+
+static void record_upload(void* ctx, uint8_t slot, const uint8_t* rows) {
+  last_slot = slot;
+  last_rows = rows;
+}
+
+static void init_emu(void) {
+  hd44780_emu_init(&emu, LCD_ADDRESS);
+  pending_len = 0;
+  ddram_address = 0;
+  uint8_t buf[HD44780_BYTES_PER_CHAR];
+  for (int i = 0; i < 3; i++) send(buf, hd44780_encode_nibble(buf, sizeof(buf), 0x3, true));
+  send(buf, hd44780_encode_nibble(buf, sizeof(buf), 0x2, true));
+  static const uint8_t commands[] = {
+    HD44780_FUNCTION_SET | HD44780_FUNCTION_2LINE,
+    HD44780_DISPLAY_CTRL | HD44780_DISPLAY_ON,
+    HD44780_CLEAR,
+    HD44780_ENTRY_MODE | HD44780_ENTRY_INC,
+  };
+  for (size_t i = 0; i < sizeof(commands); i++) send(buf, hd44780_encode_command(buf, sizeof(buf), commands[i], true));
+  hd44780_emu_reset_stats(&emu);
+  lcd_frame_init(&frame);
+  lcd_glyph_init(&cache, emu_upload, NULL);
+}
+
+static uint32_t verify_screen(const char* top, const char* bottom) {
+  // setiap sel sama dengan frame, dan setiap sel glyph menunjuk CGRAM yang berisi bitmap yang benar
+  uint32_t mismatches = 0;
+  const char* expected[2] = { top, bottom };
+  char visible[LCD_COLS + 1];
+  for (uint8_t row = 0; row < 2; row++) {
+    hd44780_emu_line(&emu, row, LCD_COLS, visible);
+    for (uint8_t col = 0; col < LCD_COLS; col++) {
+      uint8_t code = (uint8_t) visible[col];
+      if (code != (uint8_t) expected[row][col]) {
+        mismatches++;
+        continue;
+      }
+      if (code < LCD_GLYPH_CODE_BASE || code >= LCD_GLYPH_CODE_BASE + HD44780_CGRAM_SLOTS) continue;
+      uint8_t slot = (uint8_t) (code - LCD_GLYPH_CODE_BASE);
+      const uint8_t* bitmap = lcd_glyph_bitmap((lcd_glyph_id_t) cache.slot_glyph[slot]);
+      if (bitmap == NULL || memcmp(&emu.cgram[slot * HD44780_GLYPH_ROWS], bitmap, HD44780_GLYPH_ROWS) != 0) {
+        mismatches++;
+      }
+    }
+  }
+  return mismatches;
+}
+
+static ramp_result_t run_ramp(view_t view) {
+  // skenario commit: berat naik 0..2220 g step 0.37 g, 6000 frame lewat emulator
+  ramp_result_t result = { 0 };
+  init_emu();
+  for (int i = 0; i < RAMP_FRAMES; i++) {
+    float grams = (float) i * RAMP_STEP_G;
+    char text[LCD_COLS + 1], top[LCD_COLS + 1], bottom[LCD_COLS + 1];
+    weight_fmt_weight(text, sizeof(text), weight_fmt_from_units(grams), WEIGHT_UNIT_GRAM, LCD_COLS, true);
+
+    uint32_t uploads = cache.stats.uploads;
+    lcd_glyph_begin_frame(&cache);
+    view_t shown = view == VIEW_SWITCHING ? ((i / VIEW_FRAMES) % 2 ? VIEW_BAR : VIEW_BIG) : view;
+    if (shown == VIEW_BIG) {
+      lcd_glyph_big_text(&cache, text, top, bottom, LCD_COLS);
+    } else {
+      memcpy(top, text, sizeof(top));
+      lcd_glyph_bar(&cache, bottom, LCD_COLS, (uint16_t) (grams > 1000.0f ? 1000.0f : grams));
+    }
+    lcd_frame_set_line(&frame, 0, top);
+    lcd_frame_set_line(&frame, 1, bottom);
+    lcd_frame_flush(&frame, &(lcd_sink_t) { &emu_ops, NULL });
+
+    result.mismatches += verify_screen(top, bottom);
+    uploads = cache.stats.uploads - uploads;
+    if (uploads > result.max_uploads) result.max_uploads = uploads;
+  }
+  return result;
+}
+
+static void test_upload_once_then_hit(void) {
+  lcd_glyph_begin_frame(&cache);
+  char code = lcd_glyph_code(&cache, LCD_GLYPH_BAR_3, '|');
+  TEST_ASSERT_EQUAL_INT(LCD_GLYPH_CODE_BASE + 0, code);
+  TEST_ASSERT_EQUAL_UINT8(0, last_slot);
+  TEST_ASSERT_EQUAL_MEMORY(lcd_glyph_bitmap(LCD_GLYPH_BAR_3), last_rows, HD44780_GLYPH_ROWS);
+
+  last_rows = NULL;
+  lcd_glyph_begin_frame(&cache);
+  TEST_ASSERT_EQUAL_INT(code, lcd_glyph_code(&cache, LCD_GLYPH_BAR_3, '|'));
+  TEST_ASSERT_NULL(last_rows);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats.uploads);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats.hits);
+  TEST_ASSERT_EQUAL_UINT32(2, cache.stats.frames);
+}
+
+static void test_lru_eviction(void) {
+  lcd_glyph_begin_frame(&cache);
+  for (int id = 0; id < HD44780_CGRAM_SLOTS; id++) lcd_glyph_code(&cache, (lcd_glyph_id_t) id, '?');
+
+  // frame berikutnya memakai semua kecuali glyph 0 dan 1, lalu glyph 1 dipakai sekali lagi
+  lcd_glyph_begin_frame(&cache);
+  for (int id = 2; id < HD44780_CGRAM_SLOTS; id++) lcd_glyph_code(&cache, (lcd_glyph_id_t) id, '?');
+  lcd_glyph_begin_frame(&cache);
+  lcd_glyph_code(&cache, (lcd_glyph_id_t) 1, '?');
+
+  // glyph 0 yang paling lama tidak dipakai
+  char code = lcd_glyph_code(&cache, LCD_GLYPH_BOTTOM_GECD, '?');
+  TEST_ASSERT_EQUAL_INT(LCD_GLYPH_CODE_BASE + 0, code);
+  TEST_ASSERT_EQUAL_INT8(LCD_GLYPH_BOTTOM_GECD, cache.slot_glyph[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats.evictions);
+  TEST_ASSERT_EQUAL_UINT32(HD44780_CGRAM_SLOTS + 1, cache.stats.uploads);
+}
+
+static void test_frame_never_evicts_own_glyphs(void) {
+  lcd_glyph_begin_frame(&cache);
+  for (int id = 0; id < HD44780_CGRAM_SLOTS; id++) lcd_glyph_code(&cache, (lcd_glyph_id_t) id, '?');
+  TEST_ASSERT_EQUAL_INT('?', lcd_glyph_code(&cache, (lcd_glyph_id_t) HD44780_CGRAM_SLOTS, '?'));
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats.fallbacks);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats.evictions);
+
+  TEST_ASSERT_EQUAL_INT('#', lcd_glyph_code(&cache, LCD_GLYPH_COUNT, '#'));
+  TEST_ASSERT_NULL(lcd_glyph_bitmap(LCD_GLYPH_COUNT));
+}
+
+static void test_bar(void) {
+  char out[LCD_COLS + 1];
+  char full[LCD_COLS + 1];
+  memset(full, LCD_GLYPH_FULL, LCD_COLS);
+  full[LCD_COLS] = '\0';
+
+  lcd_glyph_begin_frame(&cache);
+  lcd_glyph_bar(&cache, out, LCD_COLS, 0);
+  TEST_ASSERT_EQUAL_STRING("                ", out);
+  lcd_glyph_bar(&cache, out, LCD_COLS, 1000);
+  TEST_ASSERT_EQUAL_STRING(full, out);
+  lcd_glyph_bar(&cache, out, LCD_COLS, 60000);
+  TEST_ASSERT_EQUAL_STRING(full, out);
+  // 80 langkah: 500 permille = tepat 8 sel penuh, tanpa glyph
+  lcd_glyph_bar(&cache, out, LCD_COLS, 500);
+  TEST_ASSERT_EQUAL_MEMORY(full, out, 8);
+  TEST_ASSERT_EQUAL_STRING("        ", out + 8);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats.uploads);
+
+  // 41 langkah: sel ke-9 memakai glyph 1/5
+  lcd_glyph_bar(&cache, out, LCD_COLS, 520);
+  TEST_ASSERT_EQUAL_INT(LCD_GLYPH_CODE_BASE, out[8]);
+  TEST_ASSERT_EQUAL_INT8(LCD_GLYPH_BAR_1, cache.slot_glyph[0]);
+  TEST_ASSERT_EQUAL_STRING("       ", out + 9);
+  TEST_ASSERT_EQUAL_size_t(LCD_COLS, strlen(out));
+}
+
+static void test_big_text(void) {
+  char top[LCD_COLS + 1], bottom[LCD_COLS + 1];
+  lcd_glyph_begin_frame(&cache);
+  lcd_glyph_big_text(&cache, "-10.5 g", top, bottom, LCD_COLS);
+
+  // '-' di atas, titik dan satuan di bawah, angka jadi dua setengah glyph
+  TEST_ASSERT_EQUAL_INT('-', top[0]);
+  TEST_ASSERT_EQUAL_INT(' ', bottom[0]);
+  TEST_ASSERT_EQUAL_INT('.', bottom[3]);
+  TEST_ASSERT_EQUAL_INT('g', bottom[6]);
+  static const uint8_t cols[] = { 1, 2, 4 };
+  static const lcd_glyph_id_t halves[][2] = {
+    { LCD_GLYPH_RIGHT, LCD_GLYPH_RIGHT },
+    { LCD_GLYPH_TOP_AFB, LCD_GLYPH_SIDES },
+    { LCD_GLYPH_TOP_AF, LCD_GLYPH_BOTTOM_GCD },
+  };
+  for (int i = 0; i < 3; i++) {
+    uint8_t upper = (uint8_t) (top[cols[i]] - LCD_GLYPH_CODE_BASE);
+    uint8_t lower = (uint8_t) (bottom[cols[i]] - LCD_GLYPH_CODE_BASE);
+    TEST_ASSERT_LESS_THAN(HD44780_CGRAM_SLOTS, upper);
+    TEST_ASSERT_LESS_THAN(HD44780_CGRAM_SLOTS, lower);
+    TEST_ASSERT_EQUAL_INT8(halves[i][0], cache.slot_glyph[upper]);
+    TEST_ASSERT_EQUAL_INT8(halves[i][1], cache.slot_glyph[lower]);
+  }
+  TEST_ASSERT_EQUAL_size_t(LCD_COLS, strlen(top));
+  TEST_ASSERT_EQUAL_size_t(LCD_COLS, strlen(bottom));
+}
+
+static void test_big_text_falls_back_to_ascii(void) {
+  // 8 slot sudah dipakai frame ini oleh glyph yang tidak dibutuhkan angka 8
+  static const lcd_glyph_id_t used[] = {
+    LCD_GLYPH_BAR_1, LCD_GLYPH_BAR_2, LCD_GLYPH_BAR_3, LCD_GLYPH_BAR_4,
+    LCD_GLYPH_TOP_AB, LCD_GLYPH_TOP_AF, LCD_GLYPH_SIDES, LCD_GLYPH_RIGHT,
+  };
+  lcd_glyph_begin_frame(&cache);
+  for (size_t i = 0; i < sizeof(used) / sizeof(used[0]); i++) lcd_glyph_code(&cache, used[i], '?');
+
+  char top[4], bottom[4];
+  lcd_glyph_big_text(&cache, "8 g", top, bottom, 3);
+  TEST_ASSERT_EQUAL_STRING("   ", top);
+  TEST_ASSERT_EQUAL_STRING("8 g", bottom);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats.fallbacks);
+}
+
+static void test_big_ramp_on_emulator(void) {
+  ramp_result_t result = run_ramp(VIEW_BIG);
+  TEST_ASSERT_EQUAL_UINT32(0, result.mismatches);
+  // semua digit cukup 8 glyph: tanpa cache 11 upload per frame (65996 total)
+  TEST_ASSERT_EQUAL_UINT32(8, cache.stats.uploads);
+  TEST_ASSERT_EQUAL_UINT32(65996, cache.stats.uploads + cache.stats.hits);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats.evictions);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats.fallbacks);
+  TEST_ASSERT_LESS_THAN(27ULL * RAMP_FRAMES, emu.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+static void test_bar_ramp_on_emulator(void) {
+  ramp_result_t result = run_ramp(VIEW_BAR);
+  TEST_ASSERT_EQUAL_UINT32(0, result.mismatches);
+  TEST_ASSERT_EQUAL_UINT32(4, cache.stats.uploads);
+  TEST_ASSERT_EQUAL_UINT32(1, result.max_uploads);
+  TEST_ASSERT_LESS_THAN(16ULL * RAMP_FRAMES, emu.stats.bytes);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+static void test_switching_views_on_emulator(void) {
+  ramp_result_t result = run_ramp(VIEW_SWITCHING);
+  TEST_ASSERT_EQUAL_UINT32(0, result.mismatches);
+  TEST_ASSERT_EQUAL_UINT32(40, cache.stats.uploads);
+  TEST_ASSERT_EQUAL_UINT32(5, result.max_uploads);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats.fallbacks);
+  TEST_ASSERT_EQUAL_UINT32(0, emu.stats.protocol_errors);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_upload_once_then_hit);
+  RUN_TEST(test_lru_eviction);
+  RUN_TEST(test_frame_never_evicts_own_glyphs);
+  RUN_TEST(test_bar);
+  RUN_TEST(test_big_text);
+  RUN_TEST(test_big_text_falls_back_to_ascii);
+  RUN_TEST(test_big_ramp_on_emulator);
+  RUN_TEST(test_bar_ramp_on_emulator);
+  RUN_TEST(test_switching_views_on_emulator);
+  return UNITY_END();
+}
@@ -0,0 +1,228 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#include "sub_lcd/lcd_mailbox.h"
+#include "utils/latency_hist.h"
+
+#define STRESS_POSTS     200000
+#define STALENESS_TICKS  100000
+#define POST_INTERVAL_US 10000
+#define RENDER_US        2200
+
+static lcd_mailbox_t mailbox;
+static atomic_bool writer_done;
+static atomic_bool reader_ready;
+static uint32_t torn_frames;
+static uint32_t reader_frames;
+
+// forward declaration
+static void make_frame(led_data_t* data, char fill, lcd_state_t state);
+static bool frame_consistent(const led_data_t* data);
+static void* stress_writer(void* arg);
+static void* stress_reader(void* arg);
+
+void setUp(void) {
+  lcd_mailbox_init(&mailbox);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void make_frame(led_data_t* data, char fill, lcd_state_t state) {
+  // isi yang saling terkait, jadi salinan robek langsung terlihat
+  memset(data, 0, sizeof(*data));
+  memset(data->line_1, fill, 16);
+  memset(data->line_2, fill, 16);
+  data->cursor_row = (uint8_t) fill;
+  data->cursor_col = (uint8_t) ~fill;
+  data->lcd_state = state;
+}
+
+static bool frame_consistent(const led_data_t* data) {
+  char fill = data->line_1[0];
+  // ~ mempromosikan ke int: potong dulu ke uint8_t supaya perbandingan tetap unsigned
+  uint8_t expected_col = (uint8_t) ~fill;
+  for (int i = 0; i < 16; i++) {
+    if (data->line_1[i] != fill || data->line_2[i] != fill) return false;
+  }
+  return data->line_1[16] == '\0' && data->line_2[16] == '\0'
+         && data->cursor_row == (uint8_t) fill && data->cursor_col == expected_col;
+}
+
+static void* stress_writer(void* arg) {
+  while (!atomic_load(&reader_ready)) sched_yield();
+  led_data_t data;
+  for (uint32_t i = 1; i <= STRESS_POSTS; i++) {
+    make_frame(&data, (char) ('A' + i % 26), (lcd_state_t) (i % 9));
+    if ((i & 63) == 0) sched_yield();
+    lcd_mailbox_post(&mailbox, &data, (int64_t) i);
+  }
+  atomic_store(&writer_done, true);
+  return NULL;
+}
+
+static void* stress_reader(void* arg) {
+  led_data_t data;
+  int64_t posted;
+  atomic_store(&reader_ready, true);
+  while (!atomic_load(&writer_done)) {
+    if (!lcd_mailbox_take(&mailbox, &data, &posted)) continue;
+    reader_frames++;
+    if (!frame_consistent(&data)) torn_frames++;
+  }
+  return NULL;
+}
+
+static void test_empty_take(void) {
+  led_data_t out;
+  TEST_ASSERT_FALSE(lcd_mailbox_take(&mailbox, &out, NULL));
+  TEST_ASSERT_EQUAL_UINT32(0, mailbox.stats.takes);
+  TEST_ASSERT_EQUAL_UINT32(0, mailbox.stats.gave_up);
+}
+
+static void test_post_take(void) {
+  led_data_t in, out;
+  make_frame(&in, 'W', LCD_NORMAL);
+  in.overlay_ms = 1500;
+  lcd_mailbox_post(&mailbox, &in, 12345);
+
+  int64_t posted = 0;
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, &posted));
+  TEST_ASSERT_EQUAL_MEMORY(&in, &out, sizeof(in));
+  TEST_ASSERT_EQUAL_INT64(12345, posted);
+
+  // frame yang sama tidak diambil dua kali
+  TEST_ASSERT_FALSE(lcd_mailbox_take(&mailbox, &out, &posted));
+  TEST_ASSERT_EQUAL_UINT32(1, mailbox.stats.posts);
+  TEST_ASSERT_EQUAL_UINT32(1, mailbox.stats.takes);
+  TEST_ASSERT_EQUAL_UINT32(0, mailbox.stats.overwritten);
+}
+
+static void test_latest_wins(void) {
+  led_data_t in, out;
+  make_frame(&in, '1', LCD_NORMAL);
+  lcd_mailbox_post(&mailbox, &in, 100);
+  make_frame(&in, '2', LCD_NORMAL);
+  lcd_mailbox_post(&mailbox, &in, 200);
+  make_frame(&in, '3', LCD_NORMAL);
+  lcd_mailbox_post(&mailbox, &in, 300);
+
+  int64_t posted;
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, &posted));
+  TEST_ASSERT_EQUAL_INT8('3', out.line_1[0]);
+  TEST_ASSERT_EQUAL_INT64(300, posted);
+  TEST_ASSERT_EQUAL_UINT32(2, mailbox.stats.overwritten);
+
+  // post setelah take bukan overwrite
+  make_frame(&in, '4', LCD_NORMAL);
+  lcd_mailbox_post(&mailbox, &in, 400);
+  TEST_ASSERT_EQUAL_UINT32(2, mailbox.stats.overwritten);
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, NULL));
+  TEST_ASSERT_EQUAL_INT8('4', out.line_1[0]);
+}
+
+static void test_take_terminates_lines(void) {
+  led_data_t in, out;
+  memset(&in, 'x', sizeof(in));
+  lcd_mailbox_post(&mailbox, &in, 0);
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, NULL));
+  TEST_ASSERT_EQUAL_INT8('\0', out.line_1[LED_DATA_LINE_SIZE - 1]);
+  TEST_ASSERT_EQUAL_INT8('\0', out.line_2[LED_DATA_LINE_SIZE - 1]);
+  TEST_ASSERT_EQUAL_INT8('x', out.line_1[LED_DATA_LINE_SIZE - 2]);
+}
+
+static void test_gives_up_on_preempted_writer(void) {
+  led_data_t in, out;
+  make_frame(&in, 'P', LCD_NORMAL);
+  lcd_mailbox_post(&mailbox, &in, 0);
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, NULL));
+
+  // writer ter-preempt di tengah tulis: seq ganjil
+  unsigned seq = atomic_load(&mailbox.seq);
+  atomic_store(&mailbox.seq, seq + 1);
+  TEST_ASSERT_FALSE(lcd_mailbox_take(&mailbox, &out, NULL));
+  TEST_ASSERT_EQUAL_UINT32(LCD_MAILBOX_MAX_RETRIES, mailbox.stats.retries);
+  TEST_ASSERT_EQUAL_UINT32(1, mailbox.stats.gave_up);
+
+  // writer selesai: bangun berikutnya mengambil frame
+  memset(mailbox.data.line_1, 'Q', 16);
+  atomic_store(&mailbox.seq, seq + 2);
+  TEST_ASSERT_TRUE(lcd_mailbox_take(&mailbox, &out, NULL));
+  TEST_ASSERT_EQUAL_INT8('Q', out.line_1[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, mailbox.stats.takes);
+}
+
+static void test_staleness_virtual_clock(void) {
+  // skenario commit: post tiap 10 ms, burst 4 perubahan tiap 500 ms, reader bangun per post, render 2.2 ms
+  latency_hist_t hist;
+  latency_hist_reset(&hist);
+  led_data_t data, out;
+  make_frame(&data, 'S', LCD_NORMAL);
+  int64_t now = 0, render_free = 0, posted;
+
+  for (int i = 0; i < STALENESS_TICKS; i++) {
+    now += POST_INTERVAL_US;
+    int burst = (i % 50 == 0) ? 4 : 1;
+    for (int k = 0; k < burst; k++) lcd_mailbox_post(&mailbox, &data, now + k * 50);
+    int64_t start = now + burst * 50 > render_free ? now + burst * 50 : render_free;
+    if (lcd_mailbox_take(&mailbox, &out, &posted)) {
+      render_free = start + RENDER_US;
+      latency_hist_record(&hist, (uint32_t) (render_free - posted));
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(STALENESS_TICKS, hist.count);
+  TEST_ASSERT_EQUAL_UINT32(2250, hist.max_us);
+  TEST_ASSERT_LESS_OR_EQUAL(2250, latency_hist_percentile(&hist, 50));
+  TEST_ASSERT_LESS_OR_EQUAL(2250, latency_hist_percentile(&hist, 99));
+  // hanya frame di dalam burst yang ditimpa
+  TEST_ASSERT_EQUAL_UINT32(STALENESS_TICKS + 3 * STALENESS_TICKS / 50, mailbox.stats.posts);
+  TEST_ASSERT_EQUAL_UINT32(3 * STALENESS_TICKS / 50, mailbox.stats.overwritten);
+}
+
+static void test_stress_no_torn_frames(void) {
+  atomic_store(&writer_done, false);
+  atomic_store(&reader_ready, false);
+  torn_frames = 0;
+  reader_frames = 0;
+
+  pthread_t writer, reader;
+  pthread_create(&reader, NULL, stress_reader, NULL);
+  pthread_create(&writer, NULL, stress_writer, NULL);
+  pthread_join(writer, NULL);
+  pthread_join(reader, NULL);
+
+  // frame terakhir yang belum sempat diambil reader
+  led_data_t out;
+  if (lcd_mailbox_take(&mailbox, &out, NULL)) {
+    reader_frames++;
+    TEST_ASSERT_TRUE(frame_consistent(&out));
+    TEST_ASSERT_EQUAL_INT8((char) ('A' + STRESS_POSTS % 26), out.line_1[0]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn_frames);
+  TEST_ASSERT_GREATER_THAN(0, reader_frames);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_POSTS, mailbox.stats.posts);
+  TEST_ASSERT_EQUAL_UINT32(reader_frames, mailbox.stats.takes);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_POSTS - mailbox.stats.takes, mailbox.stats.overwritten);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_take);
+  RUN_TEST(test_post_take);
+  RUN_TEST(test_latest_wins);
+  RUN_TEST(test_take_terminates_lines);
+  RUN_TEST(test_gives_up_on_preempted_writer);
+  RUN_TEST(test_staleness_virtual_clock);
+  RUN_TEST(test_stress_no_torn_frames);
+  return UNITY_END();
+}
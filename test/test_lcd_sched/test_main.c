@@ -0,0 +1,236 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sub_lcd/lcd_sched.h"
+
+#define RENDER_US        2200
+#define WEIGHT_PERIOD_US 12500 // 80 Hz
+#define SIM_STEP_US      100
+#define SIM_END_US       10000000
+#define OVERLAY_AT_US    3000300
+#define STATE_AT_US      6000700
+
+static lcd_sched_t sched;
+
+// simulasi lcd_task: render memakan RENDER_US, scheduler hanya dipanggil saat bus bebas
+static int64_t render_free_us;
+static int64_t busy_us;
+static int64_t first_cal_post_us;
+static int64_t state_latency_us;
+static int64_t overlay_latency_us;
+static int64_t revert_after_us;
+
+// forward declaration
+static led_data_t base_frame(lcd_state_t state, const char* text);
+static led_data_t overlay_frame(uint16_t overlay_ms, const char* text);
+static void pump(int64_t now_us);
+
+void setUp(void) {
+  lcd_sched_init(&sched, NULL);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static led_data_t base_frame(lcd_state_t state, const char* text) {
+  led_data_t data;
+  memset(&data, 0, sizeof(data));
+  data.lcd_state = state;
+  snprintf(data.line_1, sizeof(data.line_1), "%s", text);
+  return data;
+}
+
+static led_data_t overlay_frame(uint16_t overlay_ms, const char* text) {
+  led_data_t data = base_frame(LCD_TARE, text);
+  data.overlay_ms = overlay_ms;
+  return data;
+}
+
+static void pump(int64_t now_us) {
+  led_data_t out;
+  int64_t post_us;
+  uint32_t wait_us;
+  while (render_free_us <= now_us && lcd_sched_next(&sched, now_us, &out, &post_us, &wait_us)) {
+    if (out.lcd_state == LCD_CALIBRATION && state_latency_us < 0) state_latency_us = now_us - first_cal_post_us;
+    if (out.overlay_ms > 0 && overlay_latency_us < 0) overlay_latency_us = now_us - OVERLAY_AT_US;
+    if (overlay_latency_us >= 0 && out.overlay_ms == 0 && revert_after_us < 0 && out.lcd_state == LCD_NORMAL) {
+      revert_after_us = now_us - OVERLAY_AT_US;
+    }
+    render_free_us = now_us + RENDER_US;
+    busy_us += RENDER_US;
+    now_us = render_free_us;
+  }
+}
+
+static void test_first_frame_is_urgent(void) {
+  led_data_t in = base_frame(LCD_NORMAL, "0.00 g"), out;
+  uint32_t wait_us = 0;
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 0, &out, NULL, &wait_us));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, wait_us);
+
+  lcd_sched_submit(&sched, &in, 5);
+  int64_t post_us = 0;
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 10, &out, &post_us, &wait_us));
+  TEST_ASSERT_EQUAL_STRING("0.00 g", out.line_1);
+  TEST_ASSERT_EQUAL_INT64(5, post_us);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.urgent);
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 20, &out, NULL, &wait_us));
+}
+
+static void test_refresh_is_capped(void) {
+  led_data_t in = base_frame(LCD_NORMAL, "1"), out;
+  lcd_sched_submit(&sched, &in, 0);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 0, &out, NULL, NULL));
+
+  in = base_frame(LCD_NORMAL, "2");
+  lcd_sched_submit(&sched, &in, 30000);
+  in = base_frame(LCD_NORMAL, "3");
+  lcd_sched_submit(&sched, &in, 40000);
+  uint32_t wait_us;
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 40000, &out, NULL, &wait_us));
+  TEST_ASSERT_EQUAL_UINT32(LCD_SCHED_MIN_INTERVAL_US - 40000, wait_us);
+
+  // frame terbaru yang dirender, frame di antaranya digabung
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, LCD_SCHED_MIN_INTERVAL_US, &out, NULL, NULL));
+  TEST_ASSERT_EQUAL_STRING("3", out.line_1);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.coalesced);
+  TEST_ASSERT_EQUAL_UINT32(2, sched.stats.rendered);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.urgent);
+}
+
+static void test_custom_interval(void) {
+  lcd_sched_config_t config = { .min_interval_us = 50000 };
+  lcd_sched_init(&sched, &config);
+  led_data_t in = base_frame(LCD_NORMAL, "a"), out;
+  lcd_sched_submit(&sched, &in, 0);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 0, &out, NULL, NULL));
+  lcd_sched_submit(&sched, &in, 10);
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 49999, &out, NULL, NULL));
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 50000, &out, NULL, NULL));
+}
+
+static void test_state_change_skips_cap(void) {
+  led_data_t in = base_frame(LCD_NORMAL, "w"), out;
+  lcd_sched_submit(&sched, &in, 0);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 0, &out, NULL, NULL));
+
+  in = base_frame(LCD_CALIBRATION, "CAL");
+  lcd_sched_submit(&sched, &in, 1000);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 1000, &out, NULL, NULL));
+  TEST_ASSERT_EQUAL_INT(LCD_CALIBRATION, out.lcd_state);
+  TEST_ASSERT_EQUAL_UINT32(2, sched.stats.urgent);
+
+  // kembali normal juga langsung
+  in = base_frame(LCD_NORMAL, "w");
+  lcd_sched_submit(&sched, &in, 2000);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 2000, &out, NULL, NULL));
+  TEST_ASSERT_EQUAL_UINT32(3, sched.stats.urgent);
+}
+
+static void test_overlay_then_revert(void) {
+  led_data_t in = base_frame(LCD_NORMAL, "10.00 g"), out;
+  lcd_sched_submit(&sched, &in, 0);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 0, &out, NULL, NULL));
+
+  // overlay tidak menunggu batas frame rate
+  in = overlay_frame(1200, "TARE");
+  lcd_sched_submit(&sched, &in, 1000);
+  uint32_t wait_us;
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 1000, &out, NULL, &wait_us));
+  TEST_ASSERT_EQUAL_STRING("TARE", out.line_1);
+  TEST_ASSERT_EQUAL_UINT32(1200000, wait_us);
+
+  // layar dasar selama overlay: diikuti tapi tidak tampil
+  in = base_frame(LCD_NORMAL, "0.01 g");
+  lcd_sched_submit(&sched, &in, 300000);
+  in = base_frame(LCD_NORMAL, "0.00 g");
+  lcd_sched_submit(&sched, &in, 600000);
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 600000, &out, NULL, &wait_us));
+  TEST_ASSERT_EQUAL_UINT32(601000, wait_us);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.dropped);
+
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 1201000, &out, NULL, NULL));
+  TEST_ASSERT_EQUAL_STRING("0.00 g", out.line_1);
+  TEST_ASSERT_EQUAL_INT(0, out.overlay_ms);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.reverts);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.overlays);
+}
+
+static void test_overlay_restarts_overlay(void) {
+  led_data_t in = overlay_frame(1000, "UNIT g"), out;
+  lcd_sched_submit(&sched, &in, 0);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 0, &out, NULL, NULL));
+
+  in = overlay_frame(1000, "UNIT kg");
+  lcd_sched_submit(&sched, &in, 500000);
+  TEST_ASSERT_TRUE(lcd_sched_next(&sched, 500000, &out, NULL, NULL));
+  TEST_ASSERT_EQUAL_STRING("UNIT kg", out.line_1);
+
+  // durasi dihitung dari overlay kedua; tanpa layar dasar tidak ada yang dirender setelahnya
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 1400000, &out, NULL, NULL));
+  TEST_ASSERT_TRUE(sched.overlay_showing);
+  TEST_ASSERT_FALSE(lcd_sched_next(&sched, 1500000, &out, NULL, NULL));
+  TEST_ASSERT_FALSE(sched.overlay_showing);
+  TEST_ASSERT_EQUAL_UINT32(0, sched.stats.reverts);
+}
+
+static void test_weight_stream_scenario(void) {
+  // skenario commit: 10 s weight 80 Hz, overlay tare di 3 s, kalibrasi di 6 s, render 2.2 ms
+  render_free_us = 0;
+  busy_us = 0;
+  first_cal_post_us = -1;
+  state_latency_us = -1;
+  overlay_latency_us = -1;
+  revert_after_us = -1;
+  uint32_t rendered_before_overlay = 0;
+
+  for (int64_t now = 0; now < SIM_END_US; now += SIM_STEP_US) {
+    if (now % WEIGHT_PERIOD_US == 0) {
+      char text[17];
+      snprintf(text, sizeof(text), "%lld", (long long) now);
+      led_data_t in = base_frame(now >= STATE_AT_US ? LCD_CALIBRATION : LCD_NORMAL, text);
+      if (in.lcd_state == LCD_CALIBRATION && first_cal_post_us < 0) first_cal_post_us = now;
+      lcd_sched_submit(&sched, &in, now);
+    }
+    if (now == OVERLAY_AT_US) {
+      led_data_t in = overlay_frame(1200, "TARE");
+      lcd_sched_submit(&sched, &in, now);
+    }
+    pump(now);
+    if (now == 3000000 - SIM_STEP_US) rendered_before_overlay = sched.stats.rendered;
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(801, sched.stats.submitted);
+  TEST_ASSERT_EQUAL_UINT32(91, sched.stats.rendered);
+  TEST_ASSERT_EQUAL_UINT32(614, sched.stats.coalesced);
+  TEST_ASSERT_EQUAL_UINT32(95, sched.stats.dropped);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.overlays);
+  TEST_ASSERT_EQUAL_UINT32(1, sched.stats.reverts);
+  // refresh biasa 10 fps selama 3 s pertama
+  TEST_ASSERT_EQUAL_UINT32(30, rendered_before_overlay);
+  // bus sibuk 2.0 % (tanpa batas: 800 x 2.2 ms = 17.6 %)
+  TEST_ASSERT_EQUAL_INT64(91 * RENDER_US, busy_us);
+  // overlay hanya menunggu render yang sedang jalan
+  TEST_ASSERT_EQUAL_INT64(1900, overlay_latency_us);
+  TEST_ASSERT_INT_WITHIN(1000, 1201000, revert_after_us);
+  // pergantian layar dirender pada putaran pertama setelah frame-nya masuk
+  TEST_ASSERT_LESS_OR_EQUAL(RENDER_US, state_latency_us);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_frame_is_urgent);
+  RUN_TEST(test_refresh_is_capped);
+  RUN_TEST(test_custom_interval);
+  RUN_TEST(test_state_change_skips_cap);
+  RUN_TEST(test_overlay_then_revert);
+  RUN_TEST(test_overlay_restarts_overlay);
+  RUN_TEST(test_weight_stream_scenario);
+  return UNITY_END();
+}
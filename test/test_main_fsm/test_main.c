@@ -0,0 +1,189 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "sub_main/main_fsm.h"
+
+static main_fsm_t fsm;
+static main_fsm_handler_t handlers[MAIN_ACT_COUNT];
+static main_fsm_action_t handled_action;
+static main_fsm_state_t handled_in_state;
+static int handled_count;
+
+// forward declaration
+static void record_handler(main_fsm_action_t action, void* ctx);
+static void reachable_from(main_fsm_state_t start, bool* seen);
+
+void setUp(void) {
+  for (int i = 0; i < MAIN_ACT_COUNT; i++) handlers[i] = record_handler;
+  handled_action = MAIN_ACT_NONE;
+  handled_in_state = MAIN_FSM_STAY;
+  handled_count = 0;
+  main_fsm_init(&fsm, MAIN_FSM_NORMAL, handlers, &fsm);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void record_handler(main_fsm_action_t action, void* ctx) {
+  const main_fsm_t* self = (const main_fsm_t*) ctx;
+  handled_action = action;
+  handled_in_state = self->state;
+  handled_count++;
+}
+
+static void reachable_from(main_fsm_state_t start, bool* seen) {
+  // BFS di atas tabel transisi
+  main_fsm_state_t queue[MAIN_FSM_STATE_COUNT];
+  int head = 0;
+  int tail = 0;
+  memset(seen, 0, sizeof(bool) * MAIN_FSM_STATE_COUNT);
+  seen[start] = true;
+  queue[tail++] = start;
+  while (head < tail) {
+    main_fsm_state_t state = queue[head++];
+    for (int ev = 0; ev < MAIN_EV_COUNT; ev++) {
+      const main_fsm_transition_t* t = main_fsm_lookup(state, (main_fsm_event_t) ev);
+      main_fsm_state_t next = t->next == MAIN_FSM_STAY ? state : (main_fsm_state_t) t->next;
+      if (!seen[next]) {
+        seen[next] = true;
+        queue[tail++] = next;
+      }
+    }
+  }
+}
+
+static void test_table_entries_are_valid(void) {
+  for (int state = MAIN_FSM_NORMAL; state < MAIN_FSM_STATE_COUNT; state++) {
+    // event NONE tidak pernah melakukan apa pun
+    const main_fsm_transition_t* none = main_fsm_lookup((main_fsm_state_t) state, MAIN_EV_NONE);
+    TEST_ASSERT_EQUAL_UINT8(MAIN_ACT_NONE, none->action);
+    TEST_ASSERT_EQUAL_UINT8(MAIN_FSM_STAY, none->next);
+
+    for (int ev = 0; ev < MAIN_EV_COUNT; ev++) {
+      const main_fsm_transition_t* t = main_fsm_lookup((main_fsm_state_t) state, (main_fsm_event_t) ev);
+      TEST_ASSERT_NOT_NULL(t);
+      TEST_ASSERT_TRUE(t->action < MAIN_ACT_COUNT);
+      TEST_ASSERT_TRUE(t->next < MAIN_FSM_STATE_COUNT);
+      // pindah state tanpa action tidak boleh: main_task tidak akan tahu harus menggambar apa
+      if (t->next != MAIN_FSM_STAY) TEST_ASSERT_NOT_EQUAL(MAIN_ACT_NONE, t->action);
+    }
+  }
+  TEST_ASSERT_NULL(main_fsm_lookup(MAIN_FSM_STATE_COUNT, MAIN_EV_A_CLICK));
+  TEST_ASSERT_NULL(main_fsm_lookup(MAIN_FSM_NORMAL, MAIN_EV_COUNT));
+}
+
+static void test_every_state_reachable_and_can_return(void) {
+  bool seen[MAIN_FSM_STATE_COUNT];
+  reachable_from(MAIN_FSM_NORMAL, seen);
+  for (int state = MAIN_FSM_NORMAL; state < MAIN_FSM_STATE_COUNT; state++) {
+    TEST_ASSERT_TRUE_MESSAGE(seen[state], main_fsm_state_name((main_fsm_state_t) state));
+  }
+  // tidak ada state buntu: dari mana pun NORMAL bisa dicapai lagi
+  for (int state = MAIN_FSM_NORMAL; state < MAIN_FSM_STATE_COUNT; state++) {
+    reachable_from((main_fsm_state_t) state, seen);
+    TEST_ASSERT_TRUE_MESSAGE(seen[MAIN_FSM_NORMAL], main_fsm_state_name((main_fsm_state_t) state));
+  }
+}
+
+static void test_names_cover_every_value(void) {
+  for (int state = 0; state < MAIN_FSM_STATE_COUNT; state++) {
+    TEST_ASSERT_NOT_NULL(main_fsm_state_name((main_fsm_state_t) state));
+  }
+  for (int ev = 0; ev < MAIN_EV_COUNT; ev++) {
+    TEST_ASSERT_NOT_NULL(main_fsm_event_name((main_fsm_event_t) ev));
+  }
+  for (int act = 0; act < MAIN_ACT_COUNT; act++) {
+    TEST_ASSERT_NOT_NULL(main_fsm_action_name((main_fsm_action_t) act));
+  }
+  TEST_ASSERT_EQUAL_STRING("PAIR", main_fsm_action_name(MAIN_ACT_PAIR));
+  TEST_ASSERT_EQUAL_STRING("UNKNOWN", main_fsm_state_name(MAIN_FSM_STATE_COUNT));
+}
+
+static void test_wake_up_never_gets_stuck(void) {
+  // Device A tidak menjawab: timeout dari main_task membawa kembali ke NORMAL
+  const main_fsm_event_t exits[] = { MAIN_EV_SAMPLE, MAIN_EV_IDLE_TIMEOUT, MAIN_EV_A_CLICK, MAIN_EV_AB_LONG };
+  for (size_t i = 0; i < sizeof(exits) / sizeof(exits[0]); i++) {
+    main_fsm_init(&fsm, MAIN_FSM_WAKE_UP, handlers, &fsm);
+    TEST_ASSERT_EQUAL(MAIN_ACT_WAKE_DONE, main_fsm_dispatch(&fsm, exits[i], 0));
+    TEST_ASSERT_EQUAL(MAIN_FSM_NORMAL, fsm.state);
+  }
+}
+
+static void test_sleep_cycle(void) {
+  TEST_ASSERT_EQUAL(MAIN_ACT_SLEEP, main_fsm_dispatch(&fsm, MAIN_EV_IDLE_TIMEOUT, 10));
+  TEST_ASSERT_EQUAL(SLEEP_MODE, main_fsm_main_state(fsm.state));
+  TEST_ASSERT_EQUAL(MAIN_ACT_DEEP_SLEEP, main_fsm_dispatch(&fsm, MAIN_EV_IDLE_TIMEOUT, 20));
+  // dari deep sleep hanya tombol A yang membangunkan
+  TEST_ASSERT_EQUAL(MAIN_ACT_NONE, main_fsm_dispatch(&fsm, MAIN_EV_B_CLICK, 30));
+  TEST_ASSERT_EQUAL(MAIN_ACT_WAKE_UP, main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 40));
+  TEST_ASSERT_EQUAL(WAKE_UP_MODE, main_fsm_main_state(fsm.state));
+  TEST_ASSERT_EQUAL(MAIN_ACT_WAKE_DONE, main_fsm_dispatch(&fsm, MAIN_EV_SAMPLE, 50));
+  TEST_ASSERT_EQUAL(NORMAL_MODE, main_fsm_main_state(fsm.state));
+}
+
+static void test_calibration_flow(void) {
+  TEST_ASSERT_EQUAL(MAIN_ACT_PAIR, main_fsm_dispatch(&fsm, MAIN_EV_B_LONG, 0));
+  TEST_ASSERT_EQUAL(MAIN_FSM_NORMAL, fsm.state);
+
+  main_fsm_dispatch(&fsm, MAIN_EV_AB_LONG, 0);
+  TEST_ASSERT_EQUAL(CAL_INIT, main_fsm_cal_state(fsm.state));
+  main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 0);
+  TEST_ASSERT_EQUAL(CAL_WAITING, main_fsm_cal_state(fsm.state));
+  main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 0);
+  TEST_ASSERT_EQUAL(CAL_INPUT, main_fsm_cal_state(fsm.state));
+  TEST_ASSERT_EQUAL(MAIN_ACT_CAL_INC, main_fsm_dispatch(&fsm, MAIN_EV_B_CLICK, 0));
+  TEST_ASSERT_EQUAL(MAIN_ACT_CAL_REVIEW, main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 0));
+  // titik kalibrasi tambahan lalu konfirmasi
+  TEST_ASSERT_EQUAL(MAIN_ACT_CAL_INPUT, main_fsm_dispatch(&fsm, MAIN_EV_D_CLICK, 0));
+  main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 0);
+  TEST_ASSERT_EQUAL(MAIN_ACT_CAL_CONFIRM, main_fsm_dispatch(&fsm, MAIN_EV_A_CLICK, 0));
+  TEST_ASSERT_EQUAL(MAIN_FSM_NORMAL, fsm.state);
+  TEST_ASSERT_EQUAL(CAL_UNKNOWN, main_fsm_cal_state(fsm.state));
+}
+
+static void test_handler_sees_old_state(void) {
+  main_fsm_dispatch(&fsm, MAIN_EV_AB_LONG, 0);
+  main_fsm_dispatch(&fsm, MAIN_EV_AB_LONG, 0);
+  TEST_ASSERT_EQUAL(MAIN_ACT_CAL_CANCEL, handled_action);
+  TEST_ASSERT_EQUAL(MAIN_FSM_CAL_INIT, handled_in_state);
+  TEST_ASSERT_EQUAL(2, handled_count);
+
+  // event yang diabaikan tidak memanggil handler
+  main_fsm_dispatch(&fsm, MAIN_EV_SAMPLE, 0);
+  TEST_ASSERT_EQUAL(2, handled_count);
+  TEST_ASSERT_EQUAL_UINT32(1, fsm.ignored);
+}
+
+static void test_trace_keeps_latest_first(void) {
+  main_fsm_trace_t entry;
+  TEST_ASSERT_FALSE(main_fsm_trace_get(&fsm, 0, &entry));
+
+  for (uint32_t i = 0; i < MAIN_FSM_TRACE_LEN + 5; i++) {
+    main_fsm_dispatch(&fsm, MAIN_EV_B_CLICK, i);
+  }
+  TEST_ASSERT_EQUAL_UINT8(MAIN_FSM_TRACE_LEN, fsm.trace_count);
+  TEST_ASSERT_TRUE(main_fsm_trace_get(&fsm, 0, &entry));
+  TEST_ASSERT_EQUAL_UINT32(MAIN_FSM_TRACE_LEN + 4, entry.time_ms);
+  TEST_ASSERT_EQUAL_UINT8(MAIN_ACT_NEXT_UNIT, entry.action);
+  TEST_ASSERT_TRUE(main_fsm_trace_get(&fsm, MAIN_FSM_TRACE_LEN - 1, &entry));
+  TEST_ASSERT_EQUAL_UINT32(5, entry.time_ms);
+  TEST_ASSERT_FALSE(main_fsm_trace_get(&fsm, MAIN_FSM_TRACE_LEN, &entry));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_table_entries_are_valid);
+  RUN_TEST(test_every_state_reachable_and_can_return);
+  RUN_TEST(test_names_cover_every_value);
+  RUN_TEST(test_wake_up_never_gets_stuck);
+  RUN_TEST(test_sleep_cycle);
+  RUN_TEST(test_calibration_flow);
+  RUN_TEST(test_handler_sees_old_state);
+  RUN_TEST(test_trace_keeps_latest_first);
+  return UNITY_END();
+}
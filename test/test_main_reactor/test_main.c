@@ -0,0 +1,237 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <string.h>
+
+#include "sub_main/main_reactor.h"
+
+#define BUTTON_QUEUE_LEN 8
+#define LOG_LEN          32
+
+// sumber event tiruan: sample antri di comm, button event (sudah dipetakan), power manager, FSM
+typedef struct {
+  uint32_t samples;
+  main_fsm_event_t buttons[BUTTON_QUEUE_LEN];
+  uint8_t button_head;
+  uint8_t button_count;
+  bool dark;
+  main_state_t state;
+  uint32_t activities;
+  main_fsm_event_t dispatched[LOG_LEN];
+  uint8_t dispatch_count;
+  char calls[LOG_LEN]; // urutan panggilan: 'S' = drain sample, 'B' = ambil tombol
+  uint8_t call_count;
+} sim_t;
+
+static sim_t sim;
+static main_reactor_t reactor;
+static main_fsm_t fsm;
+static bool use_fsm;
+
+// forward declaration
+static uint32_t sim_drain_samples(void* ctx);
+static bool sim_next_button(void* ctx, main_fsm_event_t* event);
+static bool sim_screen_dark(void* ctx);
+static void sim_button_activity(void* ctx);
+static main_state_t sim_state(void* ctx);
+static void sim_dispatch(void* ctx, main_fsm_event_t event);
+static void push_button(main_fsm_event_t event);
+
+static const main_reactor_io_t sim_io = {
+  .drain_samples = sim_drain_samples,
+  .next_button = sim_next_button,
+  .screen_dark = sim_screen_dark,
+  .button_activity = sim_button_activity,
+  .state = sim_state,
+  .dispatch = sim_dispatch,
+  .ctx = &sim,
+};
+
+void setUp(void) {
+  memset(&sim, 0, sizeof(sim));
+  sim.state = NORMAL_MODE;
+  use_fsm = false;
+  main_reactor_init(&reactor, &sim_io);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t sim_drain_samples(void* ctx) {
+  sim_t* s = (sim_t*) ctx;
+  if (s->call_count < LOG_LEN) s->calls[s->call_count++] = 'S';
+  uint32_t samples = s->samples;
+  s->samples = 0;
+  return samples;
+}
+
+static bool sim_next_button(void* ctx, main_fsm_event_t* event) {
+  sim_t* s = (sim_t*) ctx;
+  if (s->button_count == 0) return false;
+  if (s->call_count < LOG_LEN) s->calls[s->call_count++] = 'B';
+  *event = s->buttons[s->button_head];
+  s->button_head = (s->button_head + 1) % BUTTON_QUEUE_LEN;
+  s->button_count--;
+  return true;
+}
+
+static bool sim_screen_dark(void* ctx) {
+  return ((sim_t*) ctx)->dark;
+}
+
+static void sim_button_activity(void* ctx) {
+  // seperti power manager: tombol langsung menyalakan layar
+  sim_t* s = (sim_t*) ctx;
+  s->activities++;
+  s->dark = false;
+}
+
+static main_state_t sim_state(void* ctx) {
+  if (use_fsm) return main_fsm_main_state(fsm.state);
+  return ((sim_t*) ctx)->state;
+}
+
+static void sim_dispatch(void* ctx, main_fsm_event_t event) {
+  sim_t* s = (sim_t*) ctx;
+  if (s->dispatch_count < LOG_LEN) s->dispatched[s->dispatch_count++] = event;
+  if (use_fsm) main_fsm_dispatch(&fsm, event, 0);
+}
+
+static void push_button(main_fsm_event_t event) {
+  TEST_ASSERT_LESS_THAN(BUTTON_QUEUE_LEN, sim.button_count);
+  sim.buttons[(sim.button_head + sim.button_count) % BUTTON_QUEUE_LEN] = event;
+  sim.button_count++;
+}
+
+static void test_no_events_no_dispatch(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, main_reactor_step(&reactor));
+  TEST_ASSERT_EQUAL_UINT8(0, sim.dispatch_count);
+}
+
+static void test_samples_drained_into_one_sample_event(void) {
+  sim.samples = 17;
+  TEST_ASSERT_EQUAL_UINT32(17, main_reactor_step(&reactor));
+  TEST_ASSERT_EQUAL_UINT32(0, sim.samples);
+  TEST_ASSERT_EQUAL_UINT8(1, sim.dispatch_count);
+  TEST_ASSERT_EQUAL(MAIN_EV_SAMPLE, sim.dispatched[0]);
+}
+
+static void test_every_button_dispatched_without_sample(void) {
+  sim.samples = 4;
+  push_button(MAIN_EV_A_CLICK);
+  push_button(MAIN_EV_B_CLICK);
+  push_button(MAIN_EV_A_LONG);
+  TEST_ASSERT_EQUAL_UINT32(7, main_reactor_step(&reactor));
+
+  // sample dikuras dulu, lalu tombol satu per satu; tidak ada SAMPLE tambahan
+  TEST_ASSERT_EQUAL_STRING_LEN("SBBB", sim.calls, 4);
+  TEST_ASSERT_EQUAL_UINT8(3, sim.dispatch_count);
+  TEST_ASSERT_EQUAL(MAIN_EV_A_CLICK, sim.dispatched[0]);
+  TEST_ASSERT_EQUAL(MAIN_EV_B_CLICK, sim.dispatched[1]);
+  TEST_ASSERT_EQUAL(MAIN_EV_A_LONG, sim.dispatched[2]);
+  TEST_ASSERT_EQUAL_UINT32(3, sim.activities);
+}
+
+static void test_unmapped_button_counts_as_dispatch(void) {
+  // tombol tanpa mapping tetap aktivitas dan tetap dikirim (FSM mengabaikan MAIN_EV_NONE)
+  sim.samples = 2;
+  push_button(MAIN_EV_NONE);
+  TEST_ASSERT_EQUAL_UINT32(3, main_reactor_step(&reactor));
+  TEST_ASSERT_EQUAL_UINT8(1, sim.dispatch_count);
+  TEST_ASSERT_EQUAL(MAIN_EV_NONE, sim.dispatched[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, sim.activities);
+}
+
+static void test_dark_screen_first_press_only_wakes(void) {
+  sim.dark = true;
+  push_button(MAIN_EV_C_CLICK);
+  push_button(MAIN_EV_C_CLICK);
+  TEST_ASSERT_EQUAL_UINT32(2, main_reactor_step(&reactor));
+  // tekan pertama ditelan, tekan kedua di batch yang sama sudah melihat layar menyala
+  TEST_ASSERT_EQUAL_UINT8(1, sim.dispatch_count);
+  TEST_ASSERT_EQUAL(MAIN_EV_C_CLICK, sim.dispatched[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, reactor.stats.screen_wakes);
+  TEST_ASSERT_EQUAL_UINT32(2, sim.activities);
+}
+
+static void test_dark_screen_wake_rerenders_with_sample(void) {
+  // satu-satunya tombol ditelan: tidak ada yang di-dispatch, jadi layar yang baru menyala di-render lewat SAMPLE
+  sim.dark = true;
+  push_button(MAIN_EV_A_CLICK);
+  TEST_ASSERT_EQUAL_UINT32(1, main_reactor_step(&reactor));
+  TEST_ASSERT_EQUAL_UINT8(1, sim.dispatch_count);
+  TEST_ASSERT_EQUAL(MAIN_EV_SAMPLE, sim.dispatched[0]);
+  TEST_ASSERT_FALSE(sim.dark);
+}
+
+static void test_dark_screen_outside_normal_dispatches(void) {
+  // SLEEP / kalibrasi: tombol langsung ke FSM (tabel FSM yang membangunkan)
+  static const main_state_t states[] = { SLEEP_MODE, DEEPSLEEP_MODE, CALIBRATION_MODE, WAKE_UP_MODE };
+  for (size_t i = 0; i < sizeof(states) / sizeof(states[0]); i++) {
+    setUp();
+    sim.state = states[i];
+    sim.dark = true;
+    push_button(MAIN_EV_A_CLICK);
+    main_reactor_step(&reactor);
+    TEST_ASSERT_EQUAL_UINT8(1, sim.dispatch_count);
+    TEST_ASSERT_EQUAL(MAIN_EV_A_CLICK, sim.dispatched[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, reactor.stats.screen_wakes);
+  }
+}
+
+static void test_sleep_wakes_through_fsm(void) {
+  // dengan FSM asli: klik saat SLEEP membangunkan, klik saat NORMAL gelap tidak mengubah state
+  main_fsm_init(&fsm, MAIN_FSM_SLEEP, NULL, NULL);
+  use_fsm = true;
+  sim.dark = true;
+  push_button(MAIN_EV_B_CLICK);
+  main_reactor_step(&reactor);
+  TEST_ASSERT_EQUAL(MAIN_FSM_WAKE_UP, fsm.state);
+
+  main_fsm_init(&fsm, MAIN_FSM_NORMAL, NULL, NULL);
+  sim.dark = true;
+  push_button(MAIN_EV_B_CLICK);
+  main_reactor_step(&reactor);
+  TEST_ASSERT_EQUAL(MAIN_FSM_NORMAL, fsm.state);
+  TEST_ASSERT_EQUAL_UINT32(0, fsm.transitions);
+}
+
+static void test_loop_stats(void) {
+  // 10 iterasi dalam 1.5 s: 3 tick idle, batch terbesar 9
+  static const uint32_t batches[] = { 1, 0, 9, 2, 0, 4, 0, 3, 5, 1 };
+  int64_t now_us = 0;
+  uint32_t total = 0;
+  for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+    sim.samples = batches[i];
+    uint32_t events = main_reactor_step(&reactor);
+    TEST_ASSERT_EQUAL_UINT32(batches[i], events);
+    total += events;
+    main_reactor_record(&reactor, events, events == 0, now_us, now_us + 200 + 100 * events);
+    now_us += 150000;
+  }
+  const main_task_loop_stats_t* stats = &reactor.stats;
+  TEST_ASSERT_EQUAL_UINT32(10, stats->iterations);
+  TEST_ASSERT_EQUAL_UINT32(3, stats->idle_wakeups);
+  TEST_ASSERT_EQUAL_UINT32(total, stats->events);
+  TEST_ASSERT_EQUAL_UINT32(9, stats->max_batch);
+  TEST_ASSERT_EQUAL_UINT32(10, stats->iteration.count);
+  // jendela pertama ditutup di iterasi ke-8 (1.05 s): 19 event -> 18 event/s
+  TEST_ASSERT_EQUAL_UINT32(18, stats->events_per_sec);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_no_events_no_dispatch);
+  RUN_TEST(test_samples_drained_into_one_sample_event);
+  RUN_TEST(test_every_button_dispatched_without_sample);
+  RUN_TEST(test_unmapped_button_counts_as_dispatch);
+  RUN_TEST(test_dark_screen_first_press_only_wakes);
+  RUN_TEST(test_dark_screen_wake_rerenders_with_sample);
+  RUN_TEST(test_dark_screen_outside_normal_dispatches);
+  RUN_TEST(test_sleep_wakes_through_fsm);
+  RUN_TEST(test_loop_stats);
+  return UNITY_END();
+}
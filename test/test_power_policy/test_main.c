@@ -0,0 +1,130 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+
+#include "sub_power/power_policy.h"
+
+#define SEC_MS 1000LL
+#define MIN_MS (60 * SEC_MS)
+
+static power_policy_t policy;
+
+void setUp(void) {
+  power_policy_init(&policy, NULL, 0);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void test_first_update_applies_active(void) {
+  power_level_t level = POWER_DEEP_SLEEP;
+  TEST_ASSERT_TRUE(power_policy_update(&policy, 0, &level));
+  TEST_ASSERT_EQUAL(POWER_ACTIVE, level);
+  TEST_ASSERT_FALSE(power_policy_update(&policy, 1000, &level));
+}
+
+static void test_idle_cascade_default_timing(void) {
+  power_policy_update(&policy, 0, NULL);
+  const struct {
+    int64_t at_ms;
+    power_level_t level;
+  } steps[] = {
+    { 20 * SEC_MS, POWER_DIM },
+    { 60 * SEC_MS, POWER_LOW_CPU },
+    { 5 * MIN_MS, POWER_LIGHT_SLEEP },
+    { 30 * MIN_MS, POWER_DEEP_SLEEP },
+  };
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    power_level_t level;
+    TEST_ASSERT_FALSE(power_policy_update(&policy, steps[i].at_ms - 1, &level));
+    TEST_ASSERT_TRUE(power_policy_update(&policy, steps[i].at_ms, &level));
+    TEST_ASSERT_EQUAL(steps[i].level, level);
+  }
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, power_policy_next_deadline_ms(&policy, 30 * MIN_MS));
+}
+
+static void test_long_gap_jumps_levels(void) {
+  // loop yang tidur lama langsung masuk level terdalam yang sudah lewat
+  power_policy_update(&policy, 0, NULL);
+  power_level_t level;
+  TEST_ASSERT_TRUE(power_policy_update(&policy, 10 * MIN_MS, &level));
+  TEST_ASSERT_EQUAL(POWER_LIGHT_SLEEP, level);
+  TEST_ASSERT_EQUAL_UINT32(0, policy.stats.entries[POWER_DIM]);
+  TEST_ASSERT_EQUAL_UINT32(20 * MIN_MS, power_policy_next_deadline_ms(&policy, 10 * MIN_MS));
+}
+
+static void test_activity_wakes_and_counts_source(void) {
+  power_policy_update(&policy, 0, NULL);
+  power_policy_update(&policy, 2 * MIN_MS, NULL);
+  TEST_ASSERT_EQUAL(POWER_LOW_CPU, power_policy_level(&policy));
+
+  power_policy_activity(&policy, POWER_SRC_BUTTON, 2 * MIN_MS + 1);
+  TEST_ASSERT_EQUAL(POWER_ACTIVE, power_policy_level(&policy));
+  TEST_ASSERT_EQUAL_UINT32(1, policy.stats.wakes[POWER_SRC_BUTTON]);
+  // aktivitas saat sudah ACTIVE bukan wake
+  power_policy_activity(&policy, POWER_SRC_BUTTON, 2 * MIN_MS + 2);
+  TEST_ASSERT_EQUAL_UINT32(1, policy.stats.wakes[POWER_SRC_BUTTON]);
+  TEST_ASSERT_EQUAL_UINT32(2, policy.stats.activity[POWER_SRC_BUTTON]);
+  TEST_ASSERT_EQUAL_UINT32(20 * SEC_MS, power_policy_next_deadline_ms(&policy, 2 * MIN_MS + 2));
+}
+
+static void test_weight_change_above_threshold(void) {
+  power_policy_update(&policy, 0, NULL);
+  // sample pertama hanya referensi
+  power_policy_weight(&policy, 100.0f, 0);
+  power_policy_update(&policy, 30 * SEC_MS, NULL);
+  TEST_ASSERT_EQUAL(POWER_DIM, power_policy_level(&policy));
+
+  // noise di bawah 2 units tidak membangunkan
+  power_policy_weight(&policy, 101.5f, 31 * SEC_MS);
+  TEST_ASSERT_EQUAL(POWER_DIM, power_policy_level(&policy));
+  power_policy_weight(&policy, 150.0f, 32 * SEC_MS);
+  TEST_ASSERT_EQUAL(POWER_ACTIVE, power_policy_level(&policy));
+  TEST_ASSERT_EQUAL_UINT32(1, policy.stats.wakes[POWER_SRC_WEIGHT]);
+}
+
+static void test_hold_keeps_active(void) {
+  power_policy_update(&policy, 0, NULL);
+  power_policy_set_hold(&policy, true, 0);
+  TEST_ASSERT_FALSE(power_policy_update(&policy, 60 * MIN_MS, NULL));
+  TEST_ASSERT_EQUAL(POWER_ACTIVE, power_policy_level(&policy));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, power_policy_next_deadline_ms(&policy, 60 * MIN_MS));
+
+  // idle dihitung dari saat hold dilepas
+  power_policy_set_hold(&policy, false, 61 * MIN_MS);
+  TEST_ASSERT_FALSE(power_policy_update(&policy, 61 * MIN_MS + 19 * SEC_MS, NULL));
+  TEST_ASSERT_TRUE(power_policy_update(&policy, 61 * MIN_MS + 20 * SEC_MS, NULL));
+}
+
+static void test_residency_and_config_order(void) {
+  power_policy_config_t config = {
+    .idle_ms = { [POWER_DIM] = 1000, [POWER_LOW_CPU] = 500, [POWER_LIGHT_SLEEP] = 3000, [POWER_DEEP_SLEEP] = 4000 },
+    .weight_threshold = 1.0f,
+  };
+  power_policy_init(&policy, &config, 0);
+  // level lebih dalam tidak boleh lebih cepat dari sebelumnya
+  TEST_ASSERT_EQUAL_UINT32(1000, policy.config.idle_ms[POWER_LOW_CPU]);
+
+  for (int64_t t = 0; t <= 5000; t += 100) power_policy_update(&policy, t, NULL);
+  TEST_ASSERT_EQUAL_UINT64(1000, policy.stats.residency_ms[POWER_ACTIVE]);
+  TEST_ASSERT_EQUAL_UINT64(0, policy.stats.residency_ms[POWER_DIM]);
+  TEST_ASSERT_EQUAL_UINT64(2000, policy.stats.residency_ms[POWER_LOW_CPU]);
+  TEST_ASSERT_EQUAL_UINT64(1000, policy.stats.residency_ms[POWER_LIGHT_SLEEP]);
+  TEST_ASSERT_EQUAL_UINT64(1000, policy.stats.residency_ms[POWER_DEEP_SLEEP]);
+  TEST_ASSERT_EQUAL_STRING("LIGHT_SLEEP", power_policy_level_name(POWER_LIGHT_SLEEP));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_update_applies_active);
+  RUN_TEST(test_idle_cascade_default_timing);
+  RUN_TEST(test_long_gap_jumps_levels);
+  RUN_TEST(test_activity_wakes_and_counts_source);
+  RUN_TEST(test_weight_change_above_threshold);
+  RUN_TEST(test_hold_keeps_active);
+  RUN_TEST(test_residency_and_config_order);
+  return UNITY_END();
+}
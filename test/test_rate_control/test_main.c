@@ -0,0 +1,183 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stdio.h>
+
+#include "sub_main/rate_control.h"
+
+#define HOUR_MS          3600000
+#define UPDATE_PERIOD_MS 100     // periode loop main_task
+#define FIXED_50MS_HOUR  72000   // frame per jam tanpa rate control
+
+// satu langkah skenario: state display dan laju perubahan berat selama duration_ms
+typedef struct {
+  uint32_t duration_ms;
+  main_state_t state;
+  float grams_per_s;
+} phase_t;
+
+static rate_control_t rc;
+
+// forward declaration
+static rate_level_t level_after(main_state_t state, float units, int64_t now_ms);
+static void run_profile(const char* name, const phase_t* phases, size_t count);
+
+void setUp(void) {
+  rate_control_init(&rc, NULL);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static rate_level_t level_after(main_state_t state, float units, int64_t now_ms) {
+  rate_control_update(&rc, state, units, now_ms, NULL);
+  return rc.level;
+}
+
+static void run_profile(const char* name, const phase_t* phases, size_t count) {
+  // fase diulang berurutan sampai satu jam
+  float units = 0.0f;
+  size_t phase = 0;
+  int64_t phase_end_ms = phases[0].duration_ms;
+  for (int64_t now_ms = 0; now_ms <= HOUR_MS; now_ms += UPDATE_PERIOD_MS) {
+    while (now_ms >= phase_end_ms) {
+      phase = (phase + 1) % count;
+      phase_end_ms += phases[phase].duration_ms;
+    }
+    units += phases[phase].grams_per_s * UPDATE_PERIOD_MS / 1000.0f;
+    rate_control_update(&rc, phases[phase].state, units, now_ms, NULL);
+  }
+
+  char line[128];
+  snprintf(line, sizeof(line), "%-14s %6llu frame/jam (%llu%% dari 50 ms tetap), %u request", name,
+           (unsigned long long) rc.stats.expected_frames,
+           (unsigned long long) (rc.stats.expected_frames * 100 / FIXED_50MS_HOUR), rc.stats.requests);
+  TEST_MESSAGE(line);
+}
+
+static void test_first_update_always_sends(void) {
+  uint32_t interval = 0;
+  TEST_ASSERT_TRUE(rate_control_update(&rc, NORMAL_MODE, 0.0f, 0, &interval));
+  TEST_ASSERT_EQUAL_UINT32(200, interval);
+  TEST_ASSERT_FALSE(rate_control_update(&rc, NORMAL_MODE, 0.0f, 100, &interval));
+  TEST_ASSERT_EQUAL_UINT32(1, rc.stats.requests);
+
+  // ganti peer: level dikirim ulang walau sama
+  rate_control_reset(&rc);
+  TEST_ASSERT_TRUE(rate_control_update(&rc, NORMAL_MODE, 0.0f, 200, &interval));
+  TEST_ASSERT_EQUAL_UINT32(200, interval);
+}
+
+static void test_moving_weight_goes_fast_then_settles(void) {
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(NORMAL_MODE, 0.0f, 0));
+  // perubahan di bawah threshold tidak dihitung bergerak
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(NORMAL_MODE, 1.5f, 100));
+  TEST_ASSERT_EQUAL(RATE_FAST, level_after(NORMAL_MODE, 250.0f, 200));
+  TEST_ASSERT_EQUAL(RATE_FAST, level_after(NORMAL_MODE, 251.0f, 2199));
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(NORMAL_MODE, 251.0f, 2200));
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(NORMAL_MODE, 251.0f, 30199));
+  TEST_ASSERT_EQUAL(RATE_IDLE, level_after(NORMAL_MODE, 251.0f, 30200));
+  TEST_ASSERT_EQUAL(RATE_FAST, level_after(NORMAL_MODE, 100.0f, 40000));
+  TEST_ASSERT_EQUAL_UINT32(5, rc.stats.requests);
+}
+
+static void test_state_overrides_trend(void) {
+  TEST_ASSERT_EQUAL(RATE_FAST, level_after(CALIBRATION_MODE, 0.0f, 0));
+  TEST_ASSERT_EQUAL(RATE_HEARTBEAT, level_after(SLEEP_MODE, 0.0f, 1000));
+  TEST_ASSERT_EQUAL(RATE_HEARTBEAT, level_after(DEEPSLEEP_MODE, 500.0f, 2000));
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(WAKE_UP_MODE, 0.0f, 3000));
+  // bangun menghitung ulang waktu diam: belum langsung IDLE
+  TEST_ASSERT_EQUAL(RATE_NORMAL, level_after(NORMAL_MODE, 0.0f, 4000));
+}
+
+static void test_custom_config_fills_missing_intervals(void) {
+  rate_control_config_t config = {
+    .interval_ms = { [RATE_FAST] = 20 },
+    .change_threshold = 1.0f,
+    .settle_ms = 500,
+    .idle_after_ms = 5000,
+  };
+  rate_control_init(&rc, &config);
+  TEST_ASSERT_EQUAL_UINT32(20, rate_control_interval(&rc, RATE_FAST));
+  TEST_ASSERT_EQUAL_UINT32(200, rate_control_interval(&rc, RATE_NORMAL));
+  TEST_ASSERT_EQUAL_UINT32(5000, rate_control_interval(&rc, RATE_HEARTBEAT));
+  TEST_ASSERT_EQUAL_UINT32(0, rate_control_interval(&rc, RATE_LEVEL_COUNT));
+  TEST_ASSERT_EQUAL_STRING("IDLE", rate_control_level_name(RATE_IDLE));
+}
+
+static void test_idle_hour_frame_budget(void) {
+  // satu jam timbangan diam, update tiap 100 ms seperti loop main_task
+  for (int64_t now_ms = 0; now_ms <= 3600000; now_ms += 100) {
+    rate_control_update(&rc, NORMAL_MODE, 0.0f, now_ms, NULL);
+  }
+  // 30 s NORMAL (150 frame) + 3570 s IDLE (3570 frame), vs 72000 pada 50 ms tetap
+  TEST_ASSERT_EQUAL_UINT64(3720, rc.stats.expected_frames);
+  TEST_ASSERT_EQUAL_UINT64(30000, rc.stats.time_in_level_ms[RATE_NORMAL]);
+  TEST_ASSERT_EQUAL_UINT64(3570000, rc.stats.time_in_level_ms[RATE_IDLE]);
+  TEST_ASSERT_EQUAL_UINT32(2, rc.stats.requests);
+}
+
+static void test_light_use_hour(void) {
+  // 6 penimbangan per jam: tuang 5 s, lalu beban diam sampai 10 menit berikutnya
+  static const phase_t light[] = {
+    { 5000, NORMAL_MODE, 40.0f },
+    { 595000, NORMAL_MODE, 0.0f },
+  };
+  run_profile("light", light, 2);
+  // per siklus: 7 s FAST (tuang + settle), 30 s NORMAL, sisanya IDLE
+  TEST_ASSERT_EQUAL_UINT64(5056, rc.stats.expected_frames);
+  TEST_ASSERT_EQUAL_UINT32(20, rc.stats.requests);
+}
+
+static void test_busy_hour(void) {
+  // penimbangan tiap menit: tuang 20 s, angkat 5 s, kosong 35 s
+  static const phase_t busy[] = {
+    { 20000, NORMAL_MODE, 25.0f },
+    { 5000, NORMAL_MODE, -100.0f },
+    { 35000, NORMAL_MODE, 0.0f },
+  };
+  run_profile("busy", busy, 3);
+  // hampir setengah waktu FAST, IDLE hanya beberapa detik per menit
+  TEST_ASSERT_EQUAL_UINT64(40978, rc.stats.expected_frames);
+  TEST_ASSERT_EQUAL_UINT32(182, rc.stats.requests);
+}
+
+static void test_mostly_asleep_hour(void) {
+  // 5 menit dipakai sebentar lalu dibiarkan tidur sisa jam
+  static const phase_t asleep[] = {
+    { 10000, NORMAL_MODE, 20.0f },
+    { 290000, NORMAL_MODE, 0.0f },
+    { 3300000, SLEEP_MODE, 0.0f },
+  };
+  run_profile("mostly asleep", asleep, 3);
+  // tidur: HEARTBEAT 5 s (660 frame dalam 55 menit)
+  TEST_ASSERT_EQUAL_UINT64(1296, rc.stats.expected_frames);
+  TEST_ASSERT_EQUAL_UINT64(3300000, rc.stats.time_in_level_ms[RATE_HEARTBEAT]);
+  TEST_ASSERT_EQUAL_UINT32(6, rc.stats.requests);
+}
+
+static void test_expected_frames_do_not_drift(void) {
+  // update tiap 30 ms pada interval 200 ms: sisa pembagian dibawa, bukan dibuang
+  rate_control_update(&rc, NORMAL_MODE, 0.0f, 0, NULL);
+  for (int64_t now_ms = 30; now_ms <= 20000; now_ms += 30) {
+    rate_control_update(&rc, NORMAL_MODE, 0.0f, now_ms, NULL);
+  }
+  TEST_ASSERT_EQUAL_UINT64(99, rc.stats.expected_frames);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_update_always_sends);
+  RUN_TEST(test_moving_weight_goes_fast_then_settles);
+  RUN_TEST(test_state_overrides_trend);
+  RUN_TEST(test_custom_config_fills_missing_intervals);
+  RUN_TEST(test_idle_hour_frame_budget);
+  RUN_TEST(test_light_use_hour);
+  RUN_TEST(test_busy_hour);
+  RUN_TEST(test_mostly_asleep_hour);
+  RUN_TEST(test_expected_frames_do_not_drift);
+  return UNITY_END();
+}
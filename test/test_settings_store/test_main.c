@@ -0,0 +1,222 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sub_comm/comm_codec.h"
+#include "sub_settings/settings_store.h"
+#include "sub_settings/settings_backend_fake.h"
+
+static settings_fake_nvs_t fake;
+static settings_store_t store;
+static const settings_backend_t* backend;
+
+// forward declaration
+static cal_model_t make_cal(void);
+static void reboot(settings_fake_nvs_t* nvs, const char* path);
+
+void setUp(void) {
+  backend = settings_fake_nvs_init(&fake, NULL);
+  settings_store_init(&store, backend, NULL);
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static cal_model_t make_cal(void) {
+  cal_model_t cal = {
+    .version = CAL_MODEL_VERSION,
+    .type = CAL_MODEL_LINEAR,
+    .point_count = 2,
+    .slope = 0.001f,
+    .offset = -3.0f,
+  };
+  return cal;
+}
+
+static void reboot(settings_fake_nvs_t* nvs, const char* path) {
+  // state RAM baru, isi flash dari file
+  backend = settings_fake_nvs_init(nvs, path);
+  settings_store_init(&store, backend, NULL);
+}
+
+static void test_defaults_when_empty(void) {
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_DEFAULTS, settings_store_load(&store, 0));
+  TEST_ASSERT_FALSE(settings_store_dirty(&store));
+  settings_t settings;
+  settings_store_get(&store, &settings);
+  TEST_ASSERT_EQUAL_UINT8(0, settings.peer_count);
+  TEST_ASSERT_EQUAL_UINT8(CAL_MODEL_NONE, settings.cal.type);
+}
+
+static void test_legacy_keys_imported(void) {
+  const uint8_t macs[2 * SETTINGS_MAC_LEN] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+  cal_model_t cal = make_cal();
+  settings_fake_nvs_put(&fake, "comm", "peers", macs, sizeof(macs));
+  settings_fake_nvs_put(&fake, "cal", "model", &cal, sizeof(cal));
+
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_MIGRATED, settings_store_load(&store, 0));
+  TEST_ASSERT_TRUE(settings_store_dirty(&store));
+  TEST_ASSERT_EQUAL_UINT16(0, store.stats.loaded_version);
+
+  settings_t settings;
+  settings_store_get(&store, &settings);
+  TEST_ASSERT_EQUAL_UINT8(2, settings.peer_count);
+  TEST_ASSERT_EQUAL_MEMORY(&macs[SETTINGS_MAC_LEN], settings.peers[1], SETTINGS_MAC_LEN);
+  TEST_ASSERT_EQUAL_UINT8(CAL_MODEL_LINEAR, settings.cal.type);
+}
+
+static void test_button_hammering_coalesces_writes(void) {
+  // skenario 60 s: unit ditekan 25x dalam 5 s, tare 3x, ganti peer (sekali dengan nilai sama)
+  const uint8_t macs[2 * SETTINGS_MAC_LEN] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+  cal_model_t cal = make_cal();
+  settings_fake_nvs_put(&fake, "comm", "peers", macs, sizeof(macs));
+  settings_fake_nvs_put(&fake, "cal", "model", &cal, sizeof(cal));
+  settings_store_load(&store, 0);
+
+  for (uint32_t t = 0; t < 60000; t += 100) {
+    if (t >= 1000 && t < 6000 && t % 200 == 0) settings_store_set_unit(&store, (uint8_t) ((t / 200) % 3), t);
+    if (t == 20000 || t == 20500 || t == 21000) settings_store_set_tare(&store, (float) t / 1000.0f, t);
+    if (t == 40000 || t == 40100) settings_store_set_display_peer(&store, 1, t);
+    if (t % 1000 == 0) settings_store_poll(&store, t);
+  }
+
+  settings_stats_t stats;
+  settings_fake_stats_t flash;
+  settings_store_get_stats(&store, &stats);
+  settings_fake_nvs_get_stats(&fake, &flash);
+  TEST_ASSERT_EQUAL_UINT32(30, stats.updates);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.unchanged);
+  TEST_ASSERT_EQUAL_UINT32(27, stats.coalesced);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.flushes);
+  TEST_ASSERT_EQUAL_UINT32(3, flash.writes);
+  // 3 tulis blob = 864 byte flash, vs 8640 jika tiap perubahan ditulis langsung
+  TEST_ASSERT_EQUAL_UINT64(864, flash.flash_bytes);
+  TEST_ASSERT_FALSE(settings_store_dirty(&store));
+}
+
+static void test_debounce_and_max_delay(void) {
+  settings_store_load(&store, 0);
+  settings_store_set_unit(&store, 1, 0);
+  TEST_ASSERT_FALSE(settings_store_due(&store, SETTINGS_DEBOUNCE_MS - 1));
+  TEST_ASSERT_TRUE(settings_store_due(&store, SETTINGS_DEBOUNCE_MS));
+
+  // perubahan terus-menerus tetap ditulis paling lambat max delay setelah perubahan pertama
+  for (uint32_t t = 0; t < SETTINGS_MAX_DELAY_MS; t += 500) {
+    settings_store_set_unit(&store, (uint8_t) (t / 500 % 2), t);
+    TEST_ASSERT_FALSE(settings_store_poll(&store, t));
+  }
+  TEST_ASSERT_TRUE(settings_store_poll(&store, SETTINGS_MAX_DELAY_MS));
+  TEST_ASSERT_FALSE(settings_store_dirty(&store));
+}
+
+static void test_failed_write_retried(void) {
+  settings_store_load(&store, 0);
+  settings_store_set_unit(&store, 2, 0);
+  fake.fail_next_writes = 1;
+  settings_store_poll(&store, SETTINGS_DEBOUNCE_MS);
+  TEST_ASSERT_TRUE(settings_store_dirty(&store));
+  TEST_ASSERT_EQUAL_UINT32(1, store.stats.flush_errors);
+
+  TEST_ASSERT_TRUE(settings_store_poll(&store, SETTINGS_DEBOUNCE_MS + 1000));
+  TEST_ASSERT_FALSE(settings_store_dirty(&store));
+  TEST_ASSERT_EQUAL(SETTINGS_IO_OK, settings_store_flush(&store));
+}
+
+static void test_survives_reboot(void) {
+  char path[] = "/tmp/settings_nvs_XXXXXX";
+  int fd = mkstemp(path);
+  TEST_ASSERT_TRUE(fd >= 0);
+  close(fd);
+  unlink(path);
+
+  reboot(&fake, path);
+  settings_store_load(&store, 0);
+  cal_model_t cal = make_cal();
+  const uint8_t mac[SETTINGS_MAC_LEN] = { 0x24, 0x6F, 0x28, 0xA1, 0xB2, 0xC3 };
+  settings_store_set_unit(&store, 1, 0);
+  settings_store_set_tare(&store, 12.5f, 0);
+  settings_store_set_cal(&store, &cal, 0);
+  TEST_ASSERT_TRUE(settings_store_add_peer(&store, mac, 0));
+  TEST_ASSERT_FALSE(settings_store_add_peer(&store, mac, 0));
+  TEST_ASSERT_EQUAL(SETTINGS_IO_OK, settings_store_flush(&store));
+
+  settings_fake_nvs_t after;
+  reboot(&after, path);
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_OK, settings_store_load(&store, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, store.stats.backend_reads);
+  settings_t settings;
+  settings_store_get(&store, &settings);
+  TEST_ASSERT_EQUAL_UINT8(1, settings.unit);
+  TEST_ASSERT_EQUAL_FLOAT(12.5f, settings.tare_units);
+  TEST_ASSERT_EQUAL_UINT8(1, settings.peer_count);
+  TEST_ASSERT_EQUAL_MEMORY(mac, settings.peers[0], SETTINGS_MAC_LEN);
+  TEST_ASSERT_EQUAL_FLOAT(0.001f, settings.cal.slope);
+  unlink(path);
+}
+
+static void test_shorter_blob_from_older_firmware(void) {
+  // firmware lama belum punya field cal: sisa struct diisi default lalu ditulis ulang
+  settings_blob_t blob;
+  memset(&blob, 0, sizeof(blob));
+  blob.data.unit = 2;
+  blob.data.tare_units = 3.0f;
+  blob.header.magic = SETTINGS_MAGIC;
+  blob.header.version = SETTINGS_VERSION;
+  blob.header.size = offsetof(settings_t, cal);
+  blob.header.crc = comm_codec_crc16((const uint8_t*) &blob.data, blob.header.size);
+  settings_fake_nvs_put(&fake, SETTINGS_NAMESPACE, SETTINGS_KEY, &blob, sizeof(settings_header_t) + blob.header.size);
+
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_MIGRATED, settings_store_load(&store, 0));
+  settings_t settings;
+  settings_store_get(&store, &settings);
+  TEST_ASSERT_EQUAL_UINT8(2, settings.unit);
+  TEST_ASSERT_EQUAL_FLOAT(3.0f, settings.tare_units);
+  TEST_ASSERT_EQUAL_UINT8(CAL_MODEL_NONE, settings.cal.type);
+  TEST_ASSERT_TRUE(settings_store_dirty(&store));
+}
+
+static void test_corrupt_or_newer_blob_falls_back(void) {
+  settings_store_load(&store, 0);
+  settings_store_set_unit(&store, 1, 0);
+  settings_store_flush(&store);
+
+  settings_blob_t blob;
+  size_t len = sizeof(blob);
+  TEST_ASSERT_EQUAL(SETTINGS_IO_OK, backend->ops->read(backend->self, SETTINGS_NAMESPACE, SETTINGS_KEY, &blob, &len));
+
+  settings_blob_t bad = blob;
+  bad.data.unit ^= 1;
+  settings_fake_nvs_put(&fake, SETTINGS_NAMESPACE, SETTINGS_KEY, &bad, len);
+  settings_store_init(&store, backend, NULL);
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_CORRUPT, settings_store_load(&store, 0));
+
+  bad = blob;
+  bad.header.version = SETTINGS_VERSION + 1;
+  settings_fake_nvs_put(&fake, SETTINGS_NAMESPACE, SETTINGS_KEY, &bad, len);
+  settings_store_init(&store, backend, NULL);
+  TEST_ASSERT_EQUAL(SETTINGS_LOAD_CORRUPT, settings_store_load(&store, 0));
+  settings_t settings;
+  settings_store_get(&store, &settings);
+  TEST_ASSERT_EQUAL_UINT8(0, settings.unit);
+  TEST_ASSERT_EQUAL_STRING("CORRUPT", settings_load_result_name(SETTINGS_LOAD_CORRUPT));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_defaults_when_empty);
+  RUN_TEST(test_legacy_keys_imported);
+  RUN_TEST(test_button_hammering_coalesces_writes);
+  RUN_TEST(test_debounce_and_max_delay);
+  RUN_TEST(test_failed_write_retried);
+  RUN_TEST(test_survives_reboot);
+  RUN_TEST(test_shorter_blob_from_older_firmware);
+  RUN_TEST(test_corrupt_or_newer_blob_falls_back);
+  return UNITY_END();
+}
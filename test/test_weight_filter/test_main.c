@@ -0,0 +1,324 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "sub_main/weight_filter.h"
+#include "trace_fixture.h"
+
+#define RAMP_UNITS_PER_S 10.0f
+#define SETTLE_BAND      25.0f  // 5% dari step 500 g
+#define NOISE_WARMUP     16     // sample awal segmen yang tidak ikut rms (jendela terbesar)
+#define BENCH_PASSES     2000   // replay trace berulang untuk benchmark
+
+typedef struct {
+  const char* name;
+  weight_filter_config_t config;
+  bool use_preset;
+  main_state_t preset;
+} replay_case_t;
+
+typedef struct {
+  float noise_rms;   // beban diam (IDLE + ekor STEP), error terhadap beban acuan
+  uint32_t rise;     // sample sampai output pertama kali masuk SETTLE_BAND setelah step (latency)
+  uint32_t settle;   // sample sampai output tetap di dalam SETTLE_BAND (spike / ringing ikut dihitung)
+  uint32_t release;  // settle untuk beban diangkat
+  float ramp_lag;    // rata-rata (acuan - output) saat menuang
+  float sparse_max;  // error maksimum saat stream jarang
+} replay_result_t;
+
+static weight_filter_t filter;
+
+enum { CASE_RAW, CASE_AVG8, CASE_MEDIAN5, CASE_AB, CASE_NORMAL, CASE_CAL, REPLAY_CASES };
+
+// preset diambil dari weight_filter_preset(), bukan disalin ke sini; raw = tanpa stage
+static const replay_case_t replay_cases[REPLAY_CASES] = {
+  [CASE_RAW]     = { "raw", { .stage_count = 0 } },
+  [CASE_AVG8]    = { "avg8", { .stages = { { .type = WEIGHT_FILTER_MOVING_AVG, .window = 8 } }, .stage_count = 1 } },
+  [CASE_MEDIAN5] = { "median5", { .stages = { { .type = WEIGHT_FILTER_MEDIAN, .window = 5 } }, .stage_count = 1 } },
+  [CASE_AB]      = { "ab", { .stages = { { .type = WEIGHT_FILTER_ALPHA_BETA, .alpha = 0.35f, .beta = 0.02f } },
+                             .stage_count = 1 } },
+  [CASE_NORMAL]  = { "normal", .use_preset = true, .preset = NORMAL_MODE },
+  [CASE_CAL]     = { "cal", .use_preset = true, .preset = CALIBRATION_MODE },
+};
+
+// forward declaration
+static void init_single(weight_filter_type_t type, uint8_t window, float alpha, float beta);
+static const weight_filter_config_t* case_config(int index);
+static float trace_truth(uint16_t index);
+static uint32_t rise_samples(const float* out, const trace_segment_t* segment);
+static uint32_t settle_samples(const float* out, const trace_segment_t* segment);
+static replay_result_t replay(const weight_filter_config_t* config);
+static double bench_ns_per_sample(const weight_filter_config_t* config);
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static void init_single(weight_filter_type_t type, uint8_t window, float alpha, float beta) {
+  weight_filter_config_t config = {
+    .stages = { { .type = (uint8_t) type, .window = window, .alpha = alpha, .beta = beta } },
+    .stage_count = 1,
+  };
+  weight_filter_init(&filter, &config);
+}
+
+static const weight_filter_config_t* case_config(int index) {
+  const replay_case_t* replay_case = &replay_cases[index];
+  return replay_case->use_preset ? weight_filter_preset(replay_case->preset) : &replay_case->config;
+}
+
+static float trace_truth(uint16_t index) {
+  for (int s = 0; s < TRACE_SEGMENT_COUNT; s++) {
+    const trace_segment_t* segment = &trace_segments[s];
+    if (index < segment->first || index >= segment->first + segment->count) continue;
+    float dt = (float) (trace_samples[index].time_ms - trace_samples[segment->first].time_ms) * 1e-3f;
+    return segment->level + segment->slope_per_s * dt;
+  }
+  return 0.0f;
+}
+
+static uint32_t rise_samples(const float* out, const trace_segment_t* segment) {
+  for (uint16_t i = 0; i < segment->count; i++) {
+    if (fabsf(out[segment->first + i] - segment->level) <= SETTLE_BAND) return i + 1;
+  }
+  return segment->count;
+}
+
+static uint32_t settle_samples(const float* out, const trace_segment_t* segment) {
+  // sample terakhir yang masih di luar band, dihitung dari awal segmen
+  uint32_t settle = 0;
+  for (uint16_t i = 0; i < segment->count; i++) {
+    if (fabsf(out[segment->first + i] - segment->level) > SETTLE_BAND) settle = i + 1;
+  }
+  return settle;
+}
+
+static replay_result_t replay(const weight_filter_config_t* config) {
+  static float out[TRACE_SAMPLE_COUNT];
+  weight_filter_init(&filter, config);
+  for (uint16_t i = 0; i < TRACE_SAMPLE_COUNT; i++) {
+    out[i] = weight_filter_push(&filter, trace_samples[i].units, (int64_t) trace_samples[i].time_ms * 1000);
+  }
+
+  replay_result_t result = { 0 };
+  const trace_segment_t* idle = &trace_segments[TRACE_IDLE];
+  const trace_segment_t* step = &trace_segments[TRACE_STEP];
+  double sum_sq = 0.0;
+  uint32_t n = 0;
+  for (uint16_t i = idle->first + NOISE_WARMUP; i < idle->first + idle->count; i++, n++) {
+    sum_sq += (out[i] - trace_truth(i)) * (out[i] - trace_truth(i));
+  }
+  for (uint16_t i = step->first + step->count / 2; i < step->first + step->count; i++, n++) {
+    sum_sq += (out[i] - trace_truth(i)) * (out[i] - trace_truth(i));
+  }
+  result.noise_rms = (float) sqrt(sum_sq / n);
+  result.rise = rise_samples(out, step);
+  result.settle = settle_samples(out, step);
+  result.release = settle_samples(out, &trace_segments[TRACE_RELEASE]);
+
+  const trace_segment_t* ramp = &trace_segments[TRACE_RAMP];
+  double lag = 0.0;
+  for (uint16_t i = ramp->first + NOISE_WARMUP; i < ramp->first + ramp->count; i++) lag += trace_truth(i) - out[i];
+  result.ramp_lag = (float) (lag / (ramp->count - NOISE_WARMUP));
+
+  const trace_segment_t* sparse = &trace_segments[TRACE_SPARSE];
+  for (uint16_t i = sparse->first; i < sparse->first + sparse->count; i++) {
+    float error = fabsf(out[i] - trace_truth(i));
+    if (error > result.sparse_max) result.sparse_max = error;
+  }
+  return result;
+}
+
+static double bench_ns_per_sample(const weight_filter_config_t* config) {
+  weight_filter_init(&filter, config);
+  struct timespec start, end;
+  volatile float sink = 0.0f;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    for (uint16_t i = 0; i < TRACE_SAMPLE_COUNT; i++) {
+      // jam maju terus antar pass supaya alpha-beta tidak mulai ulang tiap pass
+      int64_t now_us = ((int64_t) pass * 30000 + trace_samples[i].time_ms) * 1000;
+      sink = weight_filter_push(&filter, trace_samples[i].units, now_us);
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  (void) sink;
+  double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+  return ns / ((double) BENCH_PASSES * TRACE_SAMPLE_COUNT);
+}
+
+static void test_moving_average(void) {
+  init_single(WEIGHT_FILTER_MOVING_AVG, 4, 0.0f, 0.0f);
+  TEST_ASSERT_EQUAL_FLOAT(4.0f, weight_filter_push(&filter, 4.0f, 0));
+  TEST_ASSERT_EQUAL_FLOAT(6.0f, weight_filter_push(&filter, 8.0f, 0));
+  weight_filter_push(&filter, 0.0f, 0);
+  TEST_ASSERT_EQUAL_FLOAT(4.0f, weight_filter_push(&filter, 4.0f, 0));
+  // sample pertama keluar dari jendela
+  TEST_ASSERT_EQUAL_FLOAT(5.0f, weight_filter_push(&filter, 8.0f, 0));
+}
+
+static void test_moving_average_does_not_drift(void) {
+  // running sum dihitung ulang berkala: setelah jutaan sample tetap tepat
+  init_single(WEIGHT_FILTER_MOVING_AVG, 8, 0.0f, 0.0f);
+  for (int i = 0; i < 1000000; i++) weight_filter_push(&filter, 1000.0f + (float) (i % 7) * 0.1f, 0);
+  for (int i = 0; i < 8; i++) weight_filter_push(&filter, 0.25f, 0);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.25f, filter.output);
+  // sisa error float hilang saat sum dihitung ulang (tiap 64 putaran jendela)
+  for (int i = 0; i < 64 * 8; i++) weight_filter_push(&filter, 0.25f, 0);
+  TEST_ASSERT_EQUAL_FLOAT(0.25f, filter.output);
+}
+
+static void test_median_drops_spikes(void) {
+  init_single(WEIGHT_FILTER_MEDIAN, 5, 0.0f, 0.0f);
+  const float in[] = { 100.0f, 101.0f, 99.0f, 100.0f, 500.0f, 100.0f, -300.0f, 101.0f };
+  for (size_t i = 0; i < sizeof(in) / sizeof(in[0]); i++) {
+    float out = weight_filter_push(&filter, in[i], 0);
+    if (i >= 2) TEST_ASSERT_FLOAT_WITHIN(1.0f, 100.0f, out);
+  }
+}
+
+static void test_alpha_beta_restarts_after_gap(void) {
+  init_single(WEIGHT_FILTER_ALPHA_BETA, 0, 0.35f, 0.02f);
+  TEST_ASSERT_EQUAL_FLOAT(10.0f, weight_filter_push(&filter, 10.0f, 1000000));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 13.5f, weight_filter_push(&filter, 20.0f, 1100000));
+  // stream putus > 2 s: langsung pakai sample baru
+  TEST_ASSERT_EQUAL_FLOAT(50.0f, weight_filter_push(&filter, 50.0f, 3200000));
+  // waktu mundur (peer berganti / jam di-reset) juga mulai ulang
+  TEST_ASSERT_EQUAL_FLOAT(70.0f, weight_filter_push(&filter, 70.0f, 100));
+}
+
+static void test_alpha_beta_same_timestamp_keeps_velocity(void) {
+  init_single(WEIGHT_FILTER_ALPHA_BETA, 0, 0.5f, 0.1f);
+  weight_filter_push(&filter, 0.0f, 0);
+  weight_filter_push(&filter, 1.0f, 100000);
+  float v = filter.stages[0].v;
+  weight_filter_push(&filter, 5.0f, 100000);
+  TEST_ASSERT_EQUAL_FLOAT(v, filter.stages[0].v);
+  TEST_ASSERT_FALSE(isnan(filter.output));
+}
+
+static void test_ramp_tracks_across_rate_change(void) {
+  // ramp 10 units/s; stream 100 ms lalu campuran 200 / 500 ms (rate control, batch, frame hilang)
+  init_single(WEIGHT_FILTER_ALPHA_BETA, 0, 0.35f, 0.02f);
+  int64_t now_us = 0;
+  for (int i = 0; i < 600; i++) {
+    now_us += 100000;
+    weight_filter_push(&filter, RAMP_UNITS_PER_S * (float) now_us * 1e-6f, now_us);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, RAMP_UNITS_PER_S, filter.stages[0].v);
+
+  float max_error = 0.0f;
+  for (int i = 0; i < 200; i++) {
+    now_us += (i % 3 == 0) ? 500000 : 200000;
+    float truth = RAMP_UNITS_PER_S * (float) now_us * 1e-6f;
+    float error = fabsf(weight_filter_push(&filter, truth, now_us) - truth);
+    if (error > max_error) max_error = error;
+  }
+  // sebelum dt diukur, prediksi per sample membuat error sampai 3.79 units
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, max_error);
+}
+
+static void test_presets_and_invalid_stages(void) {
+  weight_filter_init(&filter, NULL);
+  TEST_ASSERT_EQUAL_UINT8(2, filter.stage_count);
+  TEST_ASSERT_EQUAL_UINT8(WEIGHT_FILTER_MEDIAN, filter.stages[0].config.type);
+  TEST_ASSERT_EQUAL_UINT8(WEIGHT_FILTER_ALPHA_BETA, filter.stages[1].config.type);
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, weight_filter_delay_samples(&filter));
+
+  weight_filter_init(&filter, weight_filter_preset(CALIBRATION_MODE));
+  // median 3 (1 sample) + moving average 8 (3.5 sample)
+  TEST_ASSERT_EQUAL_FLOAT(4.5f, weight_filter_delay_samples(&filter));
+
+  weight_filter_config_t config = {
+    .stages = {
+      { .type = WEIGHT_FILTER_MEDIAN, .window = WEIGHT_FILTER_WINDOW_MAX + 1 },
+      { .type = WEIGHT_FILTER_ALPHA_BETA, .alpha = 0.0f },
+      { .type = WEIGHT_FILTER_MOVING_AVG, .window = 2 },
+    },
+    .stage_count = 3,
+  };
+  weight_filter_init(&filter, &config);
+  TEST_ASSERT_EQUAL_UINT8(1, filter.stage_count);
+  TEST_ASSERT_EQUAL_STRING("AVG", weight_filter_type_name(filter.stages[0].config.type));
+  TEST_ASSERT_EQUAL_STRING("UNKNOWN", weight_filter_type_name(WEIGHT_FILTER_TYPE_COUNT));
+}
+
+static void test_reset_clears_history(void) {
+  weight_filter_init(&filter, weight_filter_preset(CALIBRATION_MODE));
+  for (int i = 0; i < 20; i++) weight_filter_push(&filter, 500.0f, (int64_t) i * 50000);
+  weight_filter_reset(&filter);
+  TEST_ASSERT_EQUAL_UINT32(0, filter.samples);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, weight_filter_push(&filter, 0.0f, 0));
+}
+
+static void test_replay_trace(void) {
+  replay_result_t results[REPLAY_CASES];
+  for (int i = 0; i < REPLAY_CASES; i++) {
+    results[i] = replay(case_config(i));
+    char line[128];
+    snprintf(line, sizeof(line), "%-8s rms %5.2f  rise %u  settle %3u  release %3u  ramp lag %4.2f  sparse max %6.2f",
+             replay_cases[i].name, results[i].noise_rms, results[i].rise, results[i].settle, results[i].release,
+             results[i].ramp_lag, results[i].sparse_max);
+    TEST_MESSAGE(line);
+  }
+  const replay_result_t* raw = &results[CASE_RAW];
+  const replay_result_t* median = &results[CASE_MEDIAN5];
+  const replay_result_t* normal = &results[CASE_NORMAL];
+  const replay_result_t* cal = &results[CASE_CAL];
+
+  for (int i = CASE_RAW + 1; i < REPLAY_CASES; i++) TEST_ASSERT_TRUE(results[i].noise_rms < raw->noise_rms);
+  // tanpa median, spike 2% membuat angka keluar band sepanjang segmen
+  TEST_ASSERT_TRUE(median->sparse_max < 15.0f);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(6, median->settle);
+
+  // preset normal: noise turun > 10x dari raw, dibayar rise 9 sample (~110 ms di batch 12 ms)
+  TEST_ASSERT_TRUE(normal->noise_rms < raw->noise_rms / 10.0f);
+  TEST_ASSERT_TRUE(normal->noise_rms < median->noise_rms);
+  TEST_ASSERT_GREATER_THAN_UINT32(median->rise, normal->rise);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(10, normal->rise);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(30, normal->settle);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(40, normal->release);
+  TEST_ASSERT_TRUE(fabsf(normal->ramp_lag) < 1.0f);
+  // dt diukur: stream yang tiba-tiba jarang tidak membuat estimasi melenceng
+  TEST_ASSERT_TRUE(normal->sparse_max < 20.0f);
+
+  // preset kalibrasi: paling diam, lag ramp lebih besar (moving average)
+  TEST_ASSERT_TRUE(cal->noise_rms < normal->noise_rms);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(10, cal->settle);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(10, cal->release);
+  TEST_ASSERT_TRUE(cal->ramp_lag > normal->ramp_lag);
+}
+
+static void test_stage_cost(void) {
+  for (int i = CASE_RAW + 1; i < REPLAY_CASES; i++) {
+    double ns = bench_ns_per_sample(case_config(i));
+    char line[64];
+    snprintf(line, sizeof(line), "%-8s %.1f ns/sample", replay_cases[i].name, ns);
+    TEST_MESSAGE(line);
+    // batas longgar, hanya menangkap regresi kasar (mis. median jadi sort penuh per sample)
+    TEST_ASSERT_TRUE(ns < 1000.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_moving_average);
+  RUN_TEST(test_moving_average_does_not_drift);
+  RUN_TEST(test_median_drops_spikes);
+  RUN_TEST(test_alpha_beta_restarts_after_gap);
+  RUN_TEST(test_alpha_beta_same_timestamp_keeps_velocity);
+  RUN_TEST(test_ramp_tracks_across_rate_change);
+  RUN_TEST(test_presets_and_invalid_stages);
+  RUN_TEST(test_reset_clears_history);
+  RUN_TEST(test_replay_trace);
+  RUN_TEST(test_stage_cost);
+  return UNITY_END();
+}
@@ -0,0 +1,190 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#ifndef TRACE_FIXTURE_H
+#define TRACE_FIXTURE_H
+
+// Trace replay untuk test_weight_filter, dibekukan di sini supaya angka test tidak ikut berubah
+// kalau generator-nya diubah. Bentuk stream mengikuti Device A: batch 8 sample berjarak 12 ms,
+// lalu satu segmen sample jarang 200 / 500 ms (rate control). Noise load cell rms 6 g,
+// 2% spike 150..400 g, step 500 g dengan ringing mekanis 12 Hz.
+//
+// Segmen (beban acuan = level + slope * (t - t sample pertama segmen)):
+//   IDLE     timbangan kosong
+//   STEP     beban 500 g diletakkan
+//   SPARSE   beban diam, stream jarang
+//   RAMP     menuang 40 g/s
+//   RELEASE  beban diangkat
+
+#include <stdint.h>
+
+typedef struct {
+  uint32_t time_ms;
+  float units;
+} trace_sample_t;
+
+typedef struct {
+  const char* name;
+  uint16_t first;
+  uint16_t count;
+  float level;
+  float slope_per_s;
+} trace_segment_t;
+
+enum { TRACE_IDLE, TRACE_STEP, TRACE_SPARSE, TRACE_RAMP, TRACE_RELEASE, TRACE_SEGMENT_COUNT };
+
+static const trace_segment_t trace_segments[TRACE_SEGMENT_COUNT] = {
+  [TRACE_IDLE]    = { "IDLE",    0,   160, 0.0f,   0.0f },
+  [TRACE_STEP]    = { "STEP",    160, 160, 500.0f, 0.0f },
+  [TRACE_SPARSE]  = { "SPARSE",  320, 40,  500.0f, 0.0f },
+  [TRACE_RAMP]    = { "RAMP",    360, 320, 500.0f, 40.0f },
+  [TRACE_RELEASE] = { "RELEASE", 680, 160, 0.0f,   0.0f },
+};
+
+static const trace_sample_t trace_samples[] = {
+  { 0, -1.2f }, { 12, 6.3f }, { 24, 3.8f }, { 36, -13.7f }, { 48, -5.1f }, { 60, -1.8f },
+  { 72, -7.6f }, { 84, -0.6f }, { 96, 2.7f }, { 108, 4.5f }, { 120, -0.1f }, { 132, -0.5f },
+  { 144, -9.8f }, { 156, -3.5f }, { 168, -15.9f }, { 180, 0.5f }, { 192, -2.7f }, { 204, 5.5f },
+  { 216, 9.4f }, { 228, 4.4f }, { 240, -2.5f }, { 252, -13.7f }, { 264, -1.2f }, { 276, 4.9f },
+  { 288, -8.1f }, { 300, 4.0f }, { 312, -4.3f }, { 324, 2.4f }, { 336, 3.1f }, { 348, -0.4f },
+  { 360, -4.7f }, { 372, 7.3f }, { 384, -9.9f }, { 396, -9.3f }, { 408, 6.8f }, { 420, 3.4f },
+  { 432, -2.7f }, { 444, -6.6f }, { 456, 3.4f }, { 468, -3.7f }, { 480, 6.1f }, { 492, -282.6f },
+  { 504, 6.0f }, { 516, -2.8f }, { 528, -4.0f }, { 540, 4.5f }, { 552, -6.8f }, { 564, 327.6f },
+  { 576, 4.9f }, { 588, 6.2f }, { 600, -3.2f }, { 612, 13.9f }, { 624, -2.7f }, { 636, -7.1f },
+  { 648, -10.3f }, { 660, 3.2f }, { 672, -3.9f }, { 684, -4.1f }, { 696, -2.8f }, { 708, 0.4f },
+  { 720, -4.3f }, { 732, 5.1f }, { 744, -4.8f }, { 756, -4.7f }, { 768, -4.5f }, { 780, 6.0f },
+  { 792, -0.6f }, { 804, 2.5f }, { 816, -3.4f }, { 828, 4.5f }, { 840, -4.5f }, { 852, 3.7f },
+  { 864, 2.4f }, { 876, 2.2f }, { 888, 5.5f }, { 900, 4.7f }, { 912, -2.3f }, { 924, 0.6f },
+  { 936, -9.6f }, { 948, -2.6f }, { 960, 1.2f }, { 972, -8.0f }, { 984, 2.0f }, { 996, 3.8f },
+  { 1008, 1.3f }, { 1020, -18.2f }, { 1032, 0.6f }, { 1044, 4.3f }, { 1056, -2.5f }, { 1068, -9.4f },
+  { 1080, 6.1f }, { 1092, -0.2f }, { 1104, 4.2f }, { 1116, -3.2f }, { 1128, 4.6f }, { 1140, 2.0f },
+  { 1152, 5.8f }, { 1164, 3.6f }, { 1176, 5.8f }, { 1188, 1.3f }, { 1200, -8.8f }, { 1212, -1.6f },
+  { 1224, -6.0f }, { 1236, 5.9f }, { 1248, 3.7f }, { 1260, 2.6f }, { 1272, -8.2f }, { 1284, 12.9f },
+  { 1296, -0.8f }, { 1308, -6.5f }, { 1320, -4.8f }, { 1332, -0.6f }, { 1344, -7.0f }, { 1356, -8.9f },
+  { 1368, -6.1f }, { 1380, 1.1f }, { 1392, -1.5f }, { 1404, -1.6f }, { 1416, -0.9f }, { 1428, -5.7f },
+  { 1440, 11.8f }, { 1452, 8.7f }, { 1464, -5.2f }, { 1476, 6.4f }, { 1488, -4.3f }, { 1500, -7.2f },
+  { 1512, 2.3f }, { 1524, 1.4f }, { 1536, -6.4f }, { 1548, 5.8f }, { 1560, -0.3f }, { 1572, -9.3f },
+  { 1584, 8.8f }, { 1596, 12.2f }, { 1608, 3.6f }, { 1620, -3.0f }, { 1632, -1.1f }, { 1644, -5.6f },
+  { 1656, -1.9f }, { 1668, 3.0f }, { 1680, -4.0f }, { 1692, 2.4f }, { 1704, -10.9f }, { 1716, -4.0f },
+  { 1728, 1.9f }, { 1740, -0.3f }, { 1752, -5.4f }, { 1764, -13.8f }, { 1776, -6.1f }, { 1788, 6.4f },
+  { 1800, 1.8f }, { 1812, -1.2f }, { 1824, 0.8f }, { 1836, -1.7f }, { 1848, 2.9f }, { 1860, -3.9f },
+  { 1872, -10.7f }, { 1884, -4.5f }, { 1896, 0.7f }, { 1908, -1.1f }, { 1920, 547.2f }, { 1932, 524.3f },
+  { 1944, 174.3f }, { 1956, 472.8f }, { 1968, 486.4f }, { 1980, 503.9f }, { 1992, 510.7f }, { 2004, 498.4f },
+  { 2016, 493.8f }, { 2028, 500.3f }, { 2040, 501.5f }, { 2052, 495.9f }, { 2064, 502.8f }, { 2076, 496.9f },
+  { 2088, 497.3f }, { 2100, 493.8f }, { 2112, 495.7f }, { 2124, 501.8f }, { 2136, 492.3f }, { 2148, 498.5f },
+  { 2160, 496.7f }, { 2172, 502.1f }, { 2184, 499.8f }, { 2196, 100.6f }, { 2208, 495.9f }, { 2220, 493.8f },
+  { 2232, 498.1f }, { 2244, 508.8f }, { 2256, 498.7f }, { 2268, 504.4f }, { 2280, 497.7f }, { 2292, 495.8f },
+  { 2304, 504.9f }, { 2316, 492.1f }, { 2328, 500.9f }, { 2340, 501.6f }, { 2352, 500.7f }, { 2364, 497.2f },
+  { 2376, 501.3f }, { 2388, 495.8f }, { 2400, 507.8f }, { 2412, 496.7f }, { 2424, 505.2f }, { 2436, 519.1f },
+  { 2448, 499.3f }, { 2460, 508.9f }, { 2472, 494.9f }, { 2484, 486.6f }, { 2496, 504.3f }, { 2508, 497.1f },
+  { 2520, 507.3f }, { 2532, 494.1f }, { 2544, 499.2f }, { 2556, 514.5f }, { 2568, 501.9f }, { 2580, 509.0f },
+  { 2592, 853.4f }, { 2604, 495.6f }, { 2616, 493.4f }, { 2628, 500.0f }, { 2640, 501.1f }, { 2652, 491.7f },
+  { 2664, 503.5f }, { 2676, 494.1f }, { 2688, 498.3f }, { 2700, 493.1f }, { 2712, 207.6f }, { 2724, 487.3f },
+  { 2736, 505.3f }, { 2748, 483.7f }, { 2760, 497.7f }, { 2772, 492.3f }, { 2784, 496.1f }, { 2796, 504.4f },
+  { 2808, 508.8f }, { 2820, 494.1f }, { 2832, 493.1f }, { 2844, 502.8f }, { 2856, 501.9f }, { 2868, 493.9f },
+  { 2880, 503.0f }, { 2892, 499.5f }, { 2904, 491.8f }, { 2916, 508.5f }, { 2928, 505.5f }, { 2940, 502.3f },
+  { 2952, 494.2f }, { 2964, 505.0f }, { 2976, 484.8f }, { 2988, 501.5f }, { 3000, 496.5f }, { 3012, 508.1f },
+  { 3024, 494.2f }, { 3036, 502.5f }, { 3048, 495.9f }, { 3060, 497.8f }, { 3072, 506.5f }, { 3084, 502.8f },
+  { 3096, 499.5f }, { 3108, 500.3f }, { 3120, 510.2f }, { 3132, 503.1f }, { 3144, 512.6f }, { 3156, 501.0f },
+  { 3168, 495.9f }, { 3180, 494.6f }, { 3192, 498.0f }, { 3204, 498.3f }, { 3216, 485.3f }, { 3228, 507.4f },
+  { 3240, 500.1f }, { 3252, 489.6f }, { 3264, 494.2f }, { 3276, 497.8f }, { 3288, 498.6f }, { 3300, 504.2f },
+  { 3312, 512.2f }, { 3324, 494.1f }, { 3336, 500.4f }, { 3348, 498.1f }, { 3360, 493.0f }, { 3372, 503.7f },
+  { 3384, 509.4f }, { 3396, 512.0f }, { 3408, 501.5f }, { 3420, 498.0f }, { 3432, 496.8f }, { 3444, 499.2f },
+  { 3456, 491.7f }, { 3468, 511.5f }, { 3480, 495.2f }, { 3492, 503.2f }, { 3504, 498.3f }, { 3516, 499.4f },
+  { 3528, 507.5f }, { 3540, 497.4f }, { 3552, 499.9f }, { 3564, 504.2f }, { 3576, 496.9f }, { 3588, 502.8f },
+  { 3600, 506.6f }, { 3612, 494.2f }, { 3624, 501.8f }, { 3636, 502.6f }, { 3648, 493.5f }, { 3660, 496.4f },
+  { 3672, 504.1f }, { 3684, 503.4f }, { 3696, 497.0f }, { 3708, 127.0f }, { 3720, 487.6f }, { 3732, 501.2f },
+  { 3744, 496.3f }, { 3756, 507.6f }, { 3768, 511.0f }, { 3780, 494.2f }, { 3792, 496.4f }, { 3804, 501.9f },
+  { 3816, 492.2f }, { 3828, 501.7f }, { 4340, 501.4f }, { 4540, 489.9f }, { 4740, 494.7f }, { 5240, 516.4f },
+  { 5440, 487.7f }, { 5640, 489.4f }, { 6140, 491.1f }, { 6340, 492.1f }, { 6540, 490.5f }, { 7040, 494.1f },
+  { 7240, 503.7f }, { 7440, 508.1f }, { 7940, 504.2f }, { 8140, 485.1f }, { 8340, 493.9f }, { 8840, 513.7f },
+  { 9040, 497.5f }, { 9240, 497.5f }, { 9740, 501.7f }, { 9940, 490.2f }, { 10140, 492.3f }, { 10640, 502.0f },
+  { 10840, 495.6f }, { 11040, 497.8f }, { 11540, 494.5f }, { 11740, 506.3f }, { 11940, 499.5f }, { 12440, 752.4f },
+  { 12640, 496.3f }, { 12840, 496.6f }, { 13340, 685.1f }, { 13540, 501.1f }, { 13740, 494.6f }, { 14240, 508.7f },
+  { 14440, 496.2f }, { 14640, 506.0f }, { 15140, 497.6f }, { 15340, 500.3f }, { 15540, 506.8f }, { 16040, 496.4f },
+  { 16040, 494.5f }, { 16052, 495.3f }, { 16064, 502.5f }, { 16076, 499.5f }, { 16088, 496.1f }, { 16100, 503.3f },
+  { 16112, 504.6f }, { 16124, 509.9f }, { 16136, 499.6f }, { 16148, 498.8f }, { 16160, 503.4f }, { 16172, 507.8f },
+  { 16184, 503.2f }, { 16196, 493.3f }, { 16208, 504.6f }, { 16220, 502.6f }, { 16232, 515.0f }, { 16244, 505.0f },
+  { 16256, 504.7f }, { 16268, 504.8f }, { 16280, 514.1f }, { 16292, 513.0f }, { 16304, 514.9f }, { 16316, 511.0f },
+  { 16328, 518.9f }, { 16340, 520.9f }, { 16352, 515.3f }, { 16364, 507.9f }, { 16376, 505.7f }, { 16388, 513.9f },
+  { 16400, 518.0f }, { 16412, 522.8f }, { 16424, 518.5f }, { 16436, 521.6f }, { 16448, 512.7f }, { 16460, 523.5f },
+  { 16472, 516.5f }, { 16484, 121.9f }, { 16496, 509.6f }, { 16508, 523.9f }, { 16520, 522.9f }, { 16532, 517.7f },
+  { 16544, 514.4f }, { 16556, 523.1f }, { 16568, 515.1f }, { 16580, 526.7f }, { 16592, 515.8f }, { 16604, 512.8f },
+  { 16616, 516.9f }, { 16628, 518.0f }, { 16640, 517.5f }, { 16652, 519.5f }, { 16664, 529.8f }, { 16676, 522.5f },
+  { 16688, 539.1f }, { 16700, 527.1f }, { 16712, 527.7f }, { 16724, 532.3f }, { 16736, 528.5f }, { 16748, 539.6f },
+  { 16760, 522.3f }, { 16772, 532.3f }, { 16784, 532.6f }, { 16796, 532.8f }, { 16808, 538.8f }, { 16820, 530.6f },
+  { 16832, 530.7f }, { 16844, 533.4f }, { 16856, 537.4f }, { 16868, 535.5f }, { 16880, 527.4f }, { 16892, 529.5f },
+  { 16904, 534.9f }, { 16916, 525.1f }, { 16928, 540.7f }, { 16940, 526.9f }, { 16952, 543.2f }, { 16964, 534.9f },
+  { 16976, 534.0f }, { 16988, 541.2f }, { 17000, 546.5f }, { 17012, 537.4f }, { 17024, 532.8f }, { 17036, 538.4f },
+  { 17048, 534.4f }, { 17060, 536.7f }, { 17072, 540.6f }, { 17084, 545.9f }, { 17096, 539.6f }, { 17108, 532.7f },
+  { 17120, 549.3f }, { 17132, 552.8f }, { 17144, 537.6f }, { 17156, 543.9f }, { 17168, 549.0f }, { 17180, 549.9f },
+  { 17192, 546.3f }, { 17204, 542.7f }, { 17216, 527.8f }, { 17228, 547.2f }, { 17240, 550.4f }, { 17252, 548.8f },
+  { 17264, 552.2f }, { 17276, 543.1f }, { 17288, 547.6f }, { 17300, 541.0f }, { 17312, 552.7f }, { 17324, 550.3f },
+  { 17336, 548.5f }, { 17348, 545.7f }, { 17360, 537.2f }, { 17372, 562.6f }, { 17384, 554.4f }, { 17396, 558.0f },
+  { 17408, 555.3f }, { 17420, 556.2f }, { 17432, 551.0f }, { 17444, 559.9f }, { 17456, 561.9f }, { 17468, 556.9f },
+  { 17480, 565.9f }, { 17492, 571.9f }, { 17504, 558.1f }, { 17516, 563.7f }, { 17528, 556.4f }, { 17540, 566.0f },
+  { 17552, 563.7f }, { 17564, 548.2f }, { 17576, 573.2f }, { 17588, 547.8f }, { 17600, 568.6f }, { 17612, 572.6f },
+  { 17624, 572.7f }, { 17636, 568.3f }, { 17648, 571.2f }, { 17660, 564.0f }, { 17672, 565.8f }, { 17684, 565.0f },
+  { 17696, 566.4f }, { 17708, 563.5f }, { 17720, 572.2f }, { 17732, 576.8f }, { 17744, 572.7f }, { 17756, 558.1f },
+  { 17768, 567.8f }, { 17780, 579.6f }, { 17792, 571.8f }, { 17804, 582.3f }, { 17816, 560.6f }, { 17828, 573.9f },
+  { 17840, 577.7f }, { 17852, 572.8f }, { 17864, 567.5f }, { 17876, 574.8f }, { 17888, 575.0f }, { 17900, 572.8f },
+  { 17912, 574.9f }, { 17924, 580.5f }, { 17936, 588.0f }, { 17948, 579.7f }, { 17960, 579.6f }, { 17972, 578.9f },
+  { 17984, 584.0f }, { 17996, 581.2f }, { 18008, 586.9f }, { 18020, 578.1f }, { 18032, 580.8f }, { 18044, 579.1f },
+  { 18056, 576.8f }, { 18068, 578.2f }, { 18080, 576.9f }, { 18092, 574.6f }, { 18104, 967.9f }, { 18116, 590.7f },
+  { 18128, 590.2f }, { 18140, 581.1f }, { 18152, 589.8f }, { 18164, 577.2f }, { 18176, 573.8f }, { 18188, 589.8f },
+  { 18200, 583.7f }, { 18212, 592.2f }, { 18224, 590.4f }, { 18236, 582.0f }, { 18248, 590.1f }, { 18260, 580.2f },
+  { 18272, 583.6f }, { 18284, 581.4f }, { 18296, 589.2f }, { 18308, 593.0f }, { 18320, 597.1f }, { 18332, 593.3f },
+  { 18344, 596.6f }, { 18356, 591.0f }, { 18368, 590.0f }, { 18380, 595.6f }, { 18392, 603.9f }, { 18404, 592.3f },
+  { 18416, 600.3f }, { 18428, 601.3f }, { 18440, 592.4f }, { 18452, 595.8f }, { 18464, 597.2f }, { 18476, 598.3f },
+  { 18488, 599.0f }, { 18500, 602.6f }, { 18512, 581.5f }, { 18524, 599.1f }, { 18536, 602.7f }, { 18548, 587.8f },
+  { 18560, 599.2f }, { 18572, 1007.3f }, { 18584, 598.8f }, { 18596, 607.6f }, { 18608, 606.3f }, { 18620, 592.1f },
+  { 18632, 610.9f }, { 18644, 601.1f }, { 18656, 608.3f }, { 18668, 612.1f }, { 18680, 234.4f }, { 18692, 611.5f },
+  { 18704, 605.7f }, { 18716, 617.0f }, { 18728, 603.6f }, { 18740, 608.8f }, { 18752, 605.0f }, { 18764, 602.4f },
+  { 18776, 611.2f }, { 18788, 612.9f }, { 18800, 298.5f }, { 18812, 611.2f }, { 18824, 615.1f }, { 18836, 610.4f },
+  { 18848, 612.1f }, { 18860, 610.8f }, { 18872, 614.6f }, { 18884, 614.1f }, { 18896, 616.1f }, { 18908, 619.8f },
+  { 18920, 617.5f }, { 18932, 612.8f }, { 18944, 609.2f }, { 18956, 628.6f }, { 18968, 606.6f }, { 18980, 615.9f },
+  { 18992, 618.1f }, { 19004, 627.2f }, { 19016, 626.7f }, { 19028, 300.6f }, { 19040, 619.6f }, { 19052, 627.7f },
+  { 19064, 624.8f }, { 19076, 623.0f }, { 19088, 629.7f }, { 19100, 620.1f }, { 19112, 616.6f }, { 19124, 628.7f },
+  { 19136, 612.9f }, { 19148, 624.3f }, { 19160, 624.1f }, { 19172, 622.1f }, { 19184, 622.4f }, { 19196, 638.7f },
+  { 19208, 618.3f }, { 19220, 625.8f }, { 19232, 620.9f }, { 19244, 633.1f }, { 19256, 624.4f }, { 19268, 637.4f },
+  { 19280, 632.2f }, { 19292, 630.0f }, { 19304, 624.6f }, { 19316, 635.3f }, { 19328, 638.8f }, { 19340, 642.1f },
+  { 19352, 624.2f }, { 19364, 647.0f }, { 19376, 631.9f }, { 19388, 631.6f }, { 19400, 629.7f }, { 19412, 639.6f },
+  { 19424, 630.6f }, { 19436, 636.9f }, { 19448, 641.7f }, { 19460, 634.0f }, { 19472, 646.0f }, { 19484, 631.7f },
+  { 19496, 628.1f }, { 19508, 649.5f }, { 19520, 651.1f }, { 19532, 638.8f }, { 19544, 627.2f }, { 19556, 638.3f },
+  { 19568, 646.3f }, { 19580, 635.3f }, { 19592, 645.9f }, { 19604, 637.0f }, { 19616, 632.2f }, { 19628, 638.6f },
+  { 19640, 646.0f }, { 19652, 651.6f }, { 19664, 639.1f }, { 19676, 655.0f }, { 19688, 650.0f }, { 19700, 635.7f },
+  { 19712, 655.6f }, { 19724, 647.3f }, { 19736, 651.5f }, { 19748, 647.8f }, { 19760, 646.9f }, { 19772, 642.3f },
+  { 19784, 652.8f }, { 19796, 646.6f }, { 19808, 652.4f }, { 19820, 649.6f }, { 19832, 668.3f }, { 19844, 657.1f },
+  { 19856, 655.5f }, { 19868, 650.6f }, { 19880, -6.7f }, { 19892, -3.8f }, { 19904, -5.6f }, { 19916, 5.2f },
+  { 19928, 10.7f }, { 19940, 6.1f }, { 19952, 6.7f }, { 19964, -7.3f }, { 19976, -11.0f }, { 19988, 8.8f },
+  { 20000, -3.0f }, { 20012, 11.8f }, { 20024, 7.2f }, { 20036, -7.4f }, { 20048, 2.2f }, { 20060, 4.8f },
+  { 20072, 7.4f }, { 20084, -1.9f }, { 20096, -307.2f }, { 20108, -2.0f }, { 20120, -5.7f }, { 20132, -4.5f },
+  { 20144, 10.2f }, { 20156, -4.3f }, { 20168, -6.3f }, { 20180, -4.2f }, { 20192, 8.5f }, { 20204, 6.3f },
+  { 20216, -2.0f }, { 20228, -1.7f }, { 20240, 8.5f }, { 20252, -11.0f }, { 20264, -4.7f }, { 20276, 4.4f },
+  { 20288, 0.3f }, { 20300, -4.4f }, { 20312, -9.6f }, { 20324, -10.6f }, { 20336, -3.6f }, { 20348, -9.6f },
+  { 20360, -0.7f }, { 20372, -0.3f }, { 20384, -3.0f }, { 20396, -8.3f }, { 20408, -5.1f }, { 20420, 4.9f },
+  { 20432, -6.0f }, { 20444, -0.9f }, { 20456, -2.6f }, { 20468, 3.4f }, { 20480, -2.7f }, { 20492, 2.9f },
+  { 20504, -1.8f }, { 20516, -2.0f }, { 20528, -0.0f }, { 20540, 2.6f }, { 20552, -0.9f }, { 20564, 0.6f },
+  { 20576, -5.7f }, { 20588, 3.4f }, { 20600, -2.2f }, { 20612, -3.6f }, { 20624, -3.1f }, { 20636, 7.9f },
+  { 20648, -4.1f }, { 20660, 3.9f }, { 20672, -3.1f }, { 20684, -4.2f }, { 20696, -12.5f }, { 20708, -6.8f },
+  { 20720, 13.1f }, { 20732, -0.0f }, { 20744, 5.0f }, { 20756, -1.5f }, { 20768, 0.9f }, { 20780, 0.1f },
+  { 20792, -2.7f }, { 20804, -4.5f }, { 20816, -4.7f }, { 20828, -2.8f }, { 20840, -17.4f }, { 20852, -6.5f },
+  { 20864, 0.6f }, { 20876, -1.4f }, { 20888, 0.4f }, { 20900, -4.4f }, { 20912, 2.6f }, { 20924, 0.9f },
+  { 20936, 1.5f }, { 20948, 10.0f }, { 20960, 7.8f }, { 20972, 13.8f }, { 20984, -3.5f }, { 20996, -1.6f },
+  { 21008, -1.5f }, { 21020, -4.2f }, { 21032, 1.5f }, { 21044, 3.3f }, { 21056, -5.6f }, { 21068, -18.5f },
+  { 21080, 12.2f }, { 21092, 1.4f }, { 21104, -1.8f }, { 21116, -5.3f }, { 21128, -10.0f }, { 21140, 0.5f },
+  { 21152, -2.7f }, { 21164, -14.9f }, { 21176, 245.2f }, { 21188, 0.2f }, { 21200, -2.2f }, { 21212, 0.9f },
+  { 21224, 7.1f }, { 21236, -9.7f }, { 21248, 7.3f }, { 21260, -5.8f }, { 21272, -3.2f }, { 21284, -13.7f },
+  { 21296, 5.8f }, { 21308, -5.4f }, { 21320, 0.2f }, { 21332, -1.4f }, { 21344, -0.2f }, { 21356, 2.0f },
+  { 21368, 16.6f }, { 21380, 5.2f }, { 21392, -7.8f }, { 21404, -7.8f }, { 21416, 3.4f }, { 21428, -0.4f },
+  { 21440, -5.2f }, { 21452, -7.8f }, { 21464, 0.5f }, { 21476, 6.4f }, { 21488, 5.8f }, { 21500, 2.0f },
+  { 21512, 9.1f }, { 21524, 3.3f }, { 21536, 6.2f }, { 21548, -4.1f }, { 21560, -4.6f }, { 21572, -5.6f },
+  { 21584, 4.5f }, { 21596, -4.2f }, { 21608, 2.6f }, { 21620, 1.1f }, { 21632, 0.6f }, { 21644, 0.4f },
+  { 21656, 10.9f }, { 21668, -0.3f }, { 21680, -5.2f }, { 21692, 0.4f }, { 21704, -3.3f }, { 21716, 1.2f },
+  { 21728, 5.7f }, { 21740, 6.4f }, { 21752, -4.0f }, { 21764, -11.9f }, { 21776, -16.3f }, { 21788, 10.6f },
+};
+
+#define TRACE_SAMPLE_COUNT (sizeof(trace_samples) / sizeof(trace_samples[0]))
+
+#endif //TRACE_FIXTURE_H
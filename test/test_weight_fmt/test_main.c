@@ -0,0 +1,216 @@
+//
+// Created by Human Race on 17/10/2026.
+//
+
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils/weight_fmt.h"
+
+#define ORACLE_CASES 200000
+#define BENCH_CALLS  1000000
+// sama dengan batas clamp di weight_fmt.c
+#define WEIGHT_FMT_TEST_MAX 9000000000000000000LL
+
+static char line[WEIGHT_FMT_LINE_SIZE];
+static uint32_t rng_state;
+
+// forward declaration
+static uint32_t next_random(void);
+static void reference_weight(char* out, int64_t micro, weight_unit_t unit);
+static double elapsed_ns(const struct timespec* start, const struct timespec* end);
+
+void setUp(void) {
+  memset(line, 0, sizeof(line));
+  rng_state = 3;
+}
+
+void tearDown(void) {
+}
+
+// --- static function ---
+static uint32_t next_random(void) {
+  // xorshift32, deterministik
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+static void reference_weight(char* out, int64_t micro, weight_unit_t unit) {
+  // referensi pakai printf integer: bulat setengah menjauhi nol, rata kanan 16 kolom
+  static const int64_t steps[WEIGHT_UNIT_COUNT] = { 10000, 1000000, 1000000000 };
+  static const int decimals[WEIGHT_UNIT_COUNT] = { 2, 3, 3 };
+  static const char* const suffixes[WEIGHT_UNIT_COUNT] = { "g", "kg", "t" };
+
+  if (micro > WEIGHT_FMT_TEST_MAX) micro = WEIGHT_FMT_TEST_MAX;
+  if (micro < -WEIGHT_FMT_TEST_MAX) micro = -WEIGHT_FMT_TEST_MAX;
+  uint64_t magnitude = (uint64_t) (micro < 0 ? -micro : micro);
+  uint64_t digits = (magnitude + steps[unit] / 2) / steps[unit];
+  uint64_t scale = 1;
+  for (int i = 0; i < decimals[unit]; i++) scale *= 10;
+
+  char text[64];
+  int len = snprintf(text, sizeof(text), "%s%" PRIu64 ".%0*" PRIu64 " %s", (micro < 0 && digits != 0) ? "-" : "",
+                     digits / scale, decimals[unit], digits % scale, suffixes[unit]);
+  if (len > WEIGHT_FMT_LCD_COLS) {
+    memset(out, '-', WEIGHT_FMT_LCD_COLS);
+  } else {
+    memset(out, ' ', WEIGHT_FMT_LCD_COLS - len);
+    memcpy(out + WEIGHT_FMT_LCD_COLS - len, text, len);
+  }
+  out[WEIGHT_FMT_LCD_COLS] = '\0';
+}
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end) {
+  return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+static void test_grams_with_suffix(void) {
+  TEST_ASSERT_EQUAL_size_t(16, weight_fmt_weight(line, sizeof(line), 123456789, WEIGHT_UNIT_GRAM, 16, true));
+  TEST_ASSERT_EQUAL_STRING("        123.46 g", line);
+  weight_fmt_weight(line, sizeof(line), -5000, WEIGHT_UNIT_GRAM, 0, false);
+  TEST_ASSERT_EQUAL_STRING("-0.01", line);
+  weight_fmt_weight(line, sizeof(line), 1234567890, WEIGHT_UNIT_KG, 0, true);
+  TEST_ASSERT_EQUAL_STRING("1.235 kg", line);
+  weight_fmt_weight(line, sizeof(line), 2500000000000LL, WEIGHT_UNIT_TON, 0, true);
+  TEST_ASSERT_EQUAL_STRING("2.500 t", line);
+}
+
+static void test_negative_zero_shown_as_zero(void) {
+  weight_fmt_weight(line, sizeof(line), weight_fmt_from_units(-0.004f), WEIGHT_UNIT_GRAM, 0, false);
+  TEST_ASSERT_EQUAL_STRING("0.00", line);
+}
+
+static void test_overflow_fills_dashes(void) {
+  char small[5];
+  TEST_ASSERT_EQUAL_size_t(4, weight_fmt_weight(small, sizeof(small), 123456789, WEIGHT_UNIT_GRAM, 4, false));
+  TEST_ASSERT_EQUAL_STRING("----", small);
+  // buffer lebih kecil dari field: tidak menulis apa pun selain '\0'
+  TEST_ASSERT_EQUAL_size_t(0, weight_fmt_weight(line, 16, 1, WEIGHT_UNIT_GRAM, 16, true));
+  TEST_ASSERT_EQUAL_STRING("", line);
+}
+
+static void test_from_units_rounds_and_clamps(void) {
+  TEST_ASSERT_EQUAL_INT64(1500000, weight_fmt_from_units(1.5f));
+  TEST_ASSERT_EQUAL_INT64(-250000, weight_fmt_from_units(-0.25f));
+  TEST_ASSERT_EQUAL_INT64(0, weight_fmt_from_units(NAN));
+  TEST_ASSERT_EQUAL_INT64(WEIGHT_FMT_TEST_MAX, weight_fmt_from_units(INFINITY));
+  TEST_ASSERT_EQUAL_INT64(-WEIGHT_FMT_TEST_MAX, weight_fmt_from_units(-INFINITY));
+}
+
+static void test_int_and_text(void) {
+  const int32_t values[] = { 0, -1, 1, INT32_MIN, INT32_MAX, 8400123 };
+  char expected[WEIGHT_FMT_LINE_SIZE];
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    snprintf(expected, sizeof(expected), "%16" PRId32, values[i]);
+    weight_fmt_int(line, sizeof(line), values[i], 16);
+    TEST_ASSERT_EQUAL_STRING(expected, line);
+  }
+
+  weight_fmt_text(line, sizeof(line), "PAIRING", 10);
+  TEST_ASSERT_EQUAL_STRING("PAIRING   ", line);
+  weight_fmt_text(line, sizeof(line), "CALIBRATION DONE!", 16);
+  TEST_ASSERT_EQUAL_STRING("CALIBRATION DONE", line);
+  weight_fmt_text(line, sizeof(line), NULL, 3);
+  TEST_ASSERT_EQUAL_STRING("   ", line);
+
+  TEST_ASSERT_EQUAL_STRING("KG", weight_fmt_unit_name(WEIGHT_UNIT_KG));
+  TEST_ASSERT_EQUAL_STRING("?", weight_fmt_unit_name(WEIGHT_UNIT_COUNT));
+}
+
+static void test_matches_printf_oracle(void) {
+  char expected[WEIGHT_FMT_LINE_SIZE];
+  for (uint32_t i = 0; i < ORACLE_CASES; i++) {
+    int64_t micro;
+    switch (i % 4) {
+      case 0: // berat timbangan biasa, +-1 kg
+        micro = (int64_t) (next_random() % 2000001) - 1000000;
+        break;
+      case 1: // seluruh range int64
+        micro = (int64_t) ((((uint64_t) next_random() << 32) | next_random()) % 9000000000000000000ULL);
+        if (next_random() & 1) micro = -micro;
+        break;
+      case 2: // tepat di setengah step gram
+        micro = ((int64_t) (next_random() % 20001) - 10000) * 5000;
+        break;
+      default:
+        micro = (int64_t) next_random() * (int32_t) next_random();
+        break;
+    }
+    for (int unit = 0; unit < WEIGHT_UNIT_COUNT; unit++) {
+      reference_weight(expected, micro, (weight_unit_t) unit);
+      TEST_ASSERT_EQUAL_size_t(16, weight_fmt_weight(line, sizeof(line), micro, (weight_unit_t) unit, 16, true));
+      TEST_ASSERT_EQUAL_STRING(expected, line);
+    }
+  }
+}
+
+static void test_benchmark_against_snprintf(void) {
+  // berat timbangan biasa (+-1 kg), sama untuk kedua jalur; jalur lama = snprintf float di buffer LCD
+  static float grams[1024];
+  static int32_t raws[1024];
+  for (int i = 0; i < 1024; i++) {
+    grams[i] = (float) ((int32_t) (next_random() % 200001) - 100000) / 100.0f;
+    raws[i] = (int32_t) next_random() >> 8;
+  }
+  struct timespec start, end;
+  char text[32];
+  uint32_t chars = 0;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+    chars += weight_fmt_weight(line, sizeof(line), weight_fmt_from_units(grams[i & 1023]), WEIGHT_UNIT_GRAM, 16, true);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double fmt_weight_ns = elapsed_ns(&start, &end) / BENCH_CALLS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+    chars += (uint32_t) snprintf(text, sizeof(text), "%14.2f g", (double) grams[i & 1023]);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double printf_weight_ns = elapsed_ns(&start, &end) / BENCH_CALLS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) chars += weight_fmt_int(line, sizeof(line), raws[i & 1023], 16);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double fmt_int_ns = elapsed_ns(&start, &end) / BENCH_CALLS;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+    chars += (uint32_t) snprintf(text, sizeof(text), "%16" PRId32, raws[i & 1023]);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double printf_int_ns = elapsed_ns(&start, &end) / BENCH_CALLS;
+
+  char message[128];
+  snprintf(message, sizeof(message), "weight_fmt_weight %.1f ns vs snprintf(\"%%14.2f g\") %.1f ns", fmt_weight_ns,
+           printf_weight_ns);
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "weight_fmt_int    %.1f ns vs snprintf(\"%%16d\")    %.1f ns", fmt_int_ns,
+           printf_int_ns);
+  TEST_MESSAGE(message);
+
+  // semua field 16 kolom di kedua jalur
+  TEST_ASSERT_EQUAL_UINT32(4 * 16 * BENCH_CALLS, chars);
+  // formatter integer harus lebih murah dari printf float yang digantikannya
+  TEST_ASSERT_TRUE(fmt_weight_ns < printf_weight_ns);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_grams_with_suffix);
+  RUN_TEST(test_negative_zero_shown_as_zero);
+  RUN_TEST(test_overflow_fills_dashes);
+  RUN_TEST(test_from_units_rounds_and_clamps);
+  RUN_TEST(test_int_and_text);
+  RUN_TEST(test_matches_printf_oracle);
+  RUN_TEST(test_benchmark_against_snprintf);
+  return UNITY_END();
+}